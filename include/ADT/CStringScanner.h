@@ -0,0 +1,221 @@
+//
+//  ADT/CStringScanner.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "Utils/SwitchEndian.h"
+
+// Scans a buffer of null-terminated strings in a single pass, 32 bytes at a
+// time, finding both the null-terminators and any byte that isn't printable.
+//
+// The buffer is read as 64-bit words, with each byte of a word tested at once
+// through bit-tricks, so the scan is vectorized without depending on any
+// instruction-set.
+
+namespace CStringScanner {
+    constexpr static auto BlockSize = 32;
+    constexpr static auto WordSize = static_cast<int>(sizeof(uint64_t));
+    constexpr static auto WordCount = BlockSize / WordSize;
+
+    constexpr static auto LowBits = uint64_t(0x0101010101010101);
+    constexpr static auto HighBits = uint64_t(0x8080808080808080);
+
+    // Printable bytes are those that isprint() accepts in the "C" locale,
+    // [0x20, 0x7E].
+
+    [[nodiscard]] constexpr bool IsPrintable(const char Ch) noexcept {
+        return (static_cast<uint8_t>(Ch) - 0x20u) < 0x5Fu;
+    }
+
+    // Loads the word so that the first byte is in the lowest bits.
+    [[nodiscard]] inline uint64_t LoadWord(const char *const Ptr) noexcept {
+        auto Word = uint64_t();
+        memcpy(&Word, Ptr, sizeof(Word));
+
+        return SwitchEndianIf(Word, std::endian::native == std::endian::big);
+    }
+
+    // Each of the below sets the high bit of every byte in the word that
+    // matches. The additions never carry between bytes, as the high bit of
+    // each byte is cleared beforehand, so the masks are exact.
+
+    [[nodiscard]] constexpr uint64_t GetZeroMask(const uint64_t Word) noexcept {
+        const auto Low = Word & ~HighBits;
+        return ~((Low + LowBits * 0x7F) | Word) & HighBits;
+    }
+
+    [[nodiscard]]
+    constexpr uint64_t GetNonPrintableMask(const uint64_t Word) noexcept {
+        const auto Low = Word & ~HighBits;
+
+        // Bytes below 0x20, which includes the null-terminator.
+        const auto ControlMask = ~((Low + LowBits * 0x60) | Word) & HighBits;
+
+        // Bytes of 0x7F, and bytes of 0x80 and above.
+        const auto HighMask = ((Low + LowBits) | Word) & HighBits;
+
+        return (ControlMask | HighMask) & ~GetZeroMask(Word);
+    }
+
+    [[nodiscard]] constexpr uint64_t
+    GetByteMask(const uint64_t Word, const char Ch) noexcept {
+        return GetZeroMask(Word ^ (LowBits * static_cast<uint8_t>(Ch)));
+    }
+}
+
+// Returns a pointer to the first occurence of Needle in [Begin, End), or
+// nullptr if there is none.
+//
+// Positions where both the first and last bytes of Needle match are found a
+// word at a time, so only those positions are compared in full.
+
+[[nodiscard]] inline const char *
+FindSubstring(const char *const Begin,
+              const char *const End,
+              const std::string_view Needle) noexcept
+{
+    using namespace CStringScanner;
+
+    const auto Length = static_cast<int64_t>(Needle.length());
+    if (Length == 0) {
+        return Begin;
+    }
+
+    if (End - Begin < Length) {
+        return nullptr;
+    }
+
+    const auto First = Needle.front();
+    const auto Last = Needle.back();
+    const auto LastPosEnd = End - Length + 1;
+
+    auto Ptr = Begin;
+    while (LastPosEnd - Ptr >= WordSize) {
+        auto Mask =
+            GetByteMask(LoadWord(Ptr), First) &
+            GetByteMask(LoadWord(Ptr + Length - 1), Last);
+
+        while (Mask != 0) {
+            const auto Candidate = Ptr + std::countr_zero(Mask) / 8;
+            if (memcmp(Candidate, Needle.data(), Needle.length()) == 0) {
+                return Candidate;
+            }
+
+            Mask &= Mask - 1;
+        }
+
+        Ptr += WordSize;
+    }
+
+    for (; Ptr != LastPosEnd; Ptr++) {
+        if (*Ptr == First &&
+            memcmp(Ptr, Needle.data(), Needle.length()) == 0)
+        {
+            return Ptr;
+        }
+    }
+
+    return nullptr;
+}
+
+// Calls Callback(String, Offset) for each non-empty string in [Begin, End)
+// made up of only printable characters, where Offset is the offset of the
+// string from Begin. A final string that's missing its null-terminator ends at
+// End.
+
+template <typename T>
+void
+ScanPrintableCStrings(const char *const Begin,
+                      const char *const End,
+                      const T &Callback) noexcept
+{
+    using namespace CStringScanner;
+
+    auto StringBegin = Begin;
+    auto HasNonPrintable = false;
+
+    const auto EndString = [&](const char *const StringEnd) noexcept {
+        if (!HasNonPrintable && StringEnd != StringBegin) {
+            const auto Length = static_cast<uint64_t>(StringEnd - StringBegin);
+            Callback(std::string_view(StringBegin, Length),
+                     static_cast<uint64_t>(StringBegin - Begin));
+        }
+
+        StringBegin = StringEnd + 1;
+        HasNonPrintable = false;
+    };
+
+    const auto ScanWord = [&](const char *const Ptr,
+                              uint64_t ZeroMask,
+                              uint64_t NonPrintableMask) noexcept
+    {
+        while (ZeroMask != 0) {
+            const auto Index = std::countr_zero(ZeroMask) / 8;
+            const auto BeforeMask = (uint64_t(1) << (Index * 8)) - 1;
+
+            if ((NonPrintableMask & BeforeMask) != 0) {
+                HasNonPrintable = true;
+            }
+
+            EndString(Ptr + Index);
+
+            const auto ThroughMask = (BeforeMask << 8) | 0xFF;
+
+            ZeroMask &= ~ThroughMask;
+            NonPrintableMask &= ~ThroughMask;
+        }
+
+        if (NonPrintableMask != 0) {
+            HasNonPrintable = true;
+        }
+    };
+
+    auto Ptr = Begin;
+    while (End - Ptr >= BlockSize) {
+        uint64_t ZeroMaskList[WordCount];
+        uint64_t NonPrintableMaskList[WordCount];
+
+        auto BlockMask = uint64_t();
+        for (auto I = 0; I != WordCount; I++) {
+            const auto Word = LoadWord(Ptr + I * WordSize);
+
+            ZeroMaskList[I] = GetZeroMask(Word);
+            NonPrintableMaskList[I] = GetNonPrintableMask(Word);
+
+            BlockMask |= ZeroMaskList[I] | NonPrintableMaskList[I];
+        }
+
+        // Most blocks are entirely in the middle of a printable string.
+        if (BlockMask != 0) {
+            for (auto I = 0; I != WordCount; I++) {
+                ScanWord(Ptr + I * WordSize,
+                         ZeroMaskList[I],
+                         NonPrintableMaskList[I]);
+            }
+        }
+
+        Ptr += BlockSize;
+    }
+
+    for (; Ptr != End; Ptr++) {
+        if (*Ptr == '\0') {
+            EndString(Ptr);
+        } else if (!IsPrintable(*Ptr)) {
+            HasNonPrintable = true;
+        }
+    }
+
+    if (StringBegin < End) {
+        EndString(End);
+    }
+}
@@ -0,0 +1,278 @@
+//
+//  ADT/ColumnarFormat.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "Utils/SwitchEndian.h"
+
+// Layout of the columnar binary format written by --format=bin.
+//
+// Every integer is little-endian, and every offset is relative to the start of
+// the file and aligned to 8 bytes, so a mapped file can be read in place:
+//
+//     ColumnarFileHeader
+//     ColumnarColumnHeader[ColumnCount]
+//     For each column:
+//         uint64_t Values[RowCount]
+//         uint64_t Validity[(RowCount + 63) / 64]
+//     char StringHeap[StringHeapSize]
+//
+// Bit (Row % 64) of Validity[Row / 64] is set when the row has a value for the
+// column, and clear when the value is null.
+//
+// Values of String columns store an offset into the string-heap in the low 32
+// bits, and the string's length in the high 32 bits. Every string in the heap
+// is unique, and is followed by a null-terminator that isn't counted in the
+// length.
+
+enum class ColumnarColumnKind : uint8_t {
+    Null,
+    UInt64,
+    Int64,
+    Bool,
+    String
+};
+
+constexpr static auto ColumnarFileMagic = std::string_view("KTOOLCOL", 8);
+constexpr static auto ColumnarFileVersion = uint32_t(1);
+constexpr static auto ColumnarColumnNameMax = 32;
+
+struct ColumnarFileHeader {
+    char Magic[8];
+    uint32_t Version;
+    uint32_t ColumnCount;
+    uint64_t RowCount;
+    uint64_t StringHeapOffset;
+    uint64_t StringHeapSize;
+};
+
+struct ColumnarColumnHeader {
+    char Name[ColumnarColumnNameMax];
+    ColumnarColumnKind Kind;
+    uint8_t Reserved[7];
+    uint64_t ValuesOffset;
+    uint64_t ValidityOffset;
+};
+
+static_assert(sizeof(ColumnarFileHeader) == 40);
+static_assert(sizeof(ColumnarColumnHeader) == 56);
+
+template <std::integral T>
+[[nodiscard]] inline T ColumnarLoad(const uint8_t *const Ptr) noexcept {
+    auto Value = T();
+    memcpy(&Value, Ptr, sizeof(T));
+
+    return SwitchEndianIf(Value, std::endian::native == std::endian::big);
+}
+
+struct ColumnarColumnView {
+protected:
+    const uint8_t *Begin = nullptr;
+    const ColumnarColumnHeader *Header = nullptr;
+    uint64_t StringHeapOffset = 0;
+public:
+    constexpr ColumnarColumnView() noexcept = default;
+    constexpr
+    ColumnarColumnView(const uint8_t *const Begin,
+                       const ColumnarColumnHeader *const Header,
+                       const uint64_t StringHeapOffset) noexcept
+    : Begin(Begin), Header(Header), StringHeapOffset(StringHeapOffset) {}
+
+    [[nodiscard]] inline auto getName() const noexcept {
+        const auto Name = this->Header->Name;
+        return std::string_view(Name, strnlen(Name, ColumnarColumnNameMax));
+    }
+
+    [[nodiscard]] constexpr auto getKind() const noexcept {
+        return this->Header->Kind;
+    }
+
+    [[nodiscard]] inline auto getValuesOffset() const noexcept {
+        const auto HeaderPtr = reinterpret_cast<const uint8_t *>(Header);
+        return ColumnarLoad<uint64_t>(
+            HeaderPtr + offsetof(ColumnarColumnHeader, ValuesOffset));
+    }
+
+    [[nodiscard]] inline auto getValidityOffset() const noexcept {
+        const auto HeaderPtr = reinterpret_cast<const uint8_t *>(Header);
+        return ColumnarLoad<uint64_t>(
+            HeaderPtr + offsetof(ColumnarColumnHeader, ValidityOffset));
+    }
+
+    [[nodiscard]] inline auto getRaw(const uint64_t Row) const noexcept {
+        return ColumnarLoad<uint64_t>(
+            Begin + this->getValuesOffset() + Row * 8);
+    }
+
+    [[nodiscard]] inline auto isNull(const uint64_t Row) const noexcept {
+        const auto Word =
+            ColumnarLoad<uint64_t>(
+                Begin + this->getValidityOffset() + (Row / 64) * 8);
+
+        return (Word & (1ull << (Row % 64))) == 0;
+    }
+
+    [[nodiscard]] inline auto getUInt64(const uint64_t Row) const noexcept {
+        return this->getRaw(Row);
+    }
+
+    [[nodiscard]] inline auto getInt64(const uint64_t Row) const noexcept {
+        return static_cast<int64_t>(this->getRaw(Row));
+    }
+
+    [[nodiscard]] inline auto getBool(const uint64_t Row) const noexcept {
+        return this->getRaw(Row) != 0;
+    }
+
+    [[nodiscard]]
+    inline auto getString(const uint64_t Row) const noexcept {
+        const auto Value = this->getRaw(Row);
+        const auto Offset = static_cast<uint32_t>(Value);
+        const auto Length = static_cast<uint32_t>(Value >> 32);
+        const auto Ptr =
+            reinterpret_cast<const char *>(Begin + StringHeapOffset + Offset);
+
+        return std::string_view(Ptr, Length);
+    }
+};
+
+// Reads a columnar file already in memory, without copying or parsing any of
+// its columns.
+
+struct ColumnarReader {
+protected:
+    const uint8_t *Begin = nullptr;
+    const uint8_t *End = nullptr;
+
+    uint32_t ColumnCount = 0;
+    uint64_t RowCount = 0;
+    uint64_t StringHeapOffset = 0;
+
+    [[nodiscard]] inline auto
+    containsRange(const uint64_t Offset, const uint64_t Size) const noexcept {
+        const auto FileSize = static_cast<uint64_t>(End - Begin);
+        return Offset <= FileSize && Size <= FileSize - Offset;
+    }
+public:
+    constexpr ColumnarReader() noexcept = default;
+
+    // Returns false if the provided memory isn't a valid columnar file.
+    [[nodiscard]] inline bool open(const uint8_t *const Begin,
+                                   const uint8_t *const End) noexcept
+    {
+        this->Begin = Begin;
+        this->End = End;
+
+        if (!containsRange(0, sizeof(ColumnarFileHeader))) {
+            return false;
+        }
+
+        const auto Header = reinterpret_cast<const ColumnarFileHeader *>(Begin);
+        if (std::string_view(Header->Magic, 8) != ColumnarFileMagic) {
+            return false;
+        }
+
+        const auto HeaderPtr = reinterpret_cast<const uint8_t *>(Header);
+        const auto Version =
+            ColumnarLoad<uint32_t>(
+                HeaderPtr + offsetof(ColumnarFileHeader, Version));
+
+        if (Version != ColumnarFileVersion) {
+            return false;
+        }
+
+        this->ColumnCount =
+            ColumnarLoad<uint32_t>(
+                HeaderPtr + offsetof(ColumnarFileHeader, ColumnCount));
+        this->RowCount =
+            ColumnarLoad<uint64_t>(
+                HeaderPtr + offsetof(ColumnarFileHeader, RowCount));
+        this->StringHeapOffset =
+            ColumnarLoad<uint64_t>(
+                HeaderPtr + offsetof(ColumnarFileHeader, StringHeapOffset));
+
+        const auto StringHeapSize =
+            ColumnarLoad<uint64_t>(
+                HeaderPtr + offsetof(ColumnarFileHeader, StringHeapSize));
+
+        if (!containsRange(StringHeapOffset, StringHeapSize)) {
+            return false;
+        }
+
+        const auto ColumnListSize =
+            static_cast<uint64_t>(ColumnCount) * sizeof(ColumnarColumnHeader);
+
+        if (!containsRange(sizeof(ColumnarFileHeader), ColumnListSize)) {
+            return false;
+        }
+
+        if (RowCount > UINT64_MAX / 8) {
+            return false;
+        }
+
+        const auto ValuesSize = RowCount * 8;
+        const auto ValiditySize = ((RowCount + 63) / 64) * 8;
+
+        for (auto I = uint32_t(); I != ColumnCount; I++) {
+            const auto Column = this->getColumn(I);
+            const auto ValuesOffset = Column.getValuesOffset();
+            const auto ValidityOffset = Column.getValidityOffset();
+
+            if (!containsRange(ValuesOffset, ValuesSize) ||
+                !containsRange(ValidityOffset, ValiditySize))
+            {
+                return false;
+            }
+
+            if (Column.getKind() > ColumnarColumnKind::String) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] constexpr auto getColumnCount() const noexcept {
+        return this->ColumnCount;
+    }
+
+    [[nodiscard]] constexpr auto getRowCount() const noexcept {
+        return this->RowCount;
+    }
+
+    [[nodiscard]] inline auto
+    getColumn(const uint32_t Index) const noexcept -> ColumnarColumnView {
+        const auto ColumnList =
+            reinterpret_cast<const ColumnarColumnHeader *>(
+                Begin + sizeof(ColumnarFileHeader));
+
+        return ColumnarColumnView(Begin, ColumnList + Index, StringHeapOffset);
+    }
+
+    // Returns false if no column has the provided name.
+    [[nodiscard]] inline bool
+    findColumn(const std::string_view Name,
+               ColumnarColumnView &ViewOut) const noexcept
+    {
+        for (auto I = uint32_t(); I != ColumnCount; I++) {
+            const auto Column = this->getColumn(I);
+            if (Column.getName() == Name) {
+                ViewOut = Column;
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
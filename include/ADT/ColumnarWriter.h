@@ -0,0 +1,94 @@
+//
+//  ADT/ColumnarWriter.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ADT/ColumnarFormat.h"
+
+// Writer for the columnar binary format described in ADT/ColumnarFormat.h.
+//
+// Has the same record-based interface as JsonWriter. Columns are created the
+// first time a key is written, and are filled with nulls for every record
+// that doesn't write them. Because every column is written out contiguously,
+// all records are buffered in memory until endList().
+
+struct ColumnarWriter {
+protected:
+    struct Column {
+        std::string Name;
+        ColumnarColumnKind Kind = ColumnarColumnKind::Null;
+
+        std::vector<uint64_t> Values;
+        std::vector<uint64_t> Validity;
+    };
+
+    struct StringHash {
+        using is_transparent = void;
+
+        [[nodiscard]] inline
+        size_t operator()(const std::string_view String) const noexcept {
+            return std::hash<std::string_view>()(String);
+        }
+    };
+
+    FILE *OutFile;
+    uint64_t RecordCount = 0;
+
+    std::vector<Column> ColumnList;
+    std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>>
+        StringOffsetMap;
+
+    std::string StringHeap;
+
+    // Records almost always write their keys in the same order, so the column
+    // after the last one written is checked before searching the list.
+    uint32_t NextColumnIndex = 0;
+    bool InRecord : 1 = false;
+
+    [[nodiscard]] auto
+    getColumnForKey(std::string_view Key, ColumnarColumnKind Kind) noexcept
+        -> Column &;
+
+    [[nodiscard]] auto addString(std::string_view String) noexcept -> uint64_t;
+    void writeValue(std::string_view Key,
+                    ColumnarColumnKind Kind,
+                    uint64_t Value) noexcept;
+public:
+    explicit ColumnarWriter(FILE *OutFile) noexcept;
+
+    [[nodiscard]] constexpr auto getRecordCount() const noexcept {
+        return this->RecordCount;
+    }
+
+    auto beginList() noexcept -> decltype(*this);
+    auto endList() noexcept -> decltype(*this);
+
+    auto beginRecord() noexcept -> decltype(*this);
+    auto endRecord() noexcept -> decltype(*this);
+
+    auto writeString(std::string_view Key, std::string_view Value) noexcept
+        -> decltype(*this);
+
+    auto writeNumber(std::string_view Key, uint64_t Value) noexcept
+        -> decltype(*this);
+
+    auto writeSignedNumber(std::string_view Key, int64_t Value) noexcept
+        -> decltype(*this);
+
+    auto writeBool(std::string_view Key, bool Value) noexcept
+        -> decltype(*this);
+
+    auto writeNull(std::string_view Key) noexcept -> decltype(*this);
+};
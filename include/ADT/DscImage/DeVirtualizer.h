@@ -10,10 +10,13 @@
 
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <optional>
 #include <string_view>
 
 #include "ADT/DyldSharedCache/Headers.h"
+#include "ADT/DyldSharedCache/RebasedView.h"
+#include "ADT/MemoryMap.h"
 #include "ADT/Range.h"
 
 namespace DscImage {
@@ -21,6 +24,9 @@ namespace DscImage {
     protected:
         const uint8_t *Map;
         DyldSharedCache::ConstMappingInfoList MappingList;
+
+        std::shared_ptr<const DyldSharedCache::RebasedView> RebasedView;
+        DyldSharedCache::SlidePointerFormat PointerFormat;
     public:
         explicit inline
         ConstDeVirtualizer(
@@ -28,6 +34,24 @@ namespace DscImage {
             const DyldSharedCache::ConstMappingInfoList &MappingList) noexcept
         : Map(Map), MappingList(MappingList) {}
 
+        // Also decodes pointers with the provided rebased-view of the cache,
+        // which should be the one kept by the cache's object, so that pages
+        // decoded by one devirtualizer are reused by every other.
+
+        explicit inline
+        ConstDeVirtualizer(
+            const ConstMemoryMap &Map,
+            const DyldSharedCache::ConstMappingInfoList &MappingList,
+            std::shared_ptr<const DyldSharedCache::RebasedView> RebasedView)
+                noexcept
+        : Map(Map.getBegin()), MappingList(MappingList),
+          RebasedView(std::move(RebasedView))
+        {
+            if (this->RebasedView != nullptr) {
+                this->PointerFormat = this->RebasedView->getPointerFormat();
+            }
+        }
+
         [[nodiscard]] constexpr auto &getMappingsList() const noexcept {
             return this->MappingList;
         }
@@ -36,6 +60,14 @@ namespace DscImage {
             return this->Map;
         }
 
+        [[nodiscard]] constexpr auto &getPointerFormat() const noexcept {
+            return this->PointerFormat;
+        }
+
+        [[nodiscard]] inline auto getRebasedView() const noexcept {
+            return this->RebasedView.get();
+        }
+
         [[nodiscard]] constexpr auto getBeginOffset() const noexcept {
             return this->getMappingsList().front().FileOffset;
         }
@@ -102,6 +134,29 @@ namespace DscImage {
             return nullptr;
         }
 
+        // Returns the address of data found within a mapping of the cache.
+
+        [[nodiscard]] inline auto
+        GetVmAddrForData(const void *const Data) const noexcept
+            -> std::optional<uint64_t>
+        {
+            const auto Ptr = static_cast<const uint8_t *>(Data);
+            if (Ptr < this->getMap()) {
+                return std::nullopt;
+            }
+
+            const auto Offset = static_cast<uint64_t>(Ptr - this->getMap());
+            for (const auto &Mapping : this->getMappingsList()) {
+                if (const auto FileRange = Mapping.getFileRange()) {
+                    if (FileRange->hasLocation(Offset)) {
+                        return Mapping.Address + (Offset - Mapping.FileOffset);
+                    }
+                }
+            }
+
+            return std::nullopt;
+        }
+
         [[nodiscard]]
         inline auto GetStringAtAddress(const uint64_t Address) const noexcept
             -> std::optional<std::string_view>
@@ -117,6 +172,93 @@ namespace DscImage {
 
             return Name;
         }
+
+        // Decodes a pointer read from a mapping to the address it points to
+        // before the cache is slid. Pointers are returned unchanged if the
+        // cache has no slide-info.
+
+        [[nodiscard]]
+        inline auto UnslidePointer(const uint64_t Value) const noexcept {
+            return this->PointerFormat.UnslidePointer(Value);
+        }
+
+        // Reads the pointer at the provided address through the rebased-view,
+        // so only words that are in a chain are decoded. Addresses outside
+        // the mappings with slide-info fall back to UnslidePointer().
+
+        [[nodiscard]] inline auto
+        ReadUnslidPointer(const uint64_t VmAddr,
+                          const bool Is64Bit) const noexcept
+            -> std::optional<uint64_t>
+        {
+            if (this->RebasedView != nullptr) {
+                const auto Pointer =
+                    this->RebasedView->ReadPointer(VmAddr, Is64Bit);
+
+                if (Pointer.has_value()) {
+                    return Pointer;
+                }
+            }
+
+            const auto Size = Is64Bit ? sizeof(uint64_t) : sizeof(uint32_t);
+            const auto Ptr = this->GetDataAtVmAddr<uint8_t>(VmAddr, Size);
+
+            if (Ptr == nullptr) {
+                return std::nullopt;
+            }
+
+            auto Value = uint64_t();
+            memcpy(&Value, Ptr, Size);
+
+            return this->UnslidePointer(Value);
+        }
+
+        // Reads the pointer at Location, which points within a mapping of the
+        // cache, through the rebased-view. Returns std::nullopt if the cache
+        // has no view, or if Location has no slide-info.
+
+        [[nodiscard]] inline auto
+        ReadRebasedPointerAt(const void *const Location,
+                             const bool Is64Bit) const noexcept
+            -> std::optional<uint64_t>
+        {
+            if (this->RebasedView == nullptr) {
+                return std::nullopt;
+            }
+
+            if (const auto VmAddr = this->GetVmAddrForData(Location)) {
+                return this->RebasedView->ReadPointer(VmAddr.value(), Is64Bit);
+            }
+
+            return std::nullopt;
+        }
+    };
+
+    // Callable passed to the Objective-C parsers, which read every pointer
+    // through ReadPointerAt(), and decode pointers outside the rebased-view
+    // through UnslidePointer().
+
+    struct DeVirtualizeFunc {
+        const ConstDeVirtualizer &DeVirtualizer;
+
+        [[nodiscard]] inline auto
+        operator()(const uint64_t Addr,
+                   const uint64_t Size = sizeof(uint8_t)) const noexcept
+        {
+            return this->DeVirtualizer.GetDataAtVmAddr<uint8_t>(Addr, Size);
+        }
+
+        [[nodiscard]]
+        inline auto UnslidePointer(const uint64_t Value) const noexcept {
+            return this->DeVirtualizer.UnslidePointer(Value);
+        }
+
+        [[nodiscard]] inline auto
+        ReadPointerAt(const void *const Location,
+                      const bool Is64Bit) const noexcept
+        {
+            return this->DeVirtualizer.ReadRebasedPointerAt(Location, Is64Bit);
+        }
     };
 
     struct DeVirtualizer : public ConstDeVirtualizer {
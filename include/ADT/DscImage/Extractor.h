@@ -0,0 +1,95 @@
+//
+//  ADT/DscImage/Extractor.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "ADT/FileDescriptor.h"
+#include "ADT/MemoryMap.h"
+
+namespace DscImage {
+    // Reconstructs a standalone Mach-O from an image of a dyld_shared_cache.
+    //
+    // The image's segments are laid out back-to-back, and the parts of the
+    // cache's shared __LINKEDIT that the image's load-commands refer to are
+    // gathered into a compacted __LINKEDIT of its own.
+    //
+    // Only the load-commands and the image's symbol-table are rebuilt in
+    // memory, every other byte is written straight from the mapped cache.
+    // Pointers in the image's data-segments are written as they're stored in
+    // the cache, and the local-symbols the cache keeps apart aren't restored.
+
+    struct ImageExtractor {
+    public:
+        enum class Error {
+            None,
+
+            UnsupportedImage,
+            InvalidLoadCommands,
+
+            SegmentNotMapped,
+            NoTextSegment,
+            NoLinkeditSegment,
+
+            LinkeditDataOutOfBounds,
+            SymbolTableOutOfBounds
+        };
+
+        constexpr static auto SegmentAlignment = uint64_t(0x4000);
+    protected:
+        enum class PieceSource : uint8_t {
+            Cache,
+            Header,
+            SymbolTable,
+            StringTable
+        };
+
+        // A range of the output file, and the range of the source it's
+        // written from.
+
+        struct Piece {
+            uint64_t FileOffset;
+            uint64_t SourceOffset;
+            uint64_t Size;
+
+            PieceSource Source;
+        };
+
+        const uint8_t *CacheBegin = nullptr;
+
+        std::vector<uint8_t> HeaderData;
+        std::vector<uint8_t> SymbolTableData;
+        std::vector<uint8_t> StringTableData;
+
+        std::vector<Piece> PieceList;
+        uint64_t FileSize = 0;
+
+        [[nodiscard]]
+        auto getPieceData(const Piece &Item) const noexcept -> const uint8_t *;
+    public:
+        // Lays out the image whose mach-header is at ImageAddress in the cache
+        // in CacheMap. Nothing is written until WriteTo() is called.
+
+        [[nodiscard]] static auto
+        Open(const ConstMemoryMap &CacheMap,
+             uint64_t ImageAddress,
+             Error *ErrorOut) noexcept -> std::optional<ImageExtractor>;
+
+        [[nodiscard]] inline auto getFileSize() const noexcept {
+            return FileSize;
+        }
+
+        // Writes the image to Fd, which is resized to the image's size. The
+        // gaps between segments are left as holes.
+
+        [[nodiscard]] bool WriteTo(FileDescriptor &Fd) const noexcept;
+    };
+}
@@ -0,0 +1,28 @@
+//
+//  ADT/DscImage/ObjcMetadata.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include "ADT/Mach-O/ObjcMetadata.h"
+#include "DeVirtualizer.h"
+
+namespace DscImage {
+    struct ObjcMetadataCollection : public MachO::ObjcMetadataCollection {
+    public:
+        // Addresses are read through the shared-cache's mappings, as an
+        // image's metadata may point into other images of the cache.
+
+        [[nodiscard]] static ObjcMetadataCollection
+        Open(const MachO::SegmentInfoCollection &SegmentCollection,
+             const ConstDeVirtualizer &DeVirtualizer,
+             bool IsBigEndian,
+             bool Is64Bit,
+             std::optional<uint64_t> RelativeSelectorBase = std::nullopt)
+                noexcept;
+    };
+}
@@ -24,6 +24,13 @@ namespace DscImage {
              Error *ErrorOut) noexcept
             -> SegmentInfoCollection;
 
+        [[nodiscard]] static auto
+        Open(uint64_t ImageAddress,
+             const MachO::LoadCommandIndex &LoadCmdIndex,
+             bool Is64Bit,
+             Error *ErrorOut) noexcept
+            -> SegmentInfoCollection;
+
         [[nodiscard]] constexpr auto
         getFullAddressFromRelative(const uint64_t Relative) const noexcept {
             return ImageAddress + Relative;
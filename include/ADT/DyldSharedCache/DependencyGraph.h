@@ -0,0 +1,137 @@
+//
+//  ADT/DyldSharedCache/DependencyGraph.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace DyldSharedCache {
+    // Graph of the images of a dyld_shared_cache, with an edge from every
+    // image to each library it loads.
+    //
+    // Edges are stored in compressed-sparse-row form, with the edges of each
+    // image stored next to each other in one list, and a list of offsets into
+    // the edge-list for every image, so that a query only ever walks
+    // contiguous memory. The reversed edges are stored the same way to find
+    // the dependents of an image.
+
+    struct DependencyGraph {
+    public:
+        enum class EdgeKind : uint8_t {
+            Load,
+            Weak,
+            Reexport,
+            Upward
+        };
+
+        struct Edge {
+            uint32_t Node;
+            EdgeKind Kind;
+        };
+    protected:
+        std::vector<uint32_t> OffsetList = { 0 };
+        std::vector<Edge> EdgeList;
+
+        std::vector<uint32_t> ReverseOffsetList = { 0 };
+        std::vector<Edge> ReverseEdgeList;
+
+        [[nodiscard]] static inline bool
+        ShouldFollowEdge(const Edge &Edge, const bool FollowUpward) noexcept {
+            return FollowUpward || Edge.Kind != EdgeKind::Upward;
+        }
+
+        [[nodiscard]] auto
+        GetReachableNodes(uint32_t Node,
+                          const std::vector<uint32_t> &OffsetList,
+                          const std::vector<Edge> &EdgeList,
+                          bool FollowUpward) const noexcept
+            -> std::vector<uint32_t>;
+    public:
+        DependencyGraph() noexcept = default;
+
+        // Creates a graph of EdgeListList.size() nodes, with the edges of
+        // each node in the same order as in its list.
+
+        [[nodiscard]] static auto
+        Create(const std::vector<std::vector<Edge>> &EdgeListList) noexcept
+            -> DependencyGraph;
+
+        [[nodiscard]] inline auto getNodeCount() const noexcept {
+            return static_cast<uint32_t>(OffsetList.size() - 1);
+        }
+
+        [[nodiscard]] inline auto getEdgeCount() const noexcept {
+            return static_cast<uint64_t>(EdgeList.size());
+        }
+
+        [[nodiscard]] inline auto empty() const noexcept {
+            return EdgeList.empty();
+        }
+
+        [[nodiscard]]
+        inline auto getDependencies(const uint32_t Node) const noexcept {
+            assert(Node < getNodeCount());
+
+            const auto Begin = EdgeList.data();
+            return std::span<const Edge>(Begin + OffsetList[Node],
+                                         Begin + OffsetList[Node + 1]);
+        }
+
+        [[nodiscard]]
+        inline auto getDependents(const uint32_t Node) const noexcept {
+            assert(Node < getNodeCount());
+
+            const auto Begin = ReverseEdgeList.data();
+            return std::span<const Edge>(Begin + ReverseOffsetList[Node],
+                                         Begin + ReverseOffsetList[Node + 1]);
+        }
+
+        // Returns every node reachable from Node, not including Node itself,
+        // in breadth-first order. Upward-edges point back at the dependents
+        // of an image, and so are only followed if FollowUpward is set.
+
+        [[nodiscard]] inline auto
+        GetTransitiveDependencies(const uint32_t Node,
+                                  const bool FollowUpward) const noexcept
+        {
+            return GetReachableNodes(Node,
+                                     OffsetList,
+                                     EdgeList,
+                                     FollowUpward);
+        }
+
+        [[nodiscard]] inline auto
+        GetTransitiveDependents(const uint32_t Node,
+                                const bool FollowUpward) const noexcept
+        {
+            return GetReachableNodes(Node,
+                                     ReverseOffsetList,
+                                     ReverseEdgeList,
+                                     FollowUpward);
+        }
+
+        // Fills OrderOut with every node, ordered so that each node comes
+        // after all of its dependencies. Returns false if a cycle was found,
+        // in which case the nodes in or depending on a cycle are placed at the
+        // end, in ascending order.
+
+        bool
+        GetTopologicalOrder(std::vector<uint32_t> &OrderOut,
+                            bool FollowUpward) const noexcept;
+
+        // Returns every cycle of the graph as the list of nodes of the cycle,
+        // found as the strongly-connected components with more than one node,
+        // or with an edge to itself.
+
+        [[nodiscard]] auto FindCycles(bool FollowUpward) const noexcept
+            -> std::vector<std::vector<uint32_t>>;
+    };
+}
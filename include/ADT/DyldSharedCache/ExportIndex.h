@@ -0,0 +1,84 @@
+//
+//  ADT/DyldSharedCache/ExportIndex.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "ADT/Mach-O/ExportTrie.h"
+#include "ADT/StringHashMap.h"
+
+namespace DyldSharedCache {
+    // Index of every export of an image's export-trie by symbol-name, so that
+    // each lookup doesn't need to walk the trie.
+    //
+    // The trie is decoded only once, with every symbol-name and re-export
+    // import-name copied into a single buffer owned by the index.
+
+    struct ExportIndex {
+    public:
+        using ExportKind = MachO::ExportTrieExportKind;
+        using Error = MachO::ExportTrieParseError;
+
+        struct Entry {
+            ExportKind Kind = ExportKind::None;
+
+            // Offset from the image's base-address, or the value of an
+            // absolute symbol.
+
+            uint64_t ImageOffset = 0;
+            uint64_t ResolverStubAddress = 0;
+
+            // Only valid for re-exports, and empty if the symbol is
+            // re-exported under the same name.
+
+            uint32_t ReexportDylibOrdinal = 0;
+            std::string_view ReexportImportName;
+        };
+    protected:
+        std::vector<char> StringBuffer;
+        StringHashMap<Entry> Map;
+    public:
+        ExportIndex() noexcept = default;
+
+        ExportIndex(const ExportIndex &) = delete;
+        ExportIndex(ExportIndex &&) noexcept = default;
+
+        auto operator=(const ExportIndex &) -> ExportIndex & = delete;
+        auto operator=(ExportIndex &&) noexcept -> ExportIndex & = default;
+
+        // Entries up to the first error found in the trie are still indexed.
+
+        [[nodiscard]] static auto
+        Open(const MachO::ConstExportTrieExportList &Trie,
+             Error *ErrorOut) noexcept
+            -> ExportIndex;
+
+        [[nodiscard]] inline auto size() const noexcept {
+            return Map.size();
+        }
+
+        [[nodiscard]] inline auto empty() const noexcept {
+            return Map.empty();
+        }
+
+        [[nodiscard]] inline auto begin() const noexcept {
+            return Map.begin();
+        }
+
+        [[nodiscard]] inline auto end() const noexcept {
+            return Map.end();
+        }
+
+        [[nodiscard]]
+        inline auto find(const std::string_view Name) const noexcept {
+            return Map.find(Name);
+        }
+    };
+}
@@ -815,6 +815,19 @@ namespace DyldSharedCache {
                 Range::CreateWithSize(SwiftOptsOffset, SwiftOptsSize);
         }
 
+        // Local symbols of caches with sub-caches are stored in a separate
+        // .symbols file, whose header has SymbolFileUUID as its UUID.
+
+        [[nodiscard]] inline auto hasSymbolFile() const noexcept {
+            for (const auto Byte : SymbolFileUUID) {
+                if (Byte != 0) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
         [[nodiscard]] inline auto getSubCacheArrayRange() const noexcept
             -> std::optional<Range>
         {
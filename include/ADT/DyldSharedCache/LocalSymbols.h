@@ -0,0 +1,185 @@
+//
+//  ADT/DyldSharedCache/LocalSymbols.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+#include "ADT/Mach-O/LoadCommands.h"
+#include "ADT/MemoryMap.h"
+#include "Headers.h"
+
+namespace DyldSharedCache {
+    struct LocalSymbolsInfo {
+        uint32_t NlistOffset;
+        uint32_t NlistCount;
+        uint32_t StringsOffset;
+        uint32_t StringsSize;
+        uint32_t EntriesOffset;
+        uint32_t EntriesCount;
+    };
+
+    // Entries of caches before dyld v940, where DylibOffset is the file-offset
+    // of the image's mach-header. These caches have their first mapping at
+    // file-offset zero, so the file-offset is also the offset from the cache's
+    // base-address.
+
+    struct LocalSymbolsEntry {
+        uint32_t DylibOffset;
+        uint32_t NlistStartIndex;
+        uint32_t NlistCount;
+    };
+
+    // Entries of caches since dyld v940, where DylibOffset is the offset of
+    // the image's mach-header from the cache's base-address.
+
+    struct LocalSymbolsEntry64 {
+        uint64_t DylibOffset;
+        uint32_t NlistStartIndex;
+        uint32_t NlistCount;
+    };
+
+    // The local-symbols of every image of a cache are stripped from the
+    // image's symbol-table, and stored in a single nlist-list and
+    // string-table, with an entry per image naming its slice of the list.
+    //
+    // The entries are indexed once by image, so the local-symbols of any one
+    // image can be found without searching the list.
+
+    struct LocalSymbolsTable {
+    public:
+        enum class Error {
+            None,
+
+            NoLocalSymbols,
+            NeedsSymbolsFile,
+            SymbolsFileMismatch,
+
+            InvalidRange,
+            InvalidNlistRange,
+            InvalidStringRange,
+            InvalidEntryRange,
+            InvalidEntry
+        };
+
+        struct Slice {
+            uint32_t NlistStartIndex;
+            uint32_t NlistCount;
+        };
+    protected:
+        const uint8_t *NlistBegin = nullptr;
+        uint32_t NlistCount = 0;
+
+        std::string_view StringTable;
+        std::unordered_map<uint64_t, Slice> SliceMap;
+
+        bool Is64Bit : 1 = true;
+    public:
+        // Opens the local-symbols of the cache-file in Map, which is either a
+        // cache or its .symbols file.
+        //
+        // Entries whose slice is outside the nlist-list are skipped, with
+        // Error::InvalidEntry returned through ErrorOut.
+
+        [[nodiscard]] static auto
+        Open(const ConstMemoryMap &Map, bool Is64Bit, Error *ErrorOut) noexcept
+            -> std::optional<LocalSymbolsTable>;
+
+        // Opens the local-symbols of the cache in CacheMap, which are read
+        // from SymbolsFileMap if the cache has a separate .symbols file.
+        // SymbolsFileMap may be null if the cache has no .symbols file.
+
+        [[nodiscard]] static auto
+        OpenForCache(const ConstMemoryMap &CacheMap,
+                     const ConstMemoryMap *SymbolsFileMap,
+                     bool Is64Bit,
+                     Error *ErrorOut) noexcept
+            -> std::optional<LocalSymbolsTable>;
+
+        [[nodiscard]] static inline auto
+        IsInSymbolsFile(const HeaderV0 &Header) noexcept {
+            if (!Header.isV8()) {
+                return false;
+            }
+
+            return static_cast<const HeaderV8 &>(Header).hasSymbolFile();
+        }
+
+        [[nodiscard]] inline auto is64Bit() const noexcept {
+            return Is64Bit;
+        }
+
+        [[nodiscard]] inline auto getNlistCount() const noexcept {
+            return NlistCount;
+        }
+
+        [[nodiscard]] inline auto getStringTable() const noexcept {
+            return StringTable;
+        }
+
+        [[nodiscard]] inline auto getImageCount() const noexcept {
+            return SliceMap.size();
+        }
+
+        // Returns the slice of the image whose mach-header is at the provided
+        // offset from the cache's base-address.
+
+        [[nodiscard]]
+        inline auto GetSliceForImage(const uint64_t ImageOffset) const noexcept
+            -> const Slice *
+        {
+            const auto Iter = SliceMap.find(ImageOffset);
+            if (Iter == SliceMap.end()) {
+                return nullptr;
+            }
+
+            return &Iter->second;
+        }
+
+        [[nodiscard]]
+        inline auto GetEntry32List(const Slice &ImageSlice) const noexcept {
+            assert(!Is64Bit);
+
+            const auto Begin =
+                reinterpret_cast<const MachO::SymbolTableEntry32 *>(
+                    NlistBegin) + ImageSlice.NlistStartIndex;
+
+            return std::span(Begin, ImageSlice.NlistCount);
+        }
+
+        [[nodiscard]]
+        inline auto GetEntry64List(const Slice &ImageSlice) const noexcept {
+            assert(Is64Bit);
+
+            const auto Begin =
+                reinterpret_cast<const MachO::SymbolTableEntry64 *>(
+                    NlistBegin) + ImageSlice.NlistStartIndex;
+
+            return std::span(Begin, ImageSlice.NlistCount);
+        }
+
+        // Returns the name at the provided string-table index, or an empty
+        // string if the index is out of bounds.
+
+        [[nodiscard]]
+        inline auto GetString(const uint32_t Index) const noexcept
+            -> std::string_view
+        {
+            if (Index >= StringTable.size()) {
+                return std::string_view();
+            }
+
+            const auto Rest = StringTable.substr(Index);
+            return Rest.substr(0, Rest.find('\0'));
+        }
+    };
+}
@@ -0,0 +1,305 @@
+//
+//  ADT/DyldSharedCache/ObjcOpt.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "ADT/DscImage/DeVirtualizer.h"
+
+namespace DyldSharedCache {
+    // View of one of the perfect hash-tables of strings that dyld builds into
+    // libobjc's __objc_opt_ro section.
+    //
+    // A string is hashed straight to its only possible index, so a lookup
+    // compares at most one string. Each index has a check-byte, and an offset
+    // from the table to its string, with tables of classes and protocols
+    // storing more per-index data after the offsets.
+
+    struct ObjcStringHashTable {
+    public:
+        constexpr static auto NotFound = UINT32_MAX;
+    protected:
+        const uint8_t *Begin = nullptr;
+        uint64_t Address = 0;
+
+        uint32_t Capacity = 0;
+        uint32_t Occupied = 0;
+        uint32_t Shift = 0;
+        uint32_t Mask = 0;
+        uint64_t Salt = 0;
+
+        const uint8_t *ScrambleList = nullptr;
+        const uint8_t *Tab = nullptr;
+        const uint8_t *CheckByteList = nullptr;
+        const uint8_t *OffsetList = nullptr;
+
+        // Max-size of the data after the offset-list.
+        uint64_t ExtraDataMaxSize = 0;
+
+        [[nodiscard]] uint32_t Hash(std::string_view Key) const noexcept;
+    public:
+        // Returns std::nullopt if a table with its header and lists couldn't
+        // fit within MaxSize bytes.
+
+        [[nodiscard]] static auto
+        Open(const uint8_t *Begin, uint64_t Address, uint64_t MaxSize) noexcept
+            -> std::optional<ObjcStringHashTable>;
+
+        [[nodiscard]] inline auto getAddress() const noexcept {
+            return Address;
+        }
+
+        [[nodiscard]] inline auto getCapacity() const noexcept {
+            return Capacity;
+        }
+
+        [[nodiscard]] inline auto getOccupiedCount() const noexcept {
+            return Occupied;
+        }
+
+        [[nodiscard]] inline auto getExtraData() const noexcept {
+            return OffsetList + sizeof(int32_t) * Capacity;
+        }
+
+        [[nodiscard]] inline auto getExtraDataAddress() const noexcept {
+            return Address + static_cast<uint64_t>(getExtraData() - Begin);
+        }
+
+        [[nodiscard]] inline auto getExtraDataMaxSize() const noexcept {
+            return ExtraDataMaxSize;
+        }
+
+        // Returns std::nullopt for an empty index.
+        [[nodiscard]] auto
+        GetStringAddress(uint32_t Index) const noexcept
+            -> std::optional<uint64_t>;
+
+        // Returns NotFound if Key isn't in the table.
+        [[nodiscard]] uint32_t
+        GetIndex(const DscImage::ConstDeVirtualizer &DeVirtualizer,
+                 std::string_view Key) const noexcept;
+    };
+
+    // Reader for the precomputed selector, class and protocol tables of a
+    // dyld_shared_cache, which are found in libobjc's __objc_opt_ro section.
+    //
+    // Every lookup goes through the cache-wide tables, so no image has to be
+    // parsed to find a class or selector.
+
+    struct ObjcOptInfo {
+    public:
+        constexpr static auto ImagePath =
+            std::string_view("/usr/lib/libobjc.A.dylib");
+
+        constexpr static auto SegmentName = std::string_view("__TEXT");
+        constexpr static auto SectionName = std::string_view("__objc_opt_ro");
+
+        constexpr static auto MinVersion = uint32_t(12);
+        constexpr static auto MaxVersion = uint32_t(16);
+
+        enum class Error {
+            None,
+
+            SectionTooSmall,
+            UnsupportedVersion,
+            InvalidTable
+        };
+
+        struct ClassEntry {
+            uint64_t ClassAddress;
+            uint64_t HeaderInfoAddress;
+        };
+    protected:
+        DscImage::ConstDeVirtualizer DeVirtualizer;
+
+        uint64_t Address = 0;
+        uint32_t Version = 0;
+
+        bool Is64Bit : 1 = false;
+
+        // Version 2 of the protocol-table stores entries in the same format
+        // as the class-table.
+
+        bool ProtocolTableHasHeaderInfo : 1 = false;
+
+        std::optional<ObjcStringHashTable> SelectorTable;
+        std::optional<ObjcStringHashTable> ClassTable;
+        std::optional<ObjcStringHashTable> ProtocolTable;
+
+        std::optional<uint64_t> RelativeSelectorBase;
+
+        struct ClassOffset {
+            int32_t ClsOffset;
+            int32_t HiOffset;
+
+            // For a class-name shared by multiple images, ClsOffset is the
+            // count of images shifted left by one, with the low bit set, and
+            // HiOffset is an index into the duplicate-list.
+
+            [[nodiscard]] constexpr auto isDuplicate() const noexcept {
+                return (ClsOffset & 1) != 0;
+            }
+
+            [[nodiscard]] constexpr auto getDuplicateCount() const noexcept {
+                return static_cast<uint32_t>(ClsOffset) >> 1;
+            }
+
+            [[nodiscard]] constexpr auto getDuplicateIndex() const noexcept {
+                return static_cast<uint32_t>(HiOffset);
+            }
+        };
+
+        explicit
+        ObjcOptInfo(const DscImage::ConstDeVirtualizer &DeVirtualizer) noexcept
+        : DeVirtualizer(DeVirtualizer) {}
+
+        [[nodiscard]] auto
+        GetClassOffset(const ObjcStringHashTable &Table,
+                       uint32_t Index) const noexcept
+            -> std::optional<ClassOffset>;
+
+        [[nodiscard]] auto
+        GetDuplicateClassOffset(const ObjcStringHashTable &Table,
+                                uint32_t Index) const noexcept
+            -> std::optional<ClassOffset>;
+
+        template <typename T>
+        bool
+        ForEachClassAtIndex(const ObjcStringHashTable &Table,
+                            const uint32_t Index,
+                            const T &Callback) const noexcept
+        {
+            const auto Offset = GetClassOffset(Table, Index);
+            if (!Offset.has_value()) {
+                return false;
+            }
+
+            const auto TableAddr = Table.getAddress();
+            const auto MakeEntry = [&](const ClassOffset &Info) noexcept {
+                return ClassEntry {
+                    .ClassAddress =
+                        TableAddr + static_cast<uint64_t>(Info.ClsOffset),
+                    .HeaderInfoAddress =
+                        TableAddr + static_cast<uint64_t>(Info.HiOffset)
+                };
+            };
+
+            if (!Offset->isDuplicate()) {
+                Callback(MakeEntry(Offset.value()));
+                return true;
+            }
+
+            const auto Begin = Offset->getDuplicateIndex();
+            const auto End = Begin + Offset->getDuplicateCount();
+
+            for (auto I = Begin; I != End; I++) {
+                const auto Duplicate = GetDuplicateClassOffset(Table, I);
+                if (!Duplicate.has_value() || Duplicate->isDuplicate()) {
+                    return false;
+                }
+
+                Callback(MakeEntry(Duplicate.value()));
+            }
+
+            return true;
+        }
+    public:
+        [[nodiscard]] static auto
+        Open(const DscImage::ConstDeVirtualizer &DeVirtualizer,
+             uint64_t Address,
+             uint64_t Size,
+             bool Is64Bit,
+             Error *ErrorOut) noexcept
+            -> ObjcOptInfo;
+
+        [[nodiscard]] inline auto getVersion() const noexcept {
+            return Version;
+        }
+
+        [[nodiscard]] inline auto is64Bit() const noexcept {
+            return Is64Bit;
+        }
+
+        [[nodiscard]] inline auto &getSelectorTable() const noexcept {
+            return SelectorTable;
+        }
+
+        [[nodiscard]] inline auto &getClassTable() const noexcept {
+            return ClassTable;
+        }
+
+        [[nodiscard]] inline auto &getProtocolTable() const noexcept {
+            return ProtocolTable;
+        }
+
+        // Selectors of relative method-lists are offsets from this address.
+        [[nodiscard]] inline auto getRelativeSelectorBase() const noexcept {
+            return RelativeSelectorBase;
+        }
+
+        [[nodiscard]] auto FindSelector(std::string_view Name) const noexcept
+            -> std::optional<uint64_t>;
+
+        [[nodiscard]] auto FindProtocol(std::string_view Name) const noexcept
+            -> std::optional<uint64_t>;
+
+        // A class-name may be defined by more than one image, so every class
+        // with Name is returned.
+
+        [[nodiscard]] auto FindClass(std::string_view Name) const noexcept
+            -> std::vector<ClassEntry>;
+
+        // Returns the address of the mach-header of the image a header-info
+        // belongs to. Header-infos of versions before 14 aren't supported.
+
+        [[nodiscard]] auto
+        GetImageAddressForHeaderInfo(uint64_t HeaderInfoAddress) const noexcept
+            -> std::optional<uint64_t>;
+
+        // Calls Callback(Name, ClassEntry) for every class in the class-table,
+        // in table order.
+
+        template <typename T>
+        auto ForEachClass(const T &Callback) const noexcept
+            -> decltype(*this)
+        {
+            if (!ClassTable.has_value()) {
+                return *this;
+            }
+
+            const auto &Table = ClassTable.value();
+            for (auto I = uint32_t(); I != Table.getCapacity(); I++) {
+                const auto NameAddr = Table.GetStringAddress(I);
+                if (!NameAddr.has_value()) {
+                    continue;
+                }
+
+                const auto Name =
+                    DeVirtualizer.GetStringAtAddress(NameAddr.value());
+
+                if (!Name.has_value()) {
+                    continue;
+                }
+
+                ForEachClassAtIndex(Table,
+                                    I,
+                                    [&](const ClassEntry &Entry) noexcept
+                {
+                    Callback(Name.value(), Entry);
+                });
+            }
+
+            return *this;
+        }
+    };
+}
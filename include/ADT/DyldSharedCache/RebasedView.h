@@ -0,0 +1,107 @@
+//
+//  ADT/DyldSharedCache/RebasedView.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "ADT/MemoryMap.h"
+#include "SlideInfo.h"
+
+namespace DyldSharedCache {
+    // A view of the mappings of a cache with every pointer rebased, where a
+    // page is only decoded the first time it's read.
+    //
+    // Only the most recently read pages are kept, so memory stays bounded by
+    // the page-capacity, however large the cache is.
+    //
+    // Pages are spread over shards that each have their own lock, so threads
+    // reading different pages rarely wait on each other.
+
+    struct RebasedView {
+    public:
+        constexpr static auto DefaultPageCapacity = uint32_t(256);
+        constexpr static auto ShardCount = uint32_t(16);
+    protected:
+        struct Page {
+            uint64_t Address;
+            std::vector<uint8_t> Data;
+        };
+
+        // Pages are ordered from most to least recently read, with PageMap
+        // indexing PageList by the address of each page.
+
+        struct Shard {
+            std::mutex Lock;
+            std::list<Page> PageList;
+            std::unordered_map<uint64_t, std::list<Page>::iterator> PageMap;
+        };
+
+        const uint8_t *Map;
+        std::vector<SlideInfo> SlideInfoList;
+        SlidePointerFormat PointerFormat;
+
+        uint32_t PageCapacity;
+        uint32_t ShardPageCapacity;
+
+        mutable std::array<Shard, ShardCount> ShardList;
+
+        [[nodiscard]]
+        auto GetSlideInfoForAddress(uint64_t Address) const noexcept
+            -> const SlideInfo *;
+
+        // Must be called with the shard's lock held.
+
+        [[nodiscard]] auto
+        GetPage(Shard &Shard,
+                const SlideInfo &Info,
+                uint32_t Index) const noexcept
+            -> const Page &;
+    public:
+        explicit
+        RebasedView(const ConstMemoryMap &Map,
+                    uint32_t PageCapacity = DefaultPageCapacity) noexcept;
+
+        [[nodiscard]] inline auto &getSlideInfoList() const noexcept {
+            return SlideInfoList;
+        }
+
+        // Returns the format of the first mapping with slide-info, or a format
+        // of version None if the cache has no slide-info.
+
+        [[nodiscard]] inline auto &getPointerFormat() const noexcept {
+            return PointerFormat;
+        }
+
+        [[nodiscard]] inline auto getPageCapacity() const noexcept {
+            return PageCapacity;
+        }
+
+        [[nodiscard]] inline auto empty() const noexcept {
+            return SlideInfoList.empty();
+        }
+
+        // Copies Size bytes at the provided address, with every pointer in the
+        // range rebased. Returns false if any part of the range is outside the
+        // mappings with slide-info.
+
+        [[nodiscard]] auto
+        ReadData(uint64_t Address, uint64_t Size, void *Out) const noexcept
+            -> bool;
+
+        [[nodiscard]] auto
+        ReadPointer(uint64_t Address, bool Is64Bit) const noexcept
+            -> std::optional<uint64_t>;
+    };
+}
@@ -0,0 +1,303 @@
+//
+//  ADT/DyldSharedCache/SlideInfo.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "ADT/MemoryMap.h"
+#include "Headers.h"
+
+namespace DyldSharedCache {
+    enum class SlideInfoVersion : uint32_t {
+        None,
+        V1,
+        V2,
+        V3,
+        V4,
+        V5
+    };
+
+    // Every page of a mapping has a bit for each 32-bit word that holds a
+    // pointer, with pages sharing identical bitmaps.
+
+    struct SlideInfoV1 {
+        uint32_t Version;
+        uint32_t TocOffset;
+        uint32_t TocCount;
+        uint32_t EntriesOffset;
+        uint32_t EntriesCount;
+        uint32_t EntriesSize;
+    };
+
+    // Pointers of every page are chained together, with the delta to the next
+    // pointer stored in the bits of DeltaMask. V2 is used for 64-bit caches,
+    // and V4 for 32-bit caches.
+
+    struct SlideInfoV2 {
+        constexpr static auto PageAttrExtra = uint16_t(0x8000);
+        constexpr static auto PageAttrNoRebase = uint16_t(0x4000);
+        constexpr static auto PageAttrEnd = uint16_t(0x8000);
+        constexpr static auto PageValueMask = uint16_t(0x3fff);
+
+        uint32_t Version;
+        uint32_t PageSize;
+        uint32_t PageStartsOffset;
+        uint32_t PageStartsCount;
+        uint32_t PageExtrasOffset;
+        uint32_t PageExtrasCount;
+        uint64_t DeltaMask;
+        uint64_t ValueAdd;
+    };
+
+    // Pointers are chained with an 11-bit stride of 8 bytes, and may be
+    // authenticated pointers of arm64e.
+
+    struct SlideInfoV3 {
+        constexpr static auto PageAttrNoRebase = uint16_t(0xffff);
+
+        uint32_t Version;
+        uint32_t PageSize;
+        uint32_t PageStartsCount;
+        uint32_t Pad;
+        uint64_t AuthValueAdd;
+    };
+
+    struct SlideInfoV4 {
+        constexpr static auto PageAttrNoRebase = uint16_t(0xffff);
+        constexpr static auto PageAttrExtra = uint16_t(0x8000);
+        constexpr static auto PageAttrEnd = uint16_t(0x8000);
+        constexpr static auto PageValueMask = uint16_t(0x7fff);
+
+        uint32_t Version;
+        uint32_t PageSize;
+        uint32_t PageStartsOffset;
+        uint32_t PageStartsCount;
+        uint32_t PageExtrasOffset;
+        uint32_t PageExtrasCount;
+        uint64_t DeltaMask;
+        uint64_t ValueAdd;
+    };
+
+    // As with V3, but with every pointer stored as an offset from the cache's
+    // base-address.
+
+    struct SlideInfoV5 {
+        constexpr static auto PageAttrNoRebase = uint16_t(0xffff);
+
+        uint32_t Version;
+        uint32_t PageSize;
+        uint32_t PageStartsCount;
+        uint32_t Pad;
+        uint64_t ValueAdd;
+    };
+
+    // A pointer in a mapping with slide-info, decoded to the address it points
+    // to before the cache is slid.
+
+    struct SlidPointer {
+        uint64_t Target = 0;
+
+        // Only valid for authenticated pointers.
+
+        uint16_t Diversity = 0;
+        uint8_t Key = 0;
+
+        bool IsAuthenticated : 1 = false;
+        bool HasAddressDiversity : 1 = false;
+    };
+
+    // Decodes pointers stored in the mappings of a cache. No version stores
+    // the location of a pointer within the pointer itself, so any pointer
+    // read from a mapping can be decoded, whether or not it was found
+    // through a chain.
+
+    struct SlidePointerFormat {
+    public:
+        SlideInfoVersion Version = SlideInfoVersion::None;
+
+        uint64_t DeltaMask = 0;
+        uint64_t ValueAdd = 0;
+
+        // Returns the format of the first mapping with slide-info, or a format
+        // of version None if the cache has no slide-info.
+
+        [[nodiscard]]
+        static auto Open(const ConstMemoryMap &Map) noexcept
+            -> SlidePointerFormat;
+
+        [[nodiscard]] inline auto isEmpty() const noexcept {
+            return Version == SlideInfoVersion::None;
+        }
+
+        [[nodiscard]] constexpr auto getPointerSize() const noexcept {
+            switch (Version) {
+                case SlideInfoVersion::V1:
+                case SlideInfoVersion::V4:
+                    return uint32_t(sizeof(uint32_t));
+                case SlideInfoVersion::None:
+                case SlideInfoVersion::V2:
+                case SlideInfoVersion::V3:
+                case SlideInfoVersion::V5:
+                    return uint32_t(sizeof(uint64_t));
+            }
+
+            return uint32_t(sizeof(uint64_t));
+        }
+
+        [[nodiscard]]
+        auto DecodePointer(uint64_t Value) const noexcept -> SlidPointer;
+
+        // Returns the byte-offset to the next pointer of the chain Value is
+        // in, or zero if Value is the last pointer of its chain.
+
+        [[nodiscard]]
+        auto GetChainDelta(uint64_t Value) const noexcept -> uint64_t;
+
+        [[nodiscard]]
+        inline auto UnslidePointer(const uint64_t Value) const noexcept {
+            return DecodePointer(Value).Target;
+        }
+    };
+
+    // Slide-info of a single mapping, which lists every pointer of the mapping
+    // that is rebased when the cache is slid.
+
+    struct SlideInfo {
+    public:
+        enum class Error {
+            None,
+
+            InvalidRange,
+            UnknownVersion,
+            InvalidPageSize,
+            InvalidPageStarts,
+            InvalidPageExtras,
+            InvalidChain
+        };
+
+        struct Rebase {
+            uint64_t Address;
+            SlidPointer Pointer;
+        };
+    protected:
+        const uint8_t *Map = nullptr;
+        const uint8_t *Begin = nullptr;
+
+        uint64_t Size = 0;
+        uint32_t MappingIndex = 0;
+
+        uint64_t MappingAddress = 0;
+        uint64_t MappingSize = 0;
+        uint64_t MappingFileOffset = 0;
+
+        SlidePointerFormat Format;
+
+        uint32_t PageSize = 0;
+        uint32_t PageCount = 0;
+
+        [[nodiscard]] auto
+        DecodeChain(uint64_t PageOffset,
+                    uint64_t ChainOffset,
+                    std::vector<Rebase> &ListOut) const noexcept -> Error;
+
+        [[nodiscard]]
+        auto DecodePageV1(uint32_t Index,
+                          std::vector<Rebase> &ListOut) const noexcept
+            -> Error;
+
+        [[nodiscard]]
+        auto DecodePageV2(uint32_t Index,
+                          std::vector<Rebase> &ListOut) const noexcept
+            -> Error;
+
+        [[nodiscard]]
+        auto DecodePageV3(uint32_t Index,
+                          std::vector<Rebase> &ListOut) const noexcept
+            -> Error;
+    public:
+        // Opens the slide-info at the provided file-range, for the mapping at
+        // the provided address and file-offset.
+
+        [[nodiscard]] static auto
+        Open(const ConstMemoryMap &Map,
+             uint32_t MappingIndex,
+             uint64_t MappingAddress,
+             uint64_t MappingSize,
+             uint64_t MappingFileOffset,
+             const Range &SlideInfoRange,
+             Error *ErrorOut) noexcept
+                -> std::optional<SlideInfo>;
+
+        // Returns the slide-info of every mapping of the cache that has one,
+        // up to the first slide-info that couldn't be opened.
+
+        [[nodiscard]] static auto
+        OpenAll(const ConstMemoryMap &Map, Error *ErrorOut) noexcept
+            -> std::vector<SlideInfo>;
+
+        [[nodiscard]] inline auto getVersion() const noexcept {
+            return Format.Version;
+        }
+
+        [[nodiscard]] inline auto &getPointerFormat() const noexcept {
+            return Format;
+        }
+
+        [[nodiscard]] inline auto getMappingIndex() const noexcept {
+            return MappingIndex;
+        }
+
+        [[nodiscard]] inline auto getMappingAddress() const noexcept {
+            return MappingAddress;
+        }
+
+        [[nodiscard]] inline auto getMappingSize() const noexcept {
+            return MappingSize;
+        }
+
+        [[nodiscard]] inline auto getMappingFileOffset() const noexcept {
+            return MappingFileOffset;
+        }
+
+        [[nodiscard]] inline auto getFileOffset() const noexcept {
+            return static_cast<uint64_t>(Begin - Map);
+        }
+
+        [[nodiscard]] inline auto getSize() const noexcept {
+            return Size;
+        }
+
+        [[nodiscard]] inline auto getPageSize() const noexcept {
+            return PageSize;
+        }
+
+        [[nodiscard]] inline auto getPageCount() const noexcept {
+            return PageCount;
+        }
+
+        // Appends every rebased pointer of the page at the provided index, in
+        // the order of the page's chains.
+
+        [[nodiscard]]
+        auto DecodePage(uint32_t Index,
+                        std::vector<Rebase> &ListOut) const noexcept
+            -> Error;
+
+        // Decodes every page of the mapping, with pages split across threads,
+        // and returns the rebased pointers in page-order.
+        //
+        // Pages after a page that couldn't be decoded are still decoded, with
+        // the first error found returned through ErrorOut.
+
+        [[nodiscard]] auto
+        GetRebaseList(Error *ErrorOut) const noexcept -> std::vector<Rebase>;
+    };
+}
@@ -0,0 +1,135 @@
+//
+//  ADT/DyldSharedCache/SymbolResolver.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "ADT/StringHashMap.h"
+#include "ExportIndex.h"
+
+namespace DyldSharedCache {
+    // Resolves symbols bound by an image of a dyld_shared_cache to the image
+    // exporting them, following re-exports across images.
+    //
+    // Images are identified by their index in the cache, and are only loaded,
+    // through the provided loader, the first time a symbol is looked up in
+    // them, so every export-trie is decoded at most once. Each image also
+    // keeps every resolution made through it.
+    //
+    // The resolver can be used from multiple threads at once. Symbol-names
+    // are kept by the resolver, and so have to outlive it.
+
+    struct SymbolResolver {
+    public:
+        constexpr static auto InvalidNode = UINT32_MAX;
+        constexpr static auto MaxReexportDepth = uint32_t(64);
+
+        struct ImageData {
+            uint64_t Address = 0;
+
+            // Image of each library, at its dylib-ordinal minus one, with
+            // InvalidNode for libraries outside the cache.
+
+            std::vector<uint32_t> LibraryList;
+
+            // Images of every re-exported library, whose exports are also
+            // exported by this image.
+
+            std::vector<uint32_t> ReexportList;
+            ExportIndex Exports;
+        };
+
+        // Fills in the data of the image at the provided index, returning
+        // false if the image couldn't be parsed.
+
+        using LoaderFunc = std::function<bool(uint32_t Node, ImageData &Out)>;
+
+        enum class StatusKind {
+            Resolved,
+
+            SymbolNotFound,
+            LibraryNotInCache,
+            InvalidDylibOrdinal,
+            InMainExecutable,
+            ImageNotParsed,
+            ReexportTooDeep
+        };
+
+        struct Resolution {
+            StatusKind Status = StatusKind::SymbolNotFound;
+            ExportIndex::ExportKind Kind = ExportIndex::ExportKind::None;
+
+            // Image exporting the symbol, which may be different from the
+            // image the symbol was looked up in if it was re-exported.
+
+            uint32_t Node = InvalidNode;
+            uint64_t Address = 0;
+
+            [[nodiscard]] constexpr auto isResolved() const noexcept {
+                return Status == StatusKind::Resolved;
+            }
+        };
+    protected:
+        struct ImageState {
+            std::once_flag LoadFlag;
+            bool IsLoaded = false;
+
+            ImageData Data;
+
+            std::mutex CacheLock;
+            StringHashMap<Resolution> Cache;
+        };
+
+        LoaderFunc Loader;
+
+        uint32_t NodeCount;
+        std::unique_ptr<ImageState[]> StateList;
+
+        [[nodiscard]] auto GetImageData(uint32_t Node) noexcept
+            -> const ImageData *;
+
+        [[nodiscard]] auto
+        FindInImage(uint32_t Node,
+                    std::string_view Name,
+                    uint32_t Depth) noexcept
+            -> Resolution;
+    public:
+        explicit SymbolResolver(uint32_t NodeCount, LoaderFunc Loader) noexcept;
+
+        [[nodiscard]] inline auto getNodeCount() const noexcept {
+            return NodeCount;
+        }
+
+        // Resolves a symbol bound by the image at Node with the provided
+        // dylib-ordinal, which may also be one of the special ordinals.
+        // Flat and weak lookups search the image and then every image it
+        // depends on.
+
+        [[nodiscard]] auto
+        Resolve(uint32_t Node,
+                int64_t DylibOrdinal,
+                std::string_view Name) noexcept
+            -> Resolution;
+
+        // Resolves a symbol exported by the image at Node, or by one of the
+        // libraries it re-exports.
+
+        [[nodiscard]] inline auto
+        ResolveInImage(const uint32_t Node,
+                       const std::string_view Name) noexcept
+        {
+            return FindInImage(Node, Name, 0);
+        }
+    };
+}
@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <fcntl.h>
 #include <optional>
+#include <sys/uio.h>
 
 #include "ADT/BasicMasksHandler.h"
 
@@ -65,6 +66,13 @@ public:
 
     bool Read(void *Buf, size_t Size) const noexcept;
     bool Write(const void *Buf, size_t Size) noexcept;
+
+    // Writes at the provided offset, without moving the file's position.
+    // Partial writes are retried until everything is written.
+
+    bool WriteAt(const void *Buf, size_t Size, uint64_t Offset) noexcept;
+    bool WriteVectorAt(iovec *List, int Count, uint64_t Offset) noexcept;
+
     bool TruncateToSize(uint64_t Length) noexcept;
 
     [[nodiscard]] auto GetInfo() const noexcept -> std::optional<struct stat>;
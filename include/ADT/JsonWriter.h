@@ -0,0 +1,72 @@
+//
+//  ADT/JsonWriter.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+// Streaming writer for a flat list of JSON records. Every record is written
+// out as soon as it is finished, so callers never have to hold the entire list
+// in memory.
+//
+// With Style::Array, the records are written as one top-level JSON array.
+// With Style::LineDelimited (NDJSON), each record is written on its own line
+// with no enclosing array.
+
+struct JsonWriter {
+public:
+    enum class Style : uint8_t {
+        Array,
+        LineDelimited
+    };
+protected:
+    FILE *OutFile;
+    uint64_t RecordCount = 0;
+
+    enum Style Style;
+
+    bool InRecord : 1 = false;
+    bool WroteField : 1 = false;
+
+    void writeKey(std::string_view Key) noexcept;
+public:
+    explicit JsonWriter(FILE *OutFile, enum Style Style) noexcept;
+
+    [[nodiscard]] constexpr auto getStyle() const noexcept {
+        return this->Style;
+    }
+
+    [[nodiscard]] constexpr auto getRecordCount() const noexcept {
+        return this->RecordCount;
+    }
+
+    auto beginList() noexcept -> decltype(*this);
+    auto endList() noexcept -> decltype(*this);
+
+    auto beginRecord() noexcept -> decltype(*this);
+    auto endRecord() noexcept -> decltype(*this);
+
+    auto writeString(std::string_view Key, std::string_view Value) noexcept
+        -> decltype(*this);
+
+    auto writeNumber(std::string_view Key, uint64_t Value) noexcept
+        -> decltype(*this);
+
+    auto writeSignedNumber(std::string_view Key, int64_t Value) noexcept
+        -> decltype(*this);
+
+    auto writeBool(std::string_view Key, bool Value) noexcept
+        -> decltype(*this);
+
+    auto writeNull(std::string_view Key) noexcept -> decltype(*this);
+
+    static void
+    WriteEscapedString(FILE *OutFile, std::string_view String) noexcept;
+};
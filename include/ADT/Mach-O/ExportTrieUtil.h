@@ -19,65 +19,17 @@
 
 namespace MachO {
     struct ExportTrieEntryCollection;
-    struct ExportTrieExportChildNode;
-    struct ExportTrieChildNode : public TreeNode {
+    struct ExportTrieChildNode {
         friend ExportTrieEntryCollection;
     protected:
         ExportTrieExportKind Kind;
         std::string String;
-    public:
-        ~ExportTrieChildNode() noexcept = default;
-        using TreeNode::TreeNode;
-
-        [[nodiscard]]
-        inline TreeNode *createNew() const noexcept override {
-            return new ExportTrieChildNode;
-        }
-
-        [[nodiscard]]
-        static inline auto &get(TreeNode &Node) noexcept {
-            return reinterpret_cast<ExportTrieChildNode &>(Node);
-        }
-
-        [[nodiscard]]
-        static inline auto &get(const TreeNode &Node) noexcept {
-            return reinterpret_cast<const ExportTrieChildNode &>(Node);
-        }
-
-        [[nodiscard]] static inline
-        const ExportTrieChildNode *get(const TreeNode *Node) noexcept {
-            return reinterpret_cast<const ExportTrieChildNode *>(Node);
-        }
-
-        [[nodiscard]] static inline auto get(TreeNode *Node) noexcept {
-            return reinterpret_cast<ExportTrieChildNode *>(Node);
-        }
-
-        [[nodiscard]] inline auto getParent() const noexcept {
-            return this->get(this->Parent);
-        }
-
-        [[nodiscard]] inline auto getPrevSibling() const noexcept {
-            return this->get(this->PrevSibling);
-        }
-
-        [[nodiscard]] inline auto getNextSibling() const noexcept {
-            return this->get(this->NextSibling);
-        }
-
-        [[nodiscard]]
-        inline auto getFirstChild() const noexcept {
-            return this->get(this->FirstChild);
-        }
-
-        [[nodiscard]] inline auto getLastChild() const noexcept {
-            return this->get(this->LastChild);
-        }
 
-        [[nodiscard]] inline uint64_t GetLength() const noexcept override {
-            return this->String.length();
-        }
+        ExportTrieExportInfo Info;
 
+        const SegmentInfo *Segment = nullptr;
+        const SectionInfo *Section = nullptr;
+    public:
         [[nodiscard]] constexpr auto getKind() const noexcept {
             return Kind;
         }
@@ -95,53 +47,27 @@ namespace MachO {
         }
 
         [[nodiscard]] inline auto getIfExportNode() noexcept
-            -> ExportTrieExportChildNode *
+            -> ExportTrieChildNode *
         {
             if (this->isExport()) {
-                return reinterpret_cast<ExportTrieExportChildNode *>(this);
+                return this;
             }
 
             return nullptr;
         }
 
         [[nodiscard]] inline auto getIfExportNode() const noexcept
-            -> const ExportTrieExportChildNode *
+            -> const ExportTrieChildNode *
         {
             if (!this->isExport()) {
                 return nullptr;
             }
 
-            return reinterpret_cast<const ExportTrieExportChildNode *>(this);
+            return this;
         }
 
-        [[nodiscard]] inline auto getAsExportNode() noexcept {
-            assert(this->isExport());
-            return reinterpret_cast<ExportTrieExportChildNode *>(this);
-        }
-
-        [[nodiscard]] inline auto getAsExportNode() const noexcept {
-            assert(this->isExport());
-            return reinterpret_cast<const ExportTrieExportChildNode *>(this);
-        }
-
-        constexpr auto setParent(ExportTrieChildNode *Parent) noexcept
-            -> decltype(*this)
-        {
-            this->Parent = Parent;
-            return *this;
-        }
-    };
-
-    struct ExportTrieExportChildNode : public ExportTrieChildNode {
-    protected:
-        ExportTrieExportInfo Info;
-
-        const SegmentInfo *Segment = nullptr;
-        const SectionInfo *Section = nullptr;
-    public:
-        using ExportTrieChildNode::ExportTrieChildNode;
-
         [[nodiscard]] constexpr auto &getInfo() const noexcept {
+            assert(this->isExport());
             return this->Info;
         }
 
@@ -152,18 +78,13 @@ namespace MachO {
             return *this;
         }
 
-        [[nodiscard]]
-        inline TreeNode *createNew() const noexcept override {
-            return new ExportTrieExportChildNode;
-        }
-
         [[nodiscard]] inline auto getSegment() const noexcept {
-            assert(!this->isReexport());
+            assert(this->isExport() && !this->isReexport());
             return this->Segment;
         }
 
         [[nodiscard]] inline auto getSection() const noexcept {
-            assert(!this->isReexport());
+            assert(this->isExport() && !this->isReexport());
             return this->Section;
         }
 
@@ -186,10 +107,11 @@ namespace MachO {
         }
     };
 
-    struct ExportTrieEntryCollection : public Tree {
+    struct ExportTrieEntryCollection :
+        public IndexedTree<ExportTrieChildNode>
+    {
     public:
         using ChildNode = ExportTrieChildNode;
-        using ExportChildNode = ExportTrieExportChildNode;
         using Error = ExportTrieParseError;
     protected:
         explicit ExportTrieEntryCollection() noexcept = default;
@@ -199,7 +121,7 @@ namespace MachO {
                              uint64_t Address,
                              const SectionInfo **SectionOut) const noexcept;
 
-        [[nodiscard]] ChildNode *
+        [[nodiscard]] ChildNode
         MakeNodeForEntryInfo(const ExportTrieIterateInfo &Info,
                              const SegmentInfoCollection *Collection) noexcept;
 
@@ -208,57 +130,15 @@ namespace MachO {
                       const SegmentInfoCollection *SegmentCollection,
                       Error *Error) noexcept;
     public:
+        virtual ~ExportTrieEntryCollection() noexcept = default;
+
+        ExportTrieEntryCollection(ExportTrieEntryCollection &&) noexcept =
+            default;
+
         static ExportTrieEntryCollection
         Open(const ConstExportTrieList &Trie,
              const SegmentInfoCollection *SegmentCollection,
              Error *ErrorOut = nullptr);
-
-        [[nodiscard]] inline auto getRoot() const noexcept {
-            return reinterpret_cast<ChildNode *>(this->Root);
-        }
-
-        inline auto
-        RemoveNode(ChildNode &Ref, const bool RemoveParentLeafs) noexcept {
-            auto &Node = reinterpret_cast<TreeNode &>(Ref);
-            const auto Result = Tree::RemoveNode(Node, RemoveParentLeafs);
-
-            return reinterpret_cast<ChildNode *>(Result);
-        }
-
-        using Iterator = TreeIterator<ChildNode>;
-        using ConstIterator = TreeIterator<const ChildNode>;
-
-        [[nodiscard]] inline auto begin() const noexcept {
-            return Iterator(this->getRoot());
-        }
-
-        [[nodiscard]] inline auto end() const noexcept {
-            return Iterator::Null();
-        }
-
-        [[nodiscard]] inline auto cbegin() const noexcept {
-            return ConstIterator(this->getRoot());
-        }
-
-        [[nodiscard]] inline auto cend() const noexcept {
-            return ConstIterator::Null();
-        }
-
-        template <typename T>
-        inline auto forEach(const T &Callback) noexcept
-            -> decltype(*this)
-        {
-            this->forEachNode(Callback);
-            return *this;
-        }
-
-        template <typename T>
-        inline auto forEach(const T &Callback) const noexcept
-            -> decltype(*this)
-        {
-            this->forEachNode(Callback);
-            return *this;
-        }
     };
 
     struct ExportTrieExportCollectionEntryInfo {
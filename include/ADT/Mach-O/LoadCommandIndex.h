@@ -0,0 +1,118 @@
+//
+//  ADT/Mach-O/LoadCommandIndex.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <array>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "LoadCommands.h"
+
+namespace MachO {
+    struct ConstLoadCommandStorage;
+
+    // Groups the load-commands of an image by their kind, so that the
+    // commands of any one kind can be found without scanning the entire
+    // load-command list.
+    //
+    // Commands of each kind are kept in the order they appear in, and commands
+    // of an unrecognized kind are not indexed.
+
+    struct LoadCommandIndex {
+    protected:
+        struct KindEntry {
+            uint32_t Begin = 0;
+            uint32_t Count = 0;
+        };
+
+        // Kinds are at most 0x3f, with the required-by-dyld bit moved right
+        // above that.
+
+        constexpr static auto KindSlotCount = 128;
+
+        std::array<KindEntry, KindSlotCount> KindTable = {};
+        std::vector<const LoadCommand *> List;
+
+        bool IsBigEndian : 1 = false;
+
+        [[nodiscard]] constexpr static auto
+        GetSlotForKind(const LoadCommand::Kind Kind) noexcept -> int {
+            const auto Value = static_cast<uint32_t>(Kind);
+            const auto Index = Value & ~KindRequiredByDyld;
+
+            if (Index >= (KindSlotCount / 2)) {
+                return -1;
+            }
+
+            if (Value & KindRequiredByDyld) {
+                return static_cast<int>(Index) + (KindSlotCount / 2);
+            }
+
+            return static_cast<int>(Index);
+        }
+    public:
+        LoadCommandIndex() noexcept = default;
+
+        // Returns an empty index if LoadCmdStorage has an error.
+
+        [[nodiscard]] static auto
+        Build(const ConstLoadCommandStorage &LoadCmdStorage) noexcept
+            -> LoadCommandIndex;
+
+        [[nodiscard]] auto getAll(LoadCommand::Kind Kind) const noexcept
+            -> std::span<const LoadCommand *const>;
+
+        [[nodiscard]] inline auto
+        getFirst(const LoadCommand::Kind Kind) const noexcept
+            -> const LoadCommand *
+        {
+            const auto List = this->getAll(Kind);
+            return !List.empty() ? List.front() : nullptr;
+        }
+
+        [[nodiscard]] inline auto
+        count(const LoadCommand::Kind Kind) const noexcept {
+            return this->getAll(Kind).size();
+        }
+
+        [[nodiscard]] inline auto
+        contains(const LoadCommand::Kind Kind) const noexcept {
+            return this->count(Kind) != 0;
+        }
+
+        template <LoadCommand::Kind Kind>
+        [[nodiscard]] inline auto getAllAs() const noexcept {
+            using PtrType = LoadCommandConstPtrTypeFromKind<Kind>;
+            return std::views::transform(
+                this->getAll(Kind),
+                [](const LoadCommand *const LC) noexcept {
+                    return reinterpret_cast<PtrType>(LC);
+                });
+        }
+
+        template <LoadCommand::Kind Kind>
+        [[nodiscard]] inline auto getFirstAs() const noexcept {
+            using PtrType = LoadCommandConstPtrTypeFromKind<Kind>;
+            return reinterpret_cast<PtrType>(this->getFirst(Kind));
+        }
+
+        [[nodiscard]] inline auto size() const noexcept {
+            return this->List.size();
+        }
+
+        [[nodiscard]] inline auto empty() const noexcept {
+            return this->List.empty();
+        }
+
+        [[nodiscard]] inline auto isBigEndian() const noexcept {
+            return this->IsBigEndian;
+        }
+    };
+}
@@ -13,6 +13,7 @@
 
 #include "ADT/BasicWrapperIterator.h"
 #include "ADT/ExpectedPointer.h"
+#include "Utils/SwitchEndian.h"
 
 #include "LoadCommands.h"
 #include "LoadCommandTemplates.h"
@@ -190,6 +191,26 @@ namespace MachO {
             assert(!this->hasError());
             return sIsBigEndian;
         }
+
+        // Calls Callback with each load-command and the storage's endianness
+        // as a std::bool_constant, so that the loop, unlike the iterators,
+        // doesn't check the endianness of every load-command it reads.
+
+        template <typename T>
+        inline void forEach(const T &Callback) const noexcept {
+            const auto Walk = [&](const auto BigEndian) noexcept {
+                const auto End = this->getEnd();
+                for (auto Iter = this->getBegin(); Iter < End;) {
+                    const auto &LC =
+                        *reinterpret_cast<const LoadCommand *>(Iter);
+
+                    Callback(LC, BigEndian);
+                    Iter += LC.getCmdSize(BigEndian());
+                }
+            };
+
+            DispatchOnEndian(this->isBigEndian(), Walk);
+        }
     };
 
     struct LoadCommandStorage : public ConstLoadCommandStorage {
@@ -8,14 +8,15 @@
 
 #pragma once
 
+#include <cassert>
+#include <string>
 #include <vector>
 
-#include "ADT/Tree.h"
 #include "Objc.h"
 
 namespace MachO {
     struct ObjcClassCategoryInfo;
-    struct ObjcClassInfo : public TreeNode {
+    struct ObjcClassInfo {
     public:
         using CategoryListType = std::vector<ObjcClassCategoryInfo *>;
     protected:
@@ -27,6 +28,8 @@ namespace MachO {
         std::string Name;
         uint64_t DylibOrdinal = 0;
 
+        ObjcClassInfo *Super = nullptr;
+
         bool sIsExternal : 1 = false;
         bool sIsNull : 1 = false;
         bool sIsSwift : 1 = false;
@@ -38,68 +41,14 @@ namespace MachO {
         explicit ObjcClassInfo(const std::string_view Name) noexcept
         : Name(Name) {}
 
-        [[nodiscard]] inline TreeNode *createNew() const noexcept override {
-            return new ObjcClassInfo;
-        }
-
-        [[nodiscard]] static inline auto get(TreeNode &Node) noexcept {
-            return reinterpret_cast<ObjcClassInfo &>(Node);
-        }
-
-        [[nodiscard]]
-        static inline auto get(const TreeNode &Node) noexcept {
-            return reinterpret_cast<const ObjcClassInfo &>(Node);
-        }
-
-        [[nodiscard]] static inline auto get(TreeNode *const Node) noexcept {
-            return reinterpret_cast<ObjcClassInfo *>(Node);
-        }
-
-        [[nodiscard]]
-        static inline auto get(const TreeNode *const Node) noexcept {
-            return reinterpret_cast<const ObjcClassInfo *>(Node);
-        }
-
-        [[nodiscard]] inline auto getParent() const noexcept {
-            return this->get(Parent);
-        }
-
-        [[nodiscard]] inline auto getPrevSibling() const noexcept {
-            return this->get(PrevSibling);
-        }
-
-        [[nodiscard]] inline auto getNextSibling() const noexcept {
-            return this->get(NextSibling);
-        }
-
-        [[nodiscard]] inline auto getFirstChild() const noexcept {
-            return this->get(FirstChild);
-        }
-
-        [[nodiscard]] inline auto getLastChild() const noexcept {
-            return this->get(LastChild);
-        }
-
-        [[nodiscard]] inline uint64_t GetLength() const noexcept override {
-            return this->Name.length();
-        }
-
         [[nodiscard]] inline auto getSuper() const noexcept {
-            return reinterpret_cast<ObjcClassInfo *>(Parent);
-        }
-
-        inline auto setSuper(ObjcClassInfo *const Parent) noexcept
-            -> decltype(*this)
-        {
-            this->Parent = reinterpret_cast<TreeNode *>(Parent);
-            return *this;
+            return this->Super;
         }
 
-        inline auto
-        setLastChild(const ObjcClassInfo *const LastChild) noexcept
+        inline auto setSuper(ObjcClassInfo *const Super) noexcept
             -> decltype(*this)
         {
-            this->LastChild = const_cast<ObjcClassInfo *>(LastChild);
+            this->Super = Super;
             return *this;
         }
 
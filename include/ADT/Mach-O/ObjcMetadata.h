@@ -0,0 +1,673 @@
+//
+//  ADT/Mach-O/ObjcMetadata.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "ADT/BasicContiguousList.h"
+#include "ADT/PointerKind.h"
+#include "ADT/StringHashMap.h"
+
+#include "Utils/SwitchEndian.h"
+
+#include "DeVirtualizer.h"
+#include "ObjcParse.h"
+#include "SegmentInfo.h"
+
+namespace MachO {
+    // Slice of one of the tables in an ObjcMetadataCollection.
+    struct ObjcMetadataRange {
+        uint32_t Begin = 0;
+        uint32_t Count = 0;
+
+        [[nodiscard]] constexpr auto empty() const noexcept {
+            return Count == 0;
+        }
+    };
+
+    // Names, types and attributes are all indices into the collection's
+    // string-table.
+
+    struct ObjcMethodInfo {
+        uint32_t Selector;
+        uint32_t Types;
+        uint64_t Imp;
+    };
+
+    struct ObjcIvarInfo {
+        uint32_t Name;
+        uint32_t Type;
+        uint32_t Offset;
+        uint32_t Size;
+    };
+
+    struct ObjcPropertyInfo {
+        uint32_t Name;
+        uint32_t Attributes;
+    };
+
+    struct ObjcClassMetadata {
+        uint64_t Address;
+        uint32_t Name;
+
+        ObjcMetadataRange InstanceMethods;
+        ObjcMetadataRange ClassMethods;
+        ObjcMetadataRange Ivars;
+        ObjcMetadataRange Properties;
+        ObjcMetadataRange Protocols;
+    };
+
+    // Methods, ivars, properties and protocols of every class in an image's
+    // class-list.
+    //
+    // Each kind of metadata is stored in one table shared by every class, with
+    // classes holding slices of each table, and every string interned once in
+    // a single string-table, so that selectors shared by many classes (-init,
+    // -dealloc, ...) are only stored once.
+    //
+    // Strings are views into the mapped file, which has to outlive the
+    // collection.
+
+    struct ObjcMetadataCollection {
+    public:
+        // Set on a method-list's entsize-and-flags field when its methods
+        // store 32-bit offsets instead of pointers.
+
+        constexpr static auto RelativeMethodListFlag = 0x80000000u;
+        constexpr static auto MethodListFlagsMask = 0xffff0003u;
+    protected:
+        std::vector<std::string_view> StringList;
+        StringHashMap<uint32_t> StringMap;
+
+        std::vector<ObjcClassMetadata> ClassList;
+        std::vector<ObjcMethodInfo> MethodList;
+        std::vector<ObjcIvarInfo> IvarList;
+        std::vector<ObjcPropertyInfo> PropertyList;
+        std::vector<uint32_t> ProtocolList;
+
+        // When set, selectors of relative method-lists are offsets from this
+        // address, rather than offsets to a selector-reference, as is the case
+        // for images in a dyld_shared_cache.
+
+        std::optional<uint64_t> RelativeSelectorBase;
+
+        [[nodiscard]] uint32_t InternString(std::string_view String) noexcept;
+
+        template <typename T>
+        [[nodiscard]] static inline
+        T ReadValue(const uint8_t *const Ptr, const bool IsBigEndian) noexcept {
+            auto Value = T();
+            memcpy(&Value, Ptr, sizeof(Value));
+
+            return SwitchEndianIf(Value, IsBigEndian);
+        }
+
+        // Reads a pointer, decoding it if it's stored in the slide-info of a
+        // dyld_shared_cache.
+
+        template <PointerKind Kind, typename S>
+        [[nodiscard]] static inline uint64_t
+        ReadPointer(const S &DeVirtualizeData,
+                    const uint8_t *const Ptr,
+                    const bool IsBigEndian) noexcept
+        {
+            return ObjcParse::ReadPointerAt<Kind>(DeVirtualizeData,
+                                                  Ptr,
+                                                  IsBigEndian);
+        }
+
+        template <typename T>
+        [[nodiscard]] inline uint32_t
+        InternStringAtAddress(const T &DeVirtualizeString,
+                              const uint64_t Address) noexcept
+        {
+            if (Address == 0) {
+                return this->InternString(std::string_view());
+            }
+
+            const auto String = DeVirtualizeString(Address);
+            return this->InternString(String.value_or(std::string_view()));
+        }
+
+        template <PointerKind Kind, typename S, typename T>
+        [[nodiscard]] auto
+        ParseMethodList(const uint64_t Address,
+                        const S &DeVirtualizeData,
+                        const T &DeVirtualizeString,
+                        const bool IsBigEndian) noexcept
+            -> ObjcMetadataRange
+        {
+            using PtrType = PointerAddrTypeFromKind<Kind>;
+
+            const auto Header = DeVirtualizeData(Address, sizeof(uint32_t) * 2);
+            if (Header == nullptr) {
+                return ObjcMetadataRange();
+            }
+
+            const auto EntSizeAndFlags =
+                ReadValue<uint32_t>(Header, IsBigEndian);
+            const auto Count =
+                ReadValue<uint32_t>(Header + sizeof(uint32_t), IsBigEndian);
+
+            const auto IsRelative =
+                (EntSizeAndFlags & RelativeMethodListFlag) != 0;
+            const auto EntSize =
+                static_cast<uint64_t>(EntSizeAndFlags & ~MethodListFlagsMask);
+            const auto MinEntSize =
+                IsRelative ? sizeof(int32_t) * 3 : sizeof(PtrType) * 3;
+
+            if (Count == 0 || EntSize < MinEntSize) {
+                return ObjcMetadataRange();
+            }
+
+            const auto ListAddr = Address + sizeof(uint32_t) * 2;
+            const auto List = DeVirtualizeData(ListAddr, EntSize * Count);
+
+            if (List == nullptr) {
+                return ObjcMetadataRange();
+            }
+
+            const auto Result = ObjcMetadataRange {
+                .Begin = static_cast<uint32_t>(MethodList.size()),
+                .Count = Count
+            };
+
+            for (auto I = uint64_t(); I != Count; I++) {
+                const auto Entry = List + EntSize * I;
+                const auto EntryAddr = ListAddr + EntSize * I;
+
+                auto SelectorAddr = uint64_t();
+                auto TypesAddr = uint64_t();
+                auto Imp = uint64_t();
+
+                if (IsRelative) {
+                    const auto NameOffset =
+                        ReadValue<int32_t>(Entry, IsBigEndian);
+                    const auto TypesOffset =
+                        ReadValue<int32_t>(Entry + 4, IsBigEndian);
+                    const auto ImpOffset =
+                        ReadValue<int32_t>(Entry + 8, IsBigEndian);
+
+                    if (RelativeSelectorBase.has_value()) {
+                        SelectorAddr =
+                            RelativeSelectorBase.value() +
+                            static_cast<uint64_t>(NameOffset);
+                    } else {
+                        const auto SelRef =
+                            DeVirtualizeData(
+                                EntryAddr + static_cast<uint64_t>(NameOffset),
+                                sizeof(PtrType));
+
+                        if (SelRef != nullptr) {
+                            SelectorAddr =
+                                ReadPointer<Kind>(DeVirtualizeData,
+                                                  SelRef,
+                                                  IsBigEndian);
+                        }
+                    }
+
+                    // Types and imp are offsets from their own fields.
+                    TypesAddr =
+                        EntryAddr + 4 + static_cast<uint64_t>(TypesOffset);
+                    Imp = EntryAddr + 8 + static_cast<uint64_t>(ImpOffset);
+                } else {
+                    SelectorAddr =
+                        ReadPointer<Kind>(DeVirtualizeData,
+                                          Entry,
+                                          IsBigEndian);
+                    TypesAddr =
+                        ReadPointer<Kind>(DeVirtualizeData,
+                                          Entry + sizeof(PtrType),
+                                          IsBigEndian);
+                    Imp =
+                        ReadPointer<Kind>(DeVirtualizeData,
+                                          Entry + sizeof(PtrType) * 2,
+                                          IsBigEndian);
+                }
+
+                MethodList.emplace_back(ObjcMethodInfo {
+                    .Selector =
+                        InternStringAtAddress(DeVirtualizeString, SelectorAddr),
+                    .Types =
+                        InternStringAtAddress(DeVirtualizeString, TypesAddr),
+                    .Imp = Imp
+                });
+            }
+
+            return Result;
+        }
+
+        template <PointerKind Kind, typename S, typename T>
+        [[nodiscard]] auto
+        ParseIvarList(const uint64_t Address,
+                      const S &DeVirtualizeData,
+                      const T &DeVirtualizeString,
+                      const bool IsBigEndian) noexcept
+            -> ObjcMetadataRange
+        {
+            using PtrType = PointerAddrTypeFromKind<Kind>;
+
+            const auto Header = DeVirtualizeData(Address, sizeof(uint32_t) * 2);
+            if (Header == nullptr) {
+                return ObjcMetadataRange();
+            }
+
+            const auto EntSize =
+                static_cast<uint64_t>(ReadValue<uint32_t>(Header, IsBigEndian));
+            const auto Count =
+                ReadValue<uint32_t>(Header + sizeof(uint32_t), IsBigEndian);
+
+            // Offset-pointer, name, type, then 32-bit alignment and size.
+            const auto MinEntSize = sizeof(PtrType) * 3 + sizeof(uint32_t) * 2;
+            if (Count == 0 || EntSize < MinEntSize) {
+                return ObjcMetadataRange();
+            }
+
+            const auto ListAddr = Address + sizeof(uint32_t) * 2;
+            const auto List = DeVirtualizeData(ListAddr, EntSize * Count);
+
+            if (List == nullptr) {
+                return ObjcMetadataRange();
+            }
+
+            const auto Result = ObjcMetadataRange {
+                .Begin = static_cast<uint32_t>(IvarList.size()),
+                .Count = Count
+            };
+
+            for (auto I = uint64_t(); I != Count; I++) {
+                const auto Entry = List + EntSize * I;
+
+                const auto OffsetAddr =
+                    ReadPointer<Kind>(DeVirtualizeData, Entry, IsBigEndian);
+                const auto NameAddr =
+                    ReadPointer<Kind>(DeVirtualizeData,
+                                      Entry + sizeof(PtrType),
+                                      IsBigEndian);
+                const auto TypeAddr =
+                    ReadPointer<Kind>(DeVirtualizeData,
+                                      Entry + sizeof(PtrType) * 2,
+                                      IsBigEndian);
+                const auto Size =
+                    ReadValue<uint32_t>(
+                        Entry + sizeof(PtrType) * 3 + sizeof(uint32_t),
+                        IsBigEndian);
+
+                // Only the low 32-bits of an ivar's offset are ever used.
+                auto Offset = uint32_t();
+                if (const auto OffsetPtr =
+                        DeVirtualizeData(OffsetAddr, sizeof(uint32_t)))
+                {
+                    Offset = ReadValue<uint32_t>(OffsetPtr, IsBigEndian);
+                }
+
+                IvarList.emplace_back(ObjcIvarInfo {
+                    .Name = InternStringAtAddress(DeVirtualizeString, NameAddr),
+                    .Type = InternStringAtAddress(DeVirtualizeString, TypeAddr),
+                    .Offset = Offset,
+                    .Size = Size
+                });
+            }
+
+            return Result;
+        }
+
+        template <PointerKind Kind, typename S, typename T>
+        [[nodiscard]] auto
+        ParsePropertyList(const uint64_t Address,
+                          const S &DeVirtualizeData,
+                          const T &DeVirtualizeString,
+                          const bool IsBigEndian) noexcept
+            -> ObjcMetadataRange
+        {
+            using PtrType = PointerAddrTypeFromKind<Kind>;
+
+            const auto Header = DeVirtualizeData(Address, sizeof(uint32_t) * 2);
+            if (Header == nullptr) {
+                return ObjcMetadataRange();
+            }
+
+            const auto EntSize =
+                static_cast<uint64_t>(ReadValue<uint32_t>(Header, IsBigEndian));
+            const auto Count =
+                ReadValue<uint32_t>(Header + sizeof(uint32_t), IsBigEndian);
+
+            if (Count == 0 || EntSize < sizeof(PtrType) * 2) {
+                return ObjcMetadataRange();
+            }
+
+            const auto ListAddr = Address + sizeof(uint32_t) * 2;
+            const auto List = DeVirtualizeData(ListAddr, EntSize * Count);
+
+            if (List == nullptr) {
+                return ObjcMetadataRange();
+            }
+
+            const auto Result = ObjcMetadataRange {
+                .Begin = static_cast<uint32_t>(PropertyList.size()),
+                .Count = Count
+            };
+
+            for (auto I = uint64_t(); I != Count; I++) {
+                const auto Entry = List + EntSize * I;
+                const auto NameAddr =
+                    ReadPointer<Kind>(DeVirtualizeData, Entry, IsBigEndian);
+                const auto AttributesAddr =
+                    ReadPointer<Kind>(DeVirtualizeData,
+                                      Entry + sizeof(PtrType),
+                                      IsBigEndian);
+
+                PropertyList.emplace_back(ObjcPropertyInfo {
+                    .Name = InternStringAtAddress(DeVirtualizeString, NameAddr),
+                    .Attributes =
+                        InternStringAtAddress(DeVirtualizeString,
+                                              AttributesAddr)
+                });
+            }
+
+            return Result;
+        }
+
+        template <PointerKind Kind, typename S, typename T>
+        [[nodiscard]] auto
+        ParseProtocolList(const uint64_t Address,
+                          const S &DeVirtualizeData,
+                          const T &DeVirtualizeString,
+                          const bool IsBigEndian) noexcept
+            -> ObjcMetadataRange
+        {
+            using PtrType = PointerAddrTypeFromKind<Kind>;
+
+            // A protocol-list is a pointer-sized count, followed by pointers
+            // to each protocol.
+
+            const auto Header = DeVirtualizeData(Address, sizeof(PtrType));
+            if (Header == nullptr) {
+                return ObjcMetadataRange();
+            }
+
+            const auto Count =
+                static_cast<uint64_t>(ReadValue<PtrType>(Header, IsBigEndian));
+
+            if (Count == 0 || Count > UINT32_MAX) {
+                return ObjcMetadataRange();
+            }
+
+            const auto ListAddr = Address + sizeof(PtrType);
+            const auto List =
+                DeVirtualizeData(ListAddr, sizeof(PtrType) * Count);
+
+            if (List == nullptr) {
+                return ObjcMetadataRange();
+            }
+
+            const auto Result = ObjcMetadataRange {
+                .Begin = static_cast<uint32_t>(ProtocolList.size()),
+                .Count = static_cast<uint32_t>(Count)
+            };
+
+            for (auto I = uint64_t(); I != Count; I++) {
+                const auto ProtocolAddr =
+                    ReadPointer<Kind>(DeVirtualizeData,
+                                      List + sizeof(PtrType) * I,
+                                      IsBigEndian);
+
+                // The protocol's name follows its isa.
+                auto NameAddr = uint64_t();
+                if (const auto Protocol =
+                        DeVirtualizeData(ProtocolAddr, sizeof(PtrType) * 2))
+                {
+                    NameAddr =
+                        ReadPointer<Kind>(DeVirtualizeData,
+                                          Protocol + sizeof(PtrType),
+                                          IsBigEndian);
+                }
+
+                ProtocolList.emplace_back(
+                    InternStringAtAddress(DeVirtualizeString, NameAddr));
+            }
+
+            return Result;
+        }
+
+        template <PointerKind Kind, typename S>
+        [[nodiscard]] static auto
+        GetClassRo(const uint64_t ClassAddr,
+                   const S &DeVirtualizeData,
+                   const bool IsBigEndian) noexcept
+            -> const ObjcParse::ClassRoTypeCalculator<Kind> *
+        {
+            using ClassType = ObjcParse::ClassTypeCalculator<Kind>;
+            using ClassRoType = ObjcParse::ClassRoTypeCalculator<Kind>;
+
+            const auto Class =
+                reinterpret_cast<const ClassType *>(
+                    DeVirtualizeData(ClassAddr, sizeof(ClassType)));
+
+            if (Class == nullptr) {
+                return nullptr;
+            }
+
+            // The low bits of a class's data-pointer are used as flags.
+            const auto DataMask =
+                PointerKindIs64Bit(Kind) ? ~uint64_t(7) : ~uint64_t(3);
+            const auto RoAddr =
+                ReadPointer<Kind>(DeVirtualizeData,
+                                  reinterpret_cast<const uint8_t *>(
+                                      &Class->Data),
+                                  IsBigEndian) &
+                DataMask;
+
+            return reinterpret_cast<const ClassRoType *>(
+                DeVirtualizeData(RoAddr, sizeof(ClassRoType)));
+        }
+
+        template <PointerKind Kind, typename S, typename T>
+        void
+        ParseClass(const uint64_t ClassAddr,
+                   const S &DeVirtualizeData,
+                   const T &DeVirtualizeString,
+                   const bool IsBigEndian) noexcept
+        {
+            using ClassType = ObjcParse::ClassTypeCalculator<Kind>;
+
+            const auto ClassRo =
+                GetClassRo<Kind>(ClassAddr, DeVirtualizeData, IsBigEndian);
+
+            if (ClassRo == nullptr) {
+                return;
+            }
+
+            const auto ReadField = [&](const auto &Field) noexcept {
+                return ReadPointer<Kind>(
+                    DeVirtualizeData,
+                    reinterpret_cast<const uint8_t *>(&Field),
+                    IsBigEndian);
+            };
+
+            auto Info = ObjcClassMetadata();
+
+            Info.Address = ClassAddr;
+            Info.Name =
+                InternStringAtAddress(
+                    DeVirtualizeString,
+                    ReadField(ClassRo->Name));
+
+            Info.InstanceMethods =
+                ParseMethodList<Kind>(
+                    ReadField(ClassRo->BaseMethods),
+                    DeVirtualizeData,
+                    DeVirtualizeString,
+                    IsBigEndian);
+
+            Info.Ivars =
+                ParseIvarList<Kind>(
+                    ReadField(ClassRo->Ivars),
+                    DeVirtualizeData,
+                    DeVirtualizeString,
+                    IsBigEndian);
+
+            Info.Properties =
+                ParsePropertyList<Kind>(
+                    ReadField(ClassRo->BaseProperties),
+                    DeVirtualizeData,
+                    DeVirtualizeString,
+                    IsBigEndian);
+
+            Info.Protocols =
+                ParseProtocolList<Kind>(
+                    ReadField(ClassRo->BaseProtocols),
+                    DeVirtualizeData,
+                    DeVirtualizeString,
+                    IsBigEndian);
+
+            // Class-methods are the instance-methods of the class's
+            // meta-class, which is the class's isa.
+
+            const auto Class =
+                reinterpret_cast<const ClassType *>(
+                    DeVirtualizeData(ClassAddr, sizeof(ClassType)));
+
+            if (const auto MetaClassRo =
+                    GetClassRo<Kind>(ReadField(Class->Isa),
+                                     DeVirtualizeData,
+                                     IsBigEndian))
+            {
+                Info.ClassMethods =
+                    ParseMethodList<Kind>(
+                        ReadField(MetaClassRo->BaseMethods),
+                        DeVirtualizeData,
+                        DeVirtualizeString,
+                        IsBigEndian);
+            }
+
+            ClassList.emplace_back(Info);
+        }
+    public:
+        ObjcMetadataCollection() noexcept = default;
+
+        // DeVirtualizeData(Address, Size) returns a pointer to Size bytes at
+        // Address, or nullptr, and DeVirtualizeString(Address) returns an
+        // optional string_view.
+
+        template <typename S, typename T>
+        auto
+        Parse(const SectionInfo &ClassListSection,
+              const S &DeVirtualizeData,
+              const T &DeVirtualizeString,
+              const bool IsBigEndian,
+              const bool Is64Bit) noexcept
+            -> decltype(*this)
+        {
+            const auto ParseWithKind = [&]<PointerKind Kind>() noexcept {
+                using PtrType = PointerAddrTypeFromKind<Kind>;
+
+                const auto &Range = ClassListSection.getMemoryRange();
+                const auto Size = Range.size();
+                const auto Data = DeVirtualizeData(Range.getBegin(), Size);
+
+                if (Data == nullptr) {
+                    return;
+                }
+
+                const auto Count = Size / sizeof(PtrType);
+                for (auto I = uint64_t(); I != Count; I++) {
+                    const auto ClassAddr =
+                        ReadPointer<Kind>(DeVirtualizeData,
+                                          Data + sizeof(PtrType) * I,
+                                          IsBigEndian);
+
+                    if (ClassAddr != 0) {
+                        ParseClass<Kind>(ClassAddr,
+                                         DeVirtualizeData,
+                                         DeVirtualizeString,
+                                         IsBigEndian);
+                    }
+                }
+            };
+
+            if (Is64Bit) {
+                ParseWithKind.template operator()<PointerKind::s64Bit>();
+            } else {
+                ParseWithKind.template operator()<PointerKind::s32Bit>();
+            }
+
+            return *this;
+        }
+
+        [[nodiscard]] static const SectionInfo *
+        FindClassListSection(const SegmentInfoCollection &Collection) noexcept;
+
+        [[nodiscard]] static ObjcMetadataCollection
+        Open(const SegmentInfoCollection &SegmentCollection,
+             const ConstDeVirtualizer &DeVirtualizer,
+             bool IsBigEndian,
+             bool Is64Bit) noexcept;
+
+        inline auto
+        setRelativeSelectorBase(const std::optional<uint64_t> &Base) noexcept
+            -> decltype(*this)
+        {
+            this->RelativeSelectorBase = Base;
+            return *this;
+        }
+
+        [[nodiscard]] inline auto &getClassList() const noexcept {
+            return ClassList;
+        }
+
+        [[nodiscard]] inline auto &getClassList() noexcept {
+            return ClassList;
+        }
+
+        [[nodiscard]] inline auto getStringCount() const noexcept {
+            return StringList.size();
+        }
+
+        [[nodiscard]]
+        inline auto getString(const uint32_t Index) const noexcept {
+            return StringList[Index];
+        }
+
+        [[nodiscard]] inline auto
+        getMethodList(const ObjcMetadataRange &Range) const noexcept {
+            return BasicContiguousList<const ObjcMethodInfo>(
+                MethodList.data() + Range.Begin, Range.Count);
+        }
+
+        [[nodiscard]] inline auto
+        getIvarList(const ObjcMetadataRange &Range) const noexcept {
+            return BasicContiguousList<const ObjcIvarInfo>(
+                IvarList.data() + Range.Begin, Range.Count);
+        }
+
+        [[nodiscard]] inline auto
+        getPropertyList(const ObjcMetadataRange &Range) const noexcept {
+            return BasicContiguousList<const ObjcPropertyInfo>(
+                PropertyList.data() + Range.Begin, Range.Count);
+        }
+
+        [[nodiscard]] inline auto
+        getProtocolList(const ObjcMetadataRange &Range) const noexcept {
+            return BasicContiguousList<const uint32_t>(
+                ProtocolList.data() + Range.Begin, Range.Count);
+        }
+
+        [[nodiscard]] inline auto getMethodCount() const noexcept {
+            return MethodList.size();
+        }
+
+        [[nodiscard]] inline auto empty() const noexcept {
+            return ClassList.empty();
+        }
+    };
+}
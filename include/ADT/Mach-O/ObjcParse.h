@@ -9,10 +9,14 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "ADT/BasicContiguousList.h"
 #include "Utils/PointerUtils.h"
+#include "Utils/SwitchEndian.h"
 
 #include "BindUtil.h"
 #include "ObjcInfo.h"
@@ -43,6 +47,55 @@ namespace MachO::ObjcParse {
                            ObjcClassCategory64,
                            ObjcClassCategory>;
 
+    // Pointers read from the data of an image are stored encoded in the
+    // slide-info of a dyld_shared_cache, so they're decoded if the provided
+    // devirtualizer can, and otherwise returned unchanged.
+
+    template <typename S>
+    [[nodiscard]] constexpr auto
+    UnslidePointer(const S &DeVirtualizeAddr, const uint64_t Value) noexcept
+        -> uint64_t
+    {
+        if constexpr (requires { DeVirtualizeAddr.UnslidePointer(Value); }) {
+            return DeVirtualizeAddr.UnslidePointer(Value);
+        } else {
+            return Value;
+        }
+    }
+
+    // Reads the pointer stored at Location. A devirtualizer with a
+    // rebased-view of the cache reads it through the view, so that only a
+    // pointer in a slide-info chain is decoded. Otherwise the stored value is
+    // passed to UnslidePointer().
+
+    template <PointerKind Kind, typename S>
+    [[nodiscard]] inline auto
+    ReadPointerAt(const S &DeVirtualizeAddr,
+                  const void *const Location,
+                  const bool IsBigEndian) noexcept
+        -> uint64_t
+    {
+        constexpr auto Is64Bit = PointerKindIs64Bit(Kind);
+        if constexpr (
+            requires { DeVirtualizeAddr.ReadPointerAt(Location, Is64Bit); })
+        {
+            const auto Pointer =
+                DeVirtualizeAddr.ReadPointerAt(Location, Is64Bit);
+
+            if (Pointer.has_value()) {
+                return Pointer.value();
+            }
+        }
+
+        using PtrType = PointerAddrTypeFromKind<Kind>;
+
+        auto Value = PtrType();
+        memcpy(&Value, Location, sizeof(Value));
+
+        return UnslidePointer(DeVirtualizeAddr,
+                              SwitchEndianIf(Value, IsBigEndian));
+    }
+
     inline auto
     AddClassToList(
         std::unordered_map<uint64_t, std::unique_ptr<ObjcClassInfo>> &List,
@@ -64,12 +117,84 @@ namespace MachO::ObjcParse {
                               ObjcClassInfo *const Info) noexcept
     {
         if (Super != Info) {
-            Super->AddChild(*Info);
+            Info->setSuper(Super);
         } else {
             Info->setSuper(nullptr);
         }
     }
 
+    // Classes without a super-class in the image, being either root classes or
+    // classes imported from another image.
+    //
+    // Each class is also indexed by its dylib-ordinal and name, so that
+    // super-classes bound to an imported class are found without searching
+    // every class in the list.
+
+    struct ExternalAndRootClassCollection {
+    protected:
+        struct Key {
+            uint64_t DylibOrdinal;
+            std::string_view Name;
+
+            [[nodiscard]]
+            constexpr auto operator==(const Key &Rhs) const noexcept -> bool {
+                return DylibOrdinal == Rhs.DylibOrdinal && Name == Rhs.Name;
+            }
+        };
+
+        struct KeyHash {
+            [[nodiscard]]
+            inline auto operator()(const Key &Key) const noexcept -> size_t {
+                const auto NameHash = std::hash<std::string_view>()(Key.Name);
+                return NameHash ^ (Key.DylibOrdinal * 0x9e3779b97f4a7c15ull);
+            }
+        };
+
+        std::vector<ObjcClassInfo *> List;
+        std::unordered_map<Key, ObjcClassInfo *, KeyHash> Index;
+    public:
+        ExternalAndRootClassCollection() noexcept = default;
+
+        [[nodiscard]] inline auto &getList() const noexcept {
+            return List;
+        }
+
+        // Names are views into each class, which never move as classes are
+        // each allocated separately.
+
+        inline auto add(ObjcClassInfo *const Info) noexcept
+            -> decltype(*this)
+        {
+            List.emplace_back(Info);
+            Index.try_emplace(Key {
+                .DylibOrdinal = Info->getDylibOrdinal(),
+                .Name = Info->getName()
+            }, Info);
+
+            return *this;
+        }
+
+        // Returns the first class added with the provided dylib-ordinal and
+        // name, if any.
+
+        [[nodiscard]] inline auto
+        find(const uint64_t DylibOrdinal,
+             const std::string_view Name) const noexcept
+            -> ObjcClassInfo *
+        {
+            const auto Iter = Index.find(Key {
+                .DylibOrdinal = DylibOrdinal,
+                .Name = Name
+            });
+
+            if (Iter != Index.cend()) {
+                return Iter->second;
+            }
+
+            return nullptr;
+        }
+    };
+
     inline
     auto GetNameFromBindActionSymbol(const std::string_view Symbol) noexcept {
         constexpr auto Prefix = std::string_view("_OBJC_CLASS_$_");
@@ -85,25 +210,16 @@ namespace MachO::ObjcParse {
         ObjcClassInfo *const Info,
         const BindActionCollection::Info &Action,
         std::unordered_map<uint64_t, std::unique_ptr<ObjcClassInfo>> &List,
-        std::vector<ObjcClassInfo *> &ExternalAndRootClassList) noexcept
+        ExternalAndRootClassCollection &ExternalAndRootClassList) noexcept
     {
         const auto ActionSymbol =
             GetNameFromBindActionSymbol(Action.getSymbol());
 
-        const auto Pred = [&](const auto &Lhs) noexcept {
-            if (Lhs->getDylibOrdinal() != Action.getDylibOrdinal()) {
-                return false;
-            }
-
-            return Lhs->getName() == ActionSymbol;
-        };
-
-        const auto Begin = ExternalAndRootClassList.cbegin();
-        const auto End = ExternalAndRootClassList.cend();
-        const auto Iter = std::find_if(Begin, End, Pred);
-
-        if (Iter != End) {
-            SetSuperClassForClassInfo(*Iter, Info);
+        if (const auto Super =
+                ExternalAndRootClassList.find(Action.getDylibOrdinal(),
+                                              ActionSymbol))
+        {
+            SetSuperClassForClassInfo(Super, Info);
             return;
         }
 
@@ -117,17 +233,16 @@ namespace MachO::ObjcParse {
             AddClassToList(List, std::move(SuperInfo), Action.getAddress());
 
         SetSuperClassForClassInfo(Ptr, Info);
-        ExternalAndRootClassList.emplace_back(Ptr);
+        ExternalAndRootClassList.add(Ptr);
     }
 
-    template <PointerKind Kind, typename S, typename T>
+    template <PointerKind Kind, bool IsBigEndian, typename S, typename T>
     static void
     ParseObjcClass(const uint64_t Addr,
                    const S &DeVirtualizeAddr,
                    const T &DeVirtualizeString,
                    const BindActionCollection &BindCollection,
-                   ObjcClassInfo &Info,
-                   const bool IsBigEndian) noexcept
+                   ObjcClassInfo &Info) noexcept
     {
         // FIXME: Use bind collection
         (void)BindCollection;
@@ -145,8 +260,12 @@ namespace MachO::ObjcParse {
             return;
         }
 
-        const auto SuperAddr = Class->getSuperClassAddress(IsBigEndian);
-        const auto RoAddr = Class->getData(IsBigEndian);
+        const auto SuperAddr =
+            ReadPointerAt<Kind>(DeVirtualizeAddr,
+                                &Class->SuperClass,
+                                IsBigEndian);
+        const auto RoAddr =
+            ReadPointerAt<Kind>(DeVirtualizeAddr, &Class->Data, IsBigEndian);
         const auto ClassRo =
             reinterpret_cast<const ClassRoType *>(DeVirtualizeAddr(RoAddr));
 
@@ -157,7 +276,9 @@ namespace MachO::ObjcParse {
             return;
         }
 
-        const auto NameAddr = ClassRo->getNameAddress(IsBigEndian);
+        const auto NameAddr =
+            ReadPointerAt<Kind>(DeVirtualizeAddr, &ClassRo->Name, IsBigEndian);
+
         if (auto String = DeVirtualizeString(NameAddr)) {
             Info.setName(std::string(String.value()));
         }
@@ -188,7 +309,7 @@ namespace MachO::ObjcParse {
         return false;
     }
 
-    template <PointerKind Kind, typename S, typename T>
+    template <PointerKind Kind, bool IsBigEndian, typename S, typename T>
     static void
     FixSuperForClassInfo(
         ObjcClassInfo *const Info,
@@ -196,8 +317,7 @@ namespace MachO::ObjcParse {
         const T &DeVirtualizeString,
         const BindActionCollection &BindCollection,
         std::unordered_map<uint64_t, std::unique_ptr<ObjcClassInfo>> &List,
-        std::vector<ObjcClassInfo *> &ExternalAndRootClassList,
-        const bool IsBigEndian) noexcept
+        ExternalAndRootClassCollection &ExternalAndRootClassList) noexcept
     {
         // BindAddr points to the `SuperClass` field inside ObjcClass[64]
 
@@ -218,7 +338,7 @@ namespace MachO::ObjcParse {
 
         if (SuperAddr == 0) {
             Info->setSuper(nullptr);
-            ExternalAndRootClassList.emplace_back(Info);
+            ExternalAndRootClassList.add(Info);
 
             return;
         }
@@ -228,63 +348,60 @@ namespace MachO::ObjcParse {
         }
 
         auto SuperInfo = ObjcClassInfo();
-        ParseObjcClass<Kind>(SuperAddr,
-                             DeVirtualizeAddr,
-                             DeVirtualizeString,
-                             BindCollection,
-                             SuperInfo,
-                             IsBigEndian);
+        ParseObjcClass<Kind, IsBigEndian>(SuperAddr,
+                                          DeVirtualizeAddr,
+                                          DeVirtualizeString,
+                                          BindCollection,
+                                          SuperInfo);
 
         const auto Ptr = AddClassToList(List, std::move(SuperInfo), SuperAddr);
 
         SetSuperClassForClassInfo(Ptr, Info);
-        FixSuperForClassInfo<Kind>(Ptr,
-                                   DeVirtualizeAddr,
-                                   DeVirtualizeString,
-                                   BindCollection,
-                                   List,
-                                   ExternalAndRootClassList,
-                                   IsBigEndian);
+        FixSuperForClassInfo<Kind, IsBigEndian>(Ptr,
+                                                DeVirtualizeAddr,
+                                                DeVirtualizeString,
+                                                BindCollection,
+                                                List,
+                                                ExternalAndRootClassList);
 
         return;
     }
 
-    template <PointerKind Kind, typename S, typename T>
+    template <PointerKind Kind, bool IsBigEndian, typename S, typename T>
     static void
     HandleAddrForObjcClass(
-        const uint64_t Addr,
+        const PointerAddrConstTypeFromKind<Kind> &Addr,
         const S &DeVirtualizeAddr,
         const T &DeVirtualizeString,
         const BindActionCollection &BindCollection,
-        std::unordered_map<uint64_t, std::unique_ptr<ObjcClassInfo>> &List,
-        const bool IsBigEndian) noexcept
+        std::unordered_map<uint64_t, std::unique_ptr<ObjcClassInfo>> &List)
+            noexcept
     {
         if (Addr == 0) {
             return;
         }
 
         auto Info = ObjcClassInfo();
-        const auto SwitchedAddr = SwitchEndianIf(Addr, IsBigEndian);
+        const auto SwitchedAddr =
+            ReadPointerAt<Kind>(DeVirtualizeAddr, &Addr, IsBigEndian);
 
-        ParseObjcClass<Kind>(SwitchedAddr,
-                             DeVirtualizeAddr,
-                             DeVirtualizeString,
-                             BindCollection,
-                             Info,
-                             IsBigEndian);
+        ParseObjcClass<Kind, IsBigEndian>(SwitchedAddr,
+                                          DeVirtualizeAddr,
+                                          DeVirtualizeString,
+                                          BindCollection,
+                                          Info);
 
         AddClassToList(List, std::move(Info), SwitchedAddr);
     }
 
-    template <PointerKind Kind, typename S, typename T>
+    template <PointerKind Kind, bool IsBigEndian, typename S, typename T>
     static void
     FixSuperClassForClassList(
         const S &DeVirtualizeAddr,
         const T &DeVirtualizeString,
         const BindActionCollection &BindCollection,
         std::unordered_map<uint64_t, std::unique_ptr<ObjcClassInfo>> &List,
-        std::vector<ObjcClassInfo *> &ExternalAndRootClassList,
-        const bool IsBigEndian) noexcept
+        ExternalAndRootClassCollection &ExternalAndRootClassList) noexcept
     {
         for (auto &Iter : List) {
             const auto &Info = Iter.second.get();
@@ -298,27 +415,30 @@ namespace MachO::ObjcParse {
                 continue;
             }
 
-            FixSuperForClassInfo<Kind>(Info,
-                                       DeVirtualizeAddr,
-                                       DeVirtualizeString,
-                                       BindCollection,
-                                       List,
-                                       ExternalAndRootClassList,
-                                       IsBigEndian);
+            FixSuperForClassInfo<Kind, IsBigEndian>(Info,
+                                                    DeVirtualizeAddr,
+                                                    DeVirtualizeString,
+                                                    BindCollection,
+                                                    List,
+                                                    ExternalAndRootClassList);
         }
     }
 
-    template <PointerKind Kind, typename S, typename T>
+    // Class-lists smaller than this many classes per thread are parsed on the
+    // calling thread, as starting threads would take longer than the parse.
+
+    constexpr static auto ParallelClassListThreshold = uint64_t(1) << 10;
+
+    template <PointerKind Kind, bool IsBigEndian, typename S, typename T>
     static Error
-    ParseObjcClassListSection(
+    ParseObjcClassListSectionImpl(
         const uint8_t *const Begin,
         const uint8_t *const End,
         const S &DeVirtualizeAddr,
         const T &DeVirtualizeString,
         const BindActionCollection &BindCollection,
         std::unordered_map<uint64_t, std::unique_ptr<ObjcClassInfo>> &ClassList,
-        std::vector<ObjcClassInfo *> &ExternalAndRootClassList,
-        const bool IsBigEndian) noexcept
+        ExternalAndRootClassCollection &ExternalAndRootClassList) noexcept
     {
         using PtrAddrType = PointerAddrConstTypeFromKind<Kind>;
         if (!IntegerIsPointerAligned<Kind>(End - Begin)) {
@@ -326,21 +446,81 @@ namespace MachO::ObjcParse {
         }
 
         const auto List = BasicContiguousList<PtrAddrType>(Begin, End);
-        for (const auto &Addr : List) {
-            HandleAddrForObjcClass<Kind>(Addr,
-                                         DeVirtualizeAddr,
-                                         DeVirtualizeString,
-                                         BindCollection,
-                                         ClassList,
-                                         IsBigEndian);
+        const auto Count = static_cast<uint64_t>(List.count());
+
+        // Decode every class into a flat list first, as only reads of the
+        // image are needed, and so each chunk of the list can be decoded on
+        // a separate thread.
+
+        auto ParsedList = std::vector<ObjcClassInfo>(Count);
+        const auto ParseChunk = [&](const uint64_t ChunkBegin,
+                                    const uint64_t ChunkEnd) noexcept
+        {
+            for (auto I = ChunkBegin; I != ChunkEnd; I++) {
+                const auto &Addr = List.at(I);
+                if (Addr == 0) {
+                    continue;
+                }
+
+                const auto ClassAddr =
+                    ReadPointerAt<Kind>(DeVirtualizeAddr, &Addr, IsBigEndian);
+
+                ParseObjcClass<Kind, IsBigEndian>(ClassAddr,
+                                                  DeVirtualizeAddr,
+                                                  DeVirtualizeString,
+                                                  BindCollection,
+                                                  ParsedList[I]);
+            }
+        };
+
+        const auto HardwareCount =
+            static_cast<uint64_t>(std::thread::hardware_concurrency());
+        const auto ThreadCount =
+            std::min(HardwareCount, Count / ParallelClassListThreshold);
+
+        if (ThreadCount < 2) {
+            ParseChunk(0, Count);
+        } else {
+            const auto ChunkSize = Count / ThreadCount;
+            const auto GetChunkBegin = [&](const uint64_t Index) noexcept {
+                return (Index < ThreadCount) ? Index * ChunkSize : Count;
+            };
+
+            auto ThreadList = std::vector<std::thread>();
+            ThreadList.reserve(ThreadCount);
+
+            for (auto I = uint64_t(); I != ThreadCount; I++) {
+                ThreadList.emplace_back([&, I]() noexcept {
+                    ParseChunk(GetChunkBegin(I), GetChunkBegin(I + 1));
+                });
+            }
+
+            for (auto &Thread : ThreadList) {
+                Thread.join();
+            }
+        }
+
+        // Then add the classes in list order, so that the first class at any
+        // address is kept, just as with a serial parse, before linking every
+        // class with its super-class.
+
+        for (auto I = uint64_t(); I != Count; I++) {
+            const auto &Addr = List.at(I);
+            if (Addr == 0) {
+                continue;
+            }
+
+            const auto ClassAddr =
+                ReadPointerAt<Kind>(DeVirtualizeAddr, &Addr, IsBigEndian);
+
+            AddClassToList(ClassList, std::move(ParsedList[I]), ClassAddr);
         }
 
-        FixSuperClassForClassList<Kind>(DeVirtualizeAddr,
-                                        DeVirtualizeString,
-                                        BindCollection,
-                                        ClassList,
-                                        ExternalAndRootClassList,
-                                        IsBigEndian);
+        FixSuperClassForClassList<Kind, IsBigEndian>(DeVirtualizeAddr,
+                                                     DeVirtualizeString,
+                                                     BindCollection,
+                                                     ClassList,
+                                                     ExternalAndRootClassList);
 
         return Error::None;
     }
@@ -361,17 +541,16 @@ namespace MachO::ObjcParse {
         return NewInfo;
     }
 
-    template <PointerKind Kind, typename S, typename T>
+    template <PointerKind Kind, bool IsBigEndian, typename S, typename T>
     static Error
-    ParseObjcClassRefsSection(
+    ParseObjcClassRefsSectionImpl(
         const uint8_t *const Map,
         const SectionInfo *const SectionInfo,
         const S &DeVirtualizeAddr,
         const T &DeVirtualizeString,
         const BindActionCollection &BindCollection,
         std::unordered_map<uint64_t, std::unique_ptr<ObjcClassInfo>> &ClassList,
-        std::vector<ObjcClassInfo *> &ExternalAndRootClassList,
-        const bool IsBigEndian) noexcept
+        ExternalAndRootClassCollection &ExternalAndRootClassList) noexcept
     {
         using PointerAddrType = PointerAddrConstTypeFromKind<Kind>;
 
@@ -395,26 +574,80 @@ namespace MachO::ObjcParse {
                 const auto Ptr =
                     AddClassToList(ClassList, std::move(NewInfo), ListAddr);
 
-                ExternalAndRootClassList.emplace_back(Ptr);
+                ExternalAndRootClassList.add(Ptr);
             } else {
-                HandleAddrForObjcClass<Kind>(Addr,
-                                             DeVirtualizeAddr,
-                                             DeVirtualizeString,
-                                             BindCollection,
-                                             ClassList,
-                                             IsBigEndian);
+                HandleAddrForObjcClass<Kind, IsBigEndian>(Addr,
+                                                          DeVirtualizeAddr,
+                                                          DeVirtualizeString,
+                                                          BindCollection,
+                                                          ClassList);
             }
 
             ListAddr += PointerSize<Kind>();
         }
 
-        FixSuperClassForClassList<Kind>(DeVirtualizeAddr,
-                                        DeVirtualizeString,
-                                        BindCollection,
-                                        ClassList,
-                                        ExternalAndRootClassList,
-                                        IsBigEndian);
+        FixSuperClassForClassList<Kind, IsBigEndian>(DeVirtualizeAddr,
+                                                     DeVirtualizeString,
+                                                     BindCollection,
+                                                     ClassList,
+                                                     ExternalAndRootClassList);
 
         return Error::None;
     }
+
+    // The class-list and class-refs parsers are instantiated for each
+    // endianness, so every read of a class in the loops above needs no check
+    // of the endianness, which is instead checked just once here.
+
+    template <PointerKind Kind, typename S, typename T>
+    static Error
+    ParseObjcClassListSection(
+        const uint8_t *const Begin,
+        const uint8_t *const End,
+        const S &DeVirtualizeAddr,
+        const T &DeVirtualizeString,
+        const BindActionCollection &BindCollection,
+        std::unordered_map<uint64_t, std::unique_ptr<ObjcClassInfo>> &ClassList,
+        ExternalAndRootClassCollection &ExternalAndRootClassList,
+        const bool IsBigEndian) noexcept
+    {
+        const auto Parse = [&](const auto BigEndian) noexcept {
+            return ParseObjcClassListSectionImpl<Kind, BigEndian()>(
+                Begin,
+                End,
+                DeVirtualizeAddr,
+                DeVirtualizeString,
+                BindCollection,
+                ClassList,
+                ExternalAndRootClassList);
+        };
+
+        return DispatchOnEndian(IsBigEndian, Parse);
+    }
+
+    template <PointerKind Kind, typename S, typename T>
+    static Error
+    ParseObjcClassRefsSection(
+        const uint8_t *const Map,
+        const SectionInfo *const SectionInfo,
+        const S &DeVirtualizeAddr,
+        const T &DeVirtualizeString,
+        const BindActionCollection &BindCollection,
+        std::unordered_map<uint64_t, std::unique_ptr<ObjcClassInfo>> &ClassList,
+        ExternalAndRootClassCollection &ExternalAndRootClassList,
+        const bool IsBigEndian) noexcept
+    {
+        const auto Parse = [&](const auto BigEndian) noexcept {
+            return ParseObjcClassRefsSectionImpl<Kind, BigEndian()>(
+                Map,
+                SectionInfo,
+                DeVirtualizeAddr,
+                DeVirtualizeString,
+                BindCollection,
+                ClassList,
+                ExternalAndRootClassList);
+        };
+
+        return DispatchOnEndian(IsBigEndian, Parse);
+    }
 }
@@ -10,18 +10,25 @@
 
 #include <cassert>
 
+#include "ADT/Tree.h"
+
 #include "DeVirtualizer.h"
 #include "ObjcParse.h"
 
 namespace MachO {
     struct ObjcClassCategoryCollection;
-    struct ObjcClassInfoCollection : public Tree {
+    struct ObjcClassInfoCollection {
         friend struct ObjcClassCategoryCollection;
     public:
         using Info = ObjcClassInfo;
+        using ClassTreeType = IndexedTree<Info *>;
     protected:
         std::unordered_map<uint64_t, std::unique_ptr<Info>> List;
-        void AdjustExternalAndRootClassList(std::vector<Info *> &List) noexcept;
+        ClassTreeType ClassTree;
+
+        void
+        AdjustExternalAndRootClassList(const std::vector<Info *> &List)
+            noexcept;
 
         [[nodiscard]] static int
         GetBindCollection(
@@ -110,7 +117,23 @@ namespace MachO {
         }
 
         [[nodiscard]] inline auto getRoot() const noexcept {
-            return reinterpret_cast<Info *>(Root);
+            if (this->ClassTree.empty()) {
+                return static_cast<Info *>(nullptr);
+            }
+
+            return this->ClassTree.at(0).Value;
+        }
+
+        [[nodiscard]] inline auto &getClassTree() noexcept {
+            return this->ClassTree;
+        }
+
+        [[nodiscard]] inline auto &getClassTree() const noexcept {
+            return this->ClassTree;
+        }
+
+        [[nodiscard]] inline auto empty() const noexcept {
+            return this->ClassTree.empty();
         }
 
         [[nodiscard]] inline auto &getMap() noexcept {
@@ -140,44 +163,9 @@ namespace MachO {
         GetInfoForClassName(std::string_view Name) const noexcept
             -> ObjcClassInfo *;
 
-        using Iterator = TreeIterator<ObjcClassInfo>;
-        using ConstIterator = TreeIterator<const ObjcClassInfo>;
-
-        [[nodiscard]] inline auto begin() const noexcept {
-            return Iterator(getRoot());
-        }
-
-        [[nodiscard]] inline auto end() const noexcept {
-            return Iterator::Null();
-        }
-
-        [[nodiscard]] inline auto cbegin() const noexcept {
-            return ConstIterator(getRoot());
-        }
-
-        [[nodiscard]] inline auto cend() const noexcept {
-            return ConstIterator::Null();
-        }
-
         [[nodiscard]] inline auto size() const noexcept {
             return List.size();
         }
-
-        template <typename T>
-        inline auto forEach(const T &Callback) const noexcept
-            -> decltype(*this)
-        {
-            this->forEachNode(Callback);
-            return *this;
-        }
-
-        template <typename T>
-        inline auto forEach(const T &Callback) noexcept
-            -> decltype(*this)
-        {
-            this->forEachNode(Callback);
-            return *this;
-        }
     };
 
     struct ObjcClassCategoryCollection {
@@ -0,0 +1,166 @@
+//
+//  ADT/Mach-O/RebaseUtil.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <unordered_map>
+#include <vector>
+
+#include "ADT/Range.h"
+#include "Utils/MiscTemplates.h"
+
+#include "RebaseInfo.h"
+
+namespace MachO {
+    // Stores the locations rebased by a rebase-opcode list as a bitmap for
+    // each segment, with one bit for every pointer-aligned slot of the
+    // segment, so that checking whether a location is rebased is O(1).
+    //
+    // A rebased location doesn't keep the action that rebased it, only the
+    // write-kinds of locations not rebased as a pointer are kept.
+
+    struct RebaseActionCollection {
+    public:
+        enum class Error {
+            None,
+            ActionOutsideSegment
+        };
+
+        using ParseError = RebaseOpcodeParseError;
+    protected:
+        struct SegmentEntry {
+            Range MemoryRange;
+
+            // Bitmap of the segment's pointer-aligned slots, only as long as
+            // needed to hold the last rebased slot.
+
+            std::vector<uint64_t> BitList;
+
+            // Sorted list of the rebased segment-offsets that aren't
+            // pointer-aligned, which linkers don't emit in practice.
+
+            std::vector<uint64_t> UnalignedList;
+        };
+
+        std::vector<SegmentEntry> SegmentList;
+        std::unordered_map<uint64_t, RebaseWriteKind> WriteKindMap;
+
+        uint64_t Count = 0;
+        uint8_t SlotSize = PointerSize<PointerKind::s64Bit>();
+
+        [[nodiscard]] auto
+        GetActionInfo(uint32_t SegmentIndex, uint64_t AddrInSeg) const noexcept
+            -> RebaseActionInfo;
+    public:
+        explicit RebaseActionCollection() noexcept = default;
+
+        auto
+        Parse(const SegmentInfoCollection &SegmentCollection,
+              const RebaseActionList &ActionList,
+              bool Is64Bit,
+              ParseError *ParseErrorOut,
+              Error *ErrorOut) noexcept
+            -> decltype(*this);
+
+        [[nodiscard]] inline static RebaseActionCollection
+        Open(const SegmentInfoCollection &SegmentCollection,
+             const RebaseActionList &ActionList,
+             const bool Is64Bit,
+             ParseError *const ParseErrorOut,
+             Error *const ErrorOut) noexcept
+        {
+            auto Collection = RebaseActionCollection();
+            Collection.Parse(SegmentCollection,
+                             ActionList,
+                             Is64Bit,
+                             ParseErrorOut,
+                             ErrorOut);
+
+            return Collection;
+        }
+
+        [[nodiscard]] constexpr auto size() const noexcept {
+            return Count;
+        }
+
+        [[nodiscard]] constexpr auto empty() const noexcept {
+            return size() == 0;
+        }
+
+        [[nodiscard]] inline auto
+        isRebased(const uint32_t SegmentIndex,
+                  const uint64_t AddrInSeg) const noexcept
+        {
+            if (IndexOutOfBounds(SegmentIndex, SegmentList.size())) {
+                return false;
+            }
+
+            const auto &Entry = SegmentList[SegmentIndex];
+            if (AddrInSeg % SlotSize != 0) {
+                return std::binary_search(Entry.UnalignedList.begin(),
+                                          Entry.UnalignedList.end(),
+                                          AddrInSeg);
+            }
+
+            const auto Slot = AddrInSeg / SlotSize;
+            const auto WordIndex = Slot / 64;
+
+            if (IndexOutOfBounds(WordIndex, Entry.BitList.size())) {
+                return false;
+            }
+
+            const auto Bit = uint64_t(1) << (Slot % 64);
+            return (Entry.BitList[WordIndex] & Bit) != 0;
+        }
+
+        [[nodiscard]] bool isAddressRebased(uint64_t Address) const noexcept;
+
+        [[nodiscard]] auto
+        GetWriteKindForAddress(uint64_t Address) const noexcept
+            -> RebaseWriteKind;
+
+        // Calls Callback with every rebased location, ordered by segment, and
+        // then by the location's offset in its segment.
+
+        template <typename T>
+        void forEach(const T &Callback) const noexcept {
+            for (auto I = uint32_t(); I != SegmentList.size(); I++) {
+                const auto &Entry = SegmentList[I];
+
+                auto UnalignedIter = Entry.UnalignedList.begin();
+                const auto UnalignedEnd = Entry.UnalignedList.end();
+
+                const auto BitListSize = Entry.BitList.size();
+                for (auto Index = uint64_t(); Index != BitListSize; Index++) {
+                    for (auto Word = Entry.BitList[Index];
+                         Word != 0;
+                         Word &= Word - 1)
+                    {
+                        const auto Slot = Index * 64 + std::countr_zero(Word);
+                        const auto AddrInSeg = Slot * SlotSize;
+
+                        for (; UnalignedIter != UnalignedEnd &&
+                               *UnalignedIter < AddrInSeg;
+                             UnalignedIter++)
+                        {
+                            Callback(GetActionInfo(I, *UnalignedIter));
+                        }
+
+                        Callback(GetActionInfo(I, AddrInSeg));
+                    }
+                }
+
+                for (; UnalignedIter != UnalignedEnd; UnalignedIter++) {
+                    Callback(GetActionInfo(I, *UnalignedIter));
+                }
+            }
+        }
+    };
+}
@@ -8,9 +8,8 @@
 
 #pragma once
 
-#include <memory>
-#include <string>
-#include <vector>
+#include <span>
+#include <string_view>
 
 #include "ADT/Range.h"
 #include "ADT/Mach-O/MemoryProtections.h"
@@ -21,11 +20,14 @@
 #include "LoadCommandsCommon.h"
 
 namespace MachO {
+    // Names of segments and sections point into the load-commands they were
+    // parsed from, and so are only valid as long as the load-commands are.
+
     struct SegmentInfo;
     struct SectionInfo {
     protected:
         const SegmentInfo *Segment;
-        std::string Name;
+        std::string_view Name;
 
         Range FileRange;
         Range MemoryRange;
@@ -75,20 +77,13 @@ namespace MachO {
             return *this;
         }
 
-        constexpr auto setNameCopy(const std::string_view Name) noexcept
+        constexpr auto setName(const std::string_view Name) noexcept
             -> decltype(*this)
         {
             this->Name = Name;
             return *this;
         }
 
-        constexpr auto setName(std::string_view &&Name) noexcept
-            -> decltype(*this)
-        {
-            this->Name = std::move(Name);
-            return *this;
-        }
-
         constexpr auto setFileRange(const Range &LocRange) noexcept
             -> decltype(*this)
         {
@@ -152,7 +147,7 @@ namespace MachO {
 
     struct SegmentInfo {
     protected:
-        std::string Name;
+        std::string_view Name;
 
         Range FileRange;
         Range MemoryRange;
@@ -161,7 +156,7 @@ namespace MachO {
         MemoryProtections MaxProt;
 
         SegmentFlags Flags;
-        std::vector<std::unique_ptr<SectionInfo>> SectionList;
+        std::span<const SectionInfo> SectionList;
     public:
         [[nodiscard]]
         constexpr auto getName() const noexcept -> std::string_view {
@@ -188,11 +183,7 @@ namespace MachO {
             return this->Flags;
         }
 
-        [[nodiscard]] constexpr auto &getSectionList() const noexcept {
-            return this->SectionList;
-        }
-
-        [[nodiscard]] constexpr auto &getSectionListRef() noexcept {
+        [[nodiscard]] constexpr auto getSectionList() const noexcept {
             return this->SectionList;
         }
 
@@ -238,6 +229,14 @@ namespace MachO {
             return *this;
         }
 
+        constexpr auto
+        setSectionList(const std::span<const SectionInfo> List) noexcept
+            -> decltype(*this)
+        {
+            this->SectionList = List;
+            return *this;
+        }
+
         [[nodiscard]] auto
         FindSectionWithName(std::string_view Name) const noexcept
             -> const SectionInfo *;
@@ -259,7 +258,7 @@ namespace MachO {
                 return nullptr;
             }
 
-            return getSectionList().at(SectionIndex).get();
+            return &getSectionList()[SectionIndex];
         }
 
         template <Concepts::NotConst T = uint8_t>
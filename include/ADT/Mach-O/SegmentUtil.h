@@ -7,6 +7,8 @@
 //
 
 #pragma once
+
+#include <vector>
 #include "SegmentInfo.h"
 
 namespace MachO {
@@ -16,6 +18,8 @@ namespace MachO {
     };
 
     struct ConstLoadCommandStorage;
+    struct LoadCommandIndex;
+
     struct SegmentInfoCollection {
     public:
         enum class Error {
@@ -30,42 +34,68 @@ namespace MachO {
             OverlappingSections
         };
     protected:
-        std::vector<std::unique_ptr<SegmentInfo>> List;
+        // The segments, and the sections of every segment, are each stored in
+        // one list, with each segment's section-list being a span of
+        // SectionList. Both lists are sized before any segment is parsed, as
+        // segments and sections point to each other.
+
+        std::vector<SegmentInfo> List;
+        std::vector<SectionInfo> SectionList;
+
         explicit SegmentInfoCollection() noexcept = default;
 
         void
-        ParseFromLoadCommands(const ConstLoadCommandStorage &LoadCmdStorage,
+        ParseFromLoadCommands(const LoadCommandIndex &LoadCmdIndex,
                               bool Is64Bit,
                               Error *ErrorOut) noexcept;
     public:
+        SegmentInfoCollection(const SegmentInfoCollection &) = delete;
+        SegmentInfoCollection(SegmentInfoCollection &&) noexcept = default;
+
+        auto operator=(const SegmentInfoCollection &) = delete;
+        auto operator=(SegmentInfoCollection &&) noexcept
+            -> SegmentInfoCollection & = default;
+
         [[nodiscard]] static auto
         Open(const ConstLoadCommandStorage &LoadCmdStorage,
              bool Is64Bit,
              Error *ErrorOut) noexcept
                 -> SegmentInfoCollection;
 
+        [[nodiscard]] static auto
+        Open(const LoadCommandIndex &LoadCmdIndex,
+             bool Is64Bit,
+             Error *ErrorOut) noexcept
+                -> SegmentInfoCollection;
+
+        // Returns a collection of only the segment named Name, which is empty
+        // if no segment has the name.
+
         [[nodiscard]] static auto
         OpenSegmentInfoWithName(const ConstLoadCommandStorage &LoadCmdStorage,
                                 bool Is64Bit,
                                 std::string_view Name,
                                 Error *ErrorOut) noexcept
-            -> std::unique_ptr<SegmentInfo>;
+            -> SegmentInfoCollection;
+
+        // Returns the section, which is owned by the collection in
+        // SegmentOut.
 
         [[nodiscard]] static auto
         OpenSectionInfoWithName(const ConstLoadCommandStorage &LoadCmdStorage,
                                 bool Is64Bit,
                                 std::string_view SegmentName,
                                 std::string_view SectionName,
-                                std::unique_ptr<SegmentInfo> *SegmentOut,
+                                SegmentInfoCollection *SegmentOut,
                                 Error *ErrorOut) noexcept
-            -> std::unique_ptr<SectionInfo>;
+            -> const SectionInfo *;
 
         [[nodiscard]] inline auto &front() const noexcept {
-            return *this->List.front().get();
+            return this->List.front();
         }
 
         [[nodiscard]] inline auto &back() const noexcept {
-            return *this->List.back().get();
+            return this->List.back();
         }
 
         [[nodiscard]] auto
@@ -195,7 +225,7 @@ namespace MachO {
 
         [[nodiscard]] inline auto &at(const uint64_t Index) const noexcept {
             assert(IndexOutOfBounds(Index, this->size()));
-            return *this->List.at(Index).get();
+            return this->List.at(Index);
         }
 
         [[nodiscard]] inline auto atOrNull(const uint64_t Index) const noexcept
@@ -205,7 +235,7 @@ namespace MachO {
                 return nullptr;
             }
 
-            return this->List.at(Index).get();
+            return &this->List.at(Index);
         }
 
         [[nodiscard]] inline auto empty() const noexcept {
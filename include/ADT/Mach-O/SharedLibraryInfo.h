@@ -9,13 +9,17 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
+
 #include "LoadCommands.h"
 
 namespace MachO {
     struct SharedLibraryInfo {
     protected:
         LoadCommand::Kind Kind;
-        std::string Path;
+
+        // Points into the load-command the library was parsed from.
+        std::string_view Path;
 
         uint32_t Index;
         uint32_t Timestamp;
@@ -27,9 +31,7 @@ namespace MachO {
             return this->Kind;
         }
 
-        [[nodiscard]] constexpr auto getPath() const noexcept
-            -> std::string_view
-        {
+        [[nodiscard]] constexpr auto getPath() const noexcept {
             return this->Path;
         }
 
@@ -20,7 +20,7 @@ namespace MachO {
             InvalidPath
         };
     protected:
-        std::vector<std::unique_ptr<SharedLibraryInfo>> List;
+        std::vector<SharedLibraryInfo> List;
         SharedLibraryInfoCollection() noexcept = default;
     public:
         [[nodiscard]] static SharedLibraryInfoCollection
@@ -30,7 +30,7 @@ namespace MachO {
         [[nodiscard]] inline
         const SharedLibraryInfo &at(const uint64_t Index) const noexcept {
             assert(!IndexOutOfBounds(Index, this->size()));
-            return *List.at(Index).get();
+            return List.at(Index);
         }
 
         [[nodiscard]] inline
@@ -39,7 +39,7 @@ namespace MachO {
                 return nullptr;
             }
 
-            return List.at(Index).get();
+            return &List.at(Index);
         }
 
         [[nodiscard]] inline const SharedLibraryInfo &
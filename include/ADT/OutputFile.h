@@ -7,14 +7,23 @@
 //
 
 #pragma once
+
+#include <string>
+#include <string_view>
+
 #include "FileDescriptor.h"
 
+// Writes to a temporary file next to Path, which only replaces Path once
+// Finalize() is called. The temporary file is removed if the OutputFile is
+// destroyed before then.
+
 struct OutputFile {
 protected:
-    char *TmpPath;
+    std::string Path;
+    std::string TmpPath;
     FileDescriptor Tmp;
 public:
-    explicit OutputFile() noexcept;
+    explicit OutputFile(std::string_view Path, int Mode = 0644) noexcept;
     ~OutputFile() noexcept;
 
     [[nodiscard]] inline bool isOpen() const noexcept { return Tmp.isOpen(); }
@@ -25,8 +34,19 @@ public:
 
     bool Read(void *Buf, size_t Size) const noexcept;
     bool Write(const void *Buf, size_t Size) noexcept;
+    bool WriteAt(const void *Buf, size_t Size, uint64_t Offset) noexcept;
     bool TruncateToSize(uint64_t Length) noexcept;
 
-    bool Finalize(const char *Path) noexcept;
+    // Copies Size bytes at SrcOffset of SrcFd to the start of the file,
+    // without the data passing through user-space.
+    //
+    // The range is reflinked on filesystems that support it, and otherwise
+    // copied in the kernel. Returns false, with errno set, if neither is
+    // possible, in which case the caller should write the data itself.
+
+    bool
+    CopyRangeFrom(int SrcFd, uint64_t SrcOffset, uint64_t Size) noexcept;
+
+    bool Finalize() noexcept;
     inline void Close() noexcept { Tmp.Close(); }
 };
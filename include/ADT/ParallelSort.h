@@ -0,0 +1,123 @@
+//
+//  ADT/ParallelSort.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+// Lists smaller than this are sorted on the calling thread, as the cost of
+// starting threads outweighs any gain from splitting the sort.
+
+constexpr static auto ParallelSortThreshold = uint64_t(1) << 15;
+
+// Merge-sort that sorts equal chunks of the list on separate threads, then
+// merges neighboring chunks in parallel until one sorted list is left.
+
+template <std::random_access_iterator Iter, typename Comparator>
+void
+ParallelSort(const Iter Begin,
+             const Iter End,
+             const Comparator &Comp) noexcept
+{
+    const auto Size = static_cast<uint64_t>(End - Begin);
+    const auto HardwareCount =
+        static_cast<uint64_t>(std::thread::hardware_concurrency());
+
+    if (Size < ParallelSortThreshold || HardwareCount < 2) {
+        std::sort(Begin, End, Comp);
+        return;
+    }
+
+    // Use a power-of-two amount of chunks so each merge-round pairs up every
+    // chunk.
+
+    const auto ChunkCount =
+        std::bit_floor(std::min(HardwareCount, Size / ParallelSortThreshold));
+
+    if (ChunkCount < 2) {
+        std::sort(Begin, End, Comp);
+        return;
+    }
+
+    const auto ChunkSize = Size / ChunkCount;
+    const auto GetChunkBegin = [&](const uint64_t Index) noexcept {
+        return (Index < ChunkCount) ? Begin + Index * ChunkSize : End;
+    };
+
+    auto ThreadList = std::vector<std::thread>();
+    ThreadList.reserve(ChunkCount);
+
+    for (auto I = uint64_t(); I != ChunkCount; I++) {
+        ThreadList.emplace_back([&, I]() noexcept {
+            std::sort(GetChunkBegin(I), GetChunkBegin(I + 1), Comp);
+        });
+    }
+
+    for (auto &Thread : ThreadList) {
+        Thread.join();
+    }
+
+    for (auto Width = uint64_t(1); Width < ChunkCount; Width *= 2) {
+        ThreadList.clear();
+        for (auto I = uint64_t(); I < ChunkCount; I += Width * 2) {
+            ThreadList.emplace_back([&, I]() noexcept {
+                std::inplace_merge(GetChunkBegin(I),
+                                   GetChunkBegin(I + Width),
+                                   GetChunkBegin(I + Width * 2),
+                                   Comp);
+            });
+        }
+
+        for (auto &Thread : ThreadList) {
+            Thread.join();
+        }
+    }
+}
+
+// Comparison-function for a single sort-kind, returning a negative number,
+// zero, or a positive number, as with strcmp().
+
+template <typename T>
+using SortCompareFunc = int (*)(const T &Lhs, const T &Rhs) noexcept;
+
+// Sorts with a comparison-function known at compile-time, so that each
+// comparison can be inlined.
+
+template <auto Func, std::random_access_iterator Iter>
+inline void ParallelSortWithFunc(const Iter Begin, const Iter End) noexcept {
+    ParallelSort(Begin, End, [](const auto &Lhs, const auto &Rhs) noexcept {
+        return Func(Lhs, Rhs) < 0;
+    });
+}
+
+// Sorts by every comparison-function in the list, in order, with each later
+// function breaking ties from the ones before it.
+
+template <std::random_access_iterator Iter, typename T>
+void
+ParallelSortWithFuncList(const Iter Begin,
+                         const Iter End,
+                         const std::vector<SortCompareFunc<T>> &FuncList)
+    noexcept
+{
+    ParallelSort(Begin, End, [&](const auto &Lhs, const auto &Rhs) noexcept {
+        for (const auto &Func : FuncList) {
+            const auto Compare = Func(Lhs, Rhs);
+            if (Compare != 0) {
+                return (Compare < 0);
+            }
+        }
+
+        return false;
+    });
+}
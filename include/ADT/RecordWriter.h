@@ -0,0 +1,121 @@
+//
+//  ADT/RecordWriter.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <variant>
+
+#include "ADT/ColumnarWriter.h"
+#include "ADT/JsonWriter.h"
+
+// Forwards a list of records to either a JsonWriter or a ColumnarWriter, so
+// that operations describe each record once for every structured
+// output-format.
+
+struct RecordWriter {
+protected:
+    std::variant<JsonWriter, ColumnarWriter> Writer;
+public:
+    explicit RecordWriter(JsonWriter &&Writer) noexcept
+    : Writer(std::move(Writer)) {}
+
+    explicit RecordWriter(ColumnarWriter &&Writer) noexcept
+    : Writer(std::move(Writer)) {}
+
+    [[nodiscard]] inline auto getRecordCount() const noexcept {
+        return std::visit([](const auto &Writer) noexcept {
+            return Writer.getRecordCount();
+        }, this->Writer);
+    }
+
+    inline auto beginList() noexcept -> decltype(*this) {
+        std::visit([](auto &Writer) noexcept {
+            Writer.beginList();
+        }, this->Writer);
+
+        return *this;
+    }
+
+    inline auto endList() noexcept -> decltype(*this) {
+        std::visit([](auto &Writer) noexcept {
+            Writer.endList();
+        }, this->Writer);
+
+        return *this;
+    }
+
+    inline auto beginRecord() noexcept -> decltype(*this) {
+        std::visit([](auto &Writer) noexcept {
+            Writer.beginRecord();
+        }, this->Writer);
+
+        return *this;
+    }
+
+    inline auto endRecord() noexcept -> decltype(*this) {
+        std::visit([](auto &Writer) noexcept {
+            Writer.endRecord();
+        }, this->Writer);
+
+        return *this;
+    }
+
+    inline auto
+    writeString(const std::string_view Key,
+                const std::string_view Value) noexcept -> decltype(*this)
+    {
+        std::visit([&](auto &Writer) noexcept {
+            Writer.writeString(Key, Value);
+        }, this->Writer);
+
+        return *this;
+    }
+
+    inline auto
+    writeNumber(const std::string_view Key, const uint64_t Value) noexcept
+        -> decltype(*this)
+    {
+        std::visit([&](auto &Writer) noexcept {
+            Writer.writeNumber(Key, Value);
+        }, this->Writer);
+
+        return *this;
+    }
+
+    inline auto
+    writeSignedNumber(const std::string_view Key, const int64_t Value) noexcept
+        -> decltype(*this)
+    {
+        std::visit([&](auto &Writer) noexcept {
+            Writer.writeSignedNumber(Key, Value);
+        }, this->Writer);
+
+        return *this;
+    }
+
+    inline auto
+    writeBool(const std::string_view Key, const bool Value) noexcept
+        -> decltype(*this)
+    {
+        std::visit([&](auto &Writer) noexcept {
+            Writer.writeBool(Key, Value);
+        }, this->Writer);
+
+        return *this;
+    }
+
+    inline auto writeNull(const std::string_view Key) noexcept
+        -> decltype(*this)
+    {
+        std::visit([&](auto &Writer) noexcept {
+            Writer.writeNull(Key);
+        }, this->Writer);
+
+        return *this;
+    }
+};
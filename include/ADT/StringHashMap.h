@@ -0,0 +1,186 @@
+//
+//  ADT/StringHashMap.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+// Hash-map from strings to values, using open-addressing with linear probing.
+// Strings aren't copied, and so have to outlive the map.
+//
+// Entries are stored contiguously in the order they were added, with the table
+// only storing an entry's index alongside 32 bits of its hash. Growing the
+// table therefore never moves an entry, and most mismatched slots are skipped
+// without comparing any strings.
+
+template <typename T>
+struct StringHashMap {
+public:
+    struct Entry {
+        std::string_view Key;
+        T Value;
+    };
+protected:
+    struct Slot {
+        uint32_t Index;
+        uint32_t Tag;
+    };
+
+    constexpr static auto EmptyIndex = UINT32_MAX;
+    constexpr static auto MinSlotCount = uint64_t(64);
+
+    std::vector<Entry> EntryList;
+    std::vector<uint64_t> HashList;
+    std::vector<Slot> SlotList;
+
+    [[nodiscard]]
+    static inline uint64_t Hash(const std::string_view Key) noexcept {
+        return std::hash<std::string_view>()(Key);
+    }
+
+    [[nodiscard]] static inline uint32_t GetTag(const uint64_t Hash) noexcept {
+        return static_cast<uint32_t>(Hash >> 32);
+    }
+
+    [[nodiscard]] inline auto getSlotMask() const noexcept {
+        return this->SlotList.size() - 1;
+    }
+
+    void insertIntoSlotList(const uint32_t Index) noexcept {
+        const auto Hash = this->HashList[Index];
+        const auto Mask = this->getSlotMask();
+
+        auto SlotIndex = Hash & Mask;
+        while (this->SlotList[SlotIndex].Index != EmptyIndex) {
+            SlotIndex = (SlotIndex + 1) & Mask;
+        }
+
+        this->SlotList[SlotIndex] = Slot {
+            .Index = Index,
+            .Tag = GetTag(Hash)
+        };
+    }
+
+    // Keeps the table at most half-full, so probe-sequences stay short.
+    void growIfNeeded() noexcept {
+        if ((this->EntryList.size() + 1) * 2 <= this->SlotList.size()) {
+            return;
+        }
+
+        const auto SlotCount =
+            this->SlotList.empty() ? MinSlotCount : this->SlotList.size() * 2;
+
+        const auto EmptySlot = Slot { .Index = EmptyIndex, .Tag = 0 };
+        this->SlotList.assign(SlotCount, EmptySlot);
+
+        for (auto I = uint32_t(); I != this->EntryList.size(); I++) {
+            this->insertIntoSlotList(I);
+        }
+    }
+
+    [[nodiscard]] auto
+    findIndex(const std::string_view Key, const uint64_t Hash) const noexcept
+        -> uint32_t
+    {
+        if (this->SlotList.empty()) {
+            return EmptyIndex;
+        }
+
+        const auto Mask = this->getSlotMask();
+        const auto Tag = GetTag(Hash);
+
+        for (auto SlotIndex = Hash & Mask;;
+             SlotIndex = (SlotIndex + 1) & Mask)
+        {
+            const auto &Slot = this->SlotList[SlotIndex];
+            if (Slot.Index == EmptyIndex) {
+                return EmptyIndex;
+            }
+
+            if (Slot.Tag == Tag && this->EntryList[Slot.Index].Key == Key) {
+                return Slot.Index;
+            }
+        }
+    }
+public:
+    StringHashMap() noexcept = default;
+
+    [[nodiscard]] inline auto size() const noexcept {
+        return this->EntryList.size();
+    }
+
+    [[nodiscard]] inline auto empty() const noexcept {
+        return this->EntryList.empty();
+    }
+
+    [[nodiscard]] inline auto begin() const noexcept {
+        return this->EntryList.cbegin();
+    }
+
+    [[nodiscard]] inline auto end() const noexcept {
+        return this->EntryList.cend();
+    }
+
+    [[nodiscard]] inline auto begin() noexcept {
+        return this->EntryList.begin();
+    }
+
+    [[nodiscard]] inline auto end() noexcept {
+        return this->EntryList.end();
+    }
+
+    [[nodiscard]] inline auto &getEntryList() const noexcept {
+        return this->EntryList;
+    }
+
+    [[nodiscard]]
+    inline auto find(const std::string_view Key) const noexcept -> const T * {
+        const auto Index = this->findIndex(Key, Hash(Key));
+        if (Index == EmptyIndex) {
+            return nullptr;
+        }
+
+        return &this->EntryList[Index].Value;
+    }
+
+    // Returns the value for Key, adding a default-constructed value if Key
+    // wasn't already in the map.
+
+    [[nodiscard]] auto
+    getOrInsert(const std::string_view Key, bool *const InsertedOut = nullptr)
+        noexcept -> T &
+    {
+        const auto Hash = StringHashMap::Hash(Key);
+        if (const auto Index = this->findIndex(Key, Hash);
+            Index != EmptyIndex)
+        {
+            if (InsertedOut != nullptr) {
+                *InsertedOut = false;
+            }
+
+            return this->EntryList[Index].Value;
+        }
+
+        this->growIfNeeded();
+
+        const auto Index = static_cast<uint32_t>(this->EntryList.size());
+
+        this->EntryList.emplace_back(Entry { .Key = Key, .Value = T() });
+        this->HashList.emplace_back(Hash);
+        this->insertIntoSlotList(Index);
+
+        if (InsertedOut != nullptr) {
+            *InsertedOut = true;
+        }
+
+        return this->EntryList.back().Value;
+    }
+};
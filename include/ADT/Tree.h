@@ -8,7 +8,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
 #include <vector>
+
 #include "Utils/PrintUtils.h"
 
 struct TreeNode;
@@ -690,3 +695,316 @@ public:
         return *this;
     }
 };
+
+// A tree whose nodes are stored by value in one vector, in depth-first order,
+// and link to each other with 32-bit indices instead of pointers.
+//
+// Nodes must be added in depth-first order, which lets a node's first child be
+// found at the next index, and makes walking the tree a linear scan.
+
+template <typename T>
+struct IndexedTree {
+public:
+    using IndexType = uint32_t;
+    constexpr static auto NullIndex = std::numeric_limits<IndexType>::max();
+
+    struct Node {
+        IndexType Parent = NullIndex;
+        IndexType NextSibling = NullIndex;
+        uint32_t DepthLevel = 1;
+
+        T Value;
+
+        [[nodiscard]] constexpr auto isRoot() const noexcept {
+            return this->Parent == NullIndex;
+        }
+
+        [[nodiscard]] constexpr auto hasNextSibling() const noexcept {
+            return this->NextSibling != NullIndex;
+        }
+    };
+
+    using NodeListType = std::vector<Node>;
+protected:
+    NodeListType NodeList;
+public:
+    IndexedTree() noexcept = default;
+
+    [[nodiscard]] inline auto size() const noexcept {
+        return this->NodeList.size();
+    }
+
+    [[nodiscard]] inline auto empty() const noexcept {
+        return this->NodeList.empty();
+    }
+
+    inline auto reserve(const uint64_t Size) noexcept -> decltype(*this) {
+        this->NodeList.reserve(Size);
+        return *this;
+    }
+
+    [[nodiscard]] inline auto &at(const IndexType Index) noexcept {
+        assert(Index < this->size());
+        return this->NodeList[Index];
+    }
+
+    [[nodiscard]] inline auto &at(const IndexType Index) const noexcept {
+        assert(Index < this->size());
+        return this->NodeList[Index];
+    }
+
+    [[nodiscard]] inline auto begin() noexcept {
+        return this->NodeList.begin();
+    }
+
+    [[nodiscard]] inline auto end() noexcept {
+        return this->NodeList.end();
+    }
+
+    [[nodiscard]] inline auto begin() const noexcept {
+        return this->NodeList.cbegin();
+    }
+
+    [[nodiscard]] inline auto end() const noexcept {
+        return this->NodeList.cend();
+    }
+
+    [[nodiscard]]
+    inline auto getFirstChild(const IndexType Index) const noexcept
+        -> IndexType
+    {
+        const auto Next = Index + 1;
+        if (Next < this->size() && this->NodeList[Next].Parent == Index) {
+            return Next;
+        }
+
+        return NullIndex;
+    }
+
+    [[nodiscard]] inline auto isLeaf(const IndexType Index) const noexcept {
+        return this->getFirstChild(Index) == NullIndex;
+    }
+
+    // Parent must be NullIndex, for a root, or the last node added or one of
+    // its ancestors.
+
+    auto AddNode(const IndexType Parent, T Value) noexcept -> IndexType {
+        assert(this->size() < NullIndex);
+
+        const auto Index = static_cast<IndexType>(this->size());
+        auto DepthLevel = uint32_t(1);
+
+        if (Parent != NullIndex) {
+            assert(Parent < Index);
+            DepthLevel = this->NodeList[Parent].DepthLevel + 1;
+        }
+
+        // The previous sibling, if there is one, is the last node added, or
+        // the ancestor of it that is also a child of Parent.
+
+        for (auto Prev = Index - 1; Index != 0 && Prev != Parent;) {
+            auto &PrevNode = this->NodeList[Prev];
+            if (PrevNode.Parent == Parent) {
+                PrevNode.NextSibling = Index;
+                break;
+            }
+
+            Prev = PrevNode.Parent;
+            if (Prev == NullIndex) {
+                break;
+            }
+        }
+
+        this->NodeList.emplace_back(Node {
+            .Parent = Parent,
+            .NextSibling = NullIndex,
+            .DepthLevel = DepthLevel,
+            .Value = std::move(Value)
+        });
+
+        return Index;
+    }
+
+    // Remove every node ShouldRemove() returns true for, moving its children
+    // up into its place. If RemoveParentLeafs is true, a node left without any
+    // children is removed as well.
+
+    template <typename Predicate>
+    auto
+    RemoveIf(const Predicate &ShouldRemove,
+             const bool RemoveParentLeafs) noexcept -> decltype(*this)
+    {
+        const auto Size = static_cast<IndexType>(this->size());
+
+        auto RemoveList = std::vector<bool>(Size);
+        auto KeptCountList = std::vector<IndexType>(Size);
+
+        // Children are stored after their parent, so walking backwards decides
+        // every child before its parent.
+
+        for (auto Index = Size; Index-- != 0;) {
+            const auto &Node = this->NodeList[Index];
+
+            auto Remove = static_cast<bool>(ShouldRemove(Node.Value));
+            if (!Remove && RemoveParentLeafs && !this->isLeaf(Index)) {
+                Remove = (KeptCountList[Index] == 0);
+            }
+
+            RemoveList[Index] = Remove;
+            if (!Node.isRoot()) {
+                KeptCountList[Node.Parent] +=
+                    KeptCountList[Index] + (Remove ? 0 : 1);
+            }
+        }
+
+        // Map each node to its new index, or, for a removed node, to the new
+        // index of its closest kept ancestor, which its children move up to.
+
+        auto Result = IndexedTree();
+        auto NewIndexList = std::vector<IndexType>(Size);
+
+        for (auto Index = IndexType(); Index != Size; Index++) {
+            auto &Node = this->NodeList[Index];
+            const auto Parent =
+                Node.isRoot() ? NullIndex : NewIndexList[Node.Parent];
+
+            if (RemoveList[Index]) {
+                NewIndexList[Index] = Parent;
+                continue;
+            }
+
+            NewIndexList[Index] = Result.AddNode(Parent, std::move(Node.Value));
+        }
+
+        this->NodeList = std::move(Result.NodeList);
+        return *this;
+    }
+
+    // Order the children of every node with IsLessThan(), keeping children
+    // that compare equal in their current order.
+
+    template <typename Comparator>
+    auto Sort(const Comparator &IsLessThan) noexcept -> decltype(*this) {
+        auto Result = IndexedTree();
+        Result.reserve(this->size());
+
+        // Holds a node's index, and the new index of its parent.
+        auto StackList = std::vector<std::pair<IndexType, IndexType>>();
+        auto ChildList = std::vector<IndexType>();
+
+        const auto PushSortedSiblings =
+            [&](const IndexType First, const IndexType NewParent) noexcept
+        {
+            ChildList.clear();
+            for (auto Index = First;
+                 Index != NullIndex;
+                 Index = this->NodeList[Index].NextSibling)
+            {
+                ChildList.emplace_back(Index);
+            }
+
+            std::stable_sort(ChildList.begin(),
+                             ChildList.end(),
+                             [&](const IndexType Lhs,
+                                 const IndexType Rhs) noexcept
+            {
+                return IsLessThan(this->NodeList[Lhs].Value,
+                                  this->NodeList[Rhs].Value);
+            });
+
+            for (auto Iter = ChildList.rbegin();
+                 Iter != ChildList.rend();
+                 Iter++)
+            {
+                StackList.emplace_back(*Iter, NewParent);
+            }
+        };
+
+        if (!this->empty()) {
+            PushSortedSiblings(0, NullIndex);
+        }
+
+        while (!StackList.empty()) {
+            const auto [Index, NewParent] = StackList.back();
+            StackList.pop_back();
+
+            const auto NewIndex =
+                Result.AddNode(NewParent,
+                               std::move(this->NodeList[Index].Value));
+
+            if (const auto First = this->getFirstChild(Index);
+                First != NullIndex)
+            {
+                PushSortedSiblings(First, NewIndex);
+            }
+        }
+
+        this->NodeList = std::move(Result.NodeList);
+        return *this;
+    }
+
+    template <typename NodePrinter>
+    auto
+    PrintHorizontal(FILE *const OutFile,
+                    const int TabLength,
+                    const NodePrinter &NodePrinterFunc) const noexcept
+        -> decltype(*this)
+    {
+        const auto RootDepthLevel = static_cast<uint64_t>(1);
+
+        // Whether the ancestor at each depth-level of the current node has a
+        // next-sibling, which decides if a "│" is drawn in its column.
+
+        auto HasNextSiblingList = std::vector<bool>();
+        for (const auto &Node : this->NodeList) {
+            const auto DepthLevel = static_cast<uint64_t>(Node.DepthLevel);
+            if (HasNextSiblingList.size() <= DepthLevel) {
+                HasNextSiblingList.resize(DepthLevel + 1);
+            }
+
+            HasNextSiblingList[DepthLevel] = Node.hasNextSibling();
+            if (DepthLevel == RootDepthLevel) {
+                if (NodePrinterFunc(OutFile, 0, RootDepthLevel, Node.Value)) {
+                    fputc('\n', OutFile);
+                }
+
+                continue;
+            }
+
+            auto WrittenOut = int();
+            for (auto I = RootDepthLevel + 1; I != DepthLevel; I++) {
+                if (HasNextSiblingList[I]) {
+                    fputs("│", OutFile);
+
+                    WrittenOut += 1;
+                    WrittenOut += PrintUtilsPadSpaces(OutFile, TabLength - 1);
+                } else {
+                    WrittenOut += PrintUtilsPadSpaces(OutFile, TabLength);
+                }
+            }
+
+            WrittenOut += 1;
+            if (Node.hasNextSibling()) {
+                fputs("├", OutFile);
+            } else {
+                fputs("└", OutFile);
+            }
+
+            // Subtract 1 for the ├ or └ character, and 1 for the space in
+            // between the "----" and the node-printer's string.
+
+            const auto DashCount = (TabLength - 2);
+            WrittenOut += DashCount;
+
+            PrintUtilsStringMultTimes(OutFile, "─", DashCount);
+            fputc(' ', OutFile);
+
+            WrittenOut += 1;
+
+            NodePrinterFunc(OutFile, WrittenOut, DepthLevel, Node.Value);
+            fputc('\n', OutFile);
+        }
+
+        return *this;
+    }
+};
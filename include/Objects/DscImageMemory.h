@@ -8,7 +8,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include "ADT/DyldSharedCache/Headers.h"
+#include "ADT/DyldSharedCache/RebasedView.h"
 #include "MachOMemory.h"
 
 struct DscImageMemoryObject : public MachOMemoryObject {
@@ -19,10 +22,16 @@ protected:
     MemoryMap DscMap;
     const DyldSharedCache::ImageInfo &ImageInfo;
 
+    // The rebased-view of the cache the image was opened from.
+    std::shared_ptr<const DyldSharedCache::RebasedView> RebasedView;
+
     DscImageMemoryObject(const MemoryMap &DscMap,
                          const DyldSharedCache::ImageInfo &ImageInfo,
+                         std::shared_ptr<const DyldSharedCache::RebasedView>
+                            RebasedView,
                          uint8_t *Begin,
-                         uint8_t *End) noexcept;
+                         uint8_t *End,
+                         MachO::LoadCommandIndex &&LoadCmdIndex) noexcept;
 public:
     [[nodiscard]]
     static inline auto IsOfKind(const MemoryObject &Obj) noexcept {
@@ -39,6 +48,10 @@ public:
         return DscMap;
     }
 
+    [[nodiscard]] inline auto &getRebasedView() const noexcept {
+        return RebasedView;
+    }
+
     [[nodiscard]] inline auto getDscRange() const noexcept {
         return this->getDscMap().getRange();
     }
@@ -8,8 +8,12 @@
 
 #pragma once
 
+#include <memory>
+
 #include "ADT/DyldSharedCache/Headers.h"
+#include "ADT/DyldSharedCache/RebasedView.h"
 #include "ADT/ExpectedPointer.h"
+#include "ADT/Mach-O/LoadCommandIndex.h"
 
 #include "ADT/Mach/Info.h"
 #include "MemoryBase.h"
@@ -63,12 +67,21 @@ protected:
 
     uint8_t *End;
 
+    // Also builds the image's load-command index, so the image doesn't have
+    // to walk its load-commands again once opened.
+
     [[nodiscard]] static auto
-    ValidateImageMapAndGetEnd(const ConstMemoryMap &Map) noexcept
+    ValidateImageMapAndGetEnd(const ConstMemoryMap &Map,
+                              MachO::LoadCommandIndex &LoadCmdIndexOut) noexcept
         -> ExpectedPointer<const uint8_t, DscImageOpenError>;
 
     CpuKind sCpuKind;
 
+    // Created with the object, and shared with every image opened from the
+    // cache, so each page is only decoded once.
+
+    std::shared_ptr<const DyldSharedCache::RebasedView> RebasedView;
+
     explicit DscMemoryObject(const MemoryMap &Map, CpuKind CpuKind) noexcept;
 
     [[nodiscard]] constexpr auto getMutMap() const noexcept {
@@ -259,6 +272,10 @@ public:
         return this->getHeaderV8().ImagesCountOld;
     }
 
+    [[nodiscard]] inline auto &getRebasedView() const noexcept {
+        return this->RebasedView;
+    }
+
     [[nodiscard]] inline auto getMappingCount() const noexcept {
         return this->getHeaderV0().MappingCount;
     }
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "ADT/Mach-O/Headers.h"
+#include "ADT/Mach-O/LoadCommandIndex.h"
 #include "ADT/MemoryMap.h"
 
 #include "MemoryBase.h"
@@ -33,11 +34,18 @@ protected:
     };
 
     uint8_t *End;
+    MachO::LoadCommandIndex LoadCmdIndex;
+
     MachOMemoryObject(Error Error) noexcept;
 
-    explicit MachOMemoryObject(const MemoryMap &Map) noexcept;
     explicit
-    MachOMemoryObject(ObjectKind Kind, const MemoryMap &Map) noexcept;
+    MachOMemoryObject(const MemoryMap &Map,
+                      MachO::LoadCommandIndex &&LoadCmdIndex) noexcept;
+
+    explicit
+    MachOMemoryObject(ObjectKind Kind,
+                      const MemoryMap &Map,
+                      MachO::LoadCommandIndex &&LoadCmdIndex) noexcept;
 public:
     [[nodiscard]] static auto Open(const MemoryMap &Map) noexcept
         -> ExpectedPointer<MachOMemoryObject, Error>;
@@ -94,6 +102,13 @@ public:
         return this->getHeader().GetConstLoadCmdStorage(Verify);
     }
 
+    // Built once when the object is opened. Empty if the load-commands are
+    // invalid.
+
+    [[nodiscard]] inline auto &getLoadCommandIndex() const noexcept {
+        return this->LoadCmdIndex;
+    }
+
     [[nodiscard]] inline auto isBigEndian() const noexcept {
         return this->getConstHeader().isBigEndian();
     }
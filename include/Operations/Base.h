@@ -9,6 +9,7 @@
 #pragma once
 
 #include "ADT/ArgvArray.h"
+#include "ADT/RecordWriter.h"
 #include "Objects/MemoryBase.h"
 
 #include "Info.h"
@@ -17,6 +18,13 @@ using namespace std::literals;
 
 struct Operation {
 public:
+    enum class OutputFormat : uint8_t {
+        Default,
+        Json,
+        NdJson,
+        Binary
+    };
+
     struct Options {
     private:
         OperationKind Kind;
@@ -29,6 +37,34 @@ public:
         FILE *OutFile = stdout;
         FILE *ErrFile = stderr;
 
+        OutputFormat Format = OutputFormat::Default;
+
+        // Descriptor of the file the object was mapped from, for operations
+        // that copy parts of the file without reading them through the map.
+        // Set to -1 when there is no such file.
+
+        int InputFd = -1;
+
+        [[nodiscard]] constexpr auto isRecordFormat() const noexcept {
+            return Format != OutputFormat::Default;
+        }
+
+        [[nodiscard]] inline auto GetRecordWriter() const noexcept {
+            switch (Format) {
+                case OutputFormat::Default:
+                case OutputFormat::Json:
+                    return RecordWriter(
+                        JsonWriter(OutFile, JsonWriter::Style::Array));
+                case OutputFormat::NdJson:
+                    return RecordWriter(
+                        JsonWriter(OutFile, JsonWriter::Style::LineDelimited));
+                case OutputFormat::Binary:
+                    return RecordWriter(ColumnarWriter(OutFile));
+            }
+
+            assert(0 && "Unrecognized Output-Format");
+        }
+
         Options(const OperationKind Kind, FILE *const OutFile) noexcept
         : Kind(Kind), OutFile(OutFile) {}
 
@@ -69,6 +105,15 @@ public:
     static void
     PrintLineSpamWarning(FILE *const OutFile, uint64_t LineAmount) noexcept;
 
+    constexpr static auto OutputFormatOptionPrefix = "--format="sv;
+
+    // Parses an option of the form --format=<format>, exiting if the format is
+    // unrecognized.
+
+    [[nodiscard]] static OutputFormat
+    ParseOutputFormatOption(std::string_view Option,
+                            OperationKind ForKind) noexcept;
+
     static void
     PrintObjectKindNotSupportedError(OperationKind OpKind,
                                      const MemoryObject &Object) noexcept;
@@ -123,6 +168,9 @@ public:
     [[nodiscard]] static
     bool SupportsObjectKind(OperationKind OpKind, ObjectKind ObjKind) noexcept;
 
+    [[nodiscard]] static bool
+    SupportsOutputFormat(OperationKind OpKind, OutputFormat Format) noexcept;
+
     inline const Operation &
     printOptionHelpMenu(FILE *const OutFile,
                         const char *const Prefix = "",
@@ -190,6 +238,11 @@ public:
 
     virtual int ParseOptions(const ArgvArray &Argv) noexcept = 0;
     virtual int Run(const MemoryObject &Object) const noexcept = 0;
+
+    // Returns the options of the operation, so its output can be redirected
+    // before it's run.
+
+    [[nodiscard]] virtual Options &getOptions() noexcept = 0;
 };
 
 template <OperationKind Kind>
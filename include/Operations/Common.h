@@ -8,7 +8,13 @@
 
 #pragma once
 
+#include "ADT/DyldSharedCache/DependencyGraph.h"
+#include "ADT/DyldSharedCache/ObjcOpt.h"
+#include "ADT/DyldSharedCache/SymbolResolver.h"
+#include "ADT/RecordWriter.h"
 #include "ADT/MachO.h"
+
+#include "Objects/DscMemory.h"
 #include "Objects/MachOMemory.h"
 
 struct OperationCommon {
@@ -68,6 +74,28 @@ struct OperationCommon {
                           int64_t DylibOrdinal,
                           PrintKind Print) noexcept;
 
+    // Writes the "dylib_ordinal" and "dylib" fields of a record. Special
+    // ordinals are written with their name, and out-of-bounds ordinals with a
+    // null "dylib" field.
+
+    static void
+    WriteDylibOrdinalFields(
+        RecordWriter &Writer,
+        const MachO::SharedLibraryInfoCollection &Collection,
+        int64_t DylibOrdinal) noexcept;
+
+    static void
+    WriteSegmentSectionFields(RecordWriter &Writer,
+                              const MachO::SegmentInfo *Segment,
+                              const MachO::SectionInfo *Section) noexcept;
+
+    static void
+    WriteBindActionRecord(
+        RecordWriter &Writer,
+        const MachO::BindActionInfo &Action,
+        const MachO::SegmentInfoCollection &SegmentCollection,
+        const MachO::SharedLibraryInfoCollection &LibraryCollection) noexcept;
+
     static void
     ParseSegmentSectionPair(FILE *ErrFile,
                             std::string_view Pair,
@@ -80,6 +108,12 @@ struct OperationCommon {
         const MachO::ConstLoadCommandStorage &LoadCmdStorage,
         const MachO::DyldInfoCommand *&DyldInfoCommandOut) noexcept;
 
+    static int
+    GetDyldInfoCommand(
+        FILE *ErrFile,
+        const MachO::LoadCommandIndex &LoadCmdIndex,
+        const MachO::DyldInfoCommand *&DyldInfoCommandOut) noexcept;
+
     static int
     GetBindActionLists(
         FILE *ErrFile,
@@ -122,4 +156,44 @@ struct OperationCommon {
     static int
     HandleExportTrieParseError(FILE *const OutFile,
                                MachO::ExportTrieParseError ParseError) noexcept;
+
+    // Opens the Objective-C optimization-tables from libobjc's __objc_opt_ro
+    // section. Errors are only printed if ErrFile isn't null.
+
+    static int
+    GetDscObjcOptInfo(
+        FILE *ErrFile,
+        const DscMemoryObject &Object,
+        std::optional<DyldSharedCache::ObjcOptInfo> &InfoOut) noexcept;
+
+    // Builds the graph of the libraries loaded by every image of a
+    // dyld_shared_cache, with a node for every image-info, parsing images in
+    // parallel. Edges always point to the first image-info of an image, so
+    // aliases are left without any edges, and libraries outside the cache are
+    // left out.
+    //
+    // Returns the amount of images that could not be parsed.
+
+    static uint32_t
+    GetDscDependencyGraph(const DscMemoryObject &Object,
+                          DyldSharedCache::DependencyGraph &GraphOut) noexcept;
+
+    // Indexes the export-trie of an image, or returns an empty index if the
+    // image has no export-trie, or if its export-trie is out of bounds.
+
+    [[nodiscard]] static auto
+    GetExportIndex(
+        const ConstMemoryMap &Map,
+        const MachO::ConstLoadCommandStorage &LoadCmdStorage) noexcept
+            -> DyldSharedCache::ExportIndex;
+
+    // Creates a resolver of symbols across the images of a dyld_shared_cache,
+    // with a node for every image-info. Images are parsed, and their
+    // export-tries indexed, the first time a symbol is looked up in them.
+    //
+    // The resolver refers to the object, and so must not outlive it.
+
+    [[nodiscard]] static auto
+    CreateDscSymbolResolver(const DscMemoryObject &Object) noexcept
+        -> DyldSharedCache::SymbolResolver;
 };
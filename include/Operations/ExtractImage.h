@@ -0,0 +1,82 @@
+//
+//  Operations/ExtractImage.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <string_view>
+
+#include "Objects/DscImageMemory.h"
+#include "Objects/DscMemory.h"
+
+#include "Base.h"
+
+struct ExtractImageOperation : public Operation {
+public:
+    constexpr static auto OpKind = OperationKind::ExtractImage;
+
+    [[nodiscard]]
+    constexpr static auto IsOfKind(const Operation::Options &Opt) noexcept {
+        return Opt.getKind() == OpKind;
+    }
+
+    struct Options : public Operation::Options {
+        [[nodiscard]]
+        constexpr static auto IsOfKind(const Operation::Options &Opt) noexcept {
+            return Opt.getKind() == OpKind;
+        }
+
+        Options() noexcept : Operation::Options(OpKind) {}
+
+        // Path of the Mach-O file to write a single image to.
+        std::string_view OutputPath;
+
+        // Directory to write every image of a cache to, at the image's path
+        // within the directory.
+
+        std::string_view OutputDirectory;
+        bool Verbose : 1 = false;
+    };
+protected:
+    Options Options;
+public:
+    ExtractImageOperation() noexcept;
+    ExtractImageOperation(const struct Options &Options) noexcept;
+
+    static int
+    Run(const DscImageMemoryObject &Object,
+        const struct Options &Options) noexcept;
+
+    static int
+    Run(const DscMemoryObject &Object, const struct Options &Options) noexcept;
+
+    [[nodiscard]] static struct Options
+    ParseOptionsImpl(const ArgvArray &Argv, int *IndexOut) noexcept;
+
+    int ParseOptions(const ArgvArray &Argv) noexcept override;
+    int Run(const MemoryObject &Object) const noexcept override;
+
+    [[nodiscard]] inline struct Options &getOptions() noexcept override {
+        return Options;
+    }
+
+    [[nodiscard]]
+    constexpr static auto SupportsObjectKind(const ObjectKind Kind) noexcept {
+        switch (Kind) {
+            case ObjectKind::None:
+                assert(0 && "SupportsObjectKind() got Object-Kind None");
+            case ObjectKind::MachO:
+            case ObjectKind::FatMachO:
+                return false;
+            case ObjectKind::DyldSharedCache:
+            case ObjectKind::DscImage:
+                return true;
+        }
+
+        assert(0 && "Reached end of SupportsObjectKind()");
+    }
+};
@@ -28,6 +28,15 @@ struct PrintRebaseOpcodeListOperation;
 struct PrintCStringSectionOperation;
 struct PrintSymbolPtrSectionOperation;
 struct PrintImageListOperation;
+struct SearchCStringsOperation;
+struct PrintObjcMethodListOperation;
+struct PrintImageDependenciesOperation;
+struct PrintResolvedBindsOperation;
+struct PrintDiffOperation;
+struct PrintSlideInfoOperation;
+struct PrintSymbolListOperation;
+struct ExtractImageOperation;
+struct ThinArchOperation;
 
 using namespace std::literals;
 
@@ -154,6 +163,78 @@ struct OperationKindInfo<OperationKind::PrintImageList> {
     typedef PrintImageListOperation Type;
 };
 
+template<>
+struct OperationKindInfo<OperationKind::SearchCStrings> {
+    constexpr static auto Kind = OperationKind::SearchCStrings;
+    constexpr static auto Name = "search-c-strings"sv;
+
+    typedef SearchCStringsOperation Type;
+};
+
+template<>
+struct OperationKindInfo<OperationKind::PrintObjcMethodList> {
+    constexpr static auto Kind = OperationKind::PrintObjcMethodList;
+    constexpr static auto Name = "print-objc-method-list"sv;
+
+    typedef PrintObjcMethodListOperation Type;
+};
+
+template<>
+struct OperationKindInfo<OperationKind::PrintImageDependencies> {
+    constexpr static auto Kind = OperationKind::PrintImageDependencies;
+    constexpr static auto Name = "print-image-dependencies"sv;
+
+    typedef PrintImageDependenciesOperation Type;
+};
+
+template<>
+struct OperationKindInfo<OperationKind::PrintResolvedBinds> {
+    constexpr static auto Kind = OperationKind::PrintResolvedBinds;
+    constexpr static auto Name = "print-resolved-binds"sv;
+
+    typedef PrintResolvedBindsOperation Type;
+};
+
+template<>
+struct OperationKindInfo<OperationKind::PrintDiff> {
+    constexpr static auto Kind = OperationKind::PrintDiff;
+    constexpr static auto Name = "print-diff"sv;
+
+    typedef PrintDiffOperation Type;
+};
+
+template<>
+struct OperationKindInfo<OperationKind::PrintSlideInfo> {
+    constexpr static auto Kind = OperationKind::PrintSlideInfo;
+    constexpr static auto Name = "print-slide-info"sv;
+
+    typedef PrintSlideInfoOperation Type;
+};
+
+template<>
+struct OperationKindInfo<OperationKind::PrintSymbolList> {
+    constexpr static auto Kind = OperationKind::PrintSymbolList;
+    constexpr static auto Name = "print-symbol-list"sv;
+
+    typedef PrintSymbolListOperation Type;
+};
+
+template<>
+struct OperationKindInfo<OperationKind::ExtractImage> {
+    constexpr static auto Kind = OperationKind::ExtractImage;
+    constexpr static auto Name = "extract-image"sv;
+
+    typedef ExtractImageOperation Type;
+};
+
+template<>
+struct OperationKindInfo<OperationKind::ThinArch> {
+    constexpr static auto Kind = OperationKind::ThinArch;
+    constexpr static auto Name = "thin-arch"sv;
+
+    typedef ThinArchOperation Type;
+};
+
 [[nodiscard]] constexpr auto
 OperationKindGetOptionShortName(const OperationKind Kind) noexcept
     -> std::optional<std::string_view>
@@ -180,6 +261,15 @@ OperationKindGetOptionShortName(const OperationKind Kind) noexcept
         case OperationKind::PrintCStringSection:
         case OperationKind::PrintSymbolPtrSection:
         case OperationKind::PrintImageList:
+        case OperationKind::SearchCStrings:
+        case OperationKind::PrintObjcMethodList:
+        case OperationKind::PrintImageDependencies:
+        case OperationKind::PrintResolvedBinds:
+        case OperationKind::PrintDiff:
+        case OperationKind::PrintSlideInfo:
+        case OperationKind::PrintSymbolList:
+        case OperationKind::ExtractImage:
+        case OperationKind::ThinArch:
             return std::nullopt;
     }
 }
@@ -224,6 +314,25 @@ OperationKindGetName(const OperationKind Kind) noexcept
                 OperationKind::PrintSymbolPtrSection>::Name;
         case OperationKind::PrintImageList:
             return OperationKindInfo<OperationKind::PrintImageList>::Name;
+        case OperationKind::SearchCStrings:
+            return OperationKindInfo<OperationKind::SearchCStrings>::Name;
+        case OperationKind::PrintObjcMethodList:
+            return OperationKindInfo<OperationKind::PrintObjcMethodList>::Name;
+        case OperationKind::PrintImageDependencies:
+            return OperationKindInfo<
+                OperationKind::PrintImageDependencies>::Name;
+        case OperationKind::PrintResolvedBinds:
+            return OperationKindInfo<OperationKind::PrintResolvedBinds>::Name;
+        case OperationKind::PrintDiff:
+            return OperationKindInfo<OperationKind::PrintDiff>::Name;
+        case OperationKind::PrintSlideInfo:
+            return OperationKindInfo<OperationKind::PrintSlideInfo>::Name;
+        case OperationKind::PrintSymbolList:
+            return OperationKindInfo<OperationKind::PrintSymbolList>::Name;
+        case OperationKind::ExtractImage:
+            return OperationKindInfo<OperationKind::ExtractImage>::Name;
+        case OperationKind::ThinArch:
+            return OperationKindInfo<OperationKind::ThinArch>::Name;
     }
 
     assert(0 && "Reached end of OperationKindGetName()");
@@ -264,6 +373,24 @@ constexpr auto OperationKindGetOptionName(const OperationKind Kind) noexcept {
             return "list-symbol-ptr-section"sv;
         case OperationKind::PrintImageList:
             return "list-dsc-images"sv;
+        case OperationKind::SearchCStrings:
+            return "search-strings"sv;
+        case OperationKind::PrintObjcMethodList:
+            return "list-objc-methods"sv;
+        case OperationKind::PrintImageDependencies:
+            return "list-dependencies"sv;
+        case OperationKind::PrintResolvedBinds:
+            return "resolve-binds"sv;
+        case OperationKind::PrintDiff:
+            return "diff"sv;
+        case OperationKind::PrintSlideInfo:
+            return "list-slide-info"sv;
+        case OperationKind::PrintSymbolList:
+            return "list-symbols"sv;
+        case OperationKind::ExtractImage:
+            return "extract-image"sv;
+        case OperationKind::ThinArch:
+            return "thin"sv;
     }
 }
 
@@ -285,7 +412,8 @@ OperationKindGetDescription(const OperationKind Kind) noexcept {
         case OperationKind::PrintExportTrie:
             return "List Export-Trie of a Thin Mach-O File"sv;
         case OperationKind::PrintObjcClassList:
-            return "List Objc-Classes of a Thin Mach-O File"sv;
+            return "List Objc-Classes of a Thin Mach-O File or Dyld "
+                   "Shared-Cache"sv;
         case OperationKind::PrintBindActionList:
             return "List Bind-Actions of a Thin Mach-O File"sv;
         case OperationKind::PrintBindOpcodeList:
@@ -310,5 +438,28 @@ OperationKindGetDescription(const OperationKind Kind) noexcept {
         }
         case OperationKind::PrintImageList:
             return "List Images of a Dyld Shared-Cache File"sv;
+        case OperationKind::SearchCStrings:
+            return "Search C-Strings of every Image of a Dyld Shared-Cache "
+                   "File"sv;
+        case OperationKind::PrintObjcMethodList:
+            return "List Objc-Methods of a Thin Mach-O File or Dyld "
+                   "Shared-Cache"sv;
+        case OperationKind::PrintImageDependencies:
+            return "List Dependencies of Images of a Dyld Shared-Cache "
+                   "File"sv;
+        case OperationKind::PrintResolvedBinds:
+            return "Resolve Binds of Images of a Dyld Shared-Cache File"sv;
+        case OperationKind::PrintDiff:
+            return "Compare two Mach-O or Dyld Shared-Cache Files"sv;
+        case OperationKind::PrintSlideInfo:
+            return "List Slide-Info of a Dyld Shared-Cache File"sv;
+        case OperationKind::PrintSymbolList:
+            return "List Symbols of a Mach-O File or Dyld Shared-Cache "
+                   "Image"sv;
+        case OperationKind::ExtractImage:
+            return "Extract Images of a Dyld Shared-Cache File into Mach-O "
+                   "Files"sv;
+        case OperationKind::ThinArch:
+            return "Extract an Arch of a FAT Mach-O File into a Mach-O File"sv;
     }
 }
@@ -11,19 +11,28 @@
 enum class OperationKind {
     None,
 
-    PrintHeader           = (1ull << 1),
-    PrintLoadCommands     = (2ull << 1),
-    PrintSharedLibraries  = (3ull << 1),
-    PrintId               = (4ull << 1),
-    PrintArchList         = (5ull << 1),
-    PrintExportTrie       = (6ull << 1),
-    PrintObjcClassList    = (7ull << 1),
-    PrintBindActionList   = (8ull << 1),
-    PrintBindOpcodeList   = (9ull << 1),
-    PrintBindSymbolList   = (10ull << 1),
-    PrintRebaseActionList = (11ull << 1),
-    PrintRebaseOpcodeList = (12ull << 1),
-    PrintCStringSection   = (13ull << 1),
-    PrintSymbolPtrSection = (14ull << 1),
-    PrintImageList        = (15ull << 1)
+    PrintHeader            = (1ull << 1),
+    PrintLoadCommands      = (2ull << 1),
+    PrintSharedLibraries   = (3ull << 1),
+    PrintId                = (4ull << 1),
+    PrintArchList          = (5ull << 1),
+    PrintExportTrie        = (6ull << 1),
+    PrintObjcClassList     = (7ull << 1),
+    PrintBindActionList    = (8ull << 1),
+    PrintBindOpcodeList    = (9ull << 1),
+    PrintBindSymbolList    = (10ull << 1),
+    PrintRebaseActionList  = (11ull << 1),
+    PrintRebaseOpcodeList  = (12ull << 1),
+    PrintCStringSection    = (13ull << 1),
+    PrintSymbolPtrSection  = (14ull << 1),
+    PrintImageList         = (15ull << 1),
+    SearchCStrings         = (16ull << 1),
+    PrintObjcMethodList    = (17ull << 1),
+    PrintImageDependencies = (18ull << 1),
+    PrintResolvedBinds     = (19ull << 1),
+    PrintDiff              = (20ull << 1),
+    PrintSlideInfo         = (21ull << 1),
+    PrintSymbolList        = (22ull << 1),
+    ExtractImage           = (23ull << 1),
+    ThinArch               = (24ull << 1)
 };
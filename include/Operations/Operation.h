@@ -24,3 +24,12 @@
 #include "PrintCStringSection.h"
 #include "PrintSymbolPtrSection.h"
 #include "PrintImageList.h"
+#include "SearchCStrings.h"
+#include "PrintObjcMethodList.h"
+#include "PrintImageDependencies.h"
+#include "PrintResolvedBinds.h"
+#include "PrintDiff.h"
+#include "PrintSlideInfo.h"
+#include "PrintSymbolList.h"
+#include "ExtractImage.h"
+#include "ThinArch.h"
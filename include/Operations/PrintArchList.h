@@ -51,6 +51,10 @@ public:
     int ParseOptions(const ArgvArray &Argv) noexcept override;
     int Run(const MemoryObject &Object) const noexcept override;
 
+    [[nodiscard]] inline struct Options &getOptions() noexcept override {
+        return Options;
+    }
+
     [[nodiscard]]
     constexpr static auto SupportsObjectKind(const ObjectKind Kind) noexcept {
         switch (Kind) {
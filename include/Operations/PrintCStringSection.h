@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Objects/DscImageMemory.h"
+#include "Objects/DscMemory.h"
 #include "Objects/MachOMemory.h"
 
 #include "Base.h"
@@ -33,8 +34,15 @@ public:
 
         Options() noexcept : Operation::Options(OpKind) {}
 
+        // Amount of the most frequent strings printed with --stats.
+        uint32_t TopCount = 10;
+
         bool Sort : 1 = false;
         bool Verbose : 1 = false;
+
+        bool AllSections : 1 = false;
+        bool Dedupe : 1 = false;
+        bool Stats : 1 = false;
     };
 protected:
     Options Options;
@@ -42,6 +50,9 @@ public:
     PrintCStringSectionOperation() noexcept;
     PrintCStringSectionOperation(const struct Options &Options) noexcept;
 
+    static int
+    Run(const DscMemoryObject &Object, const struct Options &Options) noexcept;
+
     static int
     Run(const DscImageMemoryObject &Object,
         const struct Options &Options) noexcept;
@@ -56,6 +67,10 @@ public:
     int ParseOptions(const ArgvArray &Argv) noexcept override;
     int Run(const MemoryObject &Object) const noexcept override;
 
+    [[nodiscard]] inline struct Options &getOptions() noexcept override {
+        return Options;
+    }
+
     [[nodiscard]]
     constexpr static auto SupportsObjectKind(const ObjectKind Kind) noexcept {
         switch (Kind) {
@@ -63,9 +78,9 @@ public:
                 assert(0 && "SupportsObjectKind() got Object-Kind None");
             case ObjectKind::MachO:
             case ObjectKind::DscImage:
+            case ObjectKind::DyldSharedCache:
                 return true;
             case ObjectKind::FatMachO:
-            case ObjectKind::DyldSharedCache:
                 return false;
         }
 
@@ -0,0 +1,105 @@
+//
+//  Operations/PrintDiff.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include "Objects/DscMemory.h"
+#include "Objects/MachOMemory.h"
+
+#include "Base.h"
+
+struct PrintDiffOperation : public Operation {
+public:
+    constexpr static auto OpKind = OperationKind::PrintDiff;
+
+    [[nodiscard]]
+    constexpr static auto IsOfKind(const Operation::Options &Opt) noexcept {
+        return Opt.getKind() == OpKind;
+    }
+
+    enum class SectionKind {
+        Header,
+        LoadCommands,
+        Libraries,
+        Exports,
+        Binds,
+        Symbols,
+        ObjcClasses,
+
+        // Images of a dyld_shared_cache, only compared between two caches.
+        Images
+    };
+
+    constexpr static auto SectionCount =
+        static_cast<uint32_t>(SectionKind::Images) + 1;
+
+    struct Options : public Operation::Options {
+        [[nodiscard]]
+        constexpr static auto IsOfKind(const Operation::Options &Opt) noexcept {
+            return Opt.getKind() == OpKind;
+        }
+
+        Options() noexcept : Operation::Options(OpKind) {}
+
+        // The file to compare against, provided before the file the
+        // operation is run on.
+
+        std::string_view OldPath;
+
+        // Mask of every compared section, by section-kind.
+        uint32_t SectionMask = (1u << SectionCount) - 1;
+
+        bool Verbose : 1 = false;
+
+        [[nodiscard]]
+        constexpr auto hasSection(const SectionKind Kind) const noexcept {
+            return (SectionMask & (1u << static_cast<uint32_t>(Kind))) != 0;
+        }
+    };
+protected:
+    Options Options;
+public:
+    PrintDiffOperation() noexcept;
+    PrintDiffOperation(const struct Options &Options) noexcept;
+
+    static int
+    Run(const MachOMemoryObject &Object,
+        const MemoryObject &OldObject,
+        const struct Options &Options) noexcept;
+
+    static int
+    Run(const DscMemoryObject &Object,
+        const MemoryObject &OldObject,
+        const struct Options &Options) noexcept;
+
+    [[nodiscard]] static struct Options
+    ParseOptionsImpl(const ArgvArray &Argv, int *IndexOut) noexcept;
+
+    int ParseOptions(const ArgvArray &Argv) noexcept override;
+    int Run(const MemoryObject &Object) const noexcept override;
+
+    [[nodiscard]] inline struct Options &getOptions() noexcept override {
+        return Options;
+    }
+
+    [[nodiscard]]
+    constexpr static auto SupportsObjectKind(const ObjectKind Kind) noexcept {
+        switch (Kind) {
+            case ObjectKind::None:
+                assert(0 && "SupportsObjectKind() got Object-Kind None");
+            case ObjectKind::FatMachO:
+                return false;
+            case ObjectKind::MachO:
+            case ObjectKind::DscImage:
+            case ObjectKind::DyldSharedCache:
+                return true;
+        }
+
+        assert(0 && "Reached end of SupportsObjectKind()");
+    }
+};
@@ -72,6 +72,10 @@ public:
     ParseOptionsImpl(const ArgvArray &Argv, int *IndexOut) noexcept;
 
     int Run(const MemoryObject &Object) const noexcept override;
+
+    [[nodiscard]] inline struct Options &getOptions() noexcept override {
+        return Options;
+    }
     int ParseOptions(const ArgvArray &Argv) noexcept override;
 
     [[nodiscard]]
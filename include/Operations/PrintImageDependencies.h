@@ -0,0 +1,78 @@
+//
+//  Operations/PrintImageDependencies.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include "Objects/DscMemory.h"
+#include "Base.h"
+
+struct PrintImageDependenciesOperation : public Operation {
+public:
+    constexpr static auto OpKind = OperationKind::PrintImageDependencies;
+
+    [[nodiscard]]
+    constexpr static auto IsOfKind(const Operation::Options &Opt) noexcept {
+        return Opt.getKind() == OpKind;
+    }
+
+    struct Options : public Operation::Options {
+        [[nodiscard]]
+        constexpr static auto IsOfKind(const Operation::Options &Opt) noexcept {
+            return Opt.getKind() == OpKind;
+        }
+
+        Options() noexcept : Operation::Options(OpKind) {}
+        enum class ModeKind {
+            Dependencies,
+            Dependents,
+            LoadOrder,
+            Cycles
+        };
+
+        ModeKind Mode = ModeKind::Dependencies;
+        std::string_view ImagePath;
+
+        bool Recursive : 1 = false;
+        bool IncludeUpward : 1 = false;
+        bool Verbose : 1 = false;
+    };
+protected:
+    Options Options;
+public:
+    PrintImageDependenciesOperation() noexcept;
+    PrintImageDependenciesOperation(const struct Options &Options) noexcept;
+
+    static int
+    Run(const DscMemoryObject &Object, const struct Options &Options) noexcept;
+
+    [[nodiscard]] static struct Options
+    ParseOptionsImpl(const ArgvArray &Argv, int *IndexOut) noexcept;
+
+    int ParseOptions(const ArgvArray &Argv) noexcept override;
+    int Run(const MemoryObject &Object) const noexcept override;
+
+    [[nodiscard]] inline struct Options &getOptions() noexcept override {
+        return Options;
+    }
+
+    [[nodiscard]]
+    constexpr static auto SupportsObjectKind(const ObjectKind Kind) noexcept {
+        switch (Kind) {
+            case ObjectKind::None:
+                assert(0 && "SupportsObjectKind() got Object-Kind None");
+            case ObjectKind::MachO:
+            case ObjectKind::FatMachO:
+            case ObjectKind::DscImage:
+                return false;
+            case ObjectKind::DyldSharedCache:
+                return true;
+        }
+
+        assert(0 && "Reached end of SupportsObjectKind()");
+    }
+};
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Objects/DscImageMemory.h"
+#include "Objects/DscMemory.h"
 #include "Objects/MachOMemory.h"
 
 #include "Base.h"
@@ -43,6 +44,11 @@ public:
         };
 
         std::vector<SortKind> SortKindList;
+
+        // Only supported for a whole dyld_shared_cache, where the class is
+        // looked up in the shared-cache's class-table.
+
+        std::string_view ClassName;
     };
 protected:
     Options Options;
@@ -58,21 +64,28 @@ public:
     Run(const MachOMemoryObject &Object,
         const struct Options &Options) noexcept;
 
+    static int
+    Run(const DscMemoryObject &Object, const struct Options &Options) noexcept;
+
     [[nodiscard]] static struct Options
     ParseOptionsImpl(const ArgvArray &Argv, int *IndexOut) noexcept;
 
     int ParseOptions(const ArgvArray &Argv) noexcept override;
     int Run(const MemoryObject &Object) const noexcept override;
 
+    [[nodiscard]] inline struct Options &getOptions() noexcept override {
+        return Options;
+    }
+
     [[nodiscard]]
     constexpr static auto SupportsObjectKind(const ObjectKind Kind) noexcept {
         switch (Kind) {
             case ObjectKind::None:
                 assert(0 && "SupportsObjectKind() got Object-Kind None");
             case ObjectKind::MachO:
+            case ObjectKind::DyldSharedCache:
                 return true;
             case ObjectKind::FatMachO:
-            case ObjectKind::DyldSharedCache:
             case ObjectKind::DscImage:
                 return false;
         }
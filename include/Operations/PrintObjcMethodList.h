@@ -0,0 +1,83 @@
+//
+//  Operations/PrintObjcMethodList.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include "Objects/DscImageMemory.h"
+#include "Objects/DscMemory.h"
+#include "Objects/MachOMemory.h"
+
+#include "Base.h"
+#include "Kind.h"
+
+struct PrintObjcMethodListOperation : public Operation {
+public:
+    constexpr static auto OpKind = OperationKind::PrintObjcMethodList;
+
+    [[nodiscard]]
+    constexpr static auto IsOfKind(const Operation::Options &Opt) noexcept {
+        return Opt.getKind() == OpKind;
+    }
+
+    struct Options : public Operation::Options {
+        [[nodiscard]]
+        constexpr static auto IsOfKind(const Operation::Options &Opt) noexcept {
+            return Opt.getKind() == OpKind;
+        }
+
+        Options() noexcept : Operation::Options(OpKind) {}
+
+        bool PrintIvars : 1 = false;
+        bool PrintProperties : 1 = false;
+        bool PrintProtocols : 1 = false;
+        bool Sort : 1 = false;
+        bool Verbose : 1 = false;
+    };
+protected:
+    Options Options;
+public:
+    PrintObjcMethodListOperation() noexcept;
+    PrintObjcMethodListOperation(const struct Options &Options) noexcept;
+
+    static int
+    Run(const MachOMemoryObject &Object,
+        const struct Options &Options) noexcept;
+
+    static int
+    Run(const DscImageMemoryObject &Object,
+        const struct Options &Options) noexcept;
+
+    static int
+    Run(const DscMemoryObject &Object, const struct Options &Options) noexcept;
+
+    [[nodiscard]] static struct Options
+    ParseOptionsImpl(const ArgvArray &Argv, int *IndexOut) noexcept;
+
+    int ParseOptions(const ArgvArray &Argv) noexcept override;
+    int Run(const MemoryObject &Object) const noexcept override;
+
+    [[nodiscard]] inline struct Options &getOptions() noexcept override {
+        return Options;
+    }
+
+    [[nodiscard]]
+    constexpr static auto SupportsObjectKind(const ObjectKind Kind) noexcept {
+        switch (Kind) {
+            case ObjectKind::None:
+                assert(0 && "SupportsObjectKind() got Object-Kind None");
+            case ObjectKind::MachO:
+            case ObjectKind::DyldSharedCache:
+            case ObjectKind::DscImage:
+                return true;
+            case ObjectKind::FatMachO:
+                return false;
+        }
+
+        assert(0 && "Reached end of SupportsObjectKind()");
+    }
+};
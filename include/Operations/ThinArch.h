@@ -0,0 +1,76 @@
+//
+//  Operations/ThinArch.h
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#pragma once
+
+#include <string_view>
+
+#include "Objects/FatMachOMemory.h"
+#include "Base.h"
+
+struct ThinArchOperation : public Operation {
+public:
+    constexpr static auto OpKind = OperationKind::ThinArch;
+
+    [[nodiscard]]
+    constexpr static auto IsOfKind(const Operation::Options &Opt) noexcept {
+        return Opt.getKind() == OpKind;
+    }
+
+    struct Options : public Operation::Options {
+        [[nodiscard]]
+        constexpr static auto IsOfKind(const Operation::Options &Opt) noexcept {
+            return Opt.getKind() == OpKind;
+        }
+
+        Options() noexcept : Operation::Options(OpKind) {}
+
+        // Ordinal of the arch, or the name of its cpu-type or cpu-subtype
+        // (ex. x86_64, arm64e).
+
+        std::string_view Arch;
+        std::string_view OutputPath;
+
+        bool Verbose : 1 = false;
+    };
+protected:
+    Options Options;
+public:
+    ThinArchOperation() noexcept;
+    ThinArchOperation(const struct Options &Options) noexcept;
+
+    static int
+    Run(const FatMachOMemoryObject &Object,
+        const struct Options &Options) noexcept;
+
+    [[nodiscard]] static struct Options
+    ParseOptionsImpl(const ArgvArray &Argv, int *IndexOut) noexcept;
+
+    int ParseOptions(const ArgvArray &Argv) noexcept override;
+    int Run(const MemoryObject &Object) const noexcept override;
+
+    [[nodiscard]] inline struct Options &getOptions() noexcept override {
+        return Options;
+    }
+
+    [[nodiscard]]
+    constexpr static auto SupportsObjectKind(const ObjectKind Kind) noexcept {
+        switch (Kind) {
+            case ObjectKind::None:
+                assert(0 && "SupportsObjectKind() got Object-Kind None");
+            case ObjectKind::FatMachO:
+                return true;
+            case ObjectKind::MachO:
+            case ObjectKind::DyldSharedCache:
+            case ObjectKind::DscImage:
+                return false;
+        }
+
+        assert(0 && "Reached end of SupportsObjectKind()");
+    }
+};
@@ -81,7 +81,7 @@
     PackedVersion.getMinor(), \
     PackedVersion.getRevision()
 
-#define STRING_VIEW_FMT "%*s"
+#define STRING_VIEW_FMT "%.*s"
 #define STRING_VIEW_FMT_ARGS(STR) \
     static_cast<int>((STR).length()), (STR).data()
 
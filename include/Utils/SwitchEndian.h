@@ -10,6 +10,7 @@
 
 #include <concepts>
 #include <cstdint>
+#include <type_traits>
 
 struct EndianSwitcherFuncs {
     [[nodiscard]]
@@ -120,3 +121,17 @@ template <std::integral T>
 [[nodiscard]] constexpr T SwitchEndianIf(T Value, bool Cond) noexcept {
     return Cond ? SwitchEndian(Value) : Value;
 }
+
+// Calls Callback with IsBigEndian as a std::bool_constant, so that a loop can
+// be instantiated for each endianness, with the endianness checked only once,
+// rather than on every access inside the loop.
+
+template <typename T>
+constexpr auto
+DispatchOnEndian(const bool IsBigEndian, const T &Callback) noexcept {
+    if (IsBigEndian) {
+        return Callback(std::true_type());
+    }
+
+    return Callback(std::false_type());
+}
@@ -0,0 +1,229 @@
+//
+//  ADT/ColumnarWriter.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <cassert>
+#include <cstring>
+
+#include "ADT/ColumnarWriter.h"
+
+ColumnarWriter::ColumnarWriter(FILE *const OutFile) noexcept
+: OutFile(OutFile) {}
+
+auto
+ColumnarWriter::getColumnForKey(const std::string_view Key,
+                                const ColumnarColumnKind Kind) noexcept
+    -> Column &
+{
+    assert(this->InRecord && "Field written outside of a record");
+    assert(Key.length() < ColumnarColumnNameMax && "Column-Name is too long");
+
+    auto Index = this->NextColumnIndex;
+    if (Index >= ColumnList.size() || ColumnList[Index].Name != Key) {
+        Index = 0;
+        for (; Index != ColumnList.size(); Index++) {
+            if (ColumnList[Index].Name == Key) {
+                break;
+            }
+        }
+
+        if (Index == ColumnList.size()) {
+            ColumnList.emplace_back().Name = std::string(Key);
+        }
+    }
+
+    this->NextColumnIndex = Index + 1;
+
+    auto &Column = ColumnList[Index];
+    if (Kind != ColumnarColumnKind::Null) {
+        if (Column.Kind == ColumnarColumnKind::Null) {
+            Column.Kind = Kind;
+        }
+
+        assert(Column.Kind == Kind && "Column written with different kinds");
+    }
+
+    // Columns created partway through the list are filled with nulls for the
+    // earlier records.
+
+    Column.Values.resize(this->RecordCount + 1);
+    Column.Validity.resize(this->RecordCount / 64 + 1);
+
+    return Column;
+}
+
+auto ColumnarWriter::addString(const std::string_view String) noexcept
+    -> uint64_t
+{
+    auto Offset = uint32_t();
+    if (const auto Iter = StringOffsetMap.find(String);
+        Iter != StringOffsetMap.end())
+    {
+        Offset = Iter->second;
+    } else {
+        Offset = static_cast<uint32_t>(StringHeap.size());
+
+        StringHeap.append(String);
+        StringHeap.push_back('\0');
+
+        StringOffsetMap.emplace(std::string(String), Offset);
+    }
+
+    return (static_cast<uint64_t>(String.length()) << 32) | Offset;
+}
+
+void
+ColumnarWriter::writeValue(const std::string_view Key,
+                           const ColumnarColumnKind Kind,
+                           const uint64_t Value) noexcept
+{
+    auto &Column = this->getColumnForKey(Key, Kind);
+    const auto Row = this->RecordCount;
+
+    Column.Values[Row] = Value;
+    Column.Validity[Row / 64] |= (1ull << (Row % 64));
+}
+
+auto ColumnarWriter::beginList() noexcept -> decltype(*this) {
+    return *this;
+}
+
+static void
+WriteLittleEndian(FILE *const OutFile,
+                  const std::vector<uint64_t> &List,
+                  const uint64_t Count) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little) {
+        fwrite(List.data(), sizeof(uint64_t), Count, OutFile);
+    } else {
+        for (auto I = uint64_t(); I != Count; I++) {
+            const auto Value = SwitchEndian(List[I]);
+            fwrite(&Value, sizeof(Value), 1, OutFile);
+        }
+    }
+}
+
+auto ColumnarWriter::endList() noexcept -> decltype(*this) {
+    assert(!this->InRecord && "List ended inside of a record");
+    constexpr auto IsBigEndian = std::endian::native == std::endian::big;
+
+    const auto RowCount = this->RecordCount;
+    const auto ValidityCount = (RowCount + 63) / 64;
+
+    for (auto &Column : ColumnList) {
+        Column.Values.resize(RowCount);
+        Column.Validity.resize(ValidityCount);
+    }
+
+    const auto ColumnCount = static_cast<uint32_t>(ColumnList.size());
+    auto Offset =
+        sizeof(ColumnarFileHeader) +
+        static_cast<uint64_t>(ColumnCount) * sizeof(ColumnarColumnHeader);
+
+    auto ColumnHeaderList = std::vector<ColumnarColumnHeader>();
+    ColumnHeaderList.reserve(ColumnCount);
+
+    for (const auto &Column : ColumnList) {
+        auto Header = ColumnarColumnHeader();
+        memcpy(Header.Name, Column.Name.data(), Column.Name.length());
+
+        Header.Kind = Column.Kind;
+        Header.ValuesOffset = SwitchEndianIf(Offset, IsBigEndian);
+
+        Offset += RowCount * sizeof(uint64_t);
+        Header.ValidityOffset = SwitchEndianIf(Offset, IsBigEndian);
+
+        Offset += ValidityCount * sizeof(uint64_t);
+        ColumnHeaderList.emplace_back(Header);
+    }
+
+    auto Header = ColumnarFileHeader();
+    memcpy(Header.Magic, ColumnarFileMagic.data(), sizeof(Header.Magic));
+
+    Header.Version = SwitchEndianIf(ColumnarFileVersion, IsBigEndian);
+    Header.ColumnCount = SwitchEndianIf(ColumnCount, IsBigEndian);
+    Header.RowCount = SwitchEndianIf(RowCount, IsBigEndian);
+    Header.StringHeapOffset = SwitchEndianIf(Offset, IsBigEndian);
+    Header.StringHeapSize =
+        SwitchEndianIf(static_cast<uint64_t>(StringHeap.size()), IsBigEndian);
+
+    fwrite(&Header, sizeof(Header), 1, OutFile);
+    fwrite(ColumnHeaderList.data(),
+           sizeof(ColumnarColumnHeader),
+           ColumnHeaderList.size(),
+           OutFile);
+
+    for (const auto &Column : ColumnList) {
+        WriteLittleEndian(OutFile, Column.Values, RowCount);
+        WriteLittleEndian(OutFile, Column.Validity, ValidityCount);
+    }
+
+    fwrite(StringHeap.data(), 1, StringHeap.size(), OutFile);
+    return *this;
+}
+
+auto ColumnarWriter::beginRecord() noexcept -> decltype(*this) {
+    assert(!this->InRecord && "Records can't be nested");
+
+    this->InRecord = true;
+    this->NextColumnIndex = 0;
+
+    return *this;
+}
+
+auto ColumnarWriter::endRecord() noexcept -> decltype(*this) {
+    assert(this->InRecord && "Record ended without being started");
+
+    this->InRecord = false;
+    this->RecordCount++;
+
+    return *this;
+}
+
+auto
+ColumnarWriter::writeString(const std::string_view Key,
+                            const std::string_view Value) noexcept
+    -> decltype(*this)
+{
+    this->writeValue(Key, ColumnarColumnKind::String, this->addString(Value));
+    return *this;
+}
+
+auto
+ColumnarWriter::writeNumber(const std::string_view Key,
+                            const uint64_t Value) noexcept
+    -> decltype(*this)
+{
+    this->writeValue(Key, ColumnarColumnKind::UInt64, Value);
+    return *this;
+}
+
+auto
+ColumnarWriter::writeSignedNumber(const std::string_view Key,
+                                  const int64_t Value) noexcept
+    -> decltype(*this)
+{
+    this->writeValue(Key,
+                     ColumnarColumnKind::Int64,
+                     static_cast<uint64_t>(Value));
+    return *this;
+}
+
+auto
+ColumnarWriter::writeBool(const std::string_view Key, const bool Value) noexcept
+    -> decltype(*this)
+{
+    this->writeValue(Key, ColumnarColumnKind::Bool, Value);
+    return *this;
+}
+
+auto ColumnarWriter::writeNull(const std::string_view Key) noexcept
+    -> decltype(*this)
+{
+    static_cast<void>(this->getColumnForKey(Key, ColumnarColumnKind::Null));
+    return *this;
+}
@@ -0,0 +1,578 @@
+//
+//  ADT/DscImage/Extractor.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include "ADT/DscImage/Extractor.h"
+#include "ADT/DyldSharedCache/Headers.h"
+#include "ADT/Mach-O/Headers.h"
+#include "ADT/Mach-O/LoadCommandStorage.h"
+#include "ADT/Mach-O/LoadCommands.h"
+
+#include "Utils/DoesOverflow.h"
+
+namespace DscImage {
+    [[nodiscard]] constexpr static auto
+    AlignUp(const uint64_t Value, const uint64_t Align) noexcept {
+        return (Value + Align - 1) & ~(Align - 1);
+    }
+
+    template <typename T>
+    [[nodiscard]] static inline auto
+    HasCmdSizeFor(const MachO::LoadCommand &LC) noexcept {
+        return LC.getCmdSize(false) >= sizeof(T);
+    }
+
+    // The image's symbol-table names its symbols with indices into the
+    // cache's string-table, which is shared by every image. The entries are
+    // copied with indices into a string-table of only the image's names.
+
+    template <typename EntryType>
+    static void
+    RebuildSymbolTable(const uint8_t *const Begin,
+                       const uint32_t Count,
+                       const std::string_view StringTable,
+                       std::vector<uint8_t> &SymbolTableOut,
+                       std::vector<uint8_t> &StringTableOut) noexcept
+    {
+        auto IndexMap = std::unordered_map<std::string_view, uint32_t>();
+
+        SymbolTableOut.resize(static_cast<uint64_t>(Count) * sizeof(EntryType));
+        StringTableOut.assign(1, '\0');
+
+        for (auto I = uint32_t(); I != Count; I++) {
+            auto Entry = EntryType();
+            memcpy(&Entry, Begin + I * sizeof(EntryType), sizeof(Entry));
+
+            if (Entry.Index == 0 || Entry.Index >= StringTable.length()) {
+                Entry.Index = 0;
+            } else {
+                const auto Rest = StringTable.substr(Entry.Index);
+                const auto Name = Rest.substr(0, Rest.find('\0'));
+                const auto [Iter, Inserted] =
+                    IndexMap.try_emplace(Name, StringTableOut.size());
+
+                if (Inserted) {
+                    StringTableOut.insert(StringTableOut.end(),
+                                          Name.begin(),
+                                          Name.end());
+                    StringTableOut.push_back('\0');
+                }
+
+                Entry.Index = Iter->second;
+            }
+
+            memcpy(SymbolTableOut.data() + I * sizeof(EntryType),
+                   &Entry,
+                   sizeof(Entry));
+        }
+
+        StringTableOut.resize(AlignUp(StringTableOut.size(), sizeof(uint64_t)));
+    }
+
+    auto
+    ImageExtractor::Open(const ConstMemoryMap &CacheMap,
+                         const uint64_t ImageAddress,
+                         Error *const ErrorOut) noexcept
+        -> std::optional<ImageExtractor>
+    {
+        const auto SetError = [&](const enum Error Error) noexcept {
+            if (ErrorOut != nullptr) {
+                *ErrorOut = Error;
+            }
+
+            return std::nullopt;
+        };
+
+        const auto CacheSize = static_cast<uint64_t>(CacheMap.size());
+        const auto IsInCache = [&](const uint64_t Offset,
+                                   const uint64_t Size) noexcept
+        {
+            auto End = uint64_t();
+            return !DoesAddOverflow(Offset, Size, &End) && End <= CacheSize;
+        };
+
+        const auto &CacheHeader =
+            *CacheMap.getBeginAs<DyldSharedCache::HeaderV0>();
+        const auto ImageFileOffset =
+            CacheHeader.GetFileOffsetForAddress(ImageAddress);
+
+        if (ImageFileOffset == 0 ||
+            !IsInCache(ImageFileOffset, sizeof(MachO::Header)))
+        {
+            return SetError(Error::SegmentNotMapped);
+        }
+
+        // Caches are always little-endian.
+
+        const auto &Header =
+            *reinterpret_cast<const MachO::Header *>(
+                CacheMap.getBegin() + ImageFileOffset);
+
+        if (!Header.hasValidMagic() || Header.isBigEndian()) {
+            return SetError(Error::UnsupportedImage);
+        }
+
+        const auto Is64Bit = Header.is64Bit();
+        const auto HeaderSize =
+            static_cast<uint64_t>(Header.size()) +
+            Header.getLoadCommandsSize();
+
+        if (!IsInCache(ImageFileOffset, HeaderSize)) {
+            return SetError(Error::InvalidLoadCommands);
+        }
+
+        const auto LoadCmdStorage =
+            MachO::ConstLoadCommandStorage::Open(
+                Header.getConstLoadCmdBuffer(),
+                Header.getLoadCommandsCount(),
+                Header.getLoadCommandsSize(),
+                /*IsBigEndian=*/false,
+                Is64Bit,
+                /*Verify=*/true);
+
+        if (LoadCmdStorage.hasError()) {
+            return SetError(Error::InvalidLoadCommands);
+        }
+
+        auto Result = ImageExtractor();
+        auto &HeaderData = Result.HeaderData;
+
+        Result.CacheBegin = CacheMap.getBegin();
+        HeaderData.assign(reinterpret_cast<const uint8_t *>(&Header),
+                          reinterpret_cast<const uint8_t *>(&Header) +
+                            HeaderSize);
+
+        auto &NewHeader = *reinterpret_cast<MachO::Header *>(HeaderData.data());
+        NewHeader.setFlags(
+            NewHeader.getFlags().remove(
+                MachO::Header::FlagsEnum::DylibInCache));
+
+        const auto LoadCmdCount = NewHeader.getLoadCommandsCount();
+        const auto ForEachLoadCommand = [&](const auto &Callback) noexcept {
+            auto Iter = NewHeader.getLoadCmdBuffer();
+            for (auto I = uint32_t(); I != LoadCmdCount; I++) {
+                auto &LC = *reinterpret_cast<MachO::LoadCommand *>(Iter);
+                const auto CallbackError = Callback(LC);
+                if (CallbackError != Error::None) {
+                    return CallbackError;
+                }
+
+                Iter += LC.getCmdSize(false);
+            }
+
+            return Error::None;
+        };
+
+        // Lay out every segment but __LINKEDIT back-to-back, with the
+        // mach-header at the start of the first.
+
+        auto FileOffset = uint64_t();
+        auto Linkedit = static_cast<MachO::LoadCommand *>(nullptr);
+
+        const auto LayoutSegment = [&](auto &Segment) noexcept {
+            using SectionType =
+                typename std::remove_reference_t<
+                    decltype(Segment)>::Section;
+
+            const auto SectionCount = Segment.Nsects;
+            if ((Segment.CmdSize - sizeof(Segment)) / sizeof(SectionType) <
+                    SectionCount)
+            {
+                return Error::InvalidLoadCommands;
+            }
+
+            if (MachO::SegOrSectNameEquals(Segment.Name, "__LINKEDIT")) {
+                Linkedit = &Segment;
+                return Error::None;
+            }
+
+            if (Segment.FileSize == 0) {
+                Segment.FileOff = 0;
+                return Error::None;
+            }
+
+            auto MaxSize = uint64_t();
+            const auto CacheOffset =
+                CacheHeader.GetFileOffsetForAddress(Segment.VmAddr, &MaxSize);
+
+            if (CacheOffset == 0 ||
+                MaxSize < Segment.FileSize ||
+                !IsInCache(CacheOffset, Segment.FileSize))
+            {
+                return Error::SegmentNotMapped;
+            }
+
+            if (FileOffset == 0) {
+                if (CacheOffset != ImageFileOffset ||
+                    Segment.FileSize < HeaderSize)
+                {
+                    return Error::NoTextSegment;
+                }
+
+                Result.PieceList.emplace_back(Piece {
+                    .FileOffset = 0,
+                    .SourceOffset = 0,
+                    .Size = HeaderSize,
+                    .Source = PieceSource::Header
+                });
+
+                Result.PieceList.emplace_back(Piece {
+                    .FileOffset = HeaderSize,
+                    .SourceOffset = CacheOffset + HeaderSize,
+                    .Size = Segment.FileSize - HeaderSize,
+                    .Source = PieceSource::Cache
+                });
+            } else {
+                Result.PieceList.emplace_back(Piece {
+                    .FileOffset = FileOffset,
+                    .SourceOffset = CacheOffset,
+                    .Size = Segment.FileSize,
+                    .Source = PieceSource::Cache
+                });
+            }
+
+            const auto Sections =
+                reinterpret_cast<SectionType *>(&Segment + 1);
+
+            for (auto I = uint32_t(); I != SectionCount; I++) {
+                auto &Section = Sections[I];
+                if (Section.Offset != 0) {
+                    Section.Offset =
+                        static_cast<uint32_t>(
+                            FileOffset + (Section.Addr - Segment.VmAddr));
+                }
+            }
+
+            Segment.FileOff = FileOffset;
+            FileOffset =
+                AlignUp(FileOffset + Segment.FileSize, SegmentAlignment);
+
+            return Error::None;
+        };
+
+        const auto SegmentError =
+            ForEachLoadCommand([&](MachO::LoadCommand &LC) noexcept {
+                if (const auto Segment =
+                        dyn_cast<MachO::SegmentCommand64>(LC, false))
+                {
+                    if (!HasCmdSizeFor<MachO::SegmentCommand64>(LC)) {
+                        return Error::InvalidLoadCommands;
+                    }
+
+                    return LayoutSegment(*Segment);
+                }
+
+                if (const auto Segment =
+                        dyn_cast<MachO::SegmentCommand>(LC, false))
+                {
+                    if (!HasCmdSizeFor<MachO::SegmentCommand>(LC)) {
+                        return Error::InvalidLoadCommands;
+                    }
+
+                    return LayoutSegment(*Segment);
+                }
+
+                return Error::None;
+            });
+
+        if (SegmentError != Error::None) {
+            return SetError(SegmentError);
+        }
+
+        if (FileOffset == 0) {
+            return SetError(Error::NoTextSegment);
+        }
+
+        if (Linkedit == nullptr) {
+            return SetError(Error::NoLinkeditSegment);
+        }
+
+        // Gather the image's parts of the cache's __LINKEDIT, rewriting the
+        // offsets of the load-commands that refer to them.
+
+        const auto LinkeditBegin = FileOffset;
+        const auto PointerSize = Is64Bit ? sizeof(uint64_t) : sizeof(uint32_t);
+
+        const auto AddLinkeditPiece =
+            [&](const PieceSource Source,
+                const uint64_t SourceOffset,
+                const uint64_t Size) noexcept
+        {
+            FileOffset = AlignUp(FileOffset, PointerSize);
+            Result.PieceList.emplace_back(Piece {
+                .FileOffset = FileOffset,
+                .SourceOffset = SourceOffset,
+                .Size = Size,
+                .Source = Source
+            });
+
+            const auto Offset = static_cast<uint32_t>(FileOffset);
+            FileOffset += Size;
+
+            return Offset;
+        };
+
+        const auto AddLinkeditData =
+            [&](uint32_t &Offset, const uint64_t Size) noexcept {
+                if (Size == 0) {
+                    Offset = 0;
+                    return true;
+                }
+
+                if (!IsInCache(Offset, Size)) {
+                    return false;
+                }
+
+                Offset = AddLinkeditPiece(PieceSource::Cache, Offset, Size);
+                return true;
+            };
+
+        auto SymTab = static_cast<MachO::SymTabCommand *>(nullptr);
+        const auto LinkeditError =
+            ForEachLoadCommand([&](MachO::LoadCommand &LC) noexcept {
+                if (const auto DyldInfo =
+                        dyn_cast<MachO::DyldInfoCommand>(LC, false))
+                {
+                    if (!HasCmdSizeFor<MachO::DyldInfoCommand>(LC)) {
+                        return Error::InvalidLoadCommands;
+                    }
+
+                    const auto Valid =
+                        AddLinkeditData(DyldInfo->RebaseOff,
+                                        DyldInfo->RebaseSize) &&
+                        AddLinkeditData(DyldInfo->BindOff,
+                                        DyldInfo->BindSize) &&
+                        AddLinkeditData(DyldInfo->WeakBindOff,
+                                        DyldInfo->WeakBindSize) &&
+                        AddLinkeditData(DyldInfo->LazyBindOff,
+                                        DyldInfo->LazyBindSize) &&
+                        AddLinkeditData(DyldInfo->ExportOff,
+                                        DyldInfo->ExportSize);
+
+                    return Valid ?
+                        Error::None : Error::LinkeditDataOutOfBounds;
+                }
+
+                if (const auto Data =
+                        dyn_cast<MachO::LinkeditDataCommand>(LC, false))
+                {
+                    if (!HasCmdSizeFor<MachO::LinkeditDataCommand>(LC)) {
+                        return Error::InvalidLoadCommands;
+                    }
+
+                    return AddLinkeditData(Data->DataOff, Data->DataSize) ?
+                        Error::None : Error::LinkeditDataOutOfBounds;
+                }
+
+                if (const auto DySymTab =
+                        dyn_cast<MachO::DynamicSymTabCommand>(LC, false))
+                {
+                    if (!HasCmdSizeFor<MachO::DynamicSymTabCommand>(LC)) {
+                        return Error::InvalidLoadCommands;
+                    }
+
+                    const auto ModuleSize = Is64Bit ? 56 : 52;
+                    const auto Valid =
+                        AddLinkeditData(
+                            DySymTab->TableOfContentsOff,
+                            DySymTab->NTableOfContentsEntries * 8ull) &&
+                        AddLinkeditData(
+                            DySymTab->ModuleTableOff,
+                            DySymTab->NModuleTableEntries * 1ull *
+                                ModuleSize) &&
+                        AddLinkeditData(
+                            DySymTab->ExternalReferenceSymbolTableoff,
+                            DySymTab->NExtReferencedSymbols * 4ull) &&
+                        AddLinkeditData(
+                            DySymTab->IndirectSymbolTableOff,
+                            DySymTab->NIndirectSymbols * 4ull) &&
+                        AddLinkeditData(
+                            DySymTab->ExternalRelocationsOff,
+                            DySymTab->NExternalRelocations * 8ull) &&
+                        AddLinkeditData(
+                            DySymTab->LocalRelocationsOff,
+                            DySymTab->NLocalRelocations * 8ull);
+
+                    return Valid ?
+                        Error::None : Error::LinkeditDataOutOfBounds;
+                }
+
+                if (const auto Cmd = dyn_cast<MachO::SymTabCommand>(LC, false))
+                {
+                    if (!HasCmdSizeFor<MachO::SymTabCommand>(LC)) {
+                        return Error::InvalidLoadCommands;
+                    }
+
+                    SymTab = Cmd;
+                }
+
+                return Error::None;
+            });
+
+        if (LinkeditError != Error::None) {
+            return SetError(LinkeditError);
+        }
+
+        if (SymTab != nullptr) {
+            const auto EntrySize =
+                Is64Bit ?
+                    sizeof(MachO::SymbolTableEntry64) :
+                    sizeof(MachO::SymbolTableEntry32);
+
+            auto SymbolsEnd = uint64_t();
+            if (DoesMultiplyAndAddOverflow(SymTab->Nsyms,
+                                           EntrySize,
+                                           SymTab->SymOff,
+                                           &SymbolsEnd) ||
+                SymbolsEnd > CacheSize ||
+                !IsInCache(SymTab->StrOff, SymTab->StrSize))
+            {
+                return SetError(Error::SymbolTableOutOfBounds);
+            }
+
+            const auto StringTable =
+                std::string_view(
+                    reinterpret_cast<const char *>(CacheMap.getBegin()) +
+                        SymTab->StrOff,
+                    SymTab->StrSize);
+
+            if (Is64Bit) {
+                RebuildSymbolTable<MachO::SymbolTableEntry64>(
+                    CacheMap.getBegin() + SymTab->SymOff,
+                    SymTab->Nsyms,
+                    StringTable,
+                    Result.SymbolTableData,
+                    Result.StringTableData);
+            } else {
+                RebuildSymbolTable<MachO::SymbolTableEntry32>(
+                    CacheMap.getBegin() + SymTab->SymOff,
+                    SymTab->Nsyms,
+                    StringTable,
+                    Result.SymbolTableData,
+                    Result.StringTableData);
+            }
+
+            SymTab->SymOff =
+                AddLinkeditPiece(PieceSource::SymbolTable,
+                                 0,
+                                 Result.SymbolTableData.size());
+
+            SymTab->StrOff =
+                AddLinkeditPiece(PieceSource::StringTable,
+                                 0,
+                                 Result.StringTableData.size());
+
+            SymTab->StrSize =
+                static_cast<uint32_t>(Result.StringTableData.size());
+        }
+
+        const auto LinkeditSize = FileOffset - LinkeditBegin;
+        const auto SetLinkedit = [&](auto &Segment) noexcept {
+            Segment.FileOff = LinkeditBegin;
+            Segment.FileSize = LinkeditSize;
+            Segment.VmSize = AlignUp(LinkeditSize, SegmentAlignment);
+        };
+
+        if (const auto Segment =
+                dyn_cast<MachO::SegmentCommand64>(*Linkedit, false))
+        {
+            SetLinkedit(*Segment);
+        } else {
+            SetLinkedit(*dyn_cast<MachO::SegmentCommand>(*Linkedit, false));
+        }
+
+        std::sort(Result.PieceList.begin(),
+                  Result.PieceList.end(),
+                  [](const Piece &Lhs, const Piece &Rhs) noexcept {
+                      return Lhs.FileOffset < Rhs.FileOffset;
+                  });
+
+        Result.FileSize = FileOffset;
+        return Result;
+    }
+
+    auto
+    ImageExtractor::getPieceData(const Piece &Item) const noexcept
+        -> const uint8_t *
+    {
+        switch (Item.Source) {
+            case PieceSource::Cache:
+                return CacheBegin + Item.SourceOffset;
+            case PieceSource::Header:
+                return HeaderData.data() + Item.SourceOffset;
+            case PieceSource::SymbolTable:
+                return SymbolTableData.data() + Item.SourceOffset;
+            case PieceSource::StringTable:
+                return StringTableData.data() + Item.SourceOffset;
+        }
+
+        assert(0 && "Unrecognized Piece-Source");
+    }
+
+    // The least IOV_MAX of the platforms we support.
+    constexpr static auto MaxVectorCount = 1024;
+
+    bool ImageExtractor::WriteTo(FileDescriptor &Fd) const noexcept {
+        if (!Fd.TruncateToSize(FileSize)) {
+            return false;
+        }
+
+        // Pieces that are back-to-back in the file are written together with
+        // a single call, straight from the cache's map.
+
+        auto VectorList = std::vector<iovec>();
+        auto RunOffset = uint64_t();
+        auto RunEnd = uint64_t();
+
+        VectorList.reserve(std::min(PieceList.size(), size_t(MaxVectorCount)));
+        const auto Flush = [&]() noexcept {
+            if (VectorList.empty()) {
+                return true;
+            }
+
+            const auto Result =
+                Fd.WriteVectorAt(VectorList.data(),
+                                 static_cast<int>(VectorList.size()),
+                                 RunOffset);
+
+            VectorList.clear();
+            return Result;
+        };
+
+        for (const auto &Piece : PieceList) {
+            if (Piece.Size == 0) {
+                continue;
+            }
+
+            if (Piece.FileOffset != RunEnd ||
+                VectorList.size() == MaxVectorCount)
+            {
+                if (!Flush()) {
+                    return false;
+                }
+
+                RunOffset = Piece.FileOffset;
+            }
+
+            VectorList.emplace_back(iovec {
+                .iov_base = const_cast<uint8_t *>(getPieceData(Piece)),
+                .iov_len = Piece.Size
+            });
+
+            RunEnd = Piece.FileOffset + Piece.Size;
+        }
+
+        return Flush();
+    }
+}
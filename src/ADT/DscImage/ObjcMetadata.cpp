@@ -0,0 +1,44 @@
+//
+//  ADT/DscImage/ObjcMetadata.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include "ADT/DscImage/ObjcMetadata.h"
+
+namespace DscImage {
+    auto
+    ObjcMetadataCollection::Open(
+        const MachO::SegmentInfoCollection &SegmentCollection,
+        const ConstDeVirtualizer &DeVirtualizer,
+        const bool IsBigEndian,
+        const bool Is64Bit,
+        const std::optional<uint64_t> RelativeSelectorBase) noexcept
+            -> ObjcMetadataCollection
+    {
+        auto Result = ObjcMetadataCollection();
+        Result.setRelativeSelectorBase(RelativeSelectorBase);
+
+        const auto ClassListSection = FindClassListSection(SegmentCollection);
+        if (ClassListSection == nullptr) {
+            return Result;
+        }
+
+        const auto DeVirtualizeData =
+            DeVirtualizeFunc { .DeVirtualizer = DeVirtualizer };
+
+        const auto DeVirtualizeString = [&](const uint64_t Addr) noexcept {
+            return DeVirtualizer.GetStringAtAddress(Addr);
+        };
+
+        Result.Parse(*ClassListSection,
+                     DeVirtualizeData,
+                     DeVirtualizeString,
+                     IsBigEndian,
+                     Is64Bit);
+
+        return Result;
+    }
+}
@@ -21,11 +21,11 @@ namespace DscImage {
             -> decltype(*this)
     {
         auto Error = MachO::ObjcParse::Error::None;
-        auto ExternalAndRootClassList = std::vector<Info *>();
+        auto ExternalAndRootClassList =
+            MachO::ObjcParse::ExternalAndRootClassCollection();
 
-        const auto DeVirtualizeAddrFunc = [&](uint64_t Addr) noexcept {
-            return DeVirtualizer.GetDataAtVmAddr<uint8_t>(Addr);
-        };
+        const auto DeVirtualizeAddrFunc =
+            DeVirtualizeFunc { .DeVirtualizer = DeVirtualizer };
 
         const auto DeVirtualizeStringFunc = [&](uint64_t Addr) noexcept {
             return DeVirtualizer.GetStringAtAddress(Addr);
@@ -70,7 +70,7 @@ namespace DscImage {
                 }
             }
 
-            AdjustExternalAndRootClassList(ExternalAndRootClassList);
+            AdjustExternalAndRootClassList(ExternalAndRootClassList.getList());
             return *this;
         }
 
@@ -115,7 +115,7 @@ namespace DscImage {
                 }
             }
 
-            AdjustExternalAndRootClassList(ExternalAndRootClassList);
+            AdjustExternalAndRootClassList(ExternalAndRootClassList.getList());
             return *this;
         }
 
@@ -145,13 +145,13 @@ namespace DscImage {
         (void)ImageMap;
 
         auto Error = MachO::ObjcParse::Error::None;
-        auto ExternalAndRootClassList = std::vector<Info *>();
+        auto ExternalAndRootClassList =
+            MachO::ObjcParse::ExternalAndRootClassCollection();
 
 //      const auto ImageBase =
 //            SegmentCollection.front().getMemoryRange().getBegin();
-        const auto DeVirtualizeAddrFunc = [&](uint64_t Addr) noexcept {
-            return DeVirtualizer.GetDataAtVmAddr<uint8_t>(Addr);
-        };
+        const auto DeVirtualizeAddrFunc =
+            DeVirtualizeFunc { .DeVirtualizer = DeVirtualizer };
 
         const auto DeVirtualizeStringFunc = [&](uint64_t Addr) noexcept {
             return DeVirtualizer.GetStringAtAddress(Addr);
@@ -214,7 +214,7 @@ namespace DscImage {
                 }
             }
 
-            AdjustExternalAndRootClassList(ExternalAndRootClassList);
+            AdjustExternalAndRootClassList(ExternalAndRootClassList.getList());
             return *this;
         }
 
@@ -279,7 +279,7 @@ namespace DscImage {
                 return *this;
             }
 
-            AdjustExternalAndRootClassList(ExternalAndRootClassList);
+            AdjustExternalAndRootClassList(ExternalAndRootClassList.getList());
             return *this;
         }
 
@@ -290,7 +290,7 @@ namespace DscImage {
         return *this;
     }
 
-    template <PointerKind Kind>
+    template <PointerKind Kind, bool IsBigEndian>
     static void
     ParseObjcClassCategorySection(
         const uint8_t *const Map,
@@ -299,8 +299,8 @@ namespace DscImage {
         const MachO::BindActionCollection *const BindCollection,
         ObjcClassInfoCollection *const ClassInfoTree,
         std::vector<
-            std::unique_ptr<MachO::ObjcClassCategoryInfo>> &CategoryList,
-        const bool IsBigEndian) noexcept
+            std::unique_ptr<MachO::ObjcClassCategoryInfo>> &CategoryList)
+            noexcept
     {
         using PtrAddrType = PointerAddrConstTypeFromKind<Kind>;
         using ObjcCategoryType =
@@ -312,16 +312,30 @@ namespace DscImage {
         const auto List = BasicContiguousList<PtrAddrType>(Begin, End);
         auto ListAddr = SectInfo->getMemoryRange().getBegin();
 
+        // Pointers are read through the rebased-view of the cache, with the
+        // value already read decoded if the address can't be read.
+
+        const auto ReadPointer =
+            [&](const uint64_t Addr, const uint64_t Value) noexcept {
+                constexpr auto Is64Bit = Kind == PointerKind::s64Bit;
+                const auto Pointer = DeVirt.ReadUnslidPointer(Addr, Is64Bit);
+
+                return Pointer.value_or(DeVirt.UnslidePointer(Value));
+            };
+
         if (ClassInfoTree != nullptr) {
             assert(BindCollection != nullptr);
             for (const auto &Addr : List) {
                 auto Info = std::make_unique<MachO::ObjcClassCategoryInfo>();
 
-                const auto SwitchedAddr = SwitchEndianIf(Addr, IsBigEndian);
+                const auto SwitchedAddr =
+                    ReadPointer(ListAddr, SwitchEndianIf(Addr, IsBigEndian));
                 const auto Category =
                     DeVirt.GetDataAtVmAddr<ObjcCategoryType>(SwitchedAddr);
 
                 Info->setAddress(SwitchedAddr);
+                ListAddr += PointerSize<Kind>();
+
                 if (Category == nullptr) {
                     Info->setIsNull();
                     CategoryList.emplace_back(std::move(Info));
@@ -329,7 +343,10 @@ namespace DscImage {
                     continue;
                 }
 
-                const auto NameAddr = Category->getNameAddress(IsBigEndian);
+                const auto NameAddr =
+                    ReadPointer(SwitchedAddr + offsetof(ObjcCategoryType, Name),
+                                Category->getNameAddress(IsBigEndian));
+
                 if (const auto Name = DeVirt.GetStringAtAddress(NameAddr)) {
                     Info->setName(std::string(Name.value()));
                 }
@@ -355,7 +372,9 @@ namespace DscImage {
                                 It->getAddress());
                     }
                 } else {
-                    ClassAddr = Category->getClassAddress(IsBigEndian);
+                    ClassAddr =
+                        ReadPointer(ClassAddr,
+                                    Category->getClassAddress(IsBigEndian));
                     if (ClassAddr != 0) {
                         Class = ClassInfoTree->GetInfoForAddress(ClassAddr);
                         if (Class == nullptr) {
@@ -368,17 +387,19 @@ namespace DscImage {
                 }
 
                 CategoryList.emplace_back(std::move(Info));
-                ListAddr += PointerSize<Kind>();
             }
         } else {
             for (const auto &Addr : List) {
                 auto Info = std::make_unique<MachO::ObjcClassCategoryInfo>();
-                auto SwitchedAddr = SwitchEndianIf(Addr, IsBigEndian);
+                const auto SwitchedAddr =
+                    ReadPointer(ListAddr, SwitchEndianIf(Addr, IsBigEndian));
 
                 const auto Category =
                     DeVirt.GetDataAtVmAddr<ObjcCategoryType>(SwitchedAddr);
 
                 Info->setAddress(SwitchedAddr);
+                ListAddr += PointerSize<Kind>();
+
                 if (Category == nullptr) {
                     Info->setIsNull();
                     CategoryList.emplace_back(std::move(Info));
@@ -386,13 +407,15 @@ namespace DscImage {
                     continue;
                 }
 
-                const auto NameAddr = Category->getNameAddress(IsBigEndian);
+                const auto NameAddr =
+                    ReadPointer(SwitchedAddr + offsetof(ObjcCategoryType, Name),
+                                Category->getNameAddress(IsBigEndian));
+
                 if (const auto Name = DeVirt.GetStringAtAddress(NameAddr)) {
                     Info->setName(std::string(Name.value()));
                 }
 
                 CategoryList.emplace_back(std::move(Info));
-                ListAddr += PointerSize<Kind>();
             }
         }
     }
@@ -422,25 +445,27 @@ namespace DscImage {
             return *this;
         }
 
-        if (Is64Bit) {
-            ParseObjcClassCategorySection<PointerKind::s64Bit>(
-                Map,
-                ObjcClassCategorySection,
-                DeVirtualizer,
-                BindCollection,
-                ClassInfoTree,
-                List,
-                IsBigEndian);
-        } else {
-            ParseObjcClassCategorySection<PointerKind::s32Bit>(
-                Map,
-                ObjcClassCategorySection,
-                DeVirtualizer,
-                BindCollection,
-                ClassInfoTree,
-                List,
-                IsBigEndian);
-        }
+        const auto ParseWithEndian = [&](const auto BigEndian) noexcept {
+            if (Is64Bit) {
+                ParseObjcClassCategorySection<PointerKind::s64Bit, BigEndian()>(
+                    Map,
+                    ObjcClassCategorySection,
+                    DeVirtualizer,
+                    BindCollection,
+                    ClassInfoTree,
+                    List);
+            } else {
+                ParseObjcClassCategorySection<PointerKind::s32Bit, BigEndian()>(
+                    Map,
+                    ObjcClassCategorySection,
+                    DeVirtualizer,
+                    BindCollection,
+                    ClassInfoTree,
+                    List);
+            }
+        };
+
+        DispatchOnEndian(IsBigEndian, ParseWithEndian);
 
         return *this;
     }
@@ -493,25 +518,27 @@ namespace DscImage {
             return *this;
         }
 
-        if (Is64Bit) {
-            ParseObjcClassCategorySection<PointerKind::s64Bit>(
-                Map.getBegin(),
-                ObjcClassCategorySection,
-                DeVirtualizer,
-                &BindCollection,
-                ClassInfoTree,
-                List,
-                IsBigEndian);
-        } else {
-            ParseObjcClassCategorySection<PointerKind::s32Bit>(
-                Map.getBegin(),
-                ObjcClassCategorySection,
-                DeVirtualizer,
-                &BindCollection,
-                ClassInfoTree,
-                List,
-                IsBigEndian);
-        }
+        const auto ParseWithEndian = [&](const auto BigEndian) noexcept {
+            if (Is64Bit) {
+                ParseObjcClassCategorySection<PointerKind::s64Bit, BigEndian()>(
+                    Map.getBegin(),
+                    ObjcClassCategorySection,
+                    DeVirtualizer,
+                    &BindCollection,
+                    ClassInfoTree,
+                    List);
+            } else {
+                ParseObjcClassCategorySection<PointerKind::s32Bit, BigEndian()>(
+                    Map.getBegin(),
+                    ObjcClassCategorySection,
+                    DeVirtualizer,
+                    &BindCollection,
+                    ClassInfoTree,
+                    List);
+            }
+        };
+
+        DispatchOnEndian(IsBigEndian, ParseWithEndian);
 
         return *this;
     }
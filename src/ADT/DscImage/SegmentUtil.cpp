@@ -7,6 +7,7 @@
 //
 
 #include "ADT/DscImage/SegmentUtil.h"
+#include "ADT/Mach-O/LoadCommandIndex.h"
 
 namespace DscImage {
     auto
@@ -16,11 +17,25 @@ namespace DscImage {
         const bool Is64Bit,
         Error *const ErrorOut) noexcept
             -> SegmentInfoCollection
+    {
+        const auto LoadCmdIndex =
+            MachO::LoadCommandIndex::Build(LoadCmdStorage);
+
+        return Open(ImageAddress, LoadCmdIndex, Is64Bit, ErrorOut);
+    }
+
+    auto
+    SegmentInfoCollection::Open(
+        const uint64_t ImageAddress,
+        const MachO::LoadCommandIndex &LoadCmdIndex,
+        const bool Is64Bit,
+        Error *const ErrorOut) noexcept
+            -> SegmentInfoCollection
     {
         auto Result = SegmentInfoCollection();
 
         Result.ImageAddress = ImageAddress;
-        Result.ParseFromLoadCommands(LoadCmdStorage, Is64Bit, ErrorOut);
+        Result.ParseFromLoadCommands(LoadCmdIndex, Is64Bit, ErrorOut);
 
         return Result;
     }
@@ -0,0 +1,265 @@
+//
+//  ADT/DyldSharedCache/DependencyGraph.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <algorithm>
+#include "ADT/DyldSharedCache/DependencyGraph.h"
+
+namespace DyldSharedCache {
+    auto
+    DependencyGraph::Create(
+        const std::vector<std::vector<Edge>> &EdgeListList) noexcept
+            -> DependencyGraph
+    {
+        const auto NodeCount = static_cast<uint32_t>(EdgeListList.size());
+        auto Result = DependencyGraph();
+
+        Result.OffsetList.reserve(NodeCount + 1);
+
+        // Also count each node's dependents so the reversed edges can be
+        // placed directly into their final position.
+
+        auto DependentCountList = std::vector<uint32_t>(NodeCount + 1);
+        auto EdgeCount = uint32_t();
+
+        for (const auto &List : EdgeListList) {
+            for (const auto &Edge : List) {
+                assert(Edge.Node < NodeCount);
+                DependentCountList[Edge.Node + 1]++;
+            }
+
+            EdgeCount += static_cast<uint32_t>(List.size());
+            Result.OffsetList.emplace_back(EdgeCount);
+        }
+
+        Result.EdgeList.reserve(EdgeCount);
+        for (const auto &List : EdgeListList) {
+            Result.EdgeList.insert(Result.EdgeList.end(),
+                                   List.cbegin(),
+                                   List.cend());
+        }
+
+        for (auto I = uint32_t(1); I <= NodeCount; I++) {
+            DependentCountList[I] += DependentCountList[I - 1];
+        }
+
+        Result.ReverseOffsetList = DependentCountList;
+        Result.ReverseEdgeList.resize(EdgeCount);
+
+        // Visiting nodes in order keeps the dependents of each node in
+        // ascending order.
+
+        for (auto Node = uint32_t(); Node != NodeCount; Node++) {
+            for (const auto &Edge : EdgeListList[Node]) {
+                const auto Index = DependentCountList[Edge.Node]++;
+                Result.ReverseEdgeList[Index] = {
+                    .Node = Node,
+                    .Kind = Edge.Kind
+                };
+            }
+        }
+
+        return Result;
+    }
+
+    auto
+    DependencyGraph::GetReachableNodes(
+        const uint32_t Node,
+        const std::vector<uint32_t> &OffsetList,
+        const std::vector<Edge> &EdgeList,
+        const bool FollowUpward) const noexcept
+            -> std::vector<uint32_t>
+    {
+        auto Result = std::vector<uint32_t>();
+        auto VisitedList = std::vector<bool>(getNodeCount());
+
+        VisitedList[Node] = true;
+        Result.emplace_back(Node);
+
+        // Result doubles as the queue of the breadth-first search.
+        for (auto I = size_t(); I != Result.size(); I++) {
+            const auto Begin = EdgeList.data() + OffsetList[Result[I]];
+            const auto End = EdgeList.data() + OffsetList[Result[I] + 1];
+
+            for (auto Edge = Begin; Edge != End; Edge++) {
+                if (!ShouldFollowEdge(*Edge, FollowUpward)) {
+                    continue;
+                }
+
+                if (VisitedList[Edge->Node]) {
+                    continue;
+                }
+
+                VisitedList[Edge->Node] = true;
+                Result.emplace_back(Edge->Node);
+            }
+        }
+
+        Result.erase(Result.begin());
+        return Result;
+    }
+
+    bool
+    DependencyGraph::GetTopologicalOrder(std::vector<uint32_t> &OrderOut,
+                                         const bool FollowUpward) const noexcept
+    {
+        const auto NodeCount = getNodeCount();
+
+        // A node is ready once all of its dependencies are in the order, so
+        // count the dependencies left for each node.
+
+        auto RemainingList = std::vector<uint32_t>(NodeCount);
+        for (auto Node = uint32_t(); Node != NodeCount; Node++) {
+            for (const auto &Edge : getDependencies(Node)) {
+                if (ShouldFollowEdge(Edge, FollowUpward)) {
+                    RemainingList[Node]++;
+                }
+            }
+        }
+
+        OrderOut.clear();
+        OrderOut.reserve(NodeCount);
+
+        for (auto Node = uint32_t(); Node != NodeCount; Node++) {
+            if (RemainingList[Node] == 0) {
+                OrderOut.emplace_back(Node);
+            }
+        }
+
+        for (auto I = size_t(); I != OrderOut.size(); I++) {
+            for (const auto &Edge : getDependents(OrderOut[I])) {
+                if (!ShouldFollowEdge(Edge, FollowUpward)) {
+                    continue;
+                }
+
+                if (--RemainingList[Edge.Node] == 0) {
+                    OrderOut.emplace_back(Edge.Node);
+                }
+            }
+        }
+
+        if (OrderOut.size() == NodeCount) {
+            return true;
+        }
+
+        for (auto Node = uint32_t(); Node != NodeCount; Node++) {
+            if (RemainingList[Node] != 0) {
+                OrderOut.emplace_back(Node);
+            }
+        }
+
+        return false;
+    }
+
+    auto DependencyGraph::FindCycles(const bool FollowUpward) const noexcept
+        -> std::vector<std::vector<uint32_t>>
+    {
+        // Tarjan's algorithm, with an explicit stack, as a chain of
+        // dependencies can be as long as the amount of images.
+
+        constexpr auto Unvisited = UINT32_MAX;
+        struct Frame {
+            uint32_t Node;
+            uint32_t EdgeIndex;
+        };
+
+        const auto NodeCount = getNodeCount();
+
+        auto IndexList = std::vector<uint32_t>(NodeCount, Unvisited);
+        auto LowLinkList = std::vector<uint32_t>(NodeCount);
+        auto OnStackList = std::vector<bool>(NodeCount);
+
+        auto NodeStack = std::vector<uint32_t>();
+        auto CallStack = std::vector<Frame>();
+        auto NextIndex = uint32_t();
+
+        auto Result = std::vector<std::vector<uint32_t>>();
+        const auto Visit = [&](const uint32_t Node) noexcept {
+            IndexList[Node] = NextIndex;
+            LowLinkList[Node] = NextIndex;
+
+            NextIndex++;
+
+            NodeStack.emplace_back(Node);
+            OnStackList[Node] = true;
+
+            CallStack.emplace_back(Frame { .Node = Node, .EdgeIndex = 0 });
+        };
+
+        for (auto Root = uint32_t(); Root != NodeCount; Root++) {
+            if (IndexList[Root] != Unvisited) {
+                continue;
+            }
+
+            Visit(Root);
+            while (!CallStack.empty()) {
+                auto &Top = CallStack.back();
+
+                const auto Node = Top.Node;
+                const auto EdgeList = getDependencies(Node);
+
+                if (Top.EdgeIndex != EdgeList.size()) {
+                    const auto &Edge = EdgeList[Top.EdgeIndex++];
+                    if (!ShouldFollowEdge(Edge, FollowUpward)) {
+                        continue;
+                    }
+
+                    if (IndexList[Edge.Node] == Unvisited) {
+                        Visit(Edge.Node);
+                    } else if (OnStackList[Edge.Node]) {
+                        LowLinkList[Node] =
+                            std::min(LowLinkList[Node], IndexList[Edge.Node]);
+                    }
+
+                    continue;
+                }
+
+                CallStack.pop_back();
+                if (!CallStack.empty()) {
+                    const auto Parent = CallStack.back().Node;
+                    LowLinkList[Parent] =
+                        std::min(LowLinkList[Parent], LowLinkList[Node]);
+                }
+
+                if (LowLinkList[Node] != IndexList[Node]) {
+                    continue;
+                }
+
+                auto Component = std::vector<uint32_t>();
+                auto Member = uint32_t();
+
+                do {
+                    Member = NodeStack.back();
+                    NodeStack.pop_back();
+
+                    OnStackList[Member] = false;
+                    Component.emplace_back(Member);
+                } while (Member != Node);
+
+                if (Component.size() == 1) {
+                    const auto HasSelfEdge =
+                        std::any_of(EdgeList.begin(),
+                                    EdgeList.end(),
+                                    [&](const Edge &Edge) noexcept {
+                                        return Edge.Node == Node &&
+                                               ShouldFollowEdge(Edge,
+                                                                FollowUpward);
+                                    });
+
+                    if (!HasSelfEdge) {
+                        continue;
+                    }
+                }
+
+                std::sort(Component.begin(), Component.end());
+                Result.emplace_back(std::move(Component));
+            }
+        }
+
+        return Result;
+    }
+}
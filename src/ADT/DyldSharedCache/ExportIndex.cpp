@@ -0,0 +1,96 @@
+//
+//  ADT/DyldSharedCache/ExportIndex.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include "ADT/DyldSharedCache/ExportIndex.h"
+
+namespace DyldSharedCache {
+    auto
+    ExportIndex::Open(const MachO::ConstExportTrieExportList &Trie,
+                      Error *const ErrorOut) noexcept
+        -> ExportIndex
+    {
+        // Names are stored as offsets into the buffer until every export is
+        // read, as growing the buffer moves every name.
+
+        struct PendingEntry {
+            uint64_t NameOffset = 0;
+            uint64_t NameLength = 0;
+            uint64_t ImportNameOffset = 0;
+            uint64_t ImportNameLength = 0;
+
+            Entry Value = Entry();
+        };
+
+        auto Result = ExportIndex();
+        auto PendingList = std::vector<PendingEntry>();
+
+        const auto AddString = [&](const std::string_view String) noexcept {
+            auto &Buffer = Result.StringBuffer;
+            const auto Offset = static_cast<uint64_t>(Buffer.size());
+
+            Buffer.insert(Buffer.end(), String.begin(), String.end());
+            return Offset;
+        };
+
+        if (ErrorOut != nullptr) {
+            *ErrorOut = Error::None;
+        }
+
+        for (auto Iter = Trie.begin(); Iter != Trie.end(); Iter++) {
+            if (Iter.hasError()) {
+                if (ErrorOut != nullptr) {
+                    *ErrorOut = Iter.getError();
+                }
+
+                break;
+            }
+
+            const auto &Info = Iter->getExportInfo();
+            const auto Name = std::string_view(Iter->getStringRef());
+
+            auto Pending = PendingEntry {
+                .NameOffset = AddString(Name),
+                .NameLength = Name.length()
+            };
+
+            Pending.Value.Kind = Iter->getKind();
+
+            if (Info.isReexport()) {
+                const auto &ImportName = Info.getReexportImportName();
+
+                Pending.ImportNameOffset = AddString(ImportName);
+                Pending.ImportNameLength = ImportName.length();
+                Pending.Value.ReexportDylibOrdinal =
+                    Info.getReexportDylibOrdinal();
+            } else {
+                Pending.Value.ImageOffset = Info.getImageOffset();
+                if (Info.isStubAndResolver()) {
+                    Pending.Value.ResolverStubAddress =
+                        Info.getResolverStubAddress();
+                }
+            }
+
+            PendingList.emplace_back(std::move(Pending));
+        }
+
+        const auto Buffer = Result.StringBuffer.data();
+        for (auto &Pending : PendingList) {
+            Pending.Value.ReexportImportName =
+                std::string_view(Buffer + Pending.ImportNameOffset,
+                                 Pending.ImportNameLength);
+
+            const auto Name =
+                std::string_view(Buffer + Pending.NameOffset,
+                                 Pending.NameLength);
+
+            Result.Map.getOrInsert(Name) = Pending.Value;
+        }
+
+        return Result;
+    }
+}
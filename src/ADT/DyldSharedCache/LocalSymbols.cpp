@@ -0,0 +1,208 @@
+//
+//  ADT/DyldSharedCache/LocalSymbols.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <cstring>
+
+#include "ADT/DyldSharedCache/LocalSymbols.h"
+#include "Utils/DoesOverflow.h"
+
+namespace DyldSharedCache {
+    template <typename T>
+    [[nodiscard]] static auto
+    IsListInRange(const uint64_t Size,
+                  const uint64_t Offset,
+                  const uint64_t Count) noexcept
+    {
+        auto End = uint64_t();
+        if (DoesMultiplyAndAddOverflow(Count, sizeof(T), Offset, &End)) {
+            return false;
+        }
+
+        return End <= Size;
+    }
+
+    template <typename T>
+    static void
+    IndexEntries(const uint8_t *const Begin,
+                 const uint32_t Count,
+                 const uint32_t NlistCount,
+                 std::unordered_map<uint64_t, LocalSymbolsTable::Slice> &Map,
+                 LocalSymbolsTable::Error *const ErrorOut) noexcept
+    {
+        const auto List = reinterpret_cast<const T *>(Begin);
+
+        Map.reserve(Count);
+        for (auto I = uint32_t(); I != Count; I++) {
+            const auto &Entry = List[I];
+            if (Entry.NlistStartIndex > NlistCount ||
+                NlistCount - Entry.NlistStartIndex < Entry.NlistCount)
+            {
+                if (ErrorOut != nullptr) {
+                    *ErrorOut = LocalSymbolsTable::Error::InvalidEntry;
+                }
+
+                continue;
+            }
+
+            Map.emplace(Entry.DylibOffset, LocalSymbolsTable::Slice {
+                .NlistStartIndex = Entry.NlistStartIndex,
+                .NlistCount = Entry.NlistCount
+            });
+        }
+    }
+
+    auto
+    LocalSymbolsTable::Open(const ConstMemoryMap &Map,
+                            const bool Is64Bit,
+                            Error *const ErrorOut) noexcept
+        -> std::optional<LocalSymbolsTable>
+    {
+        const auto SetError = [&](const enum Error Error) noexcept {
+            if (ErrorOut != nullptr) {
+                *ErrorOut = Error;
+            }
+
+            return std::nullopt;
+        };
+
+        if (static_cast<uint64_t>(Map.size()) < sizeof(HeaderV2)) {
+            return SetError(Error::NoLocalSymbols);
+        }
+
+        const auto &Header = *Map.getBeginAs<HeaderV0>();
+        if (!Header.isV2()) {
+            return SetError(Error::NoLocalSymbols);
+        }
+
+        const auto &LocalsHeader = static_cast<const HeaderV2 &>(Header);
+        if (LocalsHeader.LocalSymbolsSize == 0) {
+            return SetError(Error::NoLocalSymbols);
+        }
+
+        const auto InfoRange = LocalsHeader.getLocalSymbolInfoRange();
+        if (!InfoRange.has_value() || !Map.containsLocRange(*InfoRange)) {
+            return SetError(Error::InvalidRange);
+        }
+
+        const auto Size = InfoRange->size();
+        if (Size < sizeof(LocalSymbolsInfo)) {
+            return SetError(Error::InvalidRange);
+        }
+
+        const auto Begin = Map.getBegin() + InfoRange->getBegin();
+        const auto &Info = *reinterpret_cast<const LocalSymbolsInfo *>(Begin);
+
+        const auto NlistSize =
+            Is64Bit ?
+                sizeof(MachO::SymbolTableEntry64) :
+                sizeof(MachO::SymbolTableEntry32);
+
+        auto NlistEnd = uint64_t();
+        if (DoesMultiplyAndAddOverflow(Info.NlistCount,
+                                       NlistSize,
+                                       Info.NlistOffset,
+                                       &NlistEnd) ||
+            NlistEnd > Size)
+        {
+            return SetError(Error::InvalidNlistRange);
+        }
+
+        auto StringsEnd = uint64_t();
+        if (DoesAddOverflow(Info.StringsOffset,
+                            Info.StringsSize,
+                            &StringsEnd) ||
+            StringsEnd > Size)
+        {
+            return SetError(Error::InvalidStringRange);
+        }
+
+        auto Result = LocalSymbolsTable();
+
+        Result.NlistBegin = Begin + Info.NlistOffset;
+        Result.NlistCount = Info.NlistCount;
+        Result.StringTable =
+            std::string_view(
+                reinterpret_cast<const char *>(Begin + Info.StringsOffset),
+                Info.StringsSize);
+        Result.Is64Bit = Is64Bit;
+
+        // Caches since dyld v940 use 64-bit entries, as images may be more
+        // than 4 GiB from the cache's base-address.
+
+        if (Header.isV8()) {
+            if (!IsListInRange<LocalSymbolsEntry64>(Size,
+                                                    Info.EntriesOffset,
+                                                    Info.EntriesCount))
+            {
+                return SetError(Error::InvalidEntryRange);
+            }
+
+            IndexEntries<LocalSymbolsEntry64>(Begin + Info.EntriesOffset,
+                                              Info.EntriesCount,
+                                              Info.NlistCount,
+                                              Result.SliceMap,
+                                              ErrorOut);
+        } else {
+            if (!IsListInRange<LocalSymbolsEntry>(Size,
+                                                  Info.EntriesOffset,
+                                                  Info.EntriesCount))
+            {
+                return SetError(Error::InvalidEntryRange);
+            }
+
+            IndexEntries<LocalSymbolsEntry>(Begin + Info.EntriesOffset,
+                                            Info.EntriesCount,
+                                            Info.NlistCount,
+                                            Result.SliceMap,
+                                            ErrorOut);
+        }
+
+        return Result;
+    }
+
+    auto
+    LocalSymbolsTable::OpenForCache(const ConstMemoryMap &CacheMap,
+                                    const ConstMemoryMap *const SymbolsFileMap,
+                                    const bool Is64Bit,
+                                    Error *const ErrorOut) noexcept
+        -> std::optional<LocalSymbolsTable>
+    {
+        const auto &Header = *CacheMap.getBeginAs<HeaderV0>();
+        if (!IsInSymbolsFile(Header)) {
+            return Open(CacheMap, Is64Bit, ErrorOut);
+        }
+
+        if (SymbolsFileMap == nullptr) {
+            if (ErrorOut != nullptr) {
+                *ErrorOut = Error::NeedsSymbolsFile;
+            }
+
+            return std::nullopt;
+        }
+
+        // The .symbols file has the cache's SymbolFileUUID as its own UUID.
+
+        const auto &CacheHeader = static_cast<const HeaderV8 &>(Header);
+        const auto &SymbolsHeader = *SymbolsFileMap->getBeginAs<HeaderV0>();
+
+        if (static_cast<uint64_t>(SymbolsFileMap->size()) < sizeof(HeaderV2) ||
+            !SymbolsHeader.isV2() ||
+            memcmp(static_cast<const HeaderV2 &>(SymbolsHeader).Uuid,
+                   CacheHeader.SymbolFileUUID,
+                   sizeof(CacheHeader.SymbolFileUUID)) != 0)
+        {
+            if (ErrorOut != nullptr) {
+                *ErrorOut = Error::SymbolsFileMismatch;
+            }
+
+            return std::nullopt;
+        }
+
+        return Open(*SymbolsFileMap, Is64Bit, ErrorOut);
+    }
+}
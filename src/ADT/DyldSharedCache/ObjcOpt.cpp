@@ -0,0 +1,477 @@
+//
+//  ADT/DyldSharedCache/ObjcOpt.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include "ADT/DyldSharedCache/ObjcOpt.h"
+
+namespace DyldSharedCache {
+    template <typename T>
+    [[nodiscard]] static inline T ReadValue(const uint8_t *const Ptr) noexcept {
+        auto Value = T();
+        memcpy(&Value, Ptr, sizeof(Value));
+
+        return Value;
+    }
+
+    [[nodiscard]] static inline uint64_t
+    ReadBytes(const uint8_t *const Ptr, const uint64_t Count) noexcept {
+        auto Value = uint64_t();
+        for (auto I = uint64_t(); I != Count; I++) {
+            Value |= static_cast<uint64_t>(Ptr[I]) << (I * 8);
+        }
+
+        return Value;
+    }
+
+    // Bob Jenkins' 64-bit hash (lookup8), which libobjc uses to build its
+    // tables.
+
+    [[nodiscard]] static uint64_t
+    Lookup8(const std::string_view Key, const uint64_t Level) noexcept {
+        const auto Mix = [](uint64_t &A, uint64_t &B, uint64_t &C) noexcept {
+            A -= B; A -= C; A ^= (C >> 43);
+            B -= C; B -= A; B ^= (A << 9);
+            C -= A; C -= B; C ^= (B >> 8);
+            A -= B; A -= C; A ^= (C >> 38);
+            B -= C; B -= A; B ^= (A << 23);
+            C -= A; C -= B; C ^= (B >> 5);
+            A -= B; A -= C; A ^= (C >> 35);
+            B -= C; B -= A; B ^= (A << 49);
+            C -= A; C -= B; C ^= (B >> 11);
+            A -= B; A -= C; A ^= (C >> 12);
+            B -= C; B -= A; B ^= (A << 18);
+            C -= A; C -= B; C ^= (B >> 22);
+        };
+
+        auto Ptr = reinterpret_cast<const uint8_t *>(Key.data());
+        auto Length = static_cast<uint64_t>(Key.size());
+
+        auto A = Level;
+        auto B = Level;
+        auto C = uint64_t(0x9e3779b97f4a7c13);
+
+        while (Length >= 24) {
+            A += ReadBytes(Ptr, 8);
+            B += ReadBytes(Ptr + 8, 8);
+            C += ReadBytes(Ptr + 16, 8);
+
+            Mix(A, B, C);
+
+            Ptr += 24;
+            Length -= 24;
+        }
+
+        // The lowest byte of C is reserved for the length, so C only receives
+        // bytes 16 through 22 of the tail, shifted up by a byte.
+
+        C += static_cast<uint64_t>(Key.size());
+        if (Length > 16) {
+            C += ReadBytes(Ptr + 16, Length - 16) << 8;
+        }
+
+        if (Length > 8) {
+            B += ReadBytes(Ptr + 8, std::min(Length, uint64_t(16)) - 8);
+        }
+
+        A += ReadBytes(Ptr, std::min(Length, uint64_t(8)));
+        Mix(A, B, C);
+
+        return C;
+    }
+
+    auto
+    ObjcStringHashTable::Open(const uint8_t *const Begin,
+                              const uint64_t Address,
+                              const uint64_t MaxSize) noexcept
+        -> std::optional<ObjcStringHashTable>
+    {
+        // Capacity, occupied, shift, mask, and two unused fields, followed by
+        // a 64-bit salt, and then a 256-entry scramble-list.
+
+        constexpr auto HeaderSize = sizeof(uint32_t) * 6 + sizeof(uint64_t);
+        constexpr auto ScrambleListSize = sizeof(uint32_t) * 256;
+
+        if (MaxSize < HeaderSize + ScrambleListSize) {
+            return std::nullopt;
+        }
+
+        auto Result = ObjcStringHashTable();
+
+        Result.Begin = Begin;
+        Result.Address = Address;
+        Result.Capacity = ReadValue<uint32_t>(Begin);
+        Result.Occupied = ReadValue<uint32_t>(Begin + 4);
+        Result.Shift = ReadValue<uint32_t>(Begin + 8);
+        Result.Mask = ReadValue<uint32_t>(Begin + 12);
+        Result.Salt = ReadValue<uint64_t>(Begin + 24);
+
+        const auto TabSize = static_cast<uint64_t>(Result.Mask) + 1;
+        const auto Capacity = static_cast<uint64_t>(Result.Capacity);
+        const auto Size =
+            HeaderSize + ScrambleListSize + TabSize +
+            Capacity + sizeof(int32_t) * Capacity;
+
+        if (Size > MaxSize) {
+            return std::nullopt;
+        }
+
+        Result.ScrambleList = Begin + HeaderSize;
+        Result.Tab = Result.ScrambleList + ScrambleListSize;
+        Result.CheckByteList = Result.Tab + TabSize;
+        Result.OffsetList = Result.CheckByteList + Capacity;
+        Result.ExtraDataMaxSize = MaxSize - Size;
+
+        return Result;
+    }
+
+    uint32_t
+    ObjcStringHashTable::Hash(const std::string_view Key) const noexcept {
+        const auto Value = Lookup8(Key, Salt);
+        const auto TabIndex = Value & Mask;
+        const auto ScrambleOffset =
+            sizeof(uint32_t) * static_cast<uint64_t>(Tab[TabIndex]);
+        const auto Scramble =
+            ReadValue<uint32_t>(ScrambleList + ScrambleOffset);
+
+        const auto High = (Shift < 64) ? (Value >> Shift) : 0;
+        return static_cast<uint32_t>(High) ^ Scramble;
+    }
+
+    auto
+    ObjcStringHashTable::GetStringAddress(const uint32_t Index) const noexcept
+        -> std::optional<uint64_t>
+    {
+        if (Index >= Capacity) {
+            return std::nullopt;
+        }
+
+        const auto Offset =
+            ReadValue<int32_t>(OffsetList + sizeof(int32_t) * Index);
+
+        if (Offset == 0) {
+            return std::nullopt;
+        }
+
+        return Address + static_cast<uint64_t>(Offset);
+    }
+
+    uint32_t
+    ObjcStringHashTable::GetIndex(
+        const DscImage::ConstDeVirtualizer &DeVirtualizer,
+        const std::string_view Key) const noexcept
+    {
+        const auto Index = this->Hash(Key);
+        if (Index >= Capacity) {
+            return NotFound;
+        }
+
+        // The check-byte rejects most missing keys without reading the
+        // string at the index.
+
+        const auto First = Key.empty() ? 0 : static_cast<uint8_t>(Key.front());
+        const auto CheckByte =
+            static_cast<uint8_t>(((First & 0x7) << 5) | (Key.size() & 0x1f));
+
+        if (CheckByteList[Index] != CheckByte) {
+            return NotFound;
+        }
+
+        const auto StringAddr = this->GetStringAddress(Index);
+        if (!StringAddr.has_value()) {
+            return NotFound;
+        }
+
+        const auto String =
+            DeVirtualizer.GetStringAtAddress(StringAddr.value());
+
+        if (!String.has_value() || String.value() != Key) {
+            return NotFound;
+        }
+
+        return Index;
+    }
+
+    auto
+    ObjcOptInfo::Open(const DscImage::ConstDeVirtualizer &DeVirtualizer,
+                      const uint64_t Address,
+                      const uint64_t Size,
+                      const bool Is64Bit,
+                      Error *const ErrorOut) noexcept
+        -> ObjcOptInfo
+    {
+        auto Result = ObjcOptInfo(DeVirtualizer);
+
+        Result.Address = Address;
+        Result.Is64Bit = Is64Bit;
+
+        const auto Begin =
+            DeVirtualizer.GetDataAtVmAddr<uint8_t>(Address, Size);
+
+        if (Begin == nullptr || Size < sizeof(uint32_t)) {
+            *ErrorOut = Error::SectionTooSmall;
+            return Result;
+        }
+
+        Result.Version = ReadValue<uint32_t>(Begin);
+        if (Result.Version < MinVersion || Result.Version > MaxVersion) {
+            *ErrorOut = Error::UnsupportedVersion;
+            return Result;
+        }
+
+        // Versions 14 and later have a flags field after the version, and
+        // separate read-only and read-write header-info lists.
+
+        const auto HasFlags = Result.Version >= 14;
+        const auto SelectorTableFieldOffset = HasFlags ? 8 : 4;
+        const auto ClassTableFieldOffset = HasFlags ? 16 : 12;
+        const auto ProtocolTableFieldOffset = HasFlags ? 20 : 16;
+
+        auto HeaderSize = uint64_t();
+        switch (Result.Version) {
+            case 12:
+                HeaderSize = 16;
+                break;
+            case 13:
+                HeaderSize = 20;
+                break;
+            case 14:
+            case 15:
+                HeaderSize = 28;
+                break;
+            case 16:
+                HeaderSize = 48;
+                break;
+        }
+
+        if (Size < HeaderSize) {
+            *ErrorOut = Error::SectionTooSmall;
+            return Result;
+        }
+
+        // Every table's offset is from the start of the section, with 0
+        // meaning the table is missing.
+
+        auto InvalidTable = false;
+        const auto OpenTable = [&](const uint64_t FieldOffset) noexcept
+            -> std::optional<ObjcStringHashTable>
+        {
+            if (FieldOffset + sizeof(int32_t) > HeaderSize) {
+                return std::nullopt;
+            }
+
+            const auto Offset = ReadValue<int32_t>(Begin + FieldOffset);
+            if (Offset == 0) {
+                return std::nullopt;
+            }
+
+            if (Offset < 0 || static_cast<uint64_t>(Offset) >= Size) {
+                InvalidTable = true;
+                return std::nullopt;
+            }
+
+            const auto TableOffset = static_cast<uint64_t>(Offset);
+            const auto Table =
+                ObjcStringHashTable::Open(Begin + TableOffset,
+                                          Address + TableOffset,
+                                          Size - TableOffset);
+
+            if (!Table.has_value()) {
+                InvalidTable = true;
+            }
+
+            return Table;
+        };
+
+        Result.SelectorTable = OpenTable(SelectorTableFieldOffset);
+        Result.ClassTable = OpenTable(ClassTableFieldOffset);
+
+        // Version 16 has a second protocol-table that also stores the
+        // header-info of each protocol, and replaces the first.
+
+        if (Result.Version >= 16) {
+            Result.ProtocolTable = OpenTable(28);
+            Result.ProtocolTableHasHeaderInfo =
+                Result.ProtocolTable.has_value();
+
+            const auto RelativeSelectorBaseFieldOffset = uint64_t(40);
+            const auto RelativeSelectorBaseOffset =
+                ReadValue<int64_t>(Begin + RelativeSelectorBaseFieldOffset);
+
+            if (RelativeSelectorBaseOffset != 0) {
+                Result.RelativeSelectorBase =
+                    Address + RelativeSelectorBaseFieldOffset +
+                    static_cast<uint64_t>(RelativeSelectorBaseOffset);
+            }
+        }
+
+        if (!Result.ProtocolTable.has_value()) {
+            Result.ProtocolTable = OpenTable(ProtocolTableFieldOffset);
+        }
+
+        if (InvalidTable) {
+            *ErrorOut = Error::InvalidTable;
+            return Result;
+        }
+
+        *ErrorOut = Error::None;
+        return Result;
+    }
+
+    // The class-table stores a class-offset for every index, followed by the
+    // count of duplicate class-offsets, and then the duplicates themselves.
+
+    auto
+    ObjcOptInfo::GetClassOffset(const ObjcStringHashTable &Table,
+                                const uint32_t Index) const noexcept
+        -> std::optional<ClassOffset>
+    {
+        if (Index >= Table.getCapacity()) {
+            return std::nullopt;
+        }
+
+        const auto Offset = sizeof(ClassOffset) * Index;
+        if (Offset + sizeof(ClassOffset) > Table.getExtraDataMaxSize()) {
+            return std::nullopt;
+        }
+
+        return ReadValue<ClassOffset>(Table.getExtraData() + Offset);
+    }
+
+    auto
+    ObjcOptInfo::GetDuplicateClassOffset(const ObjcStringHashTable &Table,
+                                         const uint32_t Index) const noexcept
+        -> std::optional<ClassOffset>
+    {
+        const auto CountOffset =
+            sizeof(ClassOffset) * static_cast<uint64_t>(Table.getCapacity());
+
+        const auto MaxSize = Table.getExtraDataMaxSize();
+        if (CountOffset + sizeof(uint32_t) > MaxSize) {
+            return std::nullopt;
+        }
+
+        const auto Data = Table.getExtraData();
+        const auto Count = ReadValue<uint32_t>(Data + CountOffset);
+
+        if (Index >= Count) {
+            return std::nullopt;
+        }
+
+        const auto Offset =
+            CountOffset + sizeof(uint32_t) + sizeof(ClassOffset) * Index;
+
+        if (Offset + sizeof(ClassOffset) > MaxSize) {
+            return std::nullopt;
+        }
+
+        return ReadValue<ClassOffset>(Data + Offset);
+    }
+
+    auto ObjcOptInfo::FindSelector(const std::string_view Name) const noexcept
+        -> std::optional<uint64_t>
+    {
+        if (!SelectorTable.has_value()) {
+            return std::nullopt;
+        }
+
+        const auto &Table = SelectorTable.value();
+        const auto Index = Table.GetIndex(DeVirtualizer, Name);
+
+        if (Index == ObjcStringHashTable::NotFound) {
+            return std::nullopt;
+        }
+
+        return Table.GetStringAddress(Index);
+    }
+
+    auto ObjcOptInfo::FindProtocol(const std::string_view Name) const noexcept
+        -> std::optional<uint64_t>
+    {
+        if (!ProtocolTable.has_value()) {
+            return std::nullopt;
+        }
+
+        const auto &Table = ProtocolTable.value();
+        const auto Index = Table.GetIndex(DeVirtualizer, Name);
+
+        if (Index == ObjcStringHashTable::NotFound) {
+            return std::nullopt;
+        }
+
+        if (ProtocolTableHasHeaderInfo) {
+            auto Result = std::optional<uint64_t>();
+            ForEachClassAtIndex(Table, Index, [&](const ClassEntry &Entry) {
+                if (!Result.has_value()) {
+                    Result = Entry.ClassAddress;
+                }
+            });
+
+            return Result;
+        }
+
+        // The first protocol-table only stores an offset to each protocol.
+        const auto Offset = sizeof(int32_t) * Index;
+        if (Offset + sizeof(int32_t) > Table.getExtraDataMaxSize()) {
+            return std::nullopt;
+        }
+
+        const auto ProtocolOffset =
+            ReadValue<int32_t>(Table.getExtraData() + Offset);
+
+        return Table.getAddress() + static_cast<uint64_t>(ProtocolOffset);
+    }
+
+    auto ObjcOptInfo::FindClass(const std::string_view Name) const noexcept
+        -> std::vector<ClassEntry>
+    {
+        auto Result = std::vector<ClassEntry>();
+        if (!ClassTable.has_value()) {
+            return Result;
+        }
+
+        const auto &Table = ClassTable.value();
+        const auto Index = Table.GetIndex(DeVirtualizer, Name);
+
+        if (Index == ObjcStringHashTable::NotFound) {
+            return Result;
+        }
+
+        ForEachClassAtIndex(Table, Index, [&](const ClassEntry &Entry) {
+            Result.emplace_back(Entry);
+        });
+
+        return Result;
+    }
+
+    auto
+    ObjcOptInfo::GetImageAddressForHeaderInfo(
+        const uint64_t HeaderInfoAddress) const noexcept
+            -> std::optional<uint64_t>
+    {
+        // Starting with version 14, a header-info starts with a signed
+        // pointer-sized offset from itself to its image's mach-header.
+
+        if (Version < 14) {
+            return std::nullopt;
+        }
+
+        const auto PtrSize = Is64Bit ? sizeof(uint64_t) : sizeof(uint32_t);
+        const auto Ptr =
+            DeVirtualizer.GetDataAtVmAddr<uint8_t>(HeaderInfoAddress, PtrSize);
+
+        if (Ptr == nullptr) {
+            return std::nullopt;
+        }
+
+        const auto Offset =
+            Is64Bit ?
+                ReadValue<int64_t>(Ptr) :
+                static_cast<int64_t>(ReadValue<int32_t>(Ptr));
+
+        return HeaderInfoAddress + static_cast<uint64_t>(Offset);
+    }
+}
@@ -0,0 +1,175 @@
+//
+//  ADT/DyldSharedCache/RebasedView.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "ADT/DyldSharedCache/RebasedView.h"
+
+namespace DyldSharedCache {
+    RebasedView::RebasedView(const ConstMemoryMap &Map,
+                             const uint32_t PageCapacity) noexcept
+    : Map(Map.getBegin()), PageCapacity(std::max(PageCapacity, 1u)),
+      ShardPageCapacity(
+        std::max((this->PageCapacity + ShardCount - 1) / ShardCount, 1u))
+    {
+        auto Error = SlideInfo::Error::None;
+
+        SlideInfoList = SlideInfo::OpenAll(Map, &Error);
+        if (!SlideInfoList.empty()) {
+            PointerFormat = SlideInfoList.front().getPointerFormat();
+        }
+    }
+
+    auto
+    RebasedView::GetSlideInfoForAddress(const uint64_t Address) const noexcept
+        -> const SlideInfo *
+    {
+        for (const auto &Info : SlideInfoList) {
+            const auto Begin = Info.getMappingAddress();
+            if (Address >= Begin && Address - Begin < Info.getMappingSize()) {
+                return &Info;
+            }
+        }
+
+        return nullptr;
+    }
+
+    auto
+    RebasedView::GetPage(Shard &Shard,
+                         const SlideInfo &Info,
+                         const uint32_t Index) const noexcept -> const Page &
+    {
+        auto &PageList = Shard.PageList;
+        auto &PageMap = Shard.PageMap;
+
+        const auto PageOffset =
+            static_cast<uint64_t>(Index) * Info.getPageSize();
+        const auto PageAddress = Info.getMappingAddress() + PageOffset;
+
+        if (const auto It = PageMap.find(PageAddress); It != PageMap.end()) {
+            PageList.splice(PageList.begin(), PageList, It->second);
+            return PageList.front();
+        }
+
+        if (PageList.size() >= ShardPageCapacity) {
+            PageMap.erase(PageList.back().Address);
+            PageList.pop_back();
+        }
+
+        // The last page of a mapping may be cut short.
+
+        const auto PageSize =
+            std::min(static_cast<uint64_t>(Info.getPageSize()),
+                     Info.getMappingSize() - PageOffset);
+        const auto PageBegin = Map + Info.getMappingFileOffset() + PageOffset;
+
+        auto &Page = PageList.emplace_front();
+
+        Page.Address = PageAddress;
+        Page.Data.assign(PageBegin, PageBegin + PageSize);
+
+        PageMap.emplace(PageAddress, PageList.begin());
+
+        // A page that couldn't be fully decoded still has the pointers of its
+        // chains up to the invalid pointer rebased.
+
+        auto RebaseList = std::vector<SlideInfo::Rebase>();
+        static_cast<void>(Info.DecodePage(Index, RebaseList));
+
+        const auto PointerSize = Info.getPointerFormat().getPointerSize();
+        for (const auto &Rebase : RebaseList) {
+            const auto Offset = Rebase.Address - PageAddress;
+            if (Offset >= PageSize || PageSize - Offset < PointerSize) {
+                continue;
+            }
+
+            const auto Target = Rebase.Pointer.Target;
+            if (PointerSize == sizeof(uint32_t)) {
+                const auto Value = static_cast<uint32_t>(Target);
+                memcpy(Page.Data.data() + Offset, &Value, sizeof(Value));
+            } else {
+                memcpy(Page.Data.data() + Offset, &Target, sizeof(Target));
+            }
+        }
+
+        return Page;
+    }
+
+    auto
+    RebasedView::ReadData(uint64_t Address,
+                          uint64_t Size,
+                          void *const Out) const noexcept -> bool
+    {
+        if (Address + Size < Address) {
+            return false;
+        }
+
+        auto Dest = static_cast<uint8_t *>(Out);
+        while (Size != 0) {
+            const auto Info = GetSlideInfoForAddress(Address);
+            if (Info == nullptr || Info->getPageSize() == 0) {
+                return false;
+            }
+
+            const auto MappingOffset = Address - Info->getMappingAddress();
+            const auto Index =
+                static_cast<uint32_t>(MappingOffset / Info->getPageSize());
+
+            if (Index >= Info->getPageCount()) {
+                return false;
+            }
+
+            // Neighbouring pages go to different shards, as reads tend to
+            // be close together.
+
+            auto &Shard = ShardList[Index % ShardCount];
+            const auto Guard = std::lock_guard(Shard.Lock);
+
+            const auto &Page = GetPage(Shard, *Info, Index);
+            const auto PageOffset = Address - Page.Address;
+
+            if (PageOffset >= Page.Data.size()) {
+                return false;
+            }
+
+            const auto CopySize =
+                std::min(Size, Page.Data.size() - PageOffset);
+
+            memcpy(Dest, Page.Data.data() + PageOffset, CopySize);
+
+            Dest += CopySize;
+            Address += CopySize;
+            Size -= CopySize;
+        }
+
+        return true;
+    }
+
+    auto
+    RebasedView::ReadPointer(const uint64_t Address,
+                             const bool Is64Bit) const noexcept
+        -> std::optional<uint64_t>
+    {
+        if (Is64Bit) {
+            auto Value = uint64_t();
+            if (!ReadData(Address, sizeof(Value), &Value)) {
+                return std::nullopt;
+            }
+
+            return Value;
+        }
+
+        auto Value = uint32_t();
+        if (!ReadData(Address, sizeof(Value), &Value)) {
+            return std::nullopt;
+        }
+
+        return Value;
+    }
+}
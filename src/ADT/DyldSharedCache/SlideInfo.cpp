@@ -0,0 +1,690 @@
+//
+//  ADT/DyldSharedCache/SlideInfo.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <thread>
+
+#include "ADT/DyldSharedCache/SlideInfo.h"
+#include "Utils/DoesOverflow.h"
+
+namespace DyldSharedCache {
+    auto SlidePointerFormat::DecodePointer(const uint64_t Value) const noexcept
+        -> SlidPointer
+    {
+        auto Result = SlidPointer();
+        switch (Version) {
+            case SlideInfoVersion::None:
+            case SlideInfoVersion::V1:
+                Result.Target = Value;
+                break;
+            case SlideInfoVersion::V2:
+                Result.Target = Value & ~DeltaMask;
+                if (Result.Target != 0) {
+                    Result.Target += ValueAdd;
+                }
+
+                break;
+            case SlideInfoVersion::V3:
+                if ((Value >> 63) != 0) {
+                    Result.Target = (Value & 0xffffffff) + ValueAdd;
+                    Result.Diversity = static_cast<uint16_t>(Value >> 32);
+                    Result.HasAddressDiversity = ((Value >> 48) & 1) != 0;
+                    Result.Key = static_cast<uint8_t>((Value >> 49) & 0x3);
+                    Result.IsAuthenticated = true;
+                } else {
+                    // The top 8 bits of the pointer are stored just below the
+                    // bottom 43 bits.
+
+                    const auto Top8 = Value & 0x0007f80000000000;
+                    const auto Bottom43 = Value & 0x000007ffffffffff;
+
+                    Result.Target = (Top8 << 13) | Bottom43;
+                }
+
+                break;
+            case SlideInfoVersion::V4: {
+                // Small positive and negative numbers are stored unchanged, as
+                // they can't be pointers.
+
+                auto Value32 = static_cast<uint32_t>(Value & ~DeltaMask);
+                if ((Value32 & 0xffff8000) == 0) {
+                    Result.Target = Value32;
+                } else if ((Value32 & 0x3fff8000) == 0x3fff8000) {
+                    Result.Target = Value32 | 0xc0000000;
+                } else {
+                    Value32 += static_cast<uint32_t>(ValueAdd);
+                    Result.Target = Value32;
+                }
+
+                break;
+            }
+            case SlideInfoVersion::V5: {
+                if (Value == 0) {
+                    break;
+                }
+
+                const auto RuntimeOffset = Value & 0x3ffffffff;
+                if ((Value >> 63) != 0) {
+                    Result.Target = ValueAdd + RuntimeOffset;
+                    Result.Diversity = static_cast<uint16_t>(Value >> 34);
+                    Result.HasAddressDiversity = ((Value >> 50) & 1) != 0;
+
+                    // Authenticated pointers of V5 are signed with either the
+                    // IA or DA keys.
+
+                    Result.Key = ((Value >> 51) & 1) != 0 ? 2 : 0;
+                    Result.IsAuthenticated = true;
+                } else {
+                    const auto High8 = (Value >> 34) & 0xff;
+                    Result.Target = (ValueAdd + RuntimeOffset) | (High8 << 56);
+                }
+
+                break;
+            }
+        }
+
+        return Result;
+    }
+
+    auto SlidePointerFormat::GetChainDelta(const uint64_t Value) const noexcept
+        -> uint64_t
+    {
+        switch (Version) {
+            case SlideInfoVersion::None:
+            case SlideInfoVersion::V1:
+                return 0;
+            case SlideInfoVersion::V2:
+            case SlideInfoVersion::V4: {
+                // Deltas are stored in units of 4 bytes.
+                const auto Shift = std::countr_zero(DeltaMask) - 2;
+                return (Value & DeltaMask) >> Shift;
+            }
+            case SlideInfoVersion::V3:
+                return ((Value >> 51) & 0x7ff) * sizeof(uint64_t);
+            case SlideInfoVersion::V5:
+                return ((Value >> 52) & 0x7ff) * sizeof(uint64_t);
+        }
+
+        return 0;
+    }
+
+    auto SlidePointerFormat::Open(const ConstMemoryMap &Map) noexcept
+        -> SlidePointerFormat
+    {
+        auto Error = SlideInfo::Error::None;
+        const auto List = SlideInfo::OpenAll(Map, &Error);
+
+        if (List.empty()) {
+            return SlidePointerFormat();
+        }
+
+        return List.front().getPointerFormat();
+    }
+
+    template <typename T>
+    [[nodiscard]] static inline auto
+    IsListInRange(const uint64_t Size,
+                  const uint64_t Offset,
+                  const uint64_t Count) noexcept
+    {
+        auto End = uint64_t();
+        if (DoesMultiplyAndAddOverflow(Count, sizeof(T), Offset, &End)) {
+            return false;
+        }
+
+        return End <= Size;
+    }
+
+    auto
+    SlideInfo::Open(const ConstMemoryMap &Map,
+                    const uint32_t MappingIndex,
+                    const uint64_t MappingAddress,
+                    const uint64_t MappingSize,
+                    const uint64_t MappingFileOffset,
+                    const Range &SlideInfoRange,
+                    Error *const ErrorOut) noexcept
+        -> std::optional<SlideInfo>
+    {
+        const auto SetError = [&](const enum Error Error) noexcept {
+            if (ErrorOut != nullptr) {
+                *ErrorOut = Error;
+            }
+
+            return std::nullopt;
+        };
+
+        const auto MappingRange =
+            Range::CreateWithSize(MappingFileOffset, MappingSize);
+
+        if (!Map.containsLocRange(SlideInfoRange) ||
+            !Map.containsLocRange(MappingRange))
+        {
+            return SetError(Error::InvalidRange);
+        }
+
+        const auto Size = SlideInfoRange.size();
+        if (Size < sizeof(uint32_t)) {
+            return SetError(Error::InvalidRange);
+        }
+
+        auto Result = SlideInfo();
+
+        Result.Map = Map.getBegin();
+        Result.Begin = Map.getBegin() + SlideInfoRange.getBegin();
+        Result.Size = Size;
+        Result.MappingIndex = MappingIndex;
+        Result.MappingAddress = MappingAddress;
+        Result.MappingSize = MappingSize;
+        Result.MappingFileOffset = MappingFileOffset;
+
+        const auto Version = *reinterpret_cast<const uint32_t *>(Result.Begin);
+        switch (Version) {
+            case 1: {
+                if (Size < sizeof(SlideInfoV1)) {
+                    return SetError(Error::InvalidRange);
+                }
+
+                const auto &Info =
+                    *reinterpret_cast<const SlideInfoV1 *>(Result.Begin);
+
+                if (!IsListInRange<uint16_t>(Size,
+                                             Info.TocOffset,
+                                             Info.TocCount))
+                {
+                    return SetError(Error::InvalidPageStarts);
+                }
+
+                // Every entry has a bit for each 32-bit word of a 4096-byte
+                // page.
+
+                if (Info.EntriesSize == 0 || Info.EntriesSize > 128) {
+                    return SetError(Error::InvalidPageSize);
+                }
+
+                auto EntriesEnd = uint64_t();
+                if (DoesMultiplyAndAddOverflow(Info.EntriesCount,
+                                               Info.EntriesSize,
+                                               Info.EntriesOffset,
+                                               &EntriesEnd) ||
+                    EntriesEnd > Size)
+                {
+                    return SetError(Error::InvalidPageStarts);
+                }
+
+                Result.Format.Version = SlideInfoVersion::V1;
+                Result.PageSize = 4096;
+                Result.PageCount = Info.TocCount;
+
+                break;
+            }
+            case 2:
+            case 4: {
+                // V2 and V4 share the same layout.
+                static_assert(sizeof(SlideInfoV2) == sizeof(SlideInfoV4));
+
+                if (Size < sizeof(SlideInfoV2)) {
+                    return SetError(Error::InvalidRange);
+                }
+
+                const auto &Info =
+                    *reinterpret_cast<const SlideInfoV2 *>(Result.Begin);
+
+                if (Info.PageSize == 0) {
+                    return SetError(Error::InvalidPageSize);
+                }
+
+                if (!IsListInRange<uint16_t>(Size,
+                                             Info.PageStartsOffset,
+                                             Info.PageStartsCount))
+                {
+                    return SetError(Error::InvalidPageStarts);
+                }
+
+                if (!IsListInRange<uint16_t>(Size,
+                                             Info.PageExtrasOffset,
+                                             Info.PageExtrasCount))
+                {
+                    return SetError(Error::InvalidPageExtras);
+                }
+
+                // Deltas are shifted down to units of 4 bytes, so the mask has
+                // to start at or after the 2nd bit.
+
+                if (Info.DeltaMask == 0 ||
+                    std::countr_zero(Info.DeltaMask) < 2)
+                {
+                    return SetError(Error::InvalidChain);
+                }
+
+                Result.Format.Version =
+                    (Version == 2) ?
+                        SlideInfoVersion::V2 : SlideInfoVersion::V4;
+
+                Result.Format.DeltaMask = Info.DeltaMask;
+                Result.Format.ValueAdd = Info.ValueAdd;
+                Result.PageSize = Info.PageSize;
+                Result.PageCount = Info.PageStartsCount;
+
+                break;
+            }
+            case 3:
+            case 5: {
+                // V3 and V5 share the same layout, with the page-starts
+                // directly after the header.
+
+                static_assert(sizeof(SlideInfoV3) == sizeof(SlideInfoV5));
+                if (Size < sizeof(SlideInfoV3)) {
+                    return SetError(Error::InvalidRange);
+                }
+
+                const auto &Info =
+                    *reinterpret_cast<const SlideInfoV3 *>(Result.Begin);
+
+                if (Info.PageSize == 0) {
+                    return SetError(Error::InvalidPageSize);
+                }
+
+                if (!IsListInRange<uint16_t>(Size,
+                                             sizeof(SlideInfoV3),
+                                             Info.PageStartsCount))
+                {
+                    return SetError(Error::InvalidPageStarts);
+                }
+
+                Result.Format.Version =
+                    (Version == 3) ?
+                        SlideInfoVersion::V3 : SlideInfoVersion::V5;
+
+                Result.Format.ValueAdd = Info.AuthValueAdd;
+                Result.PageSize = Info.PageSize;
+                Result.PageCount = Info.PageStartsCount;
+
+                break;
+            }
+            default:
+                return SetError(Error::UnknownVersion);
+        }
+
+        return Result;
+    }
+
+    auto
+    SlideInfo::OpenAll(const ConstMemoryMap &Map,
+                       Error *const ErrorOut) noexcept
+        -> std::vector<SlideInfo>
+    {
+        auto Result = std::vector<SlideInfo>();
+        if (static_cast<uint64_t>(Map.size()) < sizeof(HeaderV0)) {
+            return Result;
+        }
+
+        const auto &Header = *Map.getBeginAs<HeaderV0>();
+        const auto MapSize = static_cast<uint64_t>(Map.size());
+
+        // Since V7, every mapping has its own slide-info, while older caches
+        // only had slide-info for their second mapping, which held all of
+        // their data.
+
+        if (Header.isV7()) {
+            const auto &HeaderV7 = static_cast<const struct HeaderV7 &>(Header);
+            if (!IsListInRange<MappingWithSlideInfo>(
+                    MapSize,
+                    HeaderV7.MappingWithSlideOffset,
+                    HeaderV7.MappingWithSlideCount))
+            {
+                if (ErrorOut != nullptr) {
+                    *ErrorOut = Error::InvalidRange;
+                }
+
+                return Result;
+            }
+
+            const auto List = HeaderV7.getConstMappingWithSlideInfoList();
+            for (auto I = uint32_t(); I != List.count(); I++) {
+                const auto &Mapping = List.at(I);
+                if (Mapping.SlideInfoFileSize == 0) {
+                    continue;
+                }
+
+                const auto SlideInfoRange =
+                    Range::CreateWithSize(Mapping.SlideInfoFileOffset,
+                                          Mapping.SlideInfoFileSize);
+
+                auto Info =
+                    Open(Map,
+                         I,
+                         Mapping.Address,
+                         Mapping.Size,
+                         Mapping.FileOffset,
+                         SlideInfoRange,
+                         ErrorOut);
+
+                if (!Info.has_value()) {
+                    break;
+                }
+
+                Result.emplace_back(std::move(Info.value()));
+            }
+
+            return Result;
+        }
+
+        if (!Header.isV1() || Header.MappingCount < 2) {
+            return Result;
+        }
+
+        const auto &HeaderV1 = static_cast<const struct HeaderV1 &>(Header);
+        if (HeaderV1.SlideInfoSize == 0) {
+            return Result;
+        }
+
+        const auto &Mapping = Header.getConstMappingInfoList().at(1);
+        const auto SlideInfoRange =
+            Range::CreateWithSize(HeaderV1.SlideInfoOffset,
+                                  HeaderV1.SlideInfoSize);
+
+        auto Info =
+            Open(Map,
+                 1,
+                 Mapping.Address,
+                 Mapping.Size,
+                 Mapping.FileOffset,
+                 SlideInfoRange,
+                 ErrorOut);
+
+        if (Info.has_value()) {
+            Result.emplace_back(std::move(Info.value()));
+        }
+
+        return Result;
+    }
+
+    auto
+    SlideInfo::DecodeChain(const uint64_t PageOffset,
+                           uint64_t ChainOffset,
+                           std::vector<Rebase> &ListOut) const noexcept
+        -> Error
+    {
+        const auto PointerSize = Format.getPointerSize();
+        const auto PageBegin = Map + MappingFileOffset + PageOffset;
+
+        // The last page of a mapping may be cut short.
+        const auto PageEnd =
+            std::min(static_cast<uint64_t>(PageSize), MappingSize - PageOffset);
+
+        while (true) {
+            if (ChainOffset >= PageEnd || PageEnd - ChainOffset < PointerSize) {
+                return Error::InvalidChain;
+            }
+
+            auto Value = uint64_t();
+            memcpy(&Value, PageBegin + ChainOffset, PointerSize);
+
+            ListOut.emplace_back(Rebase {
+                .Address = MappingAddress + PageOffset + ChainOffset,
+                .Pointer = Format.DecodePointer(Value)
+            });
+
+            const auto Delta = Format.GetChainDelta(Value);
+            if (Delta == 0) {
+                break;
+            }
+
+            ChainOffset += Delta;
+        }
+
+        return Error::None;
+    }
+
+    auto
+    SlideInfo::DecodePageV1(const uint32_t Index,
+                            std::vector<Rebase> &ListOut) const noexcept
+        -> Error
+    {
+        const auto &Info = *reinterpret_cast<const SlideInfoV1 *>(Begin);
+        const auto TocList =
+            reinterpret_cast<const uint16_t *>(Begin + Info.TocOffset);
+
+        const auto EntryIndex = TocList[Index];
+        if (EntryIndex >= Info.EntriesCount) {
+            return Error::InvalidPageStarts;
+        }
+
+        const auto Entry =
+            Begin + Info.EntriesOffset +
+            static_cast<uint64_t>(EntryIndex) * Info.EntriesSize;
+
+        const auto PageOffset = static_cast<uint64_t>(Index) * PageSize;
+        if (PageOffset >= MappingSize) {
+            return Error::InvalidChain;
+        }
+
+        const auto PageBegin = Map + MappingFileOffset + PageOffset;
+        const auto PageEnd =
+            std::min(static_cast<uint64_t>(PageSize), MappingSize - PageOffset);
+
+        for (auto I = uint32_t(); I != Info.EntriesSize; I++) {
+            const auto Byte = Entry[I];
+            if (Byte == 0) {
+                continue;
+            }
+
+            for (auto Bit = uint32_t(); Bit != 8; Bit++) {
+                if ((Byte & (1u << Bit)) == 0) {
+                    continue;
+                }
+
+                const auto Offset = uint64_t((I * 8 + Bit) * sizeof(uint32_t));
+                if (Offset + sizeof(uint32_t) > PageEnd) {
+                    return Error::InvalidChain;
+                }
+
+                auto Value = uint32_t();
+                memcpy(&Value, PageBegin + Offset, sizeof(Value));
+
+                ListOut.emplace_back(Rebase {
+                    .Address = MappingAddress + PageOffset + Offset,
+                    .Pointer = SlidPointer { .Target = Value }
+                });
+            }
+        }
+
+        return Error::None;
+    }
+
+    auto
+    SlideInfo::DecodePageV2(const uint32_t Index,
+                            std::vector<Rebase> &ListOut) const noexcept
+        -> Error
+    {
+        const auto IsV2 = Format.Version == SlideInfoVersion::V2;
+
+        const auto NoRebase =
+            IsV2 ?
+                SlideInfoV2::PageAttrNoRebase : SlideInfoV4::PageAttrNoRebase;
+        const auto AttrExtra =
+            IsV2 ? SlideInfoV2::PageAttrExtra : SlideInfoV4::PageAttrExtra;
+        const auto AttrEnd =
+            IsV2 ? SlideInfoV2::PageAttrEnd : SlideInfoV4::PageAttrEnd;
+        const auto ValueMask =
+            IsV2 ? SlideInfoV2::PageValueMask : SlideInfoV4::PageValueMask;
+
+        const auto &Info = *reinterpret_cast<const SlideInfoV2 *>(Begin);
+        const auto PageStartList =
+            reinterpret_cast<const uint16_t *>(Begin + Info.PageStartsOffset);
+        const auto PageExtraList =
+            reinterpret_cast<const uint16_t *>(Begin + Info.PageExtrasOffset);
+
+        const auto PageStart = PageStartList[Index];
+        if (PageStart == NoRebase) {
+            return Error::None;
+        }
+
+        const auto PageOffset = static_cast<uint64_t>(Index) * PageSize;
+        if (PageOffset >= MappingSize) {
+            return Error::InvalidChain;
+        }
+
+        // Chain-offsets are stored in units of 4 bytes.
+
+        if ((PageStart & AttrExtra) == 0) {
+            return DecodeChain(PageOffset,
+                               uint64_t(PageStart) * sizeof(uint32_t),
+                               ListOut);
+        }
+
+        for (auto I = uint32_t(PageStart & ValueMask);; I++) {
+            if (I >= Info.PageExtrasCount) {
+                return Error::InvalidPageExtras;
+            }
+
+            const auto Extra = PageExtraList[I];
+            const auto ChainError =
+                DecodeChain(PageOffset,
+                            uint64_t(Extra & ValueMask) * sizeof(uint32_t),
+                            ListOut);
+
+            if (ChainError != Error::None) {
+                return ChainError;
+            }
+
+            if ((Extra & AttrEnd) != 0) {
+                break;
+            }
+        }
+
+        return Error::None;
+    }
+
+    auto
+    SlideInfo::DecodePageV3(const uint32_t Index,
+                            std::vector<Rebase> &ListOut) const noexcept
+        -> Error
+    {
+        // V3 and V5 share the same no-rebase attribute.
+        static_assert(SlideInfoV3::PageAttrNoRebase ==
+                      SlideInfoV5::PageAttrNoRebase);
+
+        const auto PageStartList =
+            reinterpret_cast<const uint16_t *>(Begin + sizeof(SlideInfoV3));
+
+        const auto PageStart = PageStartList[Index];
+        if (PageStart == SlideInfoV3::PageAttrNoRebase) {
+            return Error::None;
+        }
+
+        const auto PageOffset = static_cast<uint64_t>(Index) * PageSize;
+        if (PageOffset >= MappingSize) {
+            return Error::InvalidChain;
+        }
+
+        return DecodeChain(PageOffset, PageStart, ListOut);
+    }
+
+    auto
+    SlideInfo::DecodePage(const uint32_t Index,
+                          std::vector<Rebase> &ListOut) const noexcept
+        -> Error
+    {
+        if (Index >= PageCount) {
+            return Error::InvalidPageStarts;
+        }
+
+        switch (Format.Version) {
+            case SlideInfoVersion::None:
+                return Error::UnknownVersion;
+            case SlideInfoVersion::V1:
+                return DecodePageV1(Index, ListOut);
+            case SlideInfoVersion::V2:
+            case SlideInfoVersion::V4:
+                return DecodePageV2(Index, ListOut);
+            case SlideInfoVersion::V3:
+            case SlideInfoVersion::V5:
+                return DecodePageV3(Index, ListOut);
+        }
+
+        return Error::UnknownVersion;
+    }
+
+    // Pages of a mapping are decoded in batches, as most pages hold only a few
+    // hundred pointers.
+
+    constexpr static auto PageBatchSize = uint32_t(64);
+
+    auto SlideInfo::GetRebaseList(Error *const ErrorOut) const noexcept
+        -> std::vector<Rebase>
+    {
+        const auto BatchCount = (PageCount + PageBatchSize - 1) / PageBatchSize;
+
+        auto BatchList = std::vector<std::vector<Rebase>>(BatchCount);
+        auto ErrorList = std::vector<Error>(BatchCount, Error::None);
+        auto NextIndex = std::atomic<uint32_t>();
+
+        const auto DecodeBatches = [&]() noexcept {
+            for (auto Batch = NextIndex++;
+                 Batch < BatchCount;
+                 Batch = NextIndex++)
+            {
+                const auto Begin = Batch * PageBatchSize;
+                const auto End = std::min(Begin + PageBatchSize, PageCount);
+
+                for (auto Index = Begin; Index != End; Index++) {
+                    const auto PageError = DecodePage(Index, BatchList[Batch]);
+                    if (PageError != Error::None &&
+                        ErrorList[Batch] == Error::None)
+                    {
+                        ErrorList[Batch] = PageError;
+                    }
+                }
+            }
+        };
+
+        if (BatchCount != 0) {
+            const auto ThreadCount =
+                std::clamp(std::thread::hardware_concurrency(),
+                           1u,
+                           BatchCount);
+
+            auto ThreadList = std::vector<std::thread>();
+            ThreadList.reserve(ThreadCount - 1);
+
+            for (auto I = 1u; I != ThreadCount; I++) {
+                ThreadList.emplace_back(DecodeBatches);
+            }
+
+            DecodeBatches();
+            for (auto &Thread : ThreadList) {
+                Thread.join();
+            }
+        }
+
+        auto Count = uint64_t();
+        for (const auto &List : BatchList) {
+            Count += List.size();
+        }
+
+        auto Result = std::vector<Rebase>();
+        Result.reserve(Count);
+
+        for (auto I = uint32_t(); I != BatchCount; I++) {
+            const auto &List = BatchList[I];
+            Result.insert(Result.end(), List.cbegin(), List.cend());
+
+            if (ErrorList[I] != Error::None && ErrorOut != nullptr) {
+                if (*ErrorOut == Error::None) {
+                    *ErrorOut = ErrorList[I];
+                }
+            }
+        }
+
+        return Result;
+    }
+}
@@ -0,0 +1,201 @@
+//
+//  ADT/DyldSharedCache/SymbolResolver.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include "ADT/DyldSharedCache/SymbolResolver.h"
+#include "ADT/Mach-O/BindInfo.h"
+
+namespace DyldSharedCache {
+    SymbolResolver::SymbolResolver(const uint32_t NodeCount,
+                                   LoaderFunc Loader) noexcept
+    : Loader(std::move(Loader)), NodeCount(NodeCount),
+      StateList(std::make_unique<ImageState[]>(NodeCount)) {}
+
+    auto SymbolResolver::GetImageData(const uint32_t Node) noexcept
+        -> const ImageData *
+    {
+        if (Node >= NodeCount) {
+            return nullptr;
+        }
+
+        auto &State = StateList[Node];
+        std::call_once(State.LoadFlag, [&]() noexcept {
+            State.IsLoaded = Loader(Node, State.Data);
+        });
+
+        if (!State.IsLoaded) {
+            return nullptr;
+        }
+
+        return &State.Data;
+    }
+
+    auto
+    SymbolResolver::FindInImage(const uint32_t Node,
+                                const std::string_view Name,
+                                const uint32_t Depth) noexcept
+        -> Resolution
+    {
+        if (Depth > MaxReexportDepth) {
+            return Resolution { .Status = StatusKind::ReexportTooDeep };
+        }
+
+        const auto Data = GetImageData(Node);
+        if (Data == nullptr) {
+            return Resolution { .Status = StatusKind::ImageNotParsed };
+        }
+
+        auto &State = StateList[Node];
+        {
+            const auto Lock = std::lock_guard(State.CacheLock);
+            if (const auto Cached = State.Cache.find(Name)) {
+                return *Cached;
+            }
+        }
+
+        auto Result = Resolution();
+        if (const auto Entry = Data->Exports.find(Name)) {
+            using ExportKind = ExportIndex::ExportKind;
+            switch (Entry->Kind) {
+                case ExportKind::None:
+                    break;
+                case ExportKind::Reexport: {
+                    const auto Ordinal = Entry->ReexportDylibOrdinal;
+                    if (Ordinal == 0 || Ordinal > Data->LibraryList.size()) {
+                        Result.Status = StatusKind::InvalidDylibOrdinal;
+                        break;
+                    }
+
+                    const auto Library = Data->LibraryList[Ordinal - 1];
+                    if (Library == InvalidNode) {
+                        Result.Status = StatusKind::LibraryNotInCache;
+                        break;
+                    }
+
+                    const auto ImportName =
+                        Entry->ReexportImportName.empty() ?
+                            Name : Entry->ReexportImportName;
+
+                    Result = FindInImage(Library, ImportName, Depth + 1);
+                    break;
+                }
+                case ExportKind::Absolute:
+                    Result = Resolution {
+                        .Status = StatusKind::Resolved,
+                        .Kind = Entry->Kind,
+                        .Node = Node,
+                        .Address = Entry->ImageOffset
+                    };
+
+                    break;
+                case ExportKind::Regular:
+                case ExportKind::WeakDefinition:
+                case ExportKind::StubAndResolver:
+                case ExportKind::ThreadLocal:
+                    Result = Resolution {
+                        .Status = StatusKind::Resolved,
+                        .Kind = Entry->Kind,
+                        .Node = Node,
+                        .Address = Data->Address + Entry->ImageOffset
+                    };
+
+                    break;
+            }
+        } else {
+            for (const auto &Library : Data->ReexportList) {
+                const auto Reexport = FindInImage(Library, Name, Depth + 1);
+                if (Reexport.isResolved()) {
+                    Result = Reexport;
+                    break;
+                }
+            }
+        }
+
+        // How deep a lookup went depends on where it started, so only keep
+        // lookups that finished.
+
+        if (Result.Status != StatusKind::ReexportTooDeep) {
+            const auto Lock = std::lock_guard(State.CacheLock);
+            State.Cache.getOrInsert(Name) = Result;
+        }
+
+        return Result;
+    }
+
+    auto
+    SymbolResolver::Resolve(const uint32_t Node,
+                            const int64_t DylibOrdinal,
+                            const std::string_view Name) noexcept
+        -> Resolution
+    {
+        using SpecialOrdinal = MachO::BindByteDylibSpecialOrdinal;
+        if (DylibOrdinal > 0) {
+            const auto Data = GetImageData(Node);
+            if (Data == nullptr) {
+                return Resolution { .Status = StatusKind::ImageNotParsed };
+            }
+
+            const auto Index = static_cast<uint64_t>(DylibOrdinal - 1);
+            if (Index >= Data->LibraryList.size()) {
+                return Resolution { .Status = StatusKind::InvalidDylibOrdinal };
+            }
+
+            const auto Library = Data->LibraryList[Index];
+            if (Library == InvalidNode) {
+                return Resolution { .Status = StatusKind::LibraryNotInCache };
+            }
+
+            return FindInImage(Library, Name, 0);
+        }
+
+        if (DylibOrdinal < -3) {
+            return Resolution { .Status = StatusKind::InvalidDylibOrdinal };
+        }
+
+        switch (SpecialOrdinal(DylibOrdinal)) {
+            case SpecialOrdinal::DylibSelf:
+                return FindInImage(Node, Name, 0);
+            case SpecialOrdinal::DylibMainExecutable:
+                return Resolution { .Status = StatusKind::InMainExecutable };
+            case SpecialOrdinal::DylibFlatLookup:
+            case SpecialOrdinal::DylibWeakLookup:
+                break;
+            default:
+                return Resolution { .Status = StatusKind::InvalidDylibOrdinal };
+        }
+
+        // Search the image, and then each image it depends on, in
+        // breadth-first order.
+
+        auto Queue = std::vector<uint32_t>({ Node });
+        auto VisitedList = std::vector<bool>(NodeCount);
+
+        VisitedList[Node] = true;
+        for (auto I = size_t(); I != Queue.size(); I++) {
+            const auto Result = FindInImage(Queue[I], Name, 0);
+            if (Result.isResolved()) {
+                return Result;
+            }
+
+            const auto Data = GetImageData(Queue[I]);
+            if (Data == nullptr) {
+                continue;
+            }
+
+            for (const auto &Library : Data->LibraryList) {
+                if (Library == InvalidNode || VisitedList[Library]) {
+                    continue;
+                }
+
+                VisitedList[Library] = true;
+                Queue.emplace_back(Library);
+            }
+        }
+
+        return Resolution { .Status = StatusKind::SymbolNotFound };
+    }
+}
@@ -9,6 +9,7 @@
 #include <sys/stat.h>
 
 #include <cassert>
+#include <cerrno>
 #include <unistd.h>
 
 #include "ADT/FileDescriptor.h"
@@ -40,6 +41,57 @@ bool FileDescriptor::Write(const void *const Buf, const size_t Size) noexcept {
     return (static_cast<size_t>(write(Fd, Buf, Size)) == Size);
 }
 
+bool
+FileDescriptor::WriteAt(const void *const Buf,
+                        const size_t Size,
+                        const uint64_t Offset) noexcept
+{
+    auto Vector = iovec {
+        .iov_base = const_cast<void *>(Buf),
+        .iov_len = Size
+    };
+
+    return this->WriteVectorAt(&Vector, 1, Offset);
+}
+
+bool
+FileDescriptor::WriteVectorAt(iovec *List,
+                              int Count,
+                              uint64_t Offset) noexcept
+{
+    assert(this->isOpen());
+    while (Count != 0) {
+        const auto Written = pwritev(Fd, List, Count, Offset);
+        if (Written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        Offset += Written;
+
+        // Skip past the vectors that were fully written, and trim the one
+        // that was partially written.
+
+        auto Left = static_cast<size_t>(Written);
+        while (Count != 0 && Left >= List->iov_len) {
+            Left -= List->iov_len;
+
+            List++;
+            Count--;
+        }
+
+        if (Count != 0) {
+            List->iov_base = static_cast<uint8_t *>(List->iov_base) + Left;
+            List->iov_len -= Left;
+        }
+    }
+
+    return true;
+}
+
 bool FileDescriptor::TruncateToSize(const uint64_t Size) noexcept {
     assert(this->isOpen());
     return (ftruncate(Fd, Size) == 0);
@@ -0,0 +1,245 @@
+//
+//  ADT/JsonWriter.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <cassert>
+#include <cinttypes>
+
+#include "ADT/JsonWriter.h"
+
+JsonWriter::JsonWriter(FILE *const OutFile, const enum Style Style) noexcept
+: OutFile(OutFile), Style(Style) {}
+
+// Returns the length of the UTF-8 sequence starting at Iter, or 0 if the
+// sequence is invalid, being truncated, overlong, a surrogate, or above
+// U+10FFFF.
+
+[[nodiscard]] static auto
+GetUtf8SequenceLength(const std::string_view::iterator Iter,
+                      const std::string_view::iterator End) noexcept
+    -> uint32_t
+{
+    const auto Lead = static_cast<uint8_t>(*Iter);
+
+    auto Length = uint32_t();
+    auto SecondMin = uint8_t(0x80);
+    auto SecondMax = uint8_t(0xBF);
+
+    if (Lead >= 0xC2 && Lead <= 0xDF) {
+        Length = 2;
+    } else if (Lead >= 0xE0 && Lead <= 0xEF) {
+        Length = 3;
+        if (Lead == 0xE0) {
+            SecondMin = 0xA0;
+        } else if (Lead == 0xED) {
+            SecondMax = 0x9F;
+        }
+    } else if (Lead >= 0xF0 && Lead <= 0xF4) {
+        Length = 4;
+        if (Lead == 0xF0) {
+            SecondMin = 0x90;
+        } else if (Lead == 0xF4) {
+            SecondMax = 0x8F;
+        }
+    } else {
+        return 0;
+    }
+
+    if (End - Iter < Length) {
+        return 0;
+    }
+
+    const auto Second = static_cast<uint8_t>(Iter[1]);
+    if (Second < SecondMin || Second > SecondMax) {
+        return 0;
+    }
+
+    for (auto I = uint32_t(2); I != Length; I++) {
+        const auto Ch = static_cast<uint8_t>(Iter[I]);
+        if (Ch < 0x80 || Ch > 0xBF) {
+            return 0;
+        }
+    }
+
+    return Length;
+}
+
+void
+JsonWriter::WriteEscapedString(FILE *const OutFile,
+                               const std::string_view String) noexcept
+{
+    fputc('"', OutFile);
+
+    // Write out runs of characters that don't need escaping in one go, rather
+    // than one character at a time.
+
+    auto RunBegin = String.begin();
+    const auto FlushRun = [&](const std::string_view::iterator RunEnd) {
+        if (RunBegin != RunEnd) {
+            fwrite(&*RunBegin,
+                   1,
+                   static_cast<size_t>(RunEnd - RunBegin),
+                   OutFile);
+        }
+    };
+
+    // Bytes that aren't part of a valid UTF-8 sequence are written as the
+    // code-point of the same value, so the output is always valid JSON.
+
+    for (auto Iter = String.begin(); Iter != String.end(); Iter++) {
+        const auto Ch = static_cast<uint8_t>(*Iter);
+        if (Ch >= 0x80) {
+            const auto Length = GetUtf8SequenceLength(Iter, String.end());
+            if (Length != 0) {
+                Iter += Length - 1;
+                continue;
+            }
+        } else if (Ch >= 0x20 && Ch != '"' && Ch != '\\') {
+            continue;
+        }
+
+        FlushRun(Iter);
+        RunBegin = Iter + 1;
+
+        switch (Ch) {
+            case '"':
+                fputs("\\\"", OutFile);
+                break;
+            case '\\':
+                fputs("\\\\", OutFile);
+                break;
+            case '\n':
+                fputs("\\n", OutFile);
+                break;
+            case '\r':
+                fputs("\\r", OutFile);
+                break;
+            case '\t':
+                fputs("\\t", OutFile);
+                break;
+            default:
+                fprintf(OutFile, "\\u%04" PRIx8, Ch);
+                break;
+        }
+    }
+
+    FlushRun(String.end());
+    fputc('"', OutFile);
+}
+
+void JsonWriter::writeKey(const std::string_view Key) noexcept {
+    assert(this->InRecord && "Field written outside of a record");
+    if (this->WroteField) {
+        fputc(',', this->OutFile);
+    }
+
+    WriteEscapedString(this->OutFile, Key);
+    fputc(':', this->OutFile);
+
+    this->WroteField = true;
+}
+
+auto JsonWriter::beginList() noexcept -> decltype(*this) {
+    if (this->Style == Style::Array) {
+        fputc('[', this->OutFile);
+    }
+
+    return *this;
+}
+
+auto JsonWriter::endList() noexcept -> decltype(*this) {
+    assert(!this->InRecord && "List ended inside of a record");
+    if (this->Style == Style::Array) {
+        if (this->RecordCount != 0) {
+            fputc('\n', this->OutFile);
+        }
+
+        fputs("]\n", this->OutFile);
+    }
+
+    return *this;
+}
+
+auto JsonWriter::beginRecord() noexcept -> decltype(*this) {
+    assert(!this->InRecord && "Records can't be nested");
+    if (this->Style == Style::Array) {
+        fputs((this->RecordCount != 0) ? ",\n" : "\n", this->OutFile);
+    }
+
+    fputc('{', this->OutFile);
+
+    this->InRecord = true;
+    this->WroteField = false;
+
+    return *this;
+}
+
+auto JsonWriter::endRecord() noexcept -> decltype(*this) {
+    assert(this->InRecord && "Record ended without being started");
+    fputc('}', this->OutFile);
+
+    if (this->Style == Style::LineDelimited) {
+        fputc('\n', this->OutFile);
+    }
+
+    this->InRecord = false;
+    this->RecordCount++;
+
+    return *this;
+}
+
+auto
+JsonWriter::writeString(const std::string_view Key,
+                        const std::string_view Value) noexcept
+    -> decltype(*this)
+{
+    this->writeKey(Key);
+    WriteEscapedString(this->OutFile, Value);
+
+    return *this;
+}
+
+auto
+JsonWriter::writeNumber(const std::string_view Key,
+                        const uint64_t Value) noexcept
+    -> decltype(*this)
+{
+    this->writeKey(Key);
+    fprintf(this->OutFile, "%" PRIu64, Value);
+
+    return *this;
+}
+
+auto
+JsonWriter::writeSignedNumber(const std::string_view Key,
+                              const int64_t Value) noexcept
+    -> decltype(*this)
+{
+    this->writeKey(Key);
+    fprintf(this->OutFile, "%" PRId64, Value);
+
+    return *this;
+}
+
+auto
+JsonWriter::writeBool(const std::string_view Key, const bool Value) noexcept
+    -> decltype(*this)
+{
+    this->writeKey(Key);
+    fputs(Value ? "true" : "false", this->OutFile);
+
+    return *this;
+}
+
+auto JsonWriter::writeNull(const std::string_view Key) noexcept
+    -> decltype(*this)
+{
+    this->writeKey(Key);
+    fputs("null", this->OutFile);
+
+    return *this;
+}
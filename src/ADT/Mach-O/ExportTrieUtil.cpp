@@ -28,22 +28,15 @@ namespace MachO {
     ExportTrieEntryCollection::MakeNodeForEntryInfo(
         const ExportTrieIterateInfo &Info,
         const SegmentInfoCollection *Collection) noexcept
-            -> ExportTrieEntryCollection::ChildNode *
+            -> ExportTrieEntryCollection::ChildNode
     {
-        auto Node = static_cast<ChildNode *>(nullptr);
-        if (Info.isExport()) {
-            Node = new ExportChildNode();
-        } else {
-            Node = new ChildNode();
-        }
+        auto Node = ChildNode();
 
-        Node->Kind = Info.getKind();
-        Node->String = Info.getString();
+        Node.Kind = Info.getKind();
+        Node.String = Info.getString();
 
         if (Info.isExport()) {
-            auto ExportNode = Node->getAsExportNode();
             const auto &ExportInfo = Info.getExportInfo();
-
             if (!ExportInfo.isReexport()) {
                 const auto Addr = ExportInfo.getImageOffset();
                 if (Collection != nullptr) {
@@ -51,12 +44,12 @@ namespace MachO {
                     const auto Segment =
                         LookupInfoForAddress(Collection, Addr, &Section);
 
-                    ExportNode->setSegment(Segment);
-                    ExportNode->setSection(Section);
+                    Node.setSegment(Segment);
+                    Node.setSection(Section);
                 }
             }
 
-            ExportNode->setInfo(ExportInfo);
+            Node.setInfo(ExportInfo);
         }
 
         return Node;
@@ -75,14 +68,17 @@ namespace MachO {
             return;
         }
 
-        this->setRoot(MakeNodeForEntryInfo(*Iter, SegmentCollection));
+        // The trie is iterated depth-first, which is the order IndexedTree
+        // stores its nodes in, so each node is appended as it's parsed.
 
-        auto Parent = this->getRoot();
-        auto PrevDepthLevel = static_cast<uint8_t>(1);
+        auto Parent =
+            this->AddNode(NullIndex,
+                          MakeNodeForEntryInfo(*Iter, SegmentCollection));
 
+        auto PrevDepthLevel = static_cast<uint8_t>(1);
         const auto MoveUpParentHierarchy = [&](uint8_t Amt) noexcept {
             for (auto I = uint8_t(); I != Amt; I++) {
-                Parent = Parent->getParent();
+                Parent = this->at(Parent).Parent;
             }
         };
 
@@ -100,9 +96,10 @@ namespace MachO {
                 MoveUpParentHierarchy(PrevDepthLevel - DepthLevel);
             }
 
-            const auto Current = MakeNodeForEntryInfo(*Iter, SegmentCollection);
+            const auto Current =
+                this->AddNode(Parent,
+                              MakeNodeForEntryInfo(*Iter, SegmentCollection));
 
-            Parent->AddChild(*Current);
             if (Iter->getNode().getChildCount() != 0) {
                 Parent = Current;
             }
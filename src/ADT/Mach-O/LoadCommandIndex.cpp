@@ -0,0 +1,79 @@
+//
+//  ADT/Mach-O/LoadCommandIndex.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include "ADT/Mach-O/LoadCommandIndex.h"
+#include "ADT/Mach-O/LoadCommandStorage.h"
+
+namespace MachO {
+    auto
+    LoadCommandIndex::Build(
+        const ConstLoadCommandStorage &LoadCmdStorage) noexcept
+            -> LoadCommandIndex
+    {
+        auto Result = LoadCommandIndex();
+        if (LoadCmdStorage.hasError()) {
+            return Result;
+        }
+
+        Result.IsBigEndian = LoadCmdStorage.isBigEndian();
+
+        // Walk the load-commands once, recording the slot of each, and then
+        // place each kind's commands together.
+
+        struct SlotEntry {
+            const LoadCommand *LC;
+            int Slot;
+        };
+
+        auto SlotList = std::vector<SlotEntry>();
+        SlotList.reserve(LoadCmdStorage.count());
+
+        LoadCmdStorage.forEach([&](const LoadCommand &LC,
+                                   const auto BigEndian) noexcept
+        {
+            const auto Slot = GetSlotForKind(LC.getKind(BigEndian()));
+            if (Slot < 0) {
+                return;
+            }
+
+            SlotList.emplace_back(SlotEntry{ .LC = &LC, .Slot = Slot });
+            Result.KindTable[Slot].Count++;
+        });
+
+        auto Begin = uint32_t();
+        for (auto &Entry : Result.KindTable) {
+            Entry.Begin = Begin;
+            Begin += Entry.Count;
+
+            // Reused below as the count of commands placed so far.
+            Entry.Count = 0;
+        }
+
+        Result.List.resize(SlotList.size());
+        for (const auto &Entry : SlotList) {
+            auto &KindEntry = Result.KindTable[Entry.Slot];
+
+            Result.List[KindEntry.Begin + KindEntry.Count] = Entry.LC;
+            KindEntry.Count++;
+        }
+
+        return Result;
+    }
+
+    auto LoadCommandIndex::getAll(const LoadCommand::Kind Kind) const noexcept
+        -> std::span<const LoadCommand *const>
+    {
+        const auto Slot = GetSlotForKind(Kind);
+        if (Slot < 0) {
+            return {};
+        }
+
+        const auto &Entry = this->KindTable[Slot];
+        return std::span(this->List.data() + Entry.Begin, Entry.Count);
+    }
+}
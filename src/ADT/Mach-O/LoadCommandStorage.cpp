@@ -7,13 +7,14 @@
 //
 
 #include "ADT/Mach-O/LoadCommandStorage.h"
+#include "Utils/SwitchEndian.h"
 
 namespace MachO {
+    template <bool IsBigEndian>
     static auto
     VerifyLoadCommands(const uint8_t *const Begin,
                        const uint8_t *const End,
                        const uint32_t Count,
-                       const bool IsBigEndian,
                        const bool Is64Bit,
                        uint32_t *const SizeOut) noexcept
         -> ConstLoadCommandStorage::Error
@@ -93,13 +94,15 @@ namespace MachO {
 
         auto End = Begin + Size;
         if (Verify) {
-            const auto Error =
-                VerifyLoadCommands(Begin,
-                                   End,
-                                   Count,
-                                   IsBigEndian,
-                                   Is64Bit,
-                                   &Size);
+            const auto VerifyLoadCmds = [&](const auto BigEndian) noexcept {
+                return VerifyLoadCommands<BigEndian()>(Begin,
+                                                       End,
+                                                       Count,
+                                                       Is64Bit,
+                                                       &Size);
+            };
+
+            const auto Error = DispatchOnEndian(IsBigEndian, VerifyLoadCmds);
 
             if (Error != Error::None) {
                 return Error;
@@ -0,0 +1,74 @@
+//
+//  ADT/Mach-O/ObjcMetadata.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include "ADT/Mach-O/ObjcMetadata.h"
+
+namespace MachO {
+    uint32_t
+    ObjcMetadataCollection::InternString(const std::string_view String) noexcept
+    {
+        auto Inserted = false;
+        auto &Index = StringMap.getOrInsert(String, &Inserted);
+
+        if (Inserted) {
+            Index = static_cast<uint32_t>(StringList.size());
+            StringList.emplace_back(String);
+        }
+
+        return Index;
+    }
+
+    auto
+    ObjcMetadataCollection::FindClassListSection(
+        const SegmentInfoCollection &Collection) noexcept
+            -> const SectionInfo *
+    {
+        return Collection.FindSectionWithName({
+            { "__OBJC2",      { "__class_list"     } },
+            { "__DATA_CONST", { "__objc_classlist" } },
+            { "__DATA",       { "__objc_classlist" } },
+            { "__DATA_DIRTY", { "__objc_classlist" } },
+        });
+    }
+
+    auto
+    ObjcMetadataCollection::Open(const SegmentInfoCollection &SegmentCollection,
+                                 const ConstDeVirtualizer &DeVirtualizer,
+                                 const bool IsBigEndian,
+                                 const bool Is64Bit) noexcept
+        -> ObjcMetadataCollection
+    {
+        auto Result = ObjcMetadataCollection();
+
+        const auto ClassListSection = FindClassListSection(SegmentCollection);
+        if (ClassListSection == nullptr) {
+            return Result;
+        }
+
+        const auto DeVirtualizeData =
+            [&](const uint64_t Addr, const uint64_t Size) noexcept
+                -> const uint8_t *
+        {
+            return
+                DeVirtualizer.GetDataAtAddressIgnoreSections<uint8_t>(Addr,
+                                                                      Size);
+        };
+
+        const auto DeVirtualizeString = [&](const uint64_t Addr) noexcept {
+            return DeVirtualizer.GetStringAtAddress(Addr);
+        };
+
+        Result.Parse(*ClassListSection,
+                     DeVirtualizeData,
+                     DeVirtualizeString,
+                     IsBigEndian,
+                     Is64Bit);
+
+        return Result;
+    }
+}
@@ -6,6 +6,9 @@
 //  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
 //
 
+#include <algorithm>
+#include <functional>
+
 #include "ADT/BasicContiguousList.h"
 #include "ADT/MemoryMap.h"
 #include "ADT/Range.h"
@@ -20,21 +23,73 @@
 namespace MachO {
     void
     ObjcClassInfoCollection::AdjustExternalAndRootClassList(
-        std::vector<Info *> &List) noexcept
+        const std::vector<Info *> &List) noexcept
     {
         if (List.empty()) {
             return;
         }
 
+        // Classes are only linked to their super-class while parsing, so pair
+        // each sub-class with its super-class, grouped by super-class, to then
+        // store the class hierarchy depth-first.
+
+        using SuperPairType = std::pair<const Info *, Info *>;
+
+        auto SubClassList = std::vector<SuperPairType>();
+        SubClassList.reserve(this->List.size());
+
+        for (const auto &Iter : this->List) {
+            const auto Class = Iter.second.get();
+            if (const auto Super = Class->getSuper()) {
+                SubClassList.emplace_back(Super, Class);
+            }
+        }
+
+        const auto CompareSuper =
+            [](const SuperPairType &Lhs, const SuperPairType &Rhs) noexcept
+        {
+            return std::less<const Info *>()(Lhs.first, Rhs.first);
+        };
+
+        std::stable_sort(SubClassList.begin(),
+                         SubClassList.end(),
+                         CompareSuper);
+
+        this->ClassTree.reserve(this->List.size() + 1);
+
+        auto RootIndex = ClassTreeType::NullIndex;
         if (List.size() != 1) {
-            this->setRoot(ObjcParse::AddClassToList(this->List, Info(), 0));
-            this->getRoot()->setIsNull();
+            const auto Root = ObjcParse::AddClassToList(this->List, Info(), 0);
+
+            Root->setIsNull();
+            RootIndex = this->ClassTree.AddNode(RootIndex, Root);
+        }
+
+        // Holds a class, and the index of its super-class in the tree.
+        auto StackList =
+            std::vector<std::pair<Info *, ClassTreeType::IndexType>>();
+
+        for (auto Iter = List.rbegin(); Iter != List.rend(); Iter++) {
+            StackList.emplace_back(*Iter, RootIndex);
+        }
 
-            for (const auto &Node : List) {
-                this->getRoot()->AddChild(*Node);
+        while (!StackList.empty()) {
+            const auto [Class, SuperIndex] = StackList.back();
+            StackList.pop_back();
+
+            const auto Index = this->ClassTree.AddNode(SuperIndex, Class);
+            const auto Range =
+                std::equal_range(SubClassList.begin(),
+                                 SubClassList.end(),
+                                 SuperPairType(Class, nullptr),
+                                 CompareSuper);
+
+            for (auto Iter = std::make_reverse_iterator(Range.second);
+                 Iter != std::make_reverse_iterator(Range.first);
+                 Iter++)
+            {
+                StackList.emplace_back(Iter->second, Index);
             }
-        } else {
-            this->setRoot(List.front());
         }
     }
 
@@ -50,7 +105,8 @@ namespace MachO {
             -> decltype(*this)
     {
         auto Error = ObjcParse::Error::None;
-        auto ExternalAndRootClassList = std::vector<Info *>();
+        auto ExternalAndRootClassList =
+            ObjcParse::ExternalAndRootClassCollection();
 
         const auto DeVirtualizeAddrFunc = [&](uint64_t Addr) noexcept {
             return DeVirtualizer.GetDataAtAddressIgnoreSections<uint8_t>(Addr);
@@ -97,7 +153,7 @@ namespace MachO {
                 }
             }
 
-            AdjustExternalAndRootClassList(ExternalAndRootClassList);
+            AdjustExternalAndRootClassList(ExternalAndRootClassList.getList());
             return *this;
         }
 
@@ -140,7 +196,7 @@ namespace MachO {
                 }
             }
 
-            AdjustExternalAndRootClassList(ExternalAndRootClassList);
+            AdjustExternalAndRootClassList(ExternalAndRootClassList.getList());
             return *this;
         }
 
@@ -209,7 +265,8 @@ namespace MachO {
             -> decltype(*this)
     {
         auto Error = ObjcParse::Error::None;
-        auto ExternalAndRootClassList = std::vector<Info *>();
+        auto ExternalAndRootClassList =
+            ObjcParse::ExternalAndRootClassCollection();
 
         const auto DeVirtualizeAddrFunc = [&](uint64_t Addr) noexcept {
             return DeVirtualizer.GetDataAtAddressIgnoreSections<uint8_t>(Addr);
@@ -274,7 +331,7 @@ namespace MachO {
                 }
             }
 
-            AdjustExternalAndRootClassList(ExternalAndRootClassList);
+            AdjustExternalAndRootClassList(ExternalAndRootClassList.getList());
             return *this;
         }
 
@@ -335,7 +392,7 @@ namespace MachO {
                 }
             }
 
-            AdjustExternalAndRootClassList(ExternalAndRootClassList);
+            AdjustExternalAndRootClassList(ExternalAndRootClassList.getList());
             return *this;
         }
 
@@ -411,15 +468,15 @@ namespace MachO {
         return nullptr;
     }
 
-    template <PointerKind Kind>
+    template <PointerKind Kind, bool IsBigEndian>
     static void ParseObjcClassCategorySection(
         const uint8_t *const Map,
         const SectionInfo *const SectInfo,
         const ConstDeVirtualizer &DeVirt,
         const BindActionCollection *const BindCollection,
         ObjcClassInfoCollection *const ClassInfoTree,
-        std::vector<std::unique_ptr<ObjcClassCategoryInfo>> &CategoryList,
-        const bool IsBigEndian) noexcept
+        std::vector<std::unique_ptr<ObjcClassCategoryInfo>> &CategoryList)
+            noexcept
     {
         using PtrAddrType = PointerAddrConstTypeFromKind<Kind>;
         using ObjcCategoryType = ObjcParse::ClassCategoryTypeCalculator<Kind>;
@@ -544,25 +601,27 @@ namespace MachO {
             return *this;
         }
 
-        if (Is64Bit) {
-            ParseObjcClassCategorySection<PointerKind::s64Bit>(
-                Map,
-                ObjcClassCategorySection,
-                DeVirtualizer,
-                BindCollection,
-                ClassInfoTree,
-                List,
-                IsBigEndian);
-        } else {
-            ParseObjcClassCategorySection<PointerKind::s32Bit>(
-                Map,
-                ObjcClassCategorySection,
-                DeVirtualizer,
-                BindCollection,
-                ClassInfoTree,
-                List,
-                IsBigEndian);
-        }
+        const auto ParseWithEndian = [&](const auto BigEndian) noexcept {
+            if (Is64Bit) {
+                ParseObjcClassCategorySection<PointerKind::s64Bit, BigEndian()>(
+                    Map,
+                    ObjcClassCategorySection,
+                    DeVirtualizer,
+                    BindCollection,
+                    ClassInfoTree,
+                    List);
+            } else {
+                ParseObjcClassCategorySection<PointerKind::s32Bit, BigEndian()>(
+                    Map,
+                    ObjcClassCategorySection,
+                    DeVirtualizer,
+                    BindCollection,
+                    ClassInfoTree,
+                    List);
+            }
+        };
+
+        DispatchOnEndian(IsBigEndian, ParseWithEndian);
 
         return *this;
     }
@@ -615,25 +674,27 @@ namespace MachO {
             return *this;
         }
 
-        if (Is64Bit) {
-            ParseObjcClassCategorySection<PointerKind::s64Bit>(
-                Map.getBegin(),
-                ObjcClassCategorySection,
-                DeVirtualizer,
-                &BindCollection,
-                ClassInfoTree,
-                List,
-                IsBigEndian);
-        } else {
-            ParseObjcClassCategorySection<PointerKind::s32Bit>(
-                Map.getBegin(),
-                ObjcClassCategorySection,
-                DeVirtualizer,
-                &BindCollection,
-                ClassInfoTree,
-                List,
-                IsBigEndian);
-        }
+        const auto ParseWithEndian = [&](const auto BigEndian) noexcept {
+            if (Is64Bit) {
+                ParseObjcClassCategorySection<PointerKind::s64Bit, BigEndian()>(
+                    Map.getBegin(),
+                    ObjcClassCategorySection,
+                    DeVirtualizer,
+                    &BindCollection,
+                    ClassInfoTree,
+                    List);
+            } else {
+                ParseObjcClassCategorySection<PointerKind::s32Bit, BigEndian()>(
+                    Map.getBegin(),
+                    ObjcClassCategorySection,
+                    DeVirtualizer,
+                    &BindCollection,
+                    ClassInfoTree,
+                    List);
+            }
+        };
+
+        DispatchOnEndian(IsBigEndian, ParseWithEndian);
 
         return *this;
     }
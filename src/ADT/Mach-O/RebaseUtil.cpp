@@ -0,0 +1,154 @@
+//
+//  ADT/Mach-O/RebaseUtil.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include "ADT/Mach-O/RebaseUtil.h"
+
+namespace MachO {
+    auto
+    RebaseActionCollection::Parse(
+        const SegmentInfoCollection &SegmentCollection,
+        const RebaseActionList &ActionList,
+        const bool Is64Bit,
+        ParseError *const ParseErrorOut,
+        Error *const ErrorOut) noexcept
+            -> decltype(*this)
+    {
+        SlotSize = PointerSize(Is64Bit);
+
+        SegmentList.clear();
+        SegmentList.reserve(SegmentCollection.size());
+
+        for (const auto &Segment : SegmentCollection) {
+            auto &Entry = SegmentList.emplace_back();
+            Entry.MemoryRange = Segment.getMemoryRange();
+        }
+
+        for (const auto &Iter : ActionList) {
+            const auto IterError = Iter.getError();
+            if (!Iter.CanIgnoreError(IterError)) {
+                if (ParseErrorOut != nullptr) {
+                    *ParseErrorOut = IterError;
+                }
+
+                break;
+            }
+
+            const auto Action = Iter.GetAction();
+            if (IndexOutOfBounds(Action.SegmentIndex, SegmentList.size())) {
+                if (ErrorOut != nullptr) {
+                    *ErrorOut = Error::ActionOutsideSegment;
+                }
+
+                continue;
+            }
+
+            auto &Entry = SegmentList[Action.SegmentIndex];
+            if (Action.AddrInSeg >= Entry.MemoryRange.size()) {
+                if (ErrorOut != nullptr) {
+                    *ErrorOut = Error::ActionOutsideSegment;
+                }
+
+                continue;
+            }
+
+            if (Action.Kind != RebaseWriteKind::Pointer) {
+                const auto Address =
+                    Entry.MemoryRange.getBegin() + Action.AddrInSeg;
+
+                WriteKindMap.insert_or_assign(Address, Action.Kind);
+            }
+
+            if (Action.AddrInSeg % SlotSize != 0) {
+                Entry.UnalignedList.emplace_back(Action.AddrInSeg);
+                continue;
+            }
+
+            // Grow the bitmap only as far as the rebased slots go, so that
+            // large segments with few rebases don't cost a full bitmap.
+
+            const auto Slot = Action.AddrInSeg / SlotSize;
+            const auto WordIndex = Slot / 64;
+
+            if (WordIndex >= Entry.BitList.size()) {
+                Entry.BitList.resize(WordIndex + 1);
+            }
+
+            auto &Word = Entry.BitList[WordIndex];
+            const auto Bit = uint64_t(1) << (Slot % 64);
+
+            if ((Word & Bit) == 0) {
+                Word |= Bit;
+                Count++;
+            }
+        }
+
+        for (auto &Entry : SegmentList) {
+            auto &List = Entry.UnalignedList;
+            if (List.empty()) {
+                continue;
+            }
+
+            std::sort(List.begin(), List.end());
+            List.erase(std::unique(List.begin(), List.end()), List.end());
+
+            Count += List.size();
+        }
+
+        return *this;
+    }
+
+    bool
+    RebaseActionCollection::isAddressRebased(
+        const uint64_t Address) const noexcept
+    {
+        for (auto I = uint32_t(); I != SegmentList.size(); I++) {
+            const auto &MemoryRange = SegmentList[I].MemoryRange;
+            if (MemoryRange.hasLocation(Address)) {
+                return isRebased(I, Address - MemoryRange.getBegin());
+            }
+        }
+
+        return false;
+    }
+
+    auto
+    RebaseActionCollection::GetWriteKindForAddress(
+        const uint64_t Address) const noexcept -> RebaseWriteKind
+    {
+        if (WriteKindMap.empty()) {
+            return RebaseWriteKind::Pointer;
+        }
+
+        const auto Iter = WriteKindMap.find(Address);
+        if (Iter != WriteKindMap.end()) {
+            return Iter->second;
+        }
+
+        return RebaseWriteKind::Pointer;
+    }
+
+    auto
+    RebaseActionCollection::GetActionInfo(
+        const uint32_t SegmentIndex,
+        const uint64_t AddrInSeg) const noexcept -> RebaseActionInfo
+    {
+        const auto &MemoryRange = SegmentList[SegmentIndex].MemoryRange;
+        const auto Address = MemoryRange.getBegin() + AddrInSeg;
+
+        const auto Result = RebaseActionInfo {
+            .Kind = GetWriteKindForAddress(Address),
+            .SegmentIndex = SegmentIndex,
+            .SegOffset = AddrInSeg,
+            .AddrInSeg = AddrInSeg,
+            .HasSegmentIndex = true,
+            .UseThreadedRebaseRebase = false
+        };
+
+        return Result;
+    }
+}
@@ -6,14 +6,16 @@
 //  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
 //
 
+#include <array>
 #include <cstring>
 
+#include "ADT/Mach-O/LoadCommandIndex.h"
 #include "ADT/Mach-O/LoadCommandStorage.h"
 #include "ADT/Mach-O/SegmentUtil.h"
 
 namespace MachO {
     template <typename SectionType>
-    [[nodiscard]] static auto
+    static void
     ParseSectionInfo(const SectionType &Section,
                      SectionInfo &InfoIn,
                      const bool IsBigEndian,
@@ -31,20 +33,19 @@ namespace MachO {
             *ErrorOut = SegmentInfoCollection::Error::InvalidSection;
         }
 
-        auto Name = std::string(Section.Name, strnlen(Section.Name, 16));
+        InfoIn.setName(std::string_view(Section.Name,
+                                        strnlen(Section.Name, 16)));
 
-        InfoIn.setName(std::move(Name));
         InfoIn.setFlags(Section.getFlags(IsBigEndian));
         InfoIn.setReserved1(Section.getReserved1(IsBigEndian));
         InfoIn.setReserved2(Section.getReserved2(IsBigEndian));
-
-        return true;
     }
 
     template <typename SegmentType>
-    [[nodiscard]] static auto
+    static void
     ParseSegmentInfo(const SegmentType &Segment,
                      SegmentInfo &InfoIn,
+                     std::vector<SectionInfo> &SectionListOut,
                      const bool IsBigEndian,
                      SegmentInfoCollection::Error *const ErrorOut) noexcept
     {
@@ -60,84 +61,86 @@ namespace MachO {
             *ErrorOut = SegmentInfoCollection::Error::InvalidSegment;
         }
 
-        auto Name = std::string(Segment.Name, strnlen(Segment.Name, 16));
+        InfoIn.setName(std::string_view(Segment.Name,
+                                        strnlen(Segment.Name, 16)));
 
-        InfoIn.setName(std::move(Name));
         InfoIn.setInitProt(Segment.getInitProt(IsBigEndian));
         InfoIn.setMaxProt(Segment.getMaxProt(IsBigEndian));
         InfoIn.setFlags(Segment.getFlags(IsBigEndian));
 
         if (!Segment.isSectionListValid(IsBigEndian)) {
             *ErrorOut = SegmentInfoCollection::Error::InvalidSectionList;
-            return true;
+            return;
         }
 
-        auto &SectionOutList = InfoIn.getSectionListRef();
+        const auto SectionBegin = SectionListOut.size();
         const auto SectionList =
             Segment.getConstSectionListUnsafe(IsBigEndian);
 
         for (const auto &Section : SectionList) {
-            auto SectInfo = std::make_unique<SectionInfo>();
-            const auto ParseSectResult =
-                ParseSectionInfo(Section,
-                                 *SectInfo.get(),
-                                 IsBigEndian,
-                                 ErrorOut);
-
-            if (ParseSectResult) {
-                SectInfo->setSegment(&InfoIn);
-                SectionOutList.emplace_back(std::move(SectInfo));
+            auto &SectInfo = SectionListOut.emplace_back();
+
+            ParseSectionInfo(Section, SectInfo, IsBigEndian, ErrorOut);
+            SectInfo.setSegment(&InfoIn);
+        }
+
+        InfoIn.setSectionList(
+            std::span(SectionListOut.data() + SectionBegin,
+                      SectionListOut.size() - SectionBegin));
+    }
+
+    template <typename T>
+    static void
+    ParseSegmentList(const T &SegmentList,
+                     std::vector<SegmentInfo> &ListOut,
+                     std::vector<SectionInfo> &SectionListOut,
+                     const bool IsBigEndian,
+                     SegmentInfoCollection::Error *const ErrorOut) noexcept
+    {
+        // Size both lists first, so no segment or section moves once another
+        // points to it.
+
+        auto SectionCount = SectionListOut.size();
+        for (const auto *Segment : SegmentList) {
+            if (Segment->isSectionListValid(IsBigEndian)) {
+                SectionCount += Segment->getSectionCount(IsBigEndian);
             }
         }
 
-        return true;
+        ListOut.reserve(ListOut.size() + std::ranges::size(SegmentList));
+        SectionListOut.reserve(SectionCount);
+
+        for (const auto *Segment : SegmentList) {
+            ParseSegmentInfo(*Segment,
+                             ListOut.emplace_back(),
+                             SectionListOut,
+                             IsBigEndian,
+                             ErrorOut);
+        }
     }
 
     void
     SegmentInfoCollection::ParseFromLoadCommands(
-        const ConstLoadCommandStorage &LoadCmdStorage,
+        const LoadCommandIndex &LoadCmdIndex,
         const bool Is64Bit,
         Error *const ErrorOut) noexcept
     {
-        const auto IsBigEndian = LoadCmdStorage.isBigEndian();
+        const auto IsBigEndian = LoadCmdIndex.isBigEndian();
         auto Error = Error::None;
 
+        using Kind = LoadCommand::Kind;
         if (Is64Bit) {
-            for (const auto &LC : LoadCmdStorage) {
-                const auto *Segment =
-                    dyn_cast<LoadCommand::Kind::Segment64>(LC, IsBigEndian);
-
-                if (Segment == nullptr) {
-                    continue;
-                }
-
-                auto Info = std::make_unique<SegmentInfo>();
-                if (ParseSegmentInfo(*Segment,
-                                     *Info.get(),
-                                     IsBigEndian,
-                                     &Error))
-                {
-                    List.emplace_back(std::move(Info));
-                }
-            }
+            ParseSegmentList(LoadCmdIndex.getAllAs<Kind::Segment64>(),
+                             List,
+                             SectionList,
+                             IsBigEndian,
+                             &Error);
         } else {
-            for (const auto &LC : LoadCmdStorage) {
-                const auto *Segment =
-                    dyn_cast<LoadCommand::Kind::Segment>(LC, IsBigEndian);
-
-                if (Segment == nullptr) {
-                    continue;
-                }
-
-                auto Info = std::make_unique<SegmentInfo>();
-                if (ParseSegmentInfo(*Segment,
-                                     *Info.get(),
-                                     IsBigEndian,
-                                     &Error))
-                {
-                    List.emplace_back(std::move(Info));
-                }
-            }
+            ParseSegmentList(LoadCmdIndex.getAllAs<Kind::Segment>(),
+                             List,
+                             SectionList,
+                             IsBigEndian,
+                             &Error);
         }
 
         // Check for any overlaps after collecting a list.
@@ -147,53 +150,53 @@ namespace MachO {
             const auto &ItSegment = *It;
             for (auto Jt = List.cbegin(); Jt != It; Jt++) {
                 const auto &JtSegment = *Jt;
-                const auto JtSegFileRange = JtSegment->getFileRange();
+                const auto JtSegFileRange = JtSegment.getFileRange();
 
-                if (ItSegment->getFileRange().overlaps(JtSegFileRange)) {
+                if (ItSegment.getFileRange().overlaps(JtSegFileRange)) {
                     Error = Error::OverlappingSegments;
                     goto done;
                 }
 
-                const auto JtSegMemoryRange = JtSegment->getMemoryRange();
-                if (ItSegment->getMemoryRange().overlaps(JtSegMemoryRange)) {
+                const auto JtSegMemoryRange = JtSegment.getMemoryRange();
+                if (ItSegment.getMemoryRange().overlaps(JtSegMemoryRange)) {
                     Error = Error::OverlappingSegments;
                     goto done;
                 }
             }
 
-            const auto &SectionList = ItSegment->getSectionList();
+            const auto ItSectionList = ItSegment.getSectionList();
 
-            const auto SectionListBegin = SectionList.cbegin();
-            const auto SectionListEnd = SectionList.cend();
+            const auto SectionListBegin = ItSectionList.begin();
+            const auto SectionListEnd = ItSectionList.end();
 
             for (auto SectIter = SectionListBegin;
                  SectIter != SectionListEnd;
                  SectIter++)
             {
                 const auto &ItSection = *SectIter;
-                const auto &ItSectFileRange = ItSection->getFileRange();
+                const auto &ItSectFileRange = ItSection.getFileRange();
 
                 if (ItSectFileRange.getBegin() == 0) {
                     continue;
                 }
 
-                if (!ItSegment->getFileRange().contains(ItSectFileRange)) {
+                if (!ItSegment.getFileRange().contains(ItSectFileRange)) {
                     Error = Error::InvalidSection;
                     goto done;
                 }
 
-                const auto &ItSectMemoryRange = ItSection->getFileRange();
+                const auto &ItSectMemoryRange = ItSection.getFileRange();
                 for (auto SectJter = SectionListBegin;
                      SectJter != SectIter;
                      SectJter++)
                 {
                     const auto &JtSection = *SectJter;
-                    if (ItSectFileRange.overlaps(JtSection->getFileRange())) {
+                    if (ItSectFileRange.overlaps(JtSection.getFileRange())) {
                         Error = Error::OverlappingSections;
                         goto done;
                     }
 
-                    const auto &JtSectMemoryRange = JtSection->getMemoryRange();
+                    const auto &JtSectMemoryRange = JtSection.getMemoryRange();
                     if (ItSectMemoryRange.overlaps(JtSectMemoryRange)) {
                         Error = Error::OverlappingSections;
                         goto done;
@@ -213,65 +216,83 @@ namespace MachO {
                                 const bool Is64Bit,
                                 Error *const ErrorOut) noexcept
         -> SegmentInfoCollection
+    {
+        const auto LoadCmdIndex = LoadCommandIndex::Build(LoadCmdStorage);
+        return Open(LoadCmdIndex, Is64Bit, ErrorOut);
+    }
+
+    auto
+    SegmentInfoCollection::Open(const LoadCommandIndex &LoadCmdIndex,
+                                const bool Is64Bit,
+                                Error *const ErrorOut) noexcept
+        -> SegmentInfoCollection
     {
         auto Result = SegmentInfoCollection();
-        Result.ParseFromLoadCommands(LoadCmdStorage, Is64Bit, ErrorOut);
+        Result.ParseFromLoadCommands(LoadCmdIndex, Is64Bit, ErrorOut);
 
         return Result;
     }
 
+    template <LoadCommand::Kind Kind>
+    static void
+    ParseSegmentWithName(const ConstLoadCommandStorage &LoadCmdStorage,
+                         const std::string_view Name,
+                         std::vector<SegmentInfo> &ListOut,
+                         std::vector<SectionInfo> &SectionListOut,
+                         SegmentInfoCollection::Error *const ErrorOut) noexcept
+    {
+        const auto IsBigEndian = LoadCmdStorage.isBigEndian();
+        for (const auto &LC : LoadCmdStorage) {
+            const auto *Segment = dyn_cast<Kind>(LC, IsBigEndian);
+            if (Segment == nullptr) {
+                continue;
+            }
+
+            if (!Segment->nameEquals(Name)) {
+                continue;
+            }
+
+            ParseSegmentList(std::array{ Segment },
+                             ListOut,
+                             SectionListOut,
+                             IsBigEndian,
+                             ErrorOut);
+            return;
+        }
+    }
+
     auto
     SegmentInfoCollection::OpenSegmentInfoWithName(
         const ConstLoadCommandStorage &LoadCmdStorage,
         const bool Is64Bit,
         const std::string_view Name,
         Error *const ErrorOut) noexcept
-            -> std::unique_ptr<SegmentInfo>
+            -> SegmentInfoCollection
     {
-        const auto IsBigEndian = LoadCmdStorage.isBigEndian();
-        if (Is64Bit) {
-            for (const auto &LC : LoadCmdStorage) {
-                const auto *Segment =
-                    dyn_cast<LoadCommand::Kind::Segment64>(LC, IsBigEndian);
-
-                if (Segment == nullptr) {
-                    continue;
-                }
-
-                if (!Segment->nameEquals(Name)) {
-                    continue;
-                }
+        auto Error = Error::None;
+        auto Result = SegmentInfoCollection();
 
-                auto Info = std::make_unique<SegmentInfo>();
-                if (ParseSegmentInfo(*Segment,
-                                     *Info.get(),
-                                     IsBigEndian,
-                                     ErrorOut))
-                {
-                    return Info;
-                }
-            }
+        if (Is64Bit) {
+            ParseSegmentWithName<LoadCommand::Kind::Segment64>(
+                LoadCmdStorage,
+                Name,
+                Result.List,
+                Result.SectionList,
+                &Error);
         } else {
-            for (const auto &LC : LoadCmdStorage) {
-                const auto *Segment =
-                    dyn_cast<LoadCommand::Kind::Segment>(LC, IsBigEndian);
-
-                if (!Segment->nameEquals(Name)) {
-                    continue;
-                }
+            ParseSegmentWithName<LoadCommand::Kind::Segment>(
+                LoadCmdStorage,
+                Name,
+                Result.List,
+                Result.SectionList,
+                &Error);
+        }
 
-                auto Info = std::make_unique<SegmentInfo>();
-                if (ParseSegmentInfo(*Segment,
-                                     *Info.get(),
-                                     IsBigEndian,
-                                     ErrorOut))
-                {
-                    return Info;
-                }
-            }
+        if (ErrorOut != nullptr) {
+            *ErrorOut = Error;
         }
 
-        return nullptr;
+        return Result;
     }
 
     auto
@@ -280,118 +301,21 @@ namespace MachO {
         const bool Is64Bit,
         const std::string_view SegmentName,
         const std::string_view SectionName,
-        std::unique_ptr<SegmentInfo> *const SegmentOut,
+        SegmentInfoCollection *const SegmentOut,
         Error *const ErrorOut) noexcept
-            -> std::unique_ptr<SectionInfo>
+            -> const SectionInfo *
     {
-        const auto IsBigEndian = LoadCmdStorage.isBigEndian();
-        if (Is64Bit) {
-            for (const auto &LC : LoadCmdStorage) {
-                const auto *Segment =
-                    dyn_cast<LoadCommand::Kind::Segment64>(LC, IsBigEndian);
-
-                if (Segment == nullptr) {
-                    continue;
-                }
+        *SegmentOut =
+            OpenSegmentInfoWithName(LoadCmdStorage,
+                                    Is64Bit,
+                                    SegmentName,
+                                    ErrorOut);
 
-                if (!Segment->nameEquals(SegmentName)) {
-                    continue;
-                }
-
-                auto Info = std::make_unique<SegmentInfo>();
-                if (!ParseSegmentInfo(*Segment,
-                                      *Info.get(),
-                                      IsBigEndian,
-                                      ErrorOut))
-                {
-                    return nullptr;
-                }
-
-                if (!Segment->isSectionListValid(IsBigEndian)) {
-                    *SegmentOut = std::move(Info);
-                    return nullptr;
-                }
-
-                *SegmentOut = std::move(Info);
-                const auto SectionList =
-                    Segment->getConstSectionListUnsafe(IsBigEndian);
-
-                for (const auto &Sect : SectionList) {
-                    if (!Sect.nameEquals(SectionName)) {
-                        continue;
-                    }
-
-                    auto SectInfo = std::make_unique<SectionInfo>();
-                    const auto ParseSectResult =
-                        ParseSectionInfo(Sect,
-                                         *SectInfo.get(),
-                                         IsBigEndian,
-                                         ErrorOut);
-
-                    if (!ParseSectResult) {
-                        return nullptr;
-                    }
-
-                    return SectInfo;
-                }
-
-                return nullptr;
-            }
-        } else {
-            for (const auto &LC : LoadCmdStorage) {
-                const auto *Segment =
-                    dyn_cast<LoadCommand::Kind::Segment>(LC, IsBigEndian);
-
-                if (Segment == nullptr) {
-                    continue;
-                }
-
-                if (!Segment->nameEquals(SegmentName)) {
-                    continue;
-                }
-
-                auto Info = std::make_unique<SegmentInfo>();
-                if (!ParseSegmentInfo(*Segment,
-                                      *Info.get(),
-                                      IsBigEndian,
-                                      ErrorOut))
-                {
-                    return nullptr;
-                }
-
-                if (!Segment->isSectionListValid(IsBigEndian)) {
-                    *SegmentOut = std::move(Info);
-                    return nullptr;
-                }
-
-                *SegmentOut = std::move(Info);
-                const auto SectionList =
-                    Segment->getConstSectionListUnsafe(IsBigEndian);
-
-                for (const auto &Sect : SectionList) {
-                    if (!Sect.nameEquals(SectionName)) {
-                        continue;
-                    }
-
-                    auto SectInfo = std::make_unique<SectionInfo>();
-                    const auto ParseSectResult =
-                        ParseSectionInfo(Sect,
-                                         *SectInfo.get(),
-                                         IsBigEndian,
-                                         ErrorOut);
-
-                    if (!ParseSectResult) {
-                        return nullptr;
-                    }
-
-                    return SectInfo;
-                }
-
-                return nullptr;
-            }
+        if (SegmentOut->empty()) {
+            return nullptr;
         }
 
-        return nullptr;
+        return SegmentOut->front().FindSectionWithName(SectionName);
     }
 
     auto SegmentInfoCollection::GetInfoForName(
@@ -399,8 +323,8 @@ namespace MachO {
             -> const SegmentInfo *
     {
         for (const auto &SegInfo : *this) {
-            if (SegInfo->getName() == Name) {
-                return SegInfo.get();
+            if (SegInfo.getName() == Name) {
+                return &SegInfo;
             }
         }
 
@@ -412,8 +336,8 @@ namespace MachO {
         -> const SectionInfo *
     {
         for (const auto &SectInfo : getSectionList()) {
-            if (SectInfo->getName() == Name) {
-                return SectInfo.get();
+            if (SectInfo.getName() == Name) {
+                return &SectInfo;
             }
         }
 
@@ -460,22 +384,17 @@ namespace MachO {
 
     auto
     SegmentInfoCollection::GetSectionWithIndex(
-        uint64_t SectionIndex) const noexcept
+        const uint64_t SectionIndex) const noexcept
             -> const SectionInfo *
     {
-        for (const auto &Segment : List) {
-            const auto &SectionList = Segment->getSectionList();
-            const auto SectionListSize = SectionList.size();
-
-            if (IndexOutOfBounds(SectionIndex, SectionListSize)) {
-                SectionIndex -= SectionListSize;
-                continue;
-            }
+        // Every segment's sections are stored in order, so the index of a
+        // section in SectionList is also its index across every segment.
 
-            return SectionList.at(SectionIndex).get();
+        if (IndexOutOfBounds(SectionIndex, SectionList.size())) {
+            return nullptr;
         }
 
-        return nullptr;
+        return &SectionList[SectionIndex];
     }
 
     auto
@@ -484,8 +403,8 @@ namespace MachO {
             -> const SegmentInfo *
     {
         for (const auto &Segment : *this) {
-            if (Segment->getMemoryRange().hasLocation(Address)) {
-                return Segment.get();
+            if (Segment.getMemoryRange().hasLocation(Address)) {
+                return &Segment;
             }
         }
 
@@ -497,8 +416,8 @@ namespace MachO {
             -> const SectionInfo *
     {
         for (const auto &Section : getSectionList()) {
-            if (Section->getMemoryRange().hasLocation(Address)) {
-                return Section.get();
+            if (Section.getMemoryRange().hasLocation(Address)) {
+                return &Section;
             }
         }
 
@@ -532,19 +451,19 @@ namespace MachO {
 
         const auto DataRange = Range::CreateWithEnd(Addr, Addr + Size);
         for (const auto &Segment : Collection) {
-            if (!Segment->getMemoryRange().contains(DataRange)) {
+            if (!Segment.getMemoryRange().contains(DataRange)) {
                 continue;
             }
 
-            for (const auto &Section : Segment->getSectionList()) {
-                const auto &SectMemoryRange = Section->getMemoryRange();
+            for (const auto &Section : Segment.getSectionList()) {
+                const auto &SectMemoryRange = Section.getMemoryRange();
                 if (!SectMemoryRange.contains(DataRange)) {
                     continue;
                 }
 
-                const auto Data = Section->getData(Map);
+                const auto Data = Section.getData(Map);
                 const auto Offset = (Addr - SectMemoryRange.getBegin());
-                const auto &SectFileRange = Section->getFileRange();
+                const auto &SectFileRange = Section.getFileRange();
 
                 if (!SectFileRange.hasIndex(Offset)) {
                     return nullptr;
@@ -576,15 +495,15 @@ namespace MachO {
 
         const auto DataRange = Range::CreateWithEnd(Addr, Addr + Size);
         for (const auto &Segment : Collection) {
-            if (!Segment->getMemoryRange().contains(DataRange)) {
+            if (!Segment.getMemoryRange().contains(DataRange)) {
                 continue;
             }
 
-            const auto Data = Segment->getData(Map);
-            const auto Offset = (Addr - Segment->getMemoryRange().getBegin());
+            const auto Data = Segment.getData(Map);
+            const auto Offset = (Addr - Segment.getMemoryRange().getBegin());
 
             if (EndOut != nullptr) {
-                const auto SegmentSize = Segment->getFileRange().size();
+                const auto SegmentSize = Segment.getFileRange().size();
                 *EndOut = reinterpret_cast<T *>(Data + SegmentSize);
             }
 
@@ -39,16 +39,15 @@ namespace MachO {
             }
 
             const auto &Info = DylibCmd.Info;
-            auto LibInfo = std::make_unique<SharedLibraryInfo>();
+            auto &LibInfo = Result.List.emplace_back();
 
-            LibInfo->setKind(LC.getKind(IsBigEndian));
-            LibInfo->setPath(std::string(Name));
-            LibInfo->setIndex(LCIndex);
-            LibInfo->setTimestamp(Info.getTimestamp(IsBigEndian));
-            LibInfo->setCurrentVersion(Info.getCurrentVersion(IsBigEndian));
-            LibInfo->setCompatVersion(Info.getCompatVersion(IsBigEndian));
+            LibInfo.setKind(LC.getKind(IsBigEndian));
+            LibInfo.setPath(Name);
+            LibInfo.setIndex(LCIndex);
+            LibInfo.setTimestamp(Info.getTimestamp(IsBigEndian));
+            LibInfo.setCurrentVersion(Info.getCurrentVersion(IsBigEndian));
+            LibInfo.setCompatVersion(Info.getCompatVersion(IsBigEndian));
 
-            Result.List.emplace_back(std::move(LibInfo));
             LCIndex++;
         }
 
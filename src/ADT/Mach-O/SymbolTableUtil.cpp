@@ -12,6 +12,7 @@
 #include "ADT/Mach-O/SymbolTableUtil.h"
 
 #include "Utils/PointerUtils.h"
+#include "Utils/SwitchEndian.h"
 
 namespace MachO {
     typedef
@@ -28,7 +29,7 @@ namespace MachO {
                            const SymbolTableEntry64,
                            const SymbolTableEntry32>;
 
-    template <PointerKind Kind>
+    template <PointerKind Kind, bool IsBigEndian>
     [[nodiscard]] static auto
     ParseSymbol(const MachOSymbolTableEntryTypeCalculator<Kind> &Entry,
                 const uint64_t Index,
@@ -37,9 +38,8 @@ namespace MachO {
                 InfoMap &InfoMap,
                 StringMap &StringMap,
                 const enum SymbolTableEntryCollection::KeyKindEnum KeyKind,
-                const SymbolTableEntryCollection::ParseOptions &Options,
-                const bool IsBigEndian) noexcept
-        -> SymbolTableEntryCollection::Error
+                const SymbolTableEntryCollection::ParseOptions &Options)
+        noexcept -> SymbolTableEntryCollection::Error
     {
         if (Entry.Info.isExternal()) {
             if (Options.IgnoreExternal) {
@@ -137,7 +137,7 @@ namespace MachO {
         return SymbolTableParseError::None;
     }
 
-    template <PointerKind Kind>
+    template <PointerKind Kind, bool IsBigEndian>
     [[nodiscard]] static auto
     ParseList(const uint8_t *Begin,
               const uint64_t Count,
@@ -147,9 +147,8 @@ namespace MachO {
               InfoMap &InfoMap,
               StringMap &StringMap,
               enum SymbolTableEntryCollection::KeyKindEnum KeyKind,
-              const SymbolTableEntryCollection::ParseOptions &Options,
-              bool IsBigEndian) noexcept
-        -> SymbolTableEntryCollection::Error
+              const SymbolTableEntryCollection::ParseOptions &Options)
+        noexcept -> SymbolTableEntryCollection::Error
     {
         using PointerType = MachOSymbolTableEntryTypeCalculator<Kind>;
         auto Index = NlistStartIndex;
@@ -159,15 +158,65 @@ namespace MachO {
 
         for (auto Iter = List.begin(); Iter != ListEnd; Iter++, Index++) {
             const auto Error =
-                ParseSymbol<Kind>(*Iter,
-                                  Index,
-                                  StrTab,
-                                  StrTabEnd,
-                                  InfoMap,
-                                  StringMap,
-                                  KeyKind,
-                                  Options,
-                                  IsBigEndian);
+                ParseSymbol<Kind, IsBigEndian>(*Iter,
+                                               Index,
+                                               StrTab,
+                                               StrTabEnd,
+                                               InfoMap,
+                                               StringMap,
+                                               KeyKind,
+                                               Options);
+
+            if (Error != SymbolTableParseError::None) {
+                return Error;
+            }
+        }
+
+        return SymbolTableParseError::None;
+    }
+
+    template <PointerKind Kind, bool IsBigEndian>
+    [[nodiscard]] static auto
+    ParseIndirectList(const uint8_t *const NlistBegin,
+                      const uint64_t NlistCount,
+                      const uint32_t *const IndexBegin,
+                      const uint64_t IndexCount,
+                      const char *const StrTab,
+                      const char *const StrTabEnd,
+                      InfoMap &InfoMap,
+                      StringMap &StringMap,
+                      enum SymbolTableEntryCollection::KeyKindEnum KeyKind,
+                      const SymbolTableEntryCollection::ParseOptions &Options)
+        noexcept -> SymbolTableEntryCollection::Error
+    {
+        using EntryType = MachOSymbolTableEntryTypeCalculator<Kind>;
+
+        const auto IndexList =
+            BasicContiguousList(IndexBegin, IndexBegin + IndexCount);
+        const auto EntryList =
+            BasicContiguousList<EntryType>(NlistBegin, NlistCount);
+
+        for (const auto &StoredIndex : IndexList) {
+            const auto Index = SwitchEndianIf(StoredIndex, IsBigEndian);
+            if (Index == IndirectSymbolAbsolute ||
+                Index == IndirectSymbolLocal)
+            {
+                continue;
+            }
+
+            if (IndexOutOfBounds(Index, EntryList.count())) {
+                return SymbolTableParseError::OutOfBoundsIndirectIndex;
+            }
+
+            const auto Error =
+                ParseSymbol<Kind, IsBigEndian>(EntryList.at(Index),
+                                               Index,
+                                               StrTab,
+                                               StrTabEnd,
+                                               InfoMap,
+                                               StringMap,
+                                               KeyKind,
+                                               Options);
 
             if (Error != SymbolTableParseError::None) {
                 return Error;
@@ -189,33 +238,31 @@ namespace MachO {
                                       Error *const ErrorOut) noexcept
         -> decltype(*this)
     {
-        auto Error = SymbolTableEntryCollection::Error();
-        if (Is64Bit) {
-            Error =
-                ParseList<PointerKind::s64Bit>(NlistBegin,
-                                               NlistCount,
-                                               0,
-                                               StrTab,
-                                               StrEnd,
-                                               InfoMap,
-                                               StringMap,
-                                               KeyKind,
-                                               Options,
-                                               IsBigEndian);
-        } else {
-            Error =
-                ParseList<PointerKind::s32Bit>(NlistBegin,
-                                               NlistCount,
-                                               0,
-                                               StrTab,
-                                               StrEnd,
-                                               InfoMap,
-                                               StringMap,
-                                               KeyKind,
-                                               Options,
-                                               IsBigEndian);
-        }
+        const auto ParseWithEndian = [&](const auto BigEndian) noexcept {
+            if (Is64Bit) {
+                return ParseList<PointerKind::s64Bit, BigEndian()>(NlistBegin,
+                                                                   NlistCount,
+                                                                   0,
+                                                                   StrTab,
+                                                                   StrEnd,
+                                                                   InfoMap,
+                                                                   StringMap,
+                                                                   KeyKind,
+                                                                   Options);
+            }
 
+            return ParseList<PointerKind::s32Bit, BigEndian()>(NlistBegin,
+                                                               NlistCount,
+                                                               0,
+                                                               StrTab,
+                                                               StrEnd,
+                                                               InfoMap,
+                                                               StringMap,
+                                                               KeyKind,
+                                                               Options);
+        };
+
+        const auto Error = DispatchOnEndian(IsBigEndian, ParseWithEndian);
         if (Error != Error::None) {
             *ErrorOut = Error;
         }
@@ -266,87 +313,38 @@ namespace MachO {
         Error *const ErrorOut) noexcept
             -> decltype(*this)
     {
-        const auto IndexEnd = IndexBegin + IndexCount;
-        const auto IndexList = BasicContiguousList(IndexBegin, IndexEnd);
-
-        if (Is64Bit) {
-            using EntryType =
-                 MachOSymbolTableEntryTypeCalculator<PointerKind::s64Bit>;
-
-            const auto EntryList =
-                BasicContiguousList<EntryType>(NlistBegin, NlistCount);
-
-            for (const auto &Index : IndexList) {
-                if (Index == IndirectSymbolAbsolute ||
-                    Index == IndirectSymbolLocal)
-                {
-                    continue;
-                }
-
-                if (IndexOutOfBounds(Index, EntryList.count())) {
-                    if (ErrorOut != nullptr) {
-                        *ErrorOut =
-                            SymbolTableParseError::OutOfBoundsIndirectIndex;
-                    }
-
-                    return *this;
-                }
-
-                const auto Error =
-                    ParseSymbol<PointerKind::s64Bit>(EntryList.at(Index),
-                                                     Index,
-                                                     StrTab,
-                                                     StrEnd,
-                                                     InfoMap,
-                                                     StringMap,
-                                                     KeyKind,
-                                                     Options,
-                                                     IsBigEndian);
-
-                if (Error != SymbolTableParseError::None) {
-                    if (ErrorOut != nullptr) {
-                        *ErrorOut = Error;
-                    }
-
-                    return *this;
-                }
+        const auto ParseWithEndian = [&](const auto BigEndian) noexcept {
+            if (Is64Bit) {
+                return ParseIndirectList<PointerKind::s64Bit, BigEndian()>(
+                    NlistBegin,
+                    NlistCount,
+                    IndexBegin,
+                    IndexCount,
+                    StrTab,
+                    StrEnd,
+                    InfoMap,
+                    StringMap,
+                    KeyKind,
+                    Options);
             }
-        } else {
-            using EntryType =
-                 MachOSymbolTableEntryTypeCalculator<PointerKind::s32Bit>;
-
-            const auto EntryList =
-                BasicContiguousList<EntryType>(NlistBegin, NlistCount);
-
-            for (const auto &Index : IndexList) {
-                if (IndexOutOfBounds(Index, EntryList.count())) {
-                    if (ErrorOut != nullptr) {
-                        *ErrorOut =
-                            SymbolTableParseError::OutOfBoundsIndirectIndex;
-                    }
-
-                    return *this;
-                }
-
-                const auto Error =
-                    ParseSymbol<PointerKind::s32Bit>(EntryList.at(Index),
-                                                     Index,
-                                                     StrTab,
-                                                     StrEnd,
-                                                     InfoMap,
-                                                     StringMap,
-                                                     KeyKind,
-                                                     Options,
-                                                     IsBigEndian);
-
-                if (Error != SymbolTableParseError::None) {
-                    if (ErrorOut != nullptr) {
-                        *ErrorOut = Error;
-                    }
-
-                    return *this;
-                }
 
+            return ParseIndirectList<PointerKind::s32Bit, BigEndian()>(
+                NlistBegin,
+                NlistCount,
+                IndexBegin,
+                IndexCount,
+                StrTab,
+                StrEnd,
+                InfoMap,
+                StringMap,
+                KeyKind,
+                Options);
+        };
+
+        const auto Error = DispatchOnEndian(IsBigEndian, ParseWithEndian);
+        if (Error != SymbolTableParseError::None) {
+            if (ErrorOut != nullptr) {
+                *ErrorOut = Error;
             }
         }
 
@@ -6,16 +6,48 @@
 //  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
 //
 
+#include <sys/stat.h>
+
 #include <cassert>
-#include <string>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#if defined(__linux__)
+    #include <linux/fs.h>
+    #include <sys/ioctl.h>
+    #include <sys/sendfile.h>
+#endif
 
 #include "ADT/OutputFile.h"
 
-OutputFile::OutputFile() noexcept {
-    const auto RandNumber = rand() % 99999;
-    const auto FileName = "Tmp." + std::to_string(RandNumber);
+OutputFile::OutputFile(const std::string_view Path, const int Mode) noexcept
+: Path(Path), TmpPath(Path) {
+    // The temporary file is created in Path's directory so that Finalize()'s
+    // rename() never crosses filesystems.
+
+    TmpPath.append(".XXXXXX");
+    this->Tmp = mkstemp(TmpPath.data());
+
+    if (Tmp.hasError()) {
+        TmpPath.clear();
+        return;
+    }
+
+    if (fchmod(Tmp.getDescriptor(), static_cast<mode_t>(Mode)) != 0) {
+        Close();
+        unlink(TmpPath.c_str());
 
-    this->Tmp = FileDescriptor::Create(FileName.data(), 0600);
+        TmpPath.clear();
+    }
+}
+
+OutputFile::~OutputFile() noexcept {
+    Close();
+    if (!TmpPath.empty()) {
+        unlink(TmpPath.c_str());
+    }
 }
 
 bool OutputFile::Read(void *const Buf, const size_t Size) const noexcept {
@@ -28,12 +60,118 @@ bool OutputFile::Write(const void *const Buf, const size_t Size) noexcept {
     return Tmp.Write(Buf, Size);
 }
 
+bool
+OutputFile::WriteAt(const void *const Buf,
+                    const size_t Size,
+                    const uint64_t Offset) noexcept
+{
+    assert(this->isOpen() && "OutputFile must be open");
+    return Tmp.WriteAt(Buf, Size, Offset);
+}
+
 bool OutputFile::TruncateToSize(const uint64_t Length) noexcept {
     assert(this->isOpen() && "OutputFile must be open");
     return Tmp.TruncateToSize(Length);
 }
 
-bool OutputFile::Finalize(const char *const Path) noexcept {
+bool
+OutputFile::CopyRangeFrom(const int SrcFd,
+                          const uint64_t SrcOffset,
+                          const uint64_t Size) noexcept
+{
+    assert(this->isOpen() && "OutputFile must be open");
+#if defined(__linux__)
+    const auto Fd = Tmp.getDescriptor();
+
+    // Copy-on-write filesystems (btrfs, xfs) can share the range's extents
+    // instead of copying them.
+
+    auto CloneRange = file_clone_range {
+        .src_fd = SrcFd,
+        .src_offset = SrcOffset,
+        .src_length = Size,
+        .dest_offset = 0
+    };
+
+    if (ioctl(Fd, FICLONERANGE, &CloneRange) == 0) {
+        return true;
+    }
+
+    auto InOffset = static_cast<loff_t>(SrcOffset);
+    auto OutOffset = loff_t();
+    auto Left = Size;
+
+    while (Left != 0) {
+        const auto Copied =
+            copy_file_range(SrcFd, &InOffset, Fd, &OutOffset, Left, 0);
+
+        if (Copied < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            break;
+        }
+
+        if (Copied == 0) {
+            errno = EIO;
+            return false;
+        }
+
+        Left -= static_cast<uint64_t>(Copied);
+    }
+
+    if (Left == 0) {
+        return true;
+    }
+
+    // copy_file_range() isn't supported between every pair of filesystems,
+    // so finish the copy with sendfile(), which writes at the file-position.
+
+    if (lseek(Fd, OutOffset, SEEK_SET) < 0) {
+        return false;
+    }
+
+    auto SendOffset = static_cast<off_t>(InOffset);
+    while (Left != 0) {
+        const auto Sent = sendfile(Fd, SrcFd, &SendOffset, Left);
+        if (Sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        if (Sent == 0) {
+            errno = EIO;
+            return false;
+        }
+
+        Left -= static_cast<uint64_t>(Sent);
+    }
+
+    return true;
+#else
+    // Darwin only supports cloning and copying entire files.
+
+    static_cast<void>(SrcFd);
+    static_cast<void>(SrcOffset);
+    static_cast<void>(Size);
+
+    errno = ENOTSUP;
+    return false;
+#endif
+}
+
+bool OutputFile::Finalize() noexcept {
+    assert(this->isOpen() && "OutputFile must be open");
+
     Close();
-    return (rename(this->TmpPath, Path) == 0);
+    if (rename(TmpPath.c_str(), Path.c_str()) != 0) {
+        return false;
+    }
+
+    TmpPath.clear();
+    return true;
 }
@@ -11,7 +11,12 @@
 DscImageMemoryObject::DscImageMemoryObject(
     const MemoryMap &DscMap,
     const DyldSharedCache::ImageInfo &ImageInfo,
+    std::shared_ptr<const DyldSharedCache::RebasedView> RebasedView,
     uint8_t *const Begin,
-    uint8_t *const End) noexcept
-: MachOMemoryObject(ObjKind, MemoryMap(Begin, End)), DscMap(DscMap),
-  ImageInfo(ImageInfo) {}
+    uint8_t *const End,
+    MachO::LoadCommandIndex &&LoadCmdIndex) noexcept
+: MachOMemoryObject(ObjKind,
+                    MemoryMap(Begin, End),
+                    std::move(LoadCmdIndex)),
+  DscMap(DscMap), ImageInfo(ImageInfo),
+  RebasedView(std::move(RebasedView)) {}
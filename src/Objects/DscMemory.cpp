@@ -19,7 +19,9 @@ using namespace std::literals;
 DscMemoryObject::DscMemoryObject(const MemoryMap &Map,
                                  const CpuKind CpuKind) noexcept
 : MemoryObject(ObjKind), Map(Map.getBegin()), End(Map.getEnd()),
-  sCpuKind(CpuKind) {}
+  sCpuKind(CpuKind),
+  RebasedView(
+    std::make_shared<const DyldSharedCache::RebasedView>(this->getMap())) {}
 
 [[nodiscard]] static auto
 ValidateMap(const ConstMemoryMap &Map,
@@ -219,8 +221,10 @@ DscMemoryObject::retrieveCpuAndSubKind(Mach::CpuKind &CpuKind,
 }
 
 auto
-DscMemoryObject::ValidateImageMapAndGetEnd(const ConstMemoryMap &Map) noexcept
-    -> ExpectedPointer<const uint8_t, DscImageOpenError>
+DscMemoryObject::ValidateImageMapAndGetEnd(
+    const ConstMemoryMap &Map,
+    MachO::LoadCommandIndex &LoadCmdIndexOut) noexcept
+        -> ExpectedPointer<const uint8_t, DscImageOpenError>
 {
     const auto ValidateError = MachOMemoryObject::ValidateMap(Map);
     switch (ValidateError) {
@@ -244,27 +248,25 @@ DscMemoryObject::ValidateImageMapAndGetEnd(const ConstMemoryMap &Map) noexcept
     }
 
     const auto Is64Bit = Header.is64Bit();
-    const auto IsBE = Header.isBigEndian();
     const auto LoadCmdStorage = Header.GetConstLoadCmdStorage();
 
     if (LoadCmdStorage.hasError()) {
         return DscImageOpenError::InvalidLoadCommands;
     }
 
+    auto LoadCmdIndex = MachO::LoadCommandIndex::Build(LoadCmdStorage);
     auto End = Map.getBegin();
+
+    using LCKind = MachO::LoadCommand::Kind;
     if (Is64Bit) {
-        for (const auto &LC : LoadCmdStorage) {
-            if (const auto *Seg = dyn_cast<MachO::SegmentCommand64>(LC, IsBE)) {
-                if (DoesAddOverflow(End, Seg->FileSize, &End)) {
-                    return DscImageOpenError::SizeTooLarge;
-                }
+        for (const auto *Seg : LoadCmdIndex.getAllAs<LCKind::Segment64>()) {
+            if (DoesAddOverflow(End, Seg->FileSize, &End)) {
+                return DscImageOpenError::SizeTooLarge;
             }
         }
     } else {
-        for (const auto &LC : LoadCmdStorage) {
-            if (const auto Seg = dyn_cast<MachO::SegmentCommand>(LC, IsBE)) {
-                End += Seg->FileSize;
-            }
+        for (const auto *Seg : LoadCmdIndex.getAllAs<LCKind::Segment>()) {
+            End += Seg->FileSize;
         }
     }
 
@@ -272,6 +274,7 @@ DscMemoryObject::ValidateImageMapAndGetEnd(const ConstMemoryMap &Map) noexcept
         return DscImageOpenError::SizeTooLarge;
     }
 
+    LoadCmdIndexOut = std::move(LoadCmdIndex);
     return End;
 }
 
@@ -298,12 +301,19 @@ auto DscMemoryObject::GetImageWithInfo(
             const_cast<uint8_t *>(GetPtrForAddress(ImageInfo.Address)))
     {
         const auto Map = this->getMutMap();
+
+        auto LoadCmdIndex = MachO::LoadCommandIndex();
         const auto EndOrError =
-            ValidateImageMapAndGetEnd(Map.mapFromPtr(Ptr));
+            ValidateImageMapAndGetEnd(Map.mapFromPtr(Ptr), LoadCmdIndex);
 
         if (EndOrError.hasValue()) {
             const auto End = const_cast<uint8_t *>(EndOrError.value());
-            return new DscImageMemoryObject(Map, ImageInfo, Ptr, End);
+            return new DscImageMemoryObject(Map,
+                                            ImageInfo,
+                                            getRebasedView(),
+                                            Ptr,
+                                            End,
+                                            std::move(LoadCmdIndex));
         }
     }
 
@@ -316,12 +326,19 @@ auto DscMemoryObject::GetImageWithInfo(
 {
     if (const auto Ptr = GetPtrForAddress(ImageInfo.Address)) {
         const auto Map = this->getMutMap();
+
+        auto LoadCmdIndex = MachO::LoadCommandIndex();
         const auto EndOrError =
-            ValidateImageMapAndGetEnd(Map.mapFromPtr(Ptr));
+            ValidateImageMapAndGetEnd(Map.mapFromPtr(Ptr), LoadCmdIndex);
 
         if (EndOrError.hasValue()) {
             const auto End = const_cast<uint8_t *>(EndOrError.value());
-            return new DscImageMemoryObject(Map, ImageInfo, Ptr, End);
+            return new DscImageMemoryObject(Map,
+                                            ImageInfo,
+                                            getRebasedView(),
+                                            Ptr,
+                                            End,
+                                            std::move(LoadCmdIndex));
         }
     }
 
@@ -10,13 +10,17 @@
 #include "Utils/DoesOverflow.h"
 
 MachOMemoryObject::MachOMemoryObject(
-    const MemoryMap &Map) noexcept
-: MemoryObject(ObjKind), Map(Map.getBegin()), End(Map.getEnd()) {}
+    const MemoryMap &Map,
+    MachO::LoadCommandIndex &&LoadCmdIndex) noexcept
+: MemoryObject(ObjKind), Map(Map.getBegin()), End(Map.getEnd()),
+  LoadCmdIndex(std::move(LoadCmdIndex)) {}
 
 MachOMemoryObject::MachOMemoryObject(
     const ObjectKind Kind,
-    const MemoryMap &Map) noexcept
-: MemoryObject(Kind), Map(Map.getBegin()), End(Map.getEnd()) {}
+    const MemoryMap &Map,
+    MachO::LoadCommandIndex &&LoadCmdIndex) noexcept
+: MemoryObject(Kind), Map(Map.getBegin()), End(Map.getEnd()),
+  LoadCmdIndex(std::move(LoadCmdIndex)) {}
 
 auto
 MachOMemoryObject::ValidateMap(const ConstMemoryMap &Map) noexcept -> Error {
@@ -74,7 +78,11 @@ auto MachOMemoryObject::Open(const MemoryMap &Map) noexcept
         return Error;
     }
 
-    return new MachOMemoryObject(Map);
+    const auto &Header = *Map.getBeginAs<MachO::Header>();
+    auto LoadCmdIndex =
+        MachO::LoadCommandIndex::Build(Header.GetConstLoadCmdStorage());
+
+    return new MachOMemoryObject(Map, std::move(LoadCmdIndex));
 }
 
 bool MachOMemoryObject::errorDidMatchFormat(const Error Error) noexcept {
@@ -87,11 +87,97 @@ Operation::SupportsObjectKind(OperationKind OpKind, ObjectKind ObjKind) noexcept
             return
                 OperationTypeFromKind<Enum::PrintImageList>::
                     SupportsObjectKind(ObjKind);
+        case OperationKind::SearchCStrings:
+            return
+                OperationTypeFromKind<Enum::SearchCStrings>::
+                    SupportsObjectKind(ObjKind);
+        case OperationKind::PrintObjcMethodList:
+            return
+                OperationTypeFromKind<Enum::PrintObjcMethodList>::
+                    SupportsObjectKind(ObjKind);
+        case OperationKind::PrintImageDependencies:
+            return
+                OperationTypeFromKind<Enum::PrintImageDependencies>::
+                    SupportsObjectKind(ObjKind);
+        case OperationKind::PrintResolvedBinds:
+            return
+                OperationTypeFromKind<Enum::PrintResolvedBinds>::
+                    SupportsObjectKind(ObjKind);
+        case OperationKind::PrintDiff:
+            return
+                OperationTypeFromKind<Enum::PrintDiff>::
+                    SupportsObjectKind(ObjKind);
+        case OperationKind::PrintSlideInfo:
+            return
+                OperationTypeFromKind<Enum::PrintSlideInfo>::
+                    SupportsObjectKind(ObjKind);
+        case OperationKind::PrintSymbolList:
+            return
+                OperationTypeFromKind<Enum::PrintSymbolList>::
+                    SupportsObjectKind(ObjKind);
+        case OperationKind::ExtractImage:
+            return
+                OperationTypeFromKind<Enum::ExtractImage>::
+                    SupportsObjectKind(ObjKind);
+        case OperationKind::ThinArch:
+            return
+                OperationTypeFromKind<Enum::ThinArch>::
+                    SupportsObjectKind(ObjKind);
     }
 
     assert(0 && "Reached end of OperationKindSupportsObjectKind()");
 }
 
+bool
+Operation::SupportsOutputFormat(const OperationKind OpKind,
+                                const OutputFormat Format) noexcept
+{
+    if (Format == OutputFormat::Default) {
+        return true;
+    }
+
+    switch (OpKind) {
+        case OperationKind::None:
+            assert(0 && "Operation-Kind is None");
+        case OperationKind::PrintHeader:
+        case OperationKind::PrintLoadCommands:
+        case OperationKind::PrintId:
+        case OperationKind::PrintBindOpcodeList:
+        case OperationKind::PrintRebaseOpcodeList:
+        case OperationKind::ExtractImage:
+        case OperationKind::ThinArch:
+            return false;
+        case OperationKind::PrintSharedLibraries:
+        case OperationKind::PrintArchList:
+        case OperationKind::PrintExportTrie:
+        case OperationKind::PrintObjcClassList:
+        case OperationKind::PrintBindActionList:
+        case OperationKind::PrintBindSymbolList:
+        case OperationKind::PrintRebaseActionList:
+        case OperationKind::PrintCStringSection:
+        case OperationKind::PrintSymbolPtrSection:
+        case OperationKind::PrintImageList:
+        case OperationKind::SearchCStrings:
+        case OperationKind::PrintObjcMethodList:
+        case OperationKind::PrintImageDependencies:
+        case OperationKind::PrintResolvedBinds:
+        case OperationKind::PrintDiff:
+        case OperationKind::PrintSlideInfo:
+        case OperationKind::PrintSymbolList:
+            switch (Format) {
+                case OutputFormat::Default:
+                case OutputFormat::Json:
+                case OutputFormat::NdJson:
+                case OutputFormat::Binary:
+                    return true;
+            }
+
+            break;
+    }
+
+    assert(0 && "Reached end of Operation::SupportsOutputFormat()");
+}
+
 void
 Operation::PrintLineSpamWarning(FILE *const OutFile,
                                 const uint64_t LineAmount) noexcept
@@ -113,6 +199,43 @@ Operation::PrintLineSpamWarning(FILE *const OutFile,
     // sleep(DelayAmount);
 }
 
+auto
+Operation::ParseOutputFormatOption(const std::string_view Option,
+                                   const OperationKind ForKind) noexcept
+    -> OutputFormat
+{
+    assert(Option.starts_with(OutputFormatOptionPrefix));
+
+    const auto Format = Option.substr(OutputFormatOptionPrefix.length());
+    auto Result = OutputFormat::Default;
+
+    if (Format == "text") {
+        Result = OutputFormat::Default;
+    } else if (Format == "json") {
+        Result = OutputFormat::Json;
+    } else if (Format == "ndjson") {
+        Result = OutputFormat::NdJson;
+    } else if (Format == "bin") {
+        Result = OutputFormat::Binary;
+    } else {
+        fprintf(stderr,
+                "Unrecognized output-format for operation %s: %s\n",
+                OperationKindGetName(ForKind).data(),
+                Format.data());
+        exit(1);
+    }
+
+    if (!SupportsOutputFormat(ForKind, Result)) {
+        fprintf(stderr,
+                "Operation %s does not support output-format %s\n",
+                OperationKindGetName(ForKind).data(),
+                Format.data());
+        exit(1);
+    }
+
+    return Result;
+}
+
 static
 void PrintSelectArchMessage(const FatMachOMemoryObject &Object) noexcept {
     const auto ArchCount = Object.getArchCount();
@@ -287,6 +410,11 @@ Operation::PrintOptionHelpMenu(FILE *const OutFile,
                     Tab);
             break;
         case OperationKind::PrintObjcClassList:
+            fprintf(OutFile,
+                    "%s%s    --class=<name>,          Only print Objective-C "
+                    "Classes named <name>\n",
+                    LinePrefix,
+                    Tab);
             fprintf(OutFile,
                     "%s%s    --include-categories,    Include Objective-C "
                     "Class Categories\n",
@@ -428,11 +556,31 @@ Operation::PrintOptionHelpMenu(FILE *const OutFile,
             break;
         case OperationKind::PrintCStringSection:
             fprintf(OutFile,
-                    "%s%s    --sort,    Sort C-String List\n",
+                    "%s%s    --all-sections, List C-Strings of every C-String "
+                    "Section\n",
                     LinePrefix,
                     Tab);
             fprintf(OutFile,
-                    "%s%s-v, --verbose, Print more Verbose Information\n",
+                    "%s%s    --dedupe,       List only Unique C-Strings, with "
+                    "their Counts\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --stats,        Print Statistics on Duplicated "
+                    "C-Strings\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --top=<count>,  Print the <count> most Frequent "
+                    "C-Strings with --stats\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --sort,         Sort C-String List\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s-v, --verbose,      Print more Verbose Information\n",
                     LinePrefix,
                     Tab);
             break;
@@ -487,6 +635,190 @@ Operation::PrintOptionHelpMenu(FILE *const OutFile,
                     LinePrefix,
                     Tab);
             break;
+        case OperationKind::SearchCStrings:
+            fprintf(OutFile,
+                    "%s%s    --prefix,  Only match C-Strings starting with "
+                    "the pattern\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --regex,   Match C-Strings with the pattern as a "
+                    "regular-expression\n",
+                    LinePrefix,
+                    Tab);
+            break;
+        case OperationKind::PrintObjcMethodList:
+            fprintf(OutFile,
+                    "%s%s    --include-ivars,      Print Ivars of each "
+                    "Class\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --include-properties, Print Properties of each "
+                    "Class\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --include-protocols,  Print Protocols of each "
+                    "Class\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --sort,               Sort Classes by Name\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s-v, --verbose,            Print more Verbose "
+                    "Information\n",
+                    LinePrefix,
+                    Tab);
+            break;
+        case OperationKind::PrintImageDependencies:
+            fprintf(OutFile,
+                    "%s%s    --image=<path>,   Image to list Dependencies "
+                    "of\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --dependents,     List Images depending on the "
+                    "Image instead\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --recursive,      Include Transitive "
+                    "Dependencies\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --load-order,     List every Image after its "
+                    "Dependencies\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --cycles,         List Dependency-Cycles\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --include-upward, Follow Upward-Dependencies\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s-v, --verbose,        Print more Verbose "
+                    "Information\n",
+                    LinePrefix,
+                    Tab);
+            break;
+        case OperationKind::PrintResolvedBinds:
+            fprintf(OutFile,
+                    "%s%s    --image=<path>, Only Resolve Binds of the "
+                    "provided Image\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --unresolved,   Only Print Unresolved Binds\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s-v, --verbose,      Print more Verbose "
+                    "Information\n",
+                    LinePrefix,
+                    Tab);
+            break;
+        case OperationKind::PrintDiff:
+            fprintf(OutFile,
+                    "%s%s    --only=<section>[,<section>...], Only Compare "
+                    "the provided Sections\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s        (header, load-commands, libraries, exports, "
+                    "binds, symbols,\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s         objc-classes, images)\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s-v, --verbose, Print Values of Added and Removed "
+                    "Entries\n",
+                    LinePrefix,
+                    Tab);
+            break;
+        case OperationKind::PrintSlideInfo:
+            fprintf(OutFile,
+                    "%s%s    --rebases, Print every Rebased Pointer\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s-v, --verbose, Print Authentication-Info of Rebased "
+                    "Pointers\n",
+                    LinePrefix,
+                    Tab);
+            break;
+        case OperationKind::PrintSymbolList:
+            fprintf(OutFile,
+                    "%s%s    --symbols-file=<path>, Path to the .symbols File "
+                    "of the Shared-Cache\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --cache-locals-only,   Only Print Local-Symbols "
+                    "of the Shared-Cache\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --debug-symbols,       Include Debug-Symbols\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s-v, --verbose,             Print more Verbose "
+                    "Information\n",
+                    LinePrefix,
+                    Tab);
+            break;
+        case OperationKind::ExtractImage:
+            fprintf(OutFile,
+                    "%s%s    --output=<path>,     Path to Extract the Image "
+                    "to\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --output-dir=<path>, Directory to Extract every "
+                    "Image of the Shared-Cache to\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s-v, --verbose,           Print every Extracted "
+                    "Image\n",
+                    LinePrefix,
+                    Tab);
+            break;
+        case OperationKind::ThinArch:
+            fprintf(OutFile,
+                    "%s%s    --arch=<ordinal|name>, Ordinal or Cpu-Name of "
+                    "the Arch to Extract\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s    --output=<path>,       Path to Extract the Arch "
+                    "to\n",
+                    LinePrefix,
+                    Tab);
+            fprintf(OutFile,
+                    "%s%s-v, --verbose,             Print more Verbose "
+                    "Information\n",
+                    LinePrefix,
+                    Tab);
+            break;
+    }
+
+    if (SupportsOutputFormat(Kind, OutputFormat::Json)) {
+        fprintf(OutFile,
+                "%s%s    --format=<text|json|ndjson|bin>, Print in the "
+                "provided output-format\n",
+                LinePrefix,
+                Tab);
     }
 
     fprintf(OutFile, "%s", Suffix);
@@ -562,7 +894,8 @@ Operation::PrintPathOptionHelpMenu(FILE *const OutFile,
                                    const char *const Suffix) noexcept
 {
     constexpr auto SelectArchString =
-        "%s\t--arch <ordinal>,          Select arch of a FAT Mach-O File\n";
+        "%s\t--arch <ordinal|all>,      Select arch (or all archs) of a FAT "
+        "Mach-O File\n";
 
     constexpr auto SelectDscImageString =
         "%s\t--image <path-or-ordinal>, Select image of an Apple "
@@ -588,8 +921,8 @@ Operation::PrintPathOptionHelpMenu(FILE *const OutFile,
     fprintf(OutFile, "%s%sPath Options:\n", Prefix, LinePrefix);
     if (SupportsFatMachO) {
         fprintf(OutFile,
-                "%s\t-arch <ordinal>,          Select arch of a FAT Mach-O "
-                "File\n",
+                "%s\t-arch <ordinal|all>,      Select arch (or all archs) of a "
+                "FAT Mach-O File\n",
                 LinePrefix);
     }
 
@@ -683,7 +1016,7 @@ void Operation::PrintHelpMenu(FILE *const OutFile) noexcept {
             break;
         }
 
-        fputc('\n', stdout);
+        fputc('\n', OutFile);
     }
 
     PrintPathOptionHelpMenu(OutFile, OperationKind::None);
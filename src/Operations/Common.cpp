@@ -6,12 +6,18 @@
 //  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
 //
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
+#include <memory>
 #include <unistd.h>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
 
 #include "ADT/MemoryMap.h"
+#include "Objects/DscImageMemory.h"
 #include "Operations/Common.h"
 #include "Utils/PrintUtils.h"
 
@@ -297,7 +303,7 @@ OperationCommon::PrintDylibOrdinalPath(
     }
 
     const auto &Path = Collection.at(DylibIndex).getPath();
-    fprintf(OutFile, "\"%s\"", Path.data());
+    fprintf(OutFile, "\"" STRING_VIEW_FMT "\"", STRING_VIEW_FMT_ARGS(Path));
 }
 
 void
@@ -323,14 +329,114 @@ OperationCommon::PrintDylibOrdinalInfo(
     if (PrintKindIsVerbose(PrintKind)) {
         const auto &Path = Collection.at(DylibIndex).getPath();
         fprintf(OutFile,
-                "Dylib-Ordinal %02" PRId64 " - \"%s\"",
+                "Dylib-Ordinal %02" PRId64 " - \"" STRING_VIEW_FMT "\"",
                 DylibOrdinal,
-                Path.data());
+                STRING_VIEW_FMT_ARGS(Path));
     } else {
         fprintf(OutFile, "Dylib-Ordinal %02" PRId64, DylibOrdinal);
     }
 }
 
+void
+OperationCommon::WriteDylibOrdinalFields(
+    RecordWriter &Writer,
+    const MachO::SharedLibraryInfoCollection &Collection,
+    const int64_t DylibOrdinal) noexcept
+{
+    Writer.writeSignedNumber("dylib_ordinal", DylibOrdinal);
+    if (DylibOrdinal <= 0) {
+        const auto Special = MachO::BindByteDylibSpecialOrdinal(DylibOrdinal);
+        const auto NameOpt = MachO::BindByteDylibSpecialOrdinalGetName(Special);
+
+        if (NameOpt.has_value()) {
+            Writer.writeString("dylib", NameOpt.value());
+        } else {
+            Writer.writeNull("dylib");
+        }
+
+        return;
+    }
+
+    const auto DylibIndex = DylibOrdinal - 1;
+    if (IndexOutOfBounds(DylibIndex, Collection.size())) {
+        Writer.writeNull("dylib");
+        return;
+    }
+
+    Writer.writeString("dylib", Collection.at(DylibIndex).getPath());
+}
+
+void
+OperationCommon::WriteSegmentSectionFields(
+    RecordWriter &Writer,
+    const MachO::SegmentInfo *const Segment,
+    const MachO::SectionInfo *const Section) noexcept
+{
+    if (Segment != nullptr) {
+        Writer.writeString("segment", Segment->getName());
+    } else {
+        Writer.writeNull("segment");
+    }
+
+    if (Section != nullptr) {
+        Writer.writeString("section", Section->getName());
+    } else {
+        Writer.writeNull("section");
+    }
+}
+
+void
+OperationCommon::WriteBindActionRecord(
+    RecordWriter &Writer,
+    const MachO::BindActionInfo &Action,
+    const MachO::SegmentInfoCollection &SegmentCollection,
+    const MachO::SharedLibraryInfoCollection &LibraryCollection) noexcept
+{
+    Writer.beginRecord();
+    switch (Action.Kind) {
+        case MachO::BindInfoKind::Normal:
+            Writer.writeString("kind", "bind");
+            break;
+        case MachO::BindInfoKind::Lazy:
+            Writer.writeString("kind", "lazy-bind");
+            break;
+        case MachO::BindInfoKind::Weak:
+            Writer.writeString("kind", "weak-bind");
+            break;
+    }
+
+    if (const auto *const Segment =
+            SegmentCollection.atOrNull(Action.SegmentIndex))
+    {
+        const auto FullAddr =
+            Segment->getMemoryRange().getBegin() + Action.AddrInSeg;
+
+        const auto Section = Segment->FindSectionContainingAddress(FullAddr);
+        WriteSegmentSectionFields(Writer, Segment, Section);
+
+        Writer.writeNumber("address", FullAddr);
+    } else {
+        WriteSegmentSectionFields(Writer, nullptr, nullptr);
+        Writer.writeNull("address");
+    }
+
+    Writer.writeSignedNumber("addend", Action.Addend);
+    if (const auto WriteKindName =
+            MachO::BindWriteKindGetName(Action.WriteKind))
+    {
+        Writer.writeString("write_kind", WriteKindName.value());
+    } else {
+        Writer.writeNull("write_kind");
+    }
+
+    Writer.writeString("symbol", Action.SymbolName);
+    if (Action.Kind != MachO::BindInfoKind::Weak) {
+        WriteDylibOrdinalFields(Writer, LibraryCollection, Action.DylibOrdinal);
+    }
+
+    Writer.endRecord();
+}
+
 constexpr static auto SegmentSectionPairFormat =
     "<segment-name>,<section-name>"sv;
 
@@ -404,46 +510,68 @@ OperationCommon::GetDyldInfoCommand(
     const MachO::ConstLoadCommandStorage &LoadCmdStorage,
     const MachO::DyldInfoCommand *&DyldInfoCommandOut) noexcept
 {
-    auto FoundDyldInfo = static_cast<const MachO::DyldInfoCommand *>(nullptr);
-    const auto IsBE = LoadCmdStorage.isBigEndian();
+    return GetDyldInfoCommand(ErrFile,
+                              MachO::LoadCommandIndex::Build(LoadCmdStorage),
+                              DyldInfoCommandOut);
+}
 
-    for (const auto &LC : LoadCmdStorage) {
-        const auto *DyldInfo = dyn_cast<MachO::DyldInfoCommand>(LC, IsBE);
-        if (DyldInfo == nullptr) {
-            continue;
-        }
+// Compare without swapping as they are all the same endian.
 
-        if (FoundDyldInfo != nullptr) {
-            // Compare without swapping as they are all the same endian.
-            if (DyldInfo->BindOff != FoundDyldInfo->BindOff ||
-                DyldInfo->BindSize != FoundDyldInfo->BindSize)
-            {
-                fputs("Provided file has multiple (conflicting) Bind-List "
-                      "information\n",
-                      ErrFile);
-                return 1;
-            }
+[[nodiscard]] static bool
+DyldInfoListsMatch(FILE *const ErrFile,
+                   const MachO::DyldInfoCommand &Lhs,
+                   const MachO::DyldInfoCommand &Rhs) noexcept
+{
+    if (Lhs.BindOff != Rhs.BindOff || Lhs.BindSize != Rhs.BindSize) {
+        fputs("Provided file has multiple (conflicting) Bind-List "
+              "information\n",
+              ErrFile);
+        return false;
+    }
 
-            if (DyldInfo->LazyBindOff != FoundDyldInfo->LazyBindOff ||
-                DyldInfo->LazyBindSize != FoundDyldInfo->LazyBindSize)
-            {
-                fputs("Provided file has multiple (conflicting) Lazy-Bind "
-                      "list information\n",
-                      ErrFile);
-                return 1;
-            }
+    if (Lhs.LazyBindOff != Rhs.LazyBindOff ||
+        Lhs.LazyBindSize != Rhs.LazyBindSize)
+    {
+        fputs("Provided file has multiple (conflicting) Lazy-Bind "
+              "list information\n",
+              ErrFile);
+        return false;
+    }
 
-            if (DyldInfo->WeakBindOff != FoundDyldInfo->WeakBindOff ||
-                DyldInfo->WeakBindSize != FoundDyldInfo->WeakBindSize)
+    if (Lhs.WeakBindOff != Rhs.WeakBindOff ||
+        Lhs.WeakBindSize != Rhs.WeakBindSize)
+    {
+        fputs("Provided file has multiple (conflicting) Weak-Bind "
+              "list information\n",
+              ErrFile);
+        return false;
+    }
+
+    return true;
+}
+
+int
+OperationCommon::GetDyldInfoCommand(
+    FILE *const ErrFile,
+    const MachO::LoadCommandIndex &LoadCmdIndex,
+    const MachO::DyldInfoCommand *&DyldInfoCommandOut) noexcept
+{
+    using LCKind = MachO::LoadCommand::Kind;
+    auto FoundDyldInfo = static_cast<const MachO::DyldInfoCommand *>(nullptr);
+
+    for (const auto Kind : { LCKind::DyldInfo, LCKind::DyldInfoOnly }) {
+        for (const auto *LC : LoadCmdIndex.getAll(Kind)) {
+            const auto &DyldInfo =
+                *reinterpret_cast<const MachO::DyldInfoCommand *>(LC);
+
+            if (FoundDyldInfo != nullptr &&
+                !DyldInfoListsMatch(ErrFile, *FoundDyldInfo, DyldInfo))
             {
-                fputs("Provided file has multiple (conflicting) Weak-Bind "
-                      "list information\n",
-                      ErrFile);
                 return 1;
             }
-        }
 
-        FoundDyldInfo = DyldInfo;
+            FoundDyldInfo = &DyldInfo;
+        }
     }
 
     if (FoundDyldInfo == nullptr) {
@@ -1144,3 +1272,353 @@ OperationCommon::HandleExportTrieParseError(
             return 1;
     }
 }
+
+static void
+HandleObjcOptError(FILE *const ErrFile,
+                   const DyldSharedCache::ObjcOptInfo::Error Error) noexcept
+{
+    using ObjcOptInfo = DyldSharedCache::ObjcOptInfo;
+    switch (Error) {
+        case ObjcOptInfo::Error::None:
+            return;
+        case ObjcOptInfo::Error::SectionTooSmall:
+            fputs("Provided file's Objective-C optimization-section is too "
+                  "small\n",
+                  ErrFile);
+            return;
+        case ObjcOptInfo::Error::UnsupportedVersion:
+            fputs("Provided file's Objective-C optimization-tables have an "
+                  "unsupported version\n",
+                  ErrFile);
+            return;
+        case ObjcOptInfo::Error::InvalidTable:
+            fputs("Provided file has an invalid Objective-C "
+                  "optimization-table\n",
+                  ErrFile);
+            return;
+    }
+}
+
+int
+OperationCommon::GetDscObjcOptInfo(
+    FILE *const ErrFile,
+    const DscMemoryObject &Object,
+    std::optional<DyldSharedCache::ObjcOptInfo> &InfoOut) noexcept
+{
+    using ObjcOptInfo = DyldSharedCache::ObjcOptInfo;
+
+    const auto Map = Object.getMap().getBegin();
+
+    auto ImageInfo = static_cast<const DyldSharedCache::ImageInfo *>(nullptr);
+    for (const auto &Info : Object.getConstImageInfoList()) {
+        if (Info.getPath(Map) == ObjcOptInfo::ImagePath) {
+            ImageInfo = &Info;
+            break;
+        }
+    }
+
+    const auto PrintError = [&](const char *const Message) noexcept {
+        if (ErrFile != nullptr) {
+            fputs(Message, ErrFile);
+        }
+
+        return 1;
+    };
+
+    if (ImageInfo == nullptr) {
+        return PrintError("Provided file has no libobjc image\n");
+    }
+
+    const auto ImageOrError = Object.GetImageWithInfo(*ImageInfo);
+    if (ImageOrError.hasError()) {
+        return PrintError("Provided file's libobjc image could not be "
+                          "parsed\n");
+    }
+
+    const auto Image =
+        std::unique_ptr<const DscImageMemoryObject>(ImageOrError.value());
+
+    const auto LoadCmdStorage = Image->GetLoadCommandsStorage();
+    if (LoadCmdStorage.hasError()) {
+        return PrintError("Provided file's libobjc image has invalid "
+                          "load-commands\n");
+    }
+
+    const auto Is64Bit = Image->is64Bit();
+
+    auto SegmentError = MachO::SegmentInfoCollection::Error::None;
+    const auto SegmentCollection =
+        MachO::SegmentInfoCollection::Open(Image->getLoadCommandIndex(),
+                                           Is64Bit,
+                                           &SegmentError);
+
+    if (SegmentError != MachO::SegmentInfoCollection::Error::None) {
+        return PrintError("Provided file's libobjc image has an invalid "
+                          "segment-list\n");
+    }
+
+    const auto Section =
+        SegmentCollection.FindSectionWithName(ObjcOptInfo::SegmentName,
+                                              ObjcOptInfo::SectionName);
+
+    if (Section == nullptr) {
+        return PrintError("Provided file has no Objective-C "
+                          "optimization-tables\n");
+    }
+
+    const auto DeVirtualizer =
+        DscImage::ConstDeVirtualizer(Object.getMap(),
+                                     Object.getConstMappingInfoList(),
+                                     Object.getRebasedView());
+
+    const auto &MemoryRange = Section->getMemoryRange();
+    auto Error = ObjcOptInfo::Error::None;
+
+    InfoOut = ObjcOptInfo::Open(DeVirtualizer,
+                                MemoryRange.getBegin(),
+                                MemoryRange.size(),
+                                Is64Bit,
+                                &Error);
+
+    if (Error != ObjcOptInfo::Error::None) {
+        if (ErrFile != nullptr) {
+            HandleObjcOptError(ErrFile, Error);
+        }
+
+        InfoOut = std::nullopt;
+        return 1;
+    }
+
+    return 0;
+}
+
+[[nodiscard]] static DyldSharedCache::DependencyGraph::EdgeKind
+GetEdgeKindForLibrary(const MachO::SharedLibraryInfo &Info) noexcept {
+    using EdgeKind = DyldSharedCache::DependencyGraph::EdgeKind;
+    switch (Info.getKind()) {
+        case MachO::LoadCommandKind::LoadWeakDylib:
+            return EdgeKind::Weak;
+        case MachO::LoadCommandKind::ReexportDylib:
+            return EdgeKind::Reexport;
+        case MachO::LoadCommandKind::LoadUpwardDylib:
+            return EdgeKind::Upward;
+        default:
+            return EdgeKind::Load;
+    }
+}
+
+uint32_t
+OperationCommon::GetDscDependencyGraph(
+    const DscMemoryObject &Object,
+    DyldSharedCache::DependencyGraph &GraphOut) noexcept
+{
+    using DependencyGraph = DyldSharedCache::DependencyGraph;
+
+    const auto Map = Object.getMap().getBegin();
+    const auto ImageCount = Object.getImageCount();
+
+    if (ImageCount == 0) {
+        GraphOut = DependencyGraph();
+        return 0;
+    }
+
+    // An alias is an image-info with the address of an earlier image, so
+    // point every path at the first image-info of its address.
+
+    auto NodeForAddressMap = std::unordered_map<uint64_t, uint32_t>();
+    auto NodeForPathMap = std::unordered_map<std::string_view, uint32_t>();
+    auto NodeList = std::vector<uint32_t>(ImageCount);
+
+    NodeForAddressMap.reserve(ImageCount);
+    NodeForPathMap.reserve(ImageCount);
+
+    for (auto Index = uint32_t(); Index != ImageCount; Index++) {
+        const auto &Info = Object.getImageInfoAtIndex(Index);
+        const auto Node =
+            NodeForAddressMap.try_emplace(Info.Address, Index).first->second;
+
+        NodeList[Index] = Node;
+        NodeForPathMap.try_emplace(Info.getPath(Map), Node);
+    }
+
+    auto EdgeListList = std::vector<std::vector<DependencyGraph::Edge>>(
+        ImageCount);
+
+    auto FailedCount = std::atomic<uint32_t>();
+    auto NextImageIndex = std::atomic<uint32_t>();
+
+    const auto ParseImages = [&]() noexcept {
+        for (auto Index = NextImageIndex++;
+             Index < ImageCount;
+             Index = NextImageIndex++)
+        {
+            if (NodeList[Index] != Index) {
+                continue;
+            }
+
+            const auto ImageOrError =
+                Object.GetImageWithInfo(Object.getImageInfoAtIndex(Index));
+
+            if (ImageOrError.hasError()) {
+                FailedCount++;
+                continue;
+            }
+
+            const auto Image =
+                std::unique_ptr<const DscImageMemoryObject>(
+                    ImageOrError.value());
+
+            const auto LoadCmdStorage = Image->GetLoadCommandsStorage();
+            if (LoadCmdStorage.hasError()) {
+                FailedCount++;
+                continue;
+            }
+
+            auto Error = MachO::SharedLibraryInfoCollection::Error::None;
+            const auto Collection =
+                MachO::SharedLibraryInfoCollection::Open(LoadCmdStorage,
+                                                         &Error);
+
+            auto &EdgeList = EdgeListList[Index];
+            EdgeList.reserve(Collection.size());
+
+            for (const auto &Library : Collection) {
+                const auto Iter = NodeForPathMap.find(Library.getPath());
+                if (Iter == NodeForPathMap.cend()) {
+                    continue;
+                }
+
+                EdgeList.emplace_back(DependencyGraph::Edge {
+                    .Node = Iter->second,
+                    .Kind = GetEdgeKindForLibrary(Library)
+                });
+            }
+        }
+    };
+
+    const auto ThreadCount =
+        std::clamp(std::thread::hardware_concurrency(), 1u, ImageCount);
+
+    auto ThreadList = std::vector<std::thread>();
+    ThreadList.reserve(ThreadCount - 1);
+
+    for (auto I = 1u; I != ThreadCount; I++) {
+        ThreadList.emplace_back(ParseImages);
+    }
+
+    ParseImages();
+    for (auto &Thread : ThreadList) {
+        Thread.join();
+    }
+
+    GraphOut = DependencyGraph::Create(EdgeListList);
+    return FailedCount;
+}
+
+auto
+OperationCommon::GetExportIndex(
+    const ConstMemoryMap &Map,
+    const MachO::ConstLoadCommandStorage &LoadCmdStorage) noexcept
+        -> DyldSharedCache::ExportIndex
+{
+    const auto IsBE = LoadCmdStorage.isBigEndian();
+    for (const auto &LC : LoadCmdStorage) {
+        if (const auto *DyldInfo = dyn_cast<MachO::DyldInfoCommand>(LC, IsBE)) {
+            const auto Trie = DyldInfo->GetConstExportTrieExportList(Map, IsBE);
+            if (Trie.getError() != MachO::SizeRangeError::None) {
+                break;
+            }
+
+            return DyldSharedCache::ExportIndex::Open(*Trie.value(), nullptr);
+        }
+
+        const auto *ET =
+            dyn_cast<MachO::LoadCommand::Kind::DyldExportsTrie>(LC, IsBE);
+
+        if (ET != nullptr) {
+            const auto Trie = ET->GetConstExportTrieExportList(Map, IsBE);
+            if (Trie.getError() != MachO::SizeRangeError::None) {
+                break;
+            }
+
+            return DyldSharedCache::ExportIndex::Open(*Trie.value(), nullptr);
+        }
+    }
+
+    return DyldSharedCache::ExportIndex();
+}
+
+auto
+OperationCommon::CreateDscSymbolResolver(const DscMemoryObject &Object) noexcept
+    -> DyldSharedCache::SymbolResolver
+{
+    using SymbolResolver = DyldSharedCache::SymbolResolver;
+
+    const auto Map = Object.getMap().getBegin();
+    const auto ImageCount = Object.getImageCount();
+
+    // As with the dependency-graph, point every path at the first image-info
+    // of its address, so aliases share the exports of their image.
+
+    auto NodeForAddressMap = std::unordered_map<uint64_t, uint32_t>();
+    auto NodeForPathMap = std::unordered_map<std::string_view, uint32_t>();
+
+    NodeForAddressMap.reserve(ImageCount);
+    NodeForPathMap.reserve(ImageCount);
+
+    for (auto Index = uint32_t(); Index != ImageCount; Index++) {
+        const auto &Info = Object.getImageInfoAtIndex(Index);
+        const auto Node =
+            NodeForAddressMap.try_emplace(Info.Address, Index).first->second;
+
+        NodeForPathMap.try_emplace(Info.getPath(Map), Node);
+    }
+
+    const auto Loader =
+        [&Object, NodeForPathMap = std::move(NodeForPathMap)](
+            const uint32_t Node,
+            SymbolResolver::ImageData &DataOut) noexcept
+    {
+        const auto ImageOrError =
+            Object.GetImageWithInfo(Object.getImageInfoAtIndex(Node));
+
+        if (ImageOrError.hasError()) {
+            return false;
+        }
+
+        const auto Image =
+            std::unique_ptr<const DscImageMemoryObject>(ImageOrError.value());
+
+        const auto LoadCmdStorage = Image->GetLoadCommandsStorage();
+        if (LoadCmdStorage.hasError()) {
+            return false;
+        }
+
+        auto Error = MachO::SharedLibraryInfoCollection::Error::None;
+        const auto Collection =
+            MachO::SharedLibraryInfoCollection::Open(LoadCmdStorage, &Error);
+
+        DataOut.Address = Image->getAddress();
+        DataOut.LibraryList.reserve(Collection.size());
+
+        for (const auto &Library : Collection) {
+            const auto Iter = NodeForPathMap.find(Library.getPath());
+            if (Iter == NodeForPathMap.cend()) {
+                DataOut.LibraryList.emplace_back(SymbolResolver::InvalidNode);
+                continue;
+            }
+
+            DataOut.LibraryList.emplace_back(Iter->second);
+            if (Library.getKind() == MachO::LoadCommandKind::ReexportDylib) {
+                DataOut.ReexportList.emplace_back(Iter->second);
+            }
+        }
+
+        DataOut.Exports =
+            GetExportIndex(Image->getDscMap(), LoadCmdStorage);
+
+        return true;
+    };
+
+    return SymbolResolver(ImageCount, Loader);
+}
@@ -0,0 +1,383 @@
+//
+//  Operations/ExtractImage.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ADT/DscImage/Extractor.h"
+#include "ADT/FileDescriptor.h"
+
+#include "Operations/ExtractImage.h"
+#include "Operations/Operation.h"
+
+#include "Utils/Path.h"
+#include "Utils/PrintUtils.h"
+
+ExtractImageOperation::ExtractImageOperation() noexcept
+: Operation(OpKind) {}
+
+ExtractImageOperation::ExtractImageOperation(
+    const struct Options &Options) noexcept
+: Operation(OpKind), Options(Options) {}
+
+using ImageExtractor = DscImage::ImageExtractor;
+
+struct ExtractResult {
+    ImageExtractor::Error Error = ImageExtractor::Error::None;
+
+    int ErrorNumber = 0;
+    uint64_t Size = 0;
+
+    bool IsAlias : 1 = false;
+    bool HasUnsafePath : 1 = false;
+
+    [[nodiscard]] constexpr auto failed() const noexcept {
+        return Error != ImageExtractor::Error::None ||
+               ErrorNumber != 0 ||
+               HasUnsafePath;
+    }
+};
+
+[[nodiscard]] static std::string_view
+GetErrorDescription(const ImageExtractor::Error Error) noexcept {
+    switch (Error) {
+        case ImageExtractor::Error::None:
+            break;
+        case ImageExtractor::Error::UnsupportedImage:
+            return "Image has an unsupported mach-header";
+        case ImageExtractor::Error::InvalidLoadCommands:
+            return "Image has invalid load-commands";
+        case ImageExtractor::Error::SegmentNotMapped:
+            return "Image has a segment outside of this file (Images of "
+                   "sub-caches are not supported)";
+        case ImageExtractor::Error::NoTextSegment:
+            return "Image's mach-header is not at the start of its first "
+                   "segment";
+        case ImageExtractor::Error::NoLinkeditSegment:
+            return "Image has no __LINKEDIT segment";
+        case ImageExtractor::Error::LinkeditDataOutOfBounds:
+            return "Image has __LINKEDIT data that is out-of-bounds";
+        case ImageExtractor::Error::SymbolTableOutOfBounds:
+            return "Image has a symbol-table that is out-of-bounds";
+    }
+
+    assert(0 && "Unrecognized Image-Extractor Error");
+}
+
+[[nodiscard]] static auto
+ExtractImageToPath(const ConstMemoryMap &CacheMap,
+                   const uint64_t ImageAddress,
+                   const char *const Path) noexcept
+{
+    auto Result = ExtractResult();
+    const auto Extractor =
+        ImageExtractor::Open(CacheMap, ImageAddress, &Result.Error);
+
+    if (!Extractor.has_value()) {
+        return Result;
+    }
+
+    auto Fd = FileDescriptor::Create(Path, 0644);
+    if (Fd.hasError() || !Extractor->WriteTo(Fd)) {
+        Result.ErrorNumber = errno;
+        return Result;
+    }
+
+    Result.Size = Extractor->getFileSize();
+    return Result;
+}
+
+static void
+PrintExtractError(FILE *const ErrFile,
+                  const char *const ImagePath,
+                  const char *const OutputPath,
+                  const ExtractResult &Result) noexcept
+{
+    if (Result.HasUnsafePath) {
+        fprintf(ErrFile,
+                "Refusing to extract image %s: Its path leaves the "
+                "output-directory\n",
+                ImagePath);
+        return;
+    }
+
+    if (Result.Error != ImageExtractor::Error::None) {
+        fprintf(ErrFile,
+                "Failed to extract image %s: %s\n",
+                ImagePath,
+                GetErrorDescription(Result.Error).data());
+        return;
+    }
+
+    fprintf(ErrFile,
+            "Failed to write image %s to %s, error: \"%s\"\n",
+            ImagePath,
+            OutputPath,
+            strerror(Result.ErrorNumber));
+}
+
+int
+ExtractImageOperation::Run(const DscImageMemoryObject &Object,
+                           const struct Options &Options) noexcept
+{
+    if (Options.OutputPath.empty()) {
+        fputs("Please provide a path to extract the image to with "
+              "--output=<path>\n",
+              Options.ErrFile);
+        return 1;
+    }
+
+    const auto Path = PathUtil::MakeAbsolute(Options.OutputPath);
+    const auto Result =
+        ExtractImageToPath(Object.getDscMap(),
+                           Object.getAddress(),
+                           Path.data());
+
+    if (Result.failed()) {
+        PrintExtractError(Options.ErrFile,
+                          Object.getPath(),
+                          Path.data(),
+                          Result);
+        return 1;
+    }
+
+    fprintf(Options.OutFile,
+            "Extracted %s to %s (%" PRIu64 " bytes)\n",
+            Object.getPath(),
+            Path.data(),
+            Result.Size);
+
+    return 0;
+}
+
+[[nodiscard]] static auto
+CreateParentDirectories(const std::string &Path) noexcept -> int {
+    const auto Parent = std::filesystem::path(Path).parent_path();
+    auto ErrorCode = std::error_code();
+
+    // Another thread may have created the directory first.
+
+    std::filesystem::create_directories(Parent, ErrorCode);
+    if (ErrorCode && !std::filesystem::is_directory(Parent, ErrorCode)) {
+        return ErrorCode.value() != 0 ? ErrorCode.value() : ENOTDIR;
+    }
+
+    return 0;
+}
+
+// Image-paths come from the cache itself, so they're normalized before being
+// joined to the output-directory, and any path that would leave the
+// output-directory, or that names no file, is rejected.
+
+[[nodiscard]] static auto
+GetOutputPathForImage(const std::string_view Directory,
+                      const std::string_view ImagePath,
+                      std::string &PathOut) noexcept -> bool
+{
+    const auto RelativePath =
+        std::filesystem::path(ImagePath).relative_path().lexically_normal();
+
+    if (!RelativePath.has_filename() ||
+        RelativePath.filename() == "." ||
+        *RelativePath.begin() == "..")
+    {
+        return false;
+    }
+
+    PathOut = (std::filesystem::path(Directory) / RelativePath).string();
+    return true;
+}
+
+// Images are handed out to threads one at a time, as their sizes vary greatly
+// between images.
+
+int
+ExtractImageOperation::Run(const DscMemoryObject &Object,
+                           const struct Options &Options) noexcept
+{
+    if (Options.OutputDirectory.empty()) {
+        fputs("Please provide a directory to extract every image to with "
+              "--output-dir=<path>\n",
+              Options.ErrFile);
+        return 1;
+    }
+
+    const auto ImageCount = Object.getImageCount();
+    if (ImageCount == 0) {
+        fputs("Provided file has no images\n", Options.OutFile);
+        return 0;
+    }
+
+    const auto Map = Object.getMap().getBegin();
+    const auto Directory = PathUtil::MakeAbsolute(Options.OutputDirectory);
+
+    auto PathList = std::vector<std::string>(ImageCount);
+    auto ResultList = std::vector<ExtractResult>(ImageCount);
+
+    const auto ThreadCount =
+        std::clamp(std::thread::hardware_concurrency(), 1u, ImageCount);
+
+    auto NextImageIndex = std::atomic<uint32_t>();
+    const auto ExtractImages = [&]() noexcept {
+        for (auto Index = NextImageIndex++;
+             Index < ImageCount;
+             Index = NextImageIndex++)
+        {
+            const auto &ImageInfo = Object.getImageInfoAtIndex(Index);
+            auto &Result = ResultList[Index];
+
+            if (ImageInfo.isAlias(Map)) {
+                Result.IsAlias = true;
+                continue;
+            }
+
+            auto &Path = PathList[Index];
+            if (!GetOutputPathForImage(Directory,
+                                       ImageInfo.getPath(Map),
+                                       Path))
+            {
+                Result.HasUnsafePath = true;
+                continue;
+            }
+
+            if (const auto ErrorNumber = CreateParentDirectories(Path)) {
+                Result.ErrorNumber = ErrorNumber;
+                continue;
+            }
+
+            Result =
+                ExtractImageToPath(Object.getMap(),
+                                   ImageInfo.Address,
+                                   Path.c_str());
+        }
+    };
+
+    auto ThreadList = std::vector<std::thread>();
+    ThreadList.reserve(ThreadCount - 1);
+
+    for (auto I = 1u; I != ThreadCount; I++) {
+        ThreadList.emplace_back(ExtractImages);
+    }
+
+    ExtractImages();
+    for (auto &Thread : ThreadList) {
+        Thread.join();
+    }
+
+    auto ExtractedCount = uint32_t();
+    auto FailedCount = uint32_t();
+
+    for (auto Index = uint32_t(); Index != ImageCount; Index++) {
+        const auto &Result = ResultList[Index];
+        if (Result.IsAlias) {
+            continue;
+        }
+
+        const auto ImagePath = Object.getImageInfoAtIndex(Index).getPath(Map);
+        if (Result.failed()) {
+            PrintExtractError(Options.ErrFile,
+                              ImagePath,
+                              PathList[Index].c_str(),
+                              Result);
+
+            FailedCount++;
+            continue;
+        }
+
+        if (Options.Verbose) {
+            fprintf(Options.OutFile,
+                    "Extracted %s (%" PRIu64 " bytes)\n",
+                    ImagePath,
+                    Result.Size);
+        }
+
+        ExtractedCount++;
+    }
+
+    fprintf(Options.OutFile,
+            "Extracted %" PRIu32 " images to %s\n",
+            ExtractedCount,
+            Directory.data());
+
+    return FailedCount != 0 ? 1 : 0;
+}
+
+auto
+ExtractImageOperation::ParseOptionsImpl(const ArgvArray &Argv,
+                                        int *const IndexOut) noexcept
+    -> struct ExtractImageOperation::Options
+{
+    auto Index = int();
+    struct Options Options;
+
+    for (const auto &Argument : Argv) {
+        if (strcmp(Argument, "-v") == 0 || strcmp(Argument, "--verbose") == 0) {
+            Options.Verbose = true;
+        } else if (Argument.GetStringView().starts_with("--output=")) {
+            Options.OutputPath =
+                Argument.GetStringView().substr(LENGTH_OF("--output="));
+
+            if (Options.OutputPath.empty()) {
+                fputs("Please provide a path to --output\n", stderr);
+                exit(1);
+            }
+        } else if (Argument.GetStringView().starts_with("--output-dir=")) {
+            Options.OutputDirectory =
+                Argument.GetStringView().substr(LENGTH_OF("--output-dir="));
+
+            if (Options.OutputDirectory.empty()) {
+                fputs("Please provide a path to --output-dir\n", stderr);
+                exit(1);
+            }
+        } else if (!Argument.isOption()) {
+            break;
+        } else {
+            fprintf(stderr,
+                    "Unrecognized argument for operation %s: %s\n",
+                    OperationKindInfo<OpKind>::Name.data(),
+                    Argument.getString());
+            exit(1);
+        }
+
+        Index++;
+    }
+
+    if (IndexOut != nullptr) {
+        *IndexOut = Index;
+    }
+
+    return Options;
+}
+
+int ExtractImageOperation::ParseOptions(const ArgvArray &Argv) noexcept {
+    auto Index = int();
+    Options = ParseOptionsImpl(Argv, &Index);
+
+    return Index;
+}
+
+int ExtractImageOperation::Run(const MemoryObject &Object) const noexcept {
+    switch (Object.getKind()) {
+        case ObjectKind::None:
+            assert(0 && "Object-Kind is None");
+        case ObjectKind::DyldSharedCache:
+            return Run(cast<ObjectKind::DyldSharedCache>(Object), Options);
+        case ObjectKind::DscImage:
+            return Run(cast<ObjectKind::DscImage>(Object), Options);
+        case ObjectKind::MachO:
+        case ObjectKind::FatMachO:
+            return InvalidObjectKind;
+    }
+
+    assert(0 && "Unrecognized Object-Kind");
+}
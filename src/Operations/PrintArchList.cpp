@@ -18,12 +18,71 @@ PrintArchListOperation::PrintArchListOperation(
     const struct Options &Options) noexcept
 : Operation(OpKind), Options(Options) {}
 
+template <typename ArchType>
+static void
+WriteArchRecord(RecordWriter &Writer,
+                const ArchType &Arch,
+                const bool IsBigEndian) noexcept
+{
+    const auto CpuKind = Arch.getCpuKind(IsBigEndian);
+    const auto CpuSubKind = Arch.getCpuSubKind(IsBigEndian);
+
+    Writer.beginRecord();
+    if (const auto CpuKindName = Mach::CpuKindGetName(CpuKind)) {
+        Writer.writeString("cpu_type", CpuKindName.value());
+    } else {
+        Writer.writeNull("cpu_type");
+    }
+
+    const auto CpuSubKindNameOpt =
+        Mach::CpuSubKind::GetName(CpuKind, CpuSubKind);
+
+    if (CpuSubKindNameOpt.has_value()) {
+        Writer.writeString("cpu_subtype", CpuSubKindNameOpt.value());
+    } else {
+        Writer.writeNull("cpu_subtype");
+    }
+
+    Writer.writeSignedNumber("cpu_type_value", static_cast<int32_t>(CpuKind));
+    Writer.writeNumber("cpu_subtype_value", CpuSubKind);
+    Writer.writeNumber("offset", Arch.getFileOffset(IsBigEndian));
+    Writer.writeNumber("size", Arch.getFileSize(IsBigEndian));
+    Writer.writeNumber("align", Arch.getAlign(IsBigEndian));
+    Writer.endRecord();
+}
+
+static void
+WriteArchListRecords(
+    const MachO::FatHeader &Header,
+    const struct PrintArchListOperation::Options &Options) noexcept
+{
+    auto Writer = Options.GetRecordWriter();
+    const auto IsBigEndian = Header.isBigEndian();
+
+    Writer.beginList();
+    if (Header.is64Bit()) {
+        for (const auto &Arch : Header.getConstArch64List()) {
+            WriteArchRecord(Writer, Arch, IsBigEndian);
+        }
+    } else {
+        for (const auto &Arch : Header.getConstArch32List()) {
+            WriteArchRecord(Writer, Arch, IsBigEndian);
+        }
+    }
+
+    Writer.endList();
+}
+
 int
 PrintArchListOperation::Run(const FatMachOMemoryObject &Object,
                             const struct Options &Options) noexcept
 {
     const auto ArchCount = Object.getArchCount();
-    fprintf(stdout, "Provided file has %" PRIu32 " archs:\n", ArchCount);
+    if (!Options.isRecordFormat()) {
+        fprintf(Options.OutFile,
+                "Provided file has %" PRIu32 " archs:\n",
+                ArchCount);
+    }
 
     // General safe-guard against over-printing. More likely than too-many valid
     // architectures is a mistake in this program.
@@ -33,6 +92,11 @@ PrintArchListOperation::Run(const FatMachOMemoryObject &Object,
         return 1;
     }
 
+    if (Options.isRecordFormat()) {
+        WriteArchListRecords(Object.getConstHeader(), Options);
+        return 0;
+    }
+
     if (Options.Verbose) {
         MachOTypePrinter<MachO::FatHeader>::PrintArchListVerbose(
             Options.OutFile, Object.getConstHeader(), "\t");
@@ -55,6 +119,10 @@ PrintArchListOperation::ParseOptionsImpl(const ArgvArray &Argv,
     for (const auto &Argument : Argv) {
         if (strcmp(Argument, "-v") == 0 || strcmp(Argument, "--verbose") == 0) {
             Options.Verbose = true;
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
         } else if (!Argument.isOption()) {
             break;
         } else {
@@ -8,6 +8,8 @@
 
 #include <cstring>
 
+#include "ADT/ParallelSort.h"
+
 #include "Operations/Common.h"
 #include "Operations/Operation.h"
 #include "Operations/PrintBindActionList.h"
@@ -21,40 +23,89 @@ PrintBindActionListOperation::PrintBindActionListOperation(
     const struct Options &Options) noexcept
 : Operation(OpKind), Options(Options) {}
 
+template <PrintBindActionListOperation::Options::SortKind SortKind>
 static int
-CompareActionsBySortKind(
-    const MachO::BindActionInfo &Lhs,
-    const MachO::BindActionInfo &Rhs,
-    const PrintBindActionListOperation::Options::SortKind SortKind) noexcept
+CompareActionsBySortKind(const MachO::BindActionInfo &Lhs,
+                         const MachO::BindActionInfo &Rhs) noexcept
 {
-    switch (SortKind) {
-        case PrintBindActionListOperation::Options::SortKind::None:
-            assert(0 && "Unrecognized Sort-Kind");
-        case PrintBindActionListOperation::Options::SortKind::ByName:
-            return Lhs.SymbolName.compare(Rhs.SymbolName);
-        case PrintBindActionListOperation::Options::SortKind::ByDylibOrdinal:
-            if (Lhs.DylibOrdinal < Rhs.DylibOrdinal) {
-                return -1;
-            } else if (Lhs.DylibOrdinal == Rhs.DylibOrdinal) {
-                return 0;
-            }
+    using Enum = PrintBindActionListOperation::Options::SortKind;
+    if constexpr (SortKind == Enum::ByName) {
+        return Lhs.SymbolName.compare(Rhs.SymbolName);
+    } else if constexpr (SortKind == Enum::ByDylibOrdinal) {
+        if (Lhs.DylibOrdinal < Rhs.DylibOrdinal) {
+            return -1;
+        } else if (Lhs.DylibOrdinal == Rhs.DylibOrdinal) {
+            return 0;
+        }
 
-            return 1;
-        case PrintBindActionListOperation::Options::SortKind::ByKind: {
-            const auto LhsKind = static_cast<uint8_t>(Lhs.WriteKind);
-            const auto RhsKind = static_cast<uint8_t>(Rhs.WriteKind);
+        return 1;
+    } else if constexpr (SortKind == Enum::ByKind) {
+        const auto LhsKind = static_cast<uint8_t>(Lhs.WriteKind);
+        const auto RhsKind = static_cast<uint8_t>(Rhs.WriteKind);
+
+        if (LhsKind < RhsKind) {
+            return -1;
+        } else if (LhsKind == RhsKind) {
+            return 0;
+        }
 
-            if (LhsKind < RhsKind) {
-                return -1;
-            } else if (LhsKind == RhsKind) {
-                return 0;
-            }
+        return 1;
+    }
+}
 
-            return 1;
+static void
+SortActionList(
+    std::vector<MachO::BindActionInfo> &List,
+    const struct PrintBindActionListOperation::Options &Options) noexcept
+{
+    using Enum = PrintBindActionListOperation::Options::SortKind;
+
+    // Sorting by a single kind is by far the most common, so give it a
+    // comparator specialized at compile-time.
+
+    if (Options.SortKindList.size() == 1) {
+        switch (Options.SortKindList.front()) {
+            case Enum::None:
+                assert(0 && "Unrecognized Sort-Kind");
+            case Enum::ByName:
+                ParallelSortWithFunc<CompareActionsBySortKind<Enum::ByName>>(
+                    List.begin(), List.end());
+                return;
+            case Enum::ByDylibOrdinal:
+                ParallelSortWithFunc<
+                    CompareActionsBySortKind<Enum::ByDylibOrdinal>>(
+                        List.begin(), List.end());
+                return;
+            case Enum::ByKind:
+                ParallelSortWithFunc<CompareActionsBySortKind<Enum::ByKind>>(
+                    List.begin(), List.end());
+                return;
         }
+
+        assert(0 && "Unrecognized Sort-Kind");
     }
 
-    return false;
+    auto FuncList = std::vector<SortCompareFunc<MachO::BindActionInfo>>();
+    FuncList.reserve(Options.SortKindList.size());
+
+    for (const auto &SortKind : Options.SortKindList) {
+        switch (SortKind) {
+            case Enum::None:
+                assert(0 && "Unrecognized Sort-Kind");
+            case Enum::ByName:
+                FuncList.emplace_back(CompareActionsBySortKind<Enum::ByName>);
+                break;
+            case Enum::ByDylibOrdinal:
+                FuncList.emplace_back(
+                    CompareActionsBySortKind<Enum::ByDylibOrdinal>);
+                break;
+            case Enum::ByKind:
+                FuncList.emplace_back(CompareActionsBySortKind<Enum::ByKind>);
+                break;
+        }
+    }
+
+    ParallelSortWithFuncList(List.begin(), List.end(), FuncList);
 }
 
 template <MachO::BindInfoKind BindKind>
@@ -135,6 +186,23 @@ PrintBindAction(
     fputc('\n', Options.OutFile);
 }
 
+static void
+PrintBindActionListHeader(const char *const Name,
+                          const uint64_t Count,
+                          FILE *const OutFile) noexcept
+{
+    switch (Count) {
+        case 0:
+            assert(0 && "Bind-Action List shouldn't be empty at this point");
+        case 1:
+            fprintf(OutFile, "1 %s Action:\n", Name);
+            break;
+        default:
+            PrintUtilsWriteFormattedNumber(OutFile, Count, "", " Actions:\n");
+            break;
+    }
+}
+
 template <MachO::BindInfoKind BindKind>
 static void
 PrintBindActionList(
@@ -155,19 +223,7 @@ PrintBindActionList(
         LongestBindSymbolLength = Action.SymbolName.length();
     }
 
-    switch (List.size()) {
-        case 0:
-            assert(0 && "Bind-Action List shouldn't be empty at this point");
-        case 1:
-            fprintf(Options.OutFile, "1 %s Action:\n", Name);
-            break;
-        default:
-            PrintUtilsWriteFormattedNumber(Options.OutFile,
-                                           List.size(),
-                                           "",
-                                           " Actions:\n");
-            break;
-    }
+    PrintBindActionListHeader(Name, List.size(), Options.OutFile);
 
     auto Counter = 1ull;
     const auto SizeDigitLength = PrintUtilsGetIntegerDigitLength(List.size());
@@ -186,6 +242,261 @@ PrintBindActionList(
     }
 }
 
+// Actions are printed as they're decoded, before the longest symbol-name is
+// known, so symbols are padded to this length, and longer ones push the rest
+// of their line out.
+
+constexpr static auto StreamedSymbolColumnLength = 64;
+
+static void
+PrintStreamedBindActionListTrailer(const char *const Name,
+                                   const uint64_t Count,
+                                   FILE *const OutFile) noexcept
+{
+    switch (Count) {
+        case 0:
+            fprintf(OutFile, "No %s Info\n", Name);
+            break;
+        case 1:
+            fprintf(OutFile, "1 %s Action\n", Name);
+            break;
+        default:
+            PrintUtilsWriteFormattedNumber(OutFile, Count);
+            fprintf(OutFile, " %s Actions\n", Name);
+            break;
+    }
+}
+
+// Prints each action as it's decoded, decoding the list only once. As the
+// count is only known at the end, it's printed after the list, and the
+// counter is padded to the digit-length of the list's size in bytes, as an
+// action almost always takes up at least one opcode byte.
+
+template <MachO::BindInfoKind BindKind>
+static MachO::BindOpcodeParseError
+StreamBindActionList(
+    const char *const Name,
+    const MachO::BindActionListBase<BindKind> &List,
+    const MachO::SegmentInfoCollection &SegmentCollection,
+    const MachO::SharedLibraryInfoCollection &LibraryCollection,
+    const bool Is64Bit,
+    const struct PrintBindActionListOperation::Options &Options) noexcept
+{
+    const auto ByteCount =
+        static_cast<uint64_t>(List.getEnd() - List.getBegin());
+    const auto SizeDigitLength = PrintUtilsGetIntegerDigitLength(ByteCount);
+
+    auto Count = uint64_t();
+    auto Error = MachO::BindOpcodeParseError::None;
+
+    for (const auto &Iter : List) {
+        if (const auto IterError = Iter.getError();
+            !Iter.canIgnoreError(IterError))
+        {
+            Error = IterError;
+            break;
+        }
+
+        if (Count == 0) {
+            fprintf(Options.OutFile, "%s Actions:\n", Name);
+        }
+
+        Count++;
+        PrintBindAction<BindKind>(Name,
+                                  Count,
+                                  SizeDigitLength,
+                                  Iter.getAction(),
+                                  StreamedSymbolColumnLength,
+                                  LibraryCollection,
+                                  SegmentCollection,
+                                  Is64Bit,
+                                  Options);
+    }
+
+    PrintStreamedBindActionListTrailer(Name, Count, Options.OutFile);
+    return Error;
+}
+
+static int
+StreamBindActionLists(
+    const MachO::DyldInfoCommand &DyldInfo,
+    const ConstMemoryMap &Map,
+    const MachO::SegmentInfoCollection &SegmentCollection,
+    const MachO::SharedLibraryInfoCollection &LibraryCollection,
+    const bool IsBigEndian,
+    const bool Is64Bit,
+    const struct PrintBindActionListOperation::Options &Options) noexcept
+{
+    auto DidPrintList = false;
+    const auto PrintList =
+        [&](const char *const Name, const auto &ListOpt) noexcept
+    {
+        if (DidPrintList) {
+            fputc('\n', Options.OutFile);
+        }
+
+        switch (ListOpt.getError()) {
+            case MachO::SizeRangeError::None:
+                break;
+            case MachO::SizeRangeError::Empty:
+                fprintf(Options.ErrFile, "No %s Info\n", Name);
+                return;
+            case MachO::SizeRangeError::Overflows:
+            case MachO::SizeRangeError::PastEnd:
+                fprintf(Options.ErrFile,
+                        "%s List goes past end-of-file\n",
+                        Name);
+                return;
+        }
+
+        const auto Error =
+            StreamBindActionList(Name,
+                                 *ListOpt.value(),
+                                 SegmentCollection,
+                                 LibraryCollection,
+                                 Is64Bit,
+                                 Options);
+
+        OperationCommon::HandleBindOpcodeParseError(Options.ErrFile, Error);
+        DidPrintList = true;
+    };
+
+    if (Options.PrintNormal) {
+        PrintList("Bind",
+                  DyldInfo.GetBindActionList(Map,
+                                             SegmentCollection,
+                                             IsBigEndian,
+                                             Is64Bit));
+    }
+
+    if (Options.PrintLazy) {
+        PrintList("Lazy-Bind",
+                  DyldInfo.GetLazyBindActionList(Map,
+                                                 SegmentCollection,
+                                                 IsBigEndian,
+                                                 Is64Bit));
+    }
+
+    if (Options.PrintWeak) {
+        PrintList("Weak-Bind",
+                  DyldInfo.GetWeakBindActionList(Map,
+                                                 SegmentCollection,
+                                                 IsBigEndian,
+                                                 Is64Bit));
+    }
+
+    return 0;
+}
+
+template <MachO::BindInfoKind BindKind>
+static MachO::BindOpcodeParseError
+WriteBindActionListRecords(
+    RecordWriter &Writer,
+    const MachO::BindActionListBase<BindKind> &List,
+    const MachO::SegmentInfoCollection &SegmentCollection,
+    const MachO::SharedLibraryInfoCollection &LibraryCollection,
+    const struct PrintBindActionListOperation::Options &Options) noexcept
+{
+    // Without a sort, write out each action as soon as it's decoded instead
+    // of collecting the entire list first.
+
+    if (Options.SortKindList.empty()) {
+        for (const auto &Iter : List) {
+            const auto Error = Iter.getError();
+            if (!Iter.canIgnoreError(Error)) {
+                return Error;
+            }
+
+            OperationCommon::WriteBindActionRecord(Writer,
+                                                   Iter.getAction(),
+                                                   SegmentCollection,
+                                                   LibraryCollection);
+        }
+
+        return MachO::BindOpcodeParseError::None;
+    }
+
+    auto ActionList = std::vector<MachO::BindActionInfo>();
+    const auto Error = List.GetAsList(ActionList);
+
+    SortActionList(ActionList, Options);
+
+    for (const auto &Action : ActionList) {
+        OperationCommon::WriteBindActionRecord(Writer,
+                                               Action,
+                                               SegmentCollection,
+                                               LibraryCollection);
+    }
+
+    return Error;
+}
+
+static int
+WriteBindActionListsRecords(
+    const MachO::DyldInfoCommand &DyldInfo,
+    const ConstMemoryMap &Map,
+    const MachO::SegmentInfoCollection &SegmentCollection,
+    const MachO::SharedLibraryInfoCollection &LibraryCollection,
+    const bool IsBigEndian,
+    const bool Is64Bit,
+    const struct PrintBindActionListOperation::Options &Options) noexcept
+{
+    auto Writer = Options.GetRecordWriter();
+    const auto WriteList =
+        [&](const char *const Name, const auto &ListOpt) noexcept
+    {
+        switch (ListOpt.getError()) {
+            case MachO::SizeRangeError::None:
+                break;
+            case MachO::SizeRangeError::Empty:
+                return;
+            case MachO::SizeRangeError::Overflows:
+            case MachO::SizeRangeError::PastEnd:
+                fprintf(Options.ErrFile,
+                        "%s List goes past end-of-file\n",
+                        Name);
+                return;
+        }
+
+        const auto Error =
+            WriteBindActionListRecords(Writer,
+                                       *ListOpt.value(),
+                                       SegmentCollection,
+                                       LibraryCollection,
+                                       Options);
+
+        OperationCommon::HandleBindOpcodeParseError(Options.ErrFile, Error);
+    };
+
+    Writer.beginList();
+    if (Options.PrintNormal) {
+        WriteList("Bind",
+                  DyldInfo.GetBindActionList(Map,
+                                             SegmentCollection,
+                                             IsBigEndian,
+                                             Is64Bit));
+    }
+
+    if (Options.PrintLazy) {
+        WriteList("Lazy-Bind",
+                  DyldInfo.GetLazyBindActionList(Map,
+                                                 SegmentCollection,
+                                                 IsBigEndian,
+                                                 Is64Bit));
+    }
+
+    if (Options.PrintWeak) {
+        WriteList("Weak-Bind",
+                  DyldInfo.GetWeakBindActionList(Map,
+                                                 SegmentCollection,
+                                                 IsBigEndian,
+                                                 Is64Bit));
+    }
+
+    Writer.endList();
+    return 0;
+}
+
 static int
 PrintBindActionList(
     const MachOMemoryObject &Object,
@@ -199,7 +510,7 @@ PrintBindActionList(
     auto DyldInfo = static_cast<const MachO::DyldInfoCommand *>(nullptr);
     const auto GetDyldInfoResult =
         OperationCommon::GetDyldInfoCommand(Options.ErrFile,
-                                            LoadCmdStorage,
+                                            Object.getLoadCommandIndex(),
                                             DyldInfo);
 
     if (GetDyldInfoResult != 0) {
@@ -231,13 +542,33 @@ PrintBindActionList(
 
     const auto Is64Bit = Object.is64Bit();
     const auto SegmentCollection =
-        MachO::SegmentInfoCollection::Open(LoadCmdStorage,
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
                                            Is64Bit,
                                            &SegmentCollectionError);
 
     OperationCommon::HandleSegmentCollectionError(Options.ErrFile,
                                                   SegmentCollectionError);
 
+    if (Options.isRecordFormat()) {
+        return WriteBindActionListsRecords(*DyldInfo,
+                                           Map,
+                                           SegmentCollection,
+                                           SharedLibraryCollection,
+                                           IsBigEndian,
+                                           Is64Bit,
+                                           Options);
+    }
+
+    if (Options.SortKindList.empty()) {
+        return StreamBindActionLists(*DyldInfo,
+                                     Map,
+                                     SegmentCollection,
+                                     SharedLibraryCollection,
+                                     IsBigEndian,
+                                     Is64Bit,
+                                     Options);
+    }
+
     auto ShouldPrintBindList = Options.PrintNormal;
     auto ShouldPrintLazyBindList = Options.PrintLazy;
     auto ShouldPrintWeakBindList = Options.PrintWeak;
@@ -254,22 +585,6 @@ PrintBindActionList(
     auto LazyBindActionListError = MachO::BindOpcodeParseError();
     auto WeakBindActionListError = MachO::BindOpcodeParseError();
 
-    const auto Comparator =
-        [&](const MachO::BindActionInfo &Lhs,
-            const MachO::BindActionInfo &Rhs) noexcept
-    {
-        for (const auto &SortKind : Options.SortKindList) {
-            const auto CmpResult = CompareActionsBySortKind(Lhs, Rhs, SortKind);
-            if (CmpResult != 0) {
-                return (CmpResult < 0);
-            }
-
-            continue;
-        }
-
-        return false;
-    };
-
     if (ShouldPrintBindList) {
         const auto BindActionListOpt =
             DyldInfo->GetBindActionList(Map,
@@ -282,11 +597,7 @@ PrintBindActionList(
             const auto &BindActionList = *BindActionListOpt.value();
             BindActionListError = BindActionList.GetAsList(BindActionInfoList);
 
-            if (!Options.SortKindList.empty()) {
-                std::sort(BindActionInfoList.begin(),
-                          BindActionInfoList.end(),
-                          Comparator);
-            }
+            SortActionList(BindActionInfoList, Options);
         }
     }
 
@@ -303,11 +614,7 @@ PrintBindActionList(
             LazyBindActionListError =
                 LazyBindActionList.GetAsList(LazyBindActionInfoList);
 
-            if (!Options.SortKindList.empty()) {
-                std::sort(LazyBindActionInfoList.begin(),
-                          LazyBindActionInfoList.end(),
-                          Comparator);
-            }
+            SortActionList(LazyBindActionInfoList, Options);
         }
     }
 
@@ -324,11 +631,7 @@ PrintBindActionList(
             WeakBindActionListError =
                 WeakBindActionList.GetAsList(WeakBindActionInfoList);
 
-            if (!Options.SortKindList.empty()) {
-                std::sort(WeakBindActionInfoList.begin(),
-                          WeakBindActionInfoList.end(),
-                          Comparator);
-            }
+            SortActionList(WeakBindActionInfoList, Options);
         }
     }
 
@@ -522,6 +825,10 @@ PrintBindActionListOperation::ParseOptionsImpl(const ArgvArray &Argv,
                         Options::SortKind::ByDylibOrdinal);
         } else if (strcmp(Argument, "--sort-by-type") == 0) {
             AddSortKind("--sort-by-type", Options, Options::SortKind::ByKind);
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
         } else if (!Argument.isOption()) {
             break;
         } else {
@@ -490,7 +490,7 @@ PrintOpcodeList(
     auto DyldInfo = static_cast<const MachO::DyldInfoCommand *>(nullptr);
     const auto GetDyldInfoResult =
         OperationCommon::GetDyldInfoCommand(Options.ErrFile,
-                                            LoadCmdStorage,
+                                            Object.getLoadCommandIndex(),
                                             DyldInfo);
 
     if (GetDyldInfoResult != 0) {
@@ -521,7 +521,7 @@ PrintOpcodeList(
 
     const auto Is64Bit = Object.is64Bit();
     const auto SegmentCollection =
-        MachO::SegmentInfoCollection::Open(LoadCmdStorage,
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
                                            Is64Bit,
                                            &SegmentCollectionError);
 
@@ -9,6 +9,8 @@
 #include <cstring>
 #include <format>
 
+#include "ADT/ParallelSort.h"
+
 #include "Operations/Common.h"
 #include "Operations/Operation.h"
 #include "Operations/PrintBindSymbolList.h"
@@ -22,37 +24,85 @@ PrintBindSymbolListOperation::PrintBindSymbolListOperation(
     const struct Options &Options) noexcept
 : Operation(OpKind), Options(Options) {}
 
+template <PrintBindSymbolListOperation::Options::SortKind SortKind>
 static int
-CompareActionsBySortKind(
-    const MachO::BindActionInfo &Lhs,
-    const MachO::BindActionInfo &Rhs,
-    const PrintBindSymbolListOperation::Options::SortKind SortKind) noexcept
+CompareActionsBySortKind(const MachO::BindActionInfo &Lhs,
+                         const MachO::BindActionInfo &Rhs) noexcept
 {
-    switch (SortKind) {
-        case PrintBindSymbolListOperation::Options::SortKind::ByName:
-            return Lhs.SymbolName.compare(Rhs.SymbolName);
-        case PrintBindSymbolListOperation::Options::SortKind::ByDylibOrdinal:
-            if (Lhs.DylibOrdinal == Rhs.DylibOrdinal) {
-                return 0;
-            } else if (Lhs.DylibOrdinal < Rhs.DylibOrdinal) {
-                return -1;
-            }
+    using Enum = PrintBindSymbolListOperation::Options::SortKind;
+    if constexpr (SortKind == Enum::ByName) {
+        return Lhs.SymbolName.compare(Rhs.SymbolName);
+    } else if constexpr (SortKind == Enum::ByDylibOrdinal) {
+        if (Lhs.DylibOrdinal == Rhs.DylibOrdinal) {
+            return 0;
+        } else if (Lhs.DylibOrdinal < Rhs.DylibOrdinal) {
+            return -1;
+        }
 
-            return 1;
-        case PrintBindSymbolListOperation::Options::SortKind::ByType:
-            const auto LhsKind = static_cast<uint8_t>(Lhs.WriteKind);
-            const auto RhsKind = static_cast<uint8_t>(Rhs.WriteKind);
+        return 1;
+    } else if constexpr (SortKind == Enum::ByType) {
+        const auto LhsKind = static_cast<uint8_t>(Lhs.WriteKind);
+        const auto RhsKind = static_cast<uint8_t>(Rhs.WriteKind);
 
-            if (LhsKind == RhsKind) {
-                return 0;
-            } else if (LhsKind < RhsKind) {
-                return -1;
-            }
+        if (LhsKind == RhsKind) {
+            return 0;
+        } else if (LhsKind < RhsKind) {
+            return -1;
+        }
 
-            return 1;
+        return 1;
+    }
+}
+
+static void
+SortActionList(
+    std::vector<MachO::BindActionInfo> &List,
+    const struct PrintBindSymbolListOperation::Options &Options) noexcept
+{
+    using Enum = PrintBindSymbolListOperation::Options::SortKind;
+
+    // Sorting by a single kind is by far the most common, so give it a
+    // comparator specialized at compile-time.
+
+    if (Options.SortKindList.size() == 1) {
+        switch (Options.SortKindList.front()) {
+            case Enum::ByName:
+                ParallelSortWithFunc<CompareActionsBySortKind<Enum::ByName>>(
+                    List.begin(), List.end());
+                return;
+            case Enum::ByDylibOrdinal:
+                ParallelSortWithFunc<
+                    CompareActionsBySortKind<Enum::ByDylibOrdinal>>(
+                        List.begin(), List.end());
+                return;
+            case Enum::ByType:
+                ParallelSortWithFunc<CompareActionsBySortKind<Enum::ByType>>(
+                    List.begin(), List.end());
+                return;
+        }
+
+        assert(0 && "Unrecognized (and invalid) Sort-Kind");
+    }
+
+    auto FuncList = std::vector<SortCompareFunc<MachO::BindActionInfo>>();
+    FuncList.reserve(Options.SortKindList.size());
+
+    for (const auto &SortKind : Options.SortKindList) {
+        switch (SortKind) {
+            case Enum::ByName:
+                FuncList.emplace_back(CompareActionsBySortKind<Enum::ByName>);
+                break;
+            case Enum::ByDylibOrdinal:
+                FuncList.emplace_back(
+                    CompareActionsBySortKind<Enum::ByDylibOrdinal>);
+                break;
+            case Enum::ByType:
+                FuncList.emplace_back(CompareActionsBySortKind<Enum::ByType>);
+                break;
+        }
     }
 
-    assert(0 && "Unrecognized (and invalid) Sort-Kind");
+    ParallelSortWithFuncList(List.begin(), List.end(), FuncList);
 }
 
 template <MachO::BindInfoKind BindKind>
@@ -185,6 +235,119 @@ PrintBindActionList(
     }
 }
 
+template <MachO::BindInfoKind BindKind>
+static MachO::BindOpcodeParseError
+WriteBindSymbolListRecords(
+    RecordWriter &Writer,
+    const MachO::BindActionListBase<BindKind> &List,
+    const MachO::SegmentInfoCollection &SegmentCollection,
+    const MachO::SharedLibraryInfoCollection &LibraryCollection,
+    const struct PrintBindSymbolListOperation::Options &Options) noexcept
+{
+    // Without a sort, write out each symbol as soon as it's decoded instead
+    // of collecting the entire list first.
+
+    if (Options.SortKindList.empty()) {
+        for (const auto &Iter : List) {
+            const auto Error = Iter.getError();
+            if (!Iter.canIgnoreError(Error)) {
+                return Error;
+            }
+
+            if (!Iter.NewSymbolName) {
+                continue;
+            }
+
+            OperationCommon::WriteBindActionRecord(Writer,
+                                                   Iter.getAction(),
+                                                   SegmentCollection,
+                                                   LibraryCollection);
+        }
+
+        return MachO::BindOpcodeParseError::None;
+    }
+
+    auto SymbolList = std::vector<MachO::BindActionInfo>();
+    const auto Error = List.GetListOfSymbols(SymbolList);
+
+    SortActionList(SymbolList, Options);
+
+    for (const auto &Symbol : SymbolList) {
+        OperationCommon::WriteBindActionRecord(Writer,
+                                               Symbol,
+                                               SegmentCollection,
+                                               LibraryCollection);
+    }
+
+    return Error;
+}
+
+static int
+WriteBindSymbolListsRecords(
+    const MachO::DyldInfoCommand &DyldInfo,
+    const ConstMemoryMap &Map,
+    const MachO::SegmentInfoCollection &SegmentCollection,
+    const MachO::SharedLibraryInfoCollection &LibraryCollection,
+    const bool IsBigEndian,
+    const bool Is64Bit,
+    const struct PrintBindSymbolListOperation::Options &Options) noexcept
+{
+    auto Writer = Options.GetRecordWriter();
+    const auto WriteList =
+        [&](const char *const Name, const auto &ListOpt) noexcept
+    {
+        switch (ListOpt.getError()) {
+            case MachO::SizeRangeError::None:
+                break;
+            case MachO::SizeRangeError::Empty:
+                return;
+            case MachO::SizeRangeError::Overflows:
+            case MachO::SizeRangeError::PastEnd:
+                fprintf(Options.ErrFile,
+                        "%s List goes past end-of-file\n",
+                        Name);
+                return;
+        }
+
+        const auto Error =
+            WriteBindSymbolListRecords(Writer,
+                                       *ListOpt.value(),
+                                       SegmentCollection,
+                                       LibraryCollection,
+                                       Options);
+
+        OperationCommon::HandleBindOpcodeParseError(Options.ErrFile, Error);
+    };
+
+    Writer.beginList();
+    if (Options.PrintNormal) {
+        WriteList("Bind",
+                  DyldInfo.GetBindActionList(Map,
+                                             SegmentCollection,
+                                             IsBigEndian,
+                                             Is64Bit));
+    }
+
+    if (Options.PrintLazy) {
+        WriteList("Lazy-Bind",
+                  DyldInfo.GetLazyBindActionList(Map,
+                                                 SegmentCollection,
+                                                 IsBigEndian,
+                                                 Is64Bit));
+    }
+
+    if (Options.PrintWeak) {
+        WriteList("Weak-Bind",
+                  DyldInfo.GetWeakBindActionList(Map,
+                                                 SegmentCollection,
+                                                 IsBigEndian,
+                                                 Is64Bit));
+    }
+
+    Writer.endList();
+    return 0;
+}
+
 static int
 PrintBindSymbolList(
     const MachOMemoryObject &Object,
@@ -268,13 +431,23 @@ PrintBindSymbolList(
 
     const auto Is64Bit = Object.is64Bit();
     const auto SegmentCollection =
-        MachO::SegmentInfoCollection::Open(LoadCmdStorage,
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
                                            Is64Bit,
                                            &SegmentCollectionError);
 
     OperationCommon::HandleSegmentCollectionError(Options.ErrFile,
                                                   SegmentCollectionError);
 
+    if (Options.isRecordFormat()) {
+        return WriteBindSymbolListsRecords(*FoundDyldInfo,
+                                           Map,
+                                           SegmentCollection,
+                                           SharedLibraryCollection,
+                                           IsBigEndian,
+                                           Is64Bit,
+                                           Options);
+    }
+
     auto ShouldPrintBind = Options.PrintNormal;
     auto ShouldPrintLazyBind = Options.PrintLazy;
     auto ShouldPrintWeakBind = Options.PrintWeak;
@@ -291,20 +464,6 @@ PrintBindSymbolList(
     auto LazyBindSymbolActionList = std::vector<MachO::BindActionInfo>();
     auto WeakBindSymbolActionList = std::vector<MachO::BindActionInfo>();
 
-    const auto Comparator =
-        [&](const MachO::BindActionInfo &Lhs,
-            const MachO::BindActionInfo &Rhs) noexcept
-    {
-        for (const auto &SortKind : Options.SortKindList) {
-            const auto CmpResult = CompareActionsBySortKind(Lhs, Rhs, SortKind);
-            if (CmpResult != 0) {
-                return (CmpResult < 0);
-            }
-        }
-
-        return false;
-    };
-
     if (ShouldPrintBind) {
         const auto BindActionListOpt =
             FoundDyldInfo->GetBindActionList(Map,
@@ -375,9 +534,7 @@ PrintBindSymbolList(
 
         if (ShouldPrintBind) {
             if (!Options.SortKindList.empty()) {
-                std::sort(BindSymbolActionList.begin(),
-                          BindSymbolActionList.end(),
-                          Comparator);
+                SortActionList(BindSymbolActionList, Options);
             }
 
             PrintBindActionList<MachO::BindInfoKind::Normal>(
@@ -417,9 +574,7 @@ PrintBindSymbolList(
 
         if (ShouldPrintLazyBind) {
             if (!Options.SortKindList.empty()) {
-                std::sort(LazyBindSymbolActionList.begin(),
-                          LazyBindSymbolActionList.end(),
-                          Comparator);
+                SortActionList(LazyBindSymbolActionList, Options);
             }
 
             PrintBindActionList<MachO::BindInfoKind::Lazy>(
@@ -460,9 +615,7 @@ PrintBindSymbolList(
 
         if (ShouldPrintWeakBind) {
             if (!Options.SortKindList.empty()) {
-                std::sort(WeakBindSymbolActionList.begin(),
-                          WeakBindSymbolActionList.end(),
-                          Comparator);
+                SortActionList(WeakBindSymbolActionList, Options);
             }
 
             PrintBindActionList<MachO::BindInfoKind::Weak>(
@@ -543,6 +696,10 @@ PrintBindSymbolListOperation::ParseOptionsImpl(const ArgvArray &Argv,
             AddSortKind(Options::SortKind::ByDylibOrdinal, Argument, Options);
         } else if (strcmp(Argument, "--sort-by-type") == 0) {
             AddSortKind(Options::SortKind::ByType, Argument, Options);
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
         } else if (!Argument.isOption()) {
             break;
         } else {
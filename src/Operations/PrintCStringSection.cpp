@@ -6,10 +6,19 @@
 //  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
 //
 
+#include <algorithm>
+#include <memory>
+
+#include "ADT/CStringScanner.h"
+#include "ADT/ParallelSort.h"
+#include "ADT/StringHashMap.h"
+
 #include "Operations/Common.h"
 #include "Operations/Operation.h"
 #include "Operations/PrintCStringSection.h"
 
+#include "Utils/StringUtils.h"
+
 PrintCStringSectionOperation::PrintCStringSectionOperation() noexcept
 : Operation(OpKind) {}
 
@@ -23,59 +32,423 @@ struct StringInfo {
     uint64_t Offset;
     uint64_t Addr;
 
+    // Only counted with --dedupe and --stats, where each string is stored
+    // once, with the location of its first occurence.
+    uint64_t Count = 1;
+
     [[nodiscard]] inline bool operator<(const StringInfo &Rhs) const noexcept {
         return (String < Rhs.String);
     }
 };
 
-[[nodiscard]]
-static inline bool ShouldExcludeString(std::string_view String) noexcept {
-    if (String.empty()) {
-        return true;
-    }
+using SectionInfoList = std::vector<const MachO::SectionInfo *>;
 
-    for (const auto &Ch : String) {
-        if (isprint(Ch) == 0) {
-            return true;
-        }
-    }
+template <typename T>
+static void
+ForEachCString(const uint8_t *const Map,
+               const MachO::SectionInfo &Section,
+               const T &Callback) noexcept
+{
+    const auto FileOffset = Section.getFileRange().getBegin();
+    const auto VmAddr = Section.getMemoryRange().getBegin();
 
-    return false;
+    ScanPrintableCStrings(Section.getData<const char>(Map),
+                          Section.getDataEnd<const char>(Map),
+                          [&](const std::string_view String,
+                              const uint64_t Offset) noexcept
+    {
+        Callback(StringInfo {
+            .String = String,
+            .Offset = FileOffset + Offset,
+            .Addr = VmAddr + Offset
+        });
+    });
 }
 
 static void
 GetCStringList(const uint8_t *const Map,
-               const MachO::SectionInfo &Section,
+               const SectionInfoList &SectionList,
                std::vector<StringInfo> &StringList,
                LargestIntHelper<uint64_t> &LongestStringLength) noexcept
 {
-    const auto Begin = Section.getData<const char>(Map);
-    const auto End = Section.getDataEnd<const char>(Map);
-
-    auto FileOffset = Section.getFileRange().getBegin();
-    auto VmAddr = Section.getMemoryRange().getBegin();
-
-    auto Length = uint64_t();
-    for (auto String = Begin;
-         String < End;
-         String += (Length + 1),
-         FileOffset += (Length + 1),
-         VmAddr += (Length + 1))
-    {
-        Length = strnlen(String, (End - String));
+    for (const auto &Section : SectionList) {
+        ForEachCString(Map, *Section, [&](const StringInfo &Info) noexcept {
+            LongestStringLength = Info.String.length();
+            StringList.emplace_back(Info);
+        });
+    }
+}
 
-        const auto StringView = std::string_view(String, Length);
-        if (ShouldExcludeString(StringView)) {
+static void
+CollectCStringSectionList(const MachO::SegmentInfoCollection &Collection,
+                          SectionInfoList &ListOut) noexcept
+{
+    for (const auto &Segment : Collection) {
+        if (Segment.getFlags().isProtected()) {
             continue;
         }
 
-        LongestStringLength = Length;
-        StringList.emplace_back(StringInfo {
-            .String = StringView,
-            .Offset = FileOffset,
-            .Addr = VmAddr
-        });
+        for (const auto &Section : Segment.getSectionList()) {
+            if (Section.getKind() !=
+                    MachO::SegmentSectionKind::CStringLiterals)
+            {
+                continue;
+            }
+
+            if (Section.getFileRange().empty()) {
+                continue;
+            }
+
+            ListOut.emplace_back(&Section);
+        }
+    }
+}
+
+// Stores each unique string once, alongside totals for every string added,
+// so memory is only used for strings that haven't been seen before.
+
+struct CStringTable {
+    StringHashMap<StringInfo> Map;
+
+    uint64_t StringCount = 0;
+    uint64_t TotalSize = 0;
+};
+
+static void
+AddSectionToTable(const uint8_t *const Map,
+                  const MachO::SectionInfo &Section,
+                  CStringTable &Table) noexcept
+{
+    ForEachCString(Map, Section, [&](const StringInfo &Info) noexcept {
+        auto Inserted = false;
+        auto &Entry = Table.Map.getOrInsert(Info.String, &Inserted);
+
+        if (Inserted) {
+            Entry = Info;
+        } else {
+            Entry.Count++;
+        }
+
+        Table.StringCount++;
+        Table.TotalSize += Info.String.length() + 1;
+    });
+}
+
+static void
+WriteCStringRecord(RecordWriter &Writer,
+                   const StringInfo &Info,
+                   const bool WriteCount) noexcept
+{
+    Writer.beginRecord();
+    Writer.writeNumber("address", Info.Addr);
+    Writer.writeNumber("offset", Info.Offset);
+    Writer.writeNumber("length", Info.String.length());
+    Writer.writeString("string", Info.String);
+
+    if (WriteCount) {
+        Writer.writeNumber("count", Info.Count);
+    }
+
+    Writer.endRecord();
+}
+
+static int
+WriteCStringListRecords(
+    const uint8_t *const MapBegin,
+    const SectionInfoList &SectionList,
+    const struct PrintCStringSectionOperation::Options &Options) noexcept
+{
+    auto Writer = Options.GetRecordWriter();
+    Writer.beginList();
+
+    if (Options.Sort) {
+        auto InfoList = std::vector<StringInfo>();
+        auto LongestStringLength = LargestIntHelper();
+
+        GetCStringList(MapBegin, SectionList, InfoList, LongestStringLength);
+        ParallelSort(InfoList.begin(), InfoList.end(), std::less<>());
+
+        for (const auto &Info : InfoList) {
+            WriteCStringRecord(Writer, Info, false);
+        }
+    } else {
+        for (const auto &Section : SectionList) {
+            ForEachCString(MapBegin,
+                           *Section,
+                           [&](const StringInfo &Info) noexcept
+            {
+                WriteCStringRecord(Writer, Info, false);
+            });
+        }
+    }
+
+    Writer.endList();
+    return 0;
+}
+
+static void
+PrintCStringInfoList(
+    const std::vector<StringInfo> &InfoList,
+    const uint64_t LongestStringLength,
+    const bool Is64Bit,
+    const bool PrintCount,
+    const struct PrintCStringSectionOperation::Options &Options) noexcept
+{
+    const auto LongestStringLengthDigitLength =
+        PrintUtilsGetIntegerDigitLength(LongestStringLength);
+
+    auto Counter = static_cast<uint64_t>(1);
+    const auto StringListSizeDigitLength =
+        PrintUtilsGetIntegerDigitLength(InfoList.size());
+
+    for (const auto &Info : InfoList) {
+        fprintf(Options.OutFile,
+                "C-String %0*" PRIu64 ": ",
+                StringListSizeDigitLength,
+                Counter);
+
+        PrintUtilsWriteOffset32Or64(Options.OutFile, Is64Bit, Info.Addr);
+        const auto PrintLength =
+            fprintf(Options.OutFile,
+                    " \"" STRING_VIEW_FMT "\"",
+                    STRING_VIEW_FMT_ARGS(Info.String));
+
+        if (Options.Verbose || PrintCount) {
+            const auto RightPad =
+                static_cast<int>(LongestStringLength + LENGTH_OF(" \"\""));
+
+            PrintUtilsRightPadSpaces(Options.OutFile, PrintLength, RightPad);
+            fputs(" (", Options.OutFile);
+
+            if (PrintCount) {
+                fprintf(Options.OutFile, "Count: %" PRIu64, Info.Count);
+                if (Options.Verbose) {
+                    fputs(", ", Options.OutFile);
+                }
+            }
+
+            if (Options.Verbose) {
+                fprintf(Options.OutFile,
+                        "Length: %0*" PRIuPTR ", File: ",
+                        LongestStringLengthDigitLength,
+                        Info.String.length());
+
+                PrintUtilsWriteOffset32Or64(Options.OutFile,
+                                            Is64Bit,
+                                            Info.Offset,
+                                            false);
+            }
+
+            fputc(')', Options.OutFile);
+        }
+
+        fputc('\n', Options.OutFile);
+        Counter++;
+    }
+}
+
+static int
+PrintUniqueCStringList(
+    const CStringTable &Table,
+    const bool Is64Bit,
+    const struct PrintCStringSectionOperation::Options &Options) noexcept
+{
+    auto InfoList = std::vector<StringInfo>();
+    auto LongestStringLength = LargestIntHelper();
+
+    InfoList.reserve(Table.Map.size());
+    for (const auto &Entry : Table.Map) {
+        LongestStringLength = Entry.Key.length();
+        InfoList.emplace_back(Entry.Value);
+    }
+
+    if (Options.Sort) {
+        ParallelSort(InfoList.begin(), InfoList.end(), std::less<>());
+    }
+
+    if (Options.isRecordFormat()) {
+        auto Writer = Options.GetRecordWriter();
+
+        Writer.beginList();
+        for (const auto &Info : InfoList) {
+            WriteCStringRecord(Writer, Info, true);
+        }
+
+        Writer.endList();
+        return 0;
+    }
+
+    Operation::PrintLineSpamWarning(Options.OutFile, InfoList.size());
+    fprintf(Options.OutFile,
+            "Provided file has %" PRIuPTR " unique C-Strings (%" PRIu64
+            " total):\n",
+            InfoList.size(),
+            Table.StringCount);
+
+    PrintCStringInfoList(InfoList, LongestStringLength, Is64Bit, true, Options);
+    return 0;
+}
+
+static int
+PrintCStringStats(
+    const CStringTable &Table,
+    const struct PrintCStringSectionOperation::Options &Options) noexcept
+{
+    auto UniqueSize = uint64_t();
+    for (const auto &Entry : Table.Map) {
+        UniqueSize += Entry.Key.length() + 1;
+    }
+
+    const auto WastedSize = Table.TotalSize - UniqueSize;
+    if (Options.isRecordFormat()) {
+        auto Writer = Options.GetRecordWriter();
+
+        Writer.beginList();
+        Writer.beginRecord();
+        Writer.writeNumber("string_count", Table.StringCount);
+        Writer.writeNumber("unique_count", Table.Map.size());
+        Writer.writeNumber("total_size", Table.TotalSize);
+        Writer.writeNumber("wasted_size", WastedSize);
+        Writer.endRecord();
+        Writer.endList();
+
+        return 0;
+    }
+
+    const auto WastedPercent =
+        (Table.TotalSize != 0) ?
+            (static_cast<double>(WastedSize) * 100 / Table.TotalSize) : 0;
+
+    fprintf(Options.OutFile,
+            "C-Strings:        %" PRIu64 "\n"
+            "Unique C-Strings: %" PRIuPTR "\n"
+            "Total Size:       %" PRIu64 " Bytes\n"
+            "Wasted Size:      %" PRIu64 " Bytes (%.2f%%)\n",
+            Table.StringCount,
+            Table.Map.size(),
+            Table.TotalSize,
+            WastedSize,
+            WastedPercent);
+
+    // Only the duplicated strings are ranked, as every other string appears
+    // exactly once.
+
+    auto DuplicateList = std::vector<const StringInfo *>();
+    for (const auto &Entry : Table.Map) {
+        if (Entry.Value.Count > 1) {
+            DuplicateList.emplace_back(&Entry.Value);
+        }
+    }
+
+    if (DuplicateList.empty()) {
+        fputs("No C-String appears more than once\n", Options.OutFile);
+        return 0;
+    }
+
+    const auto TopCount =
+        std::min(static_cast<uint64_t>(Options.TopCount),
+                 static_cast<uint64_t>(DuplicateList.size()));
+
+    const auto TopEnd = DuplicateList.begin() + TopCount;
+    std::partial_sort(DuplicateList.begin(),
+                      TopEnd,
+                      DuplicateList.end(),
+                      [](const StringInfo *const Lhs,
+                         const StringInfo *const Rhs) noexcept
+    {
+        if (Lhs->Count != Rhs->Count) {
+            return Lhs->Count > Rhs->Count;
+        }
+
+        return Lhs->String < Rhs->String;
+    });
+
+    fprintf(Options.OutFile,
+            "\nMost Frequent C-Strings (%" PRIuPTR " are duplicated):\n",
+            DuplicateList.size());
+
+    const auto TopCountDigitLength = PrintUtilsGetIntegerDigitLength(TopCount);
+    auto Counter = static_cast<uint64_t>(1);
+
+    for (auto Iter = DuplicateList.begin(); Iter != TopEnd; Iter++) {
+        const auto &Info = **Iter;
+        fprintf(Options.OutFile,
+                "%0*" PRIu64 ". \"" STRING_VIEW_FMT "\" (Count: %" PRIu64
+                ", Wasted: %" PRIu64 " Bytes)\n",
+                TopCountDigitLength,
+                Counter,
+                STRING_VIEW_FMT_ARGS(Info.String),
+                Info.Count,
+                (Info.Count - 1) * (Info.String.length() + 1));
+
+        Counter++;
     }
+
+    return 0;
+}
+
+static int
+PrintCStringTable(
+    const CStringTable &Table,
+    const bool Is64Bit,
+    const struct PrintCStringSectionOperation::Options &Options) noexcept
+{
+    if (Options.Stats) {
+        return PrintCStringStats(Table, Options);
+    }
+
+    return PrintUniqueCStringList(Table, Is64Bit, Options);
+}
+
+static int
+PrintCStringSectionList(
+    const uint8_t *const MapBegin,
+    const SectionInfoList &SectionList,
+    const bool Is64Bit,
+    const struct PrintCStringSectionOperation::Options &Options) noexcept
+{
+    if (Options.Dedupe || Options.Stats) {
+        auto Table = CStringTable();
+        for (const auto &Section : SectionList) {
+            AddSectionToTable(MapBegin, *Section, Table);
+        }
+
+        return PrintCStringTable(Table, Is64Bit, Options);
+    }
+
+    if (Options.isRecordFormat()) {
+        return WriteCStringListRecords(MapBegin, SectionList, Options);
+    }
+
+    auto InfoList = std::vector<StringInfo>();
+    auto LongestStringLength = LargestIntHelper();
+
+    GetCStringList(MapBegin, SectionList, InfoList, LongestStringLength);
+    if (Options.Sort) {
+        ParallelSort(InfoList.begin(), InfoList.end(), std::less<>());
+    }
+
+    const auto InfoListSize = InfoList.size();
+    Operation::PrintLineSpamWarning(Options.OutFile, InfoListSize);
+
+    if (SectionList.size() == 1) {
+        fprintf(Options.OutFile,
+                "Provided section has %" PRIuPTR " C-Strings:\n",
+                InfoListSize);
+    } else {
+        fprintf(Options.OutFile,
+                "Provided file has %" PRIuPTR " C-Strings in %" PRIuPTR
+                " sections:\n",
+                InfoListSize,
+                SectionList.size());
+    }
+
+    PrintCStringInfoList(InfoList,
+                         LongestStringLength,
+                         Is64Bit,
+                         false,
+                         Options);
+    return 0;
 }
 
 static int
@@ -86,18 +459,27 @@ PrintCStringList(
     const struct PrintCStringSectionOperation::Options &Options) noexcept
 {
     auto Error = MachO::SegmentInfoCollection::Error::None;
-    auto Segment = std::unique_ptr<MachO::SegmentInfo>();
-
-    const auto Section =
-        MachO::SegmentInfoCollection::OpenSectionInfoWithName(
-            LoadCmdStorage,
-            Is64Bit,
-            Options.SegmentName,
-            Options.SectionName,
-            &Segment,
-            &Error);
+    const auto Collection =
+        MachO::SegmentInfoCollection::Open(LoadCmdStorage, Is64Bit, &Error);
 
     OperationCommon::HandleSegmentCollectionError(Options.ErrFile, Error);
+    auto SectionList = SectionInfoList();
+
+    if (Options.AllSections) {
+        CollectCStringSectionList(Collection, SectionList);
+        if (SectionList.empty()) {
+            fputs("Provided file has no C-String Literal Sections\n",
+                  Options.OutFile);
+            return 0;
+        }
+
+        return PrintCStringSectionList(MapBegin,
+                                       SectionList,
+                                       Is64Bit,
+                                       Options);
+    }
+
+    const auto Segment = Collection.GetInfoForName(Options.SegmentName);
     if (Segment == nullptr) {
         fprintf(Options.ErrFile,
                 "Provided file has no segment with name \"" STRING_VIEW_FMT
@@ -108,11 +490,13 @@ PrintCStringList(
 
     if (Segment->getFlags().isProtected()) {
         fprintf(Options.ErrFile,
-                "Provided segment \"%s\" is protected (encrypted)\n",
-                Segment->getName().data());
+                "Provided segment \"" STRING_VIEW_FMT "\" is protected "
+                "(encrypted)\n",
+                STRING_VIEW_FMT_ARGS(Segment->getName()));
         return 1;
     }
 
+    const auto Section = Segment->FindSectionWithName(Options.SectionName);
     if (Section == nullptr) {
         fprintf(Options.ErrFile,
                 "Provided file has no section with name \"" STRING_VIEW_FMT
@@ -123,10 +507,11 @@ PrintCStringList(
 
     if (Section->getKind() != MachO::SegmentSectionKind::CStringLiterals) {
         fprintf(Options.OutFile,
-                "Provided Segment-Section \"%s\",\"%s\" is not a C-String "
+                "Provided Segment-Section \"" STRING_VIEW_FMT "\",\""
+                STRING_VIEW_FMT "\" is not a C-String "
                 "Literal Section\n",
-                Segment->getName().data(),
-                Section->getName().data());
+                STRING_VIEW_FMT_ARGS(Segment->getName()),
+                STRING_VIEW_FMT_ARGS(Section->getName()));
         return 0;
     }
 
@@ -135,65 +520,8 @@ PrintCStringList(
         return 0;
     }
 
-    auto InfoList = std::vector<StringInfo>();
-    auto LongestStringLength = LargestIntHelper();
-
-    GetCStringList(MapBegin,
-                   *Section.get(),
-                   InfoList,
-                   LongestStringLength);
-
-    const auto LongestStringLengthDigitLength =
-        PrintUtilsGetIntegerDigitLength(LongestStringLength);
-
-    if (Options.Sort) {
-        std::sort(InfoList.begin(), InfoList.end());
-    }
-
-    const auto InfoListSize = InfoList.size();
-    Operation::PrintLineSpamWarning(Options.OutFile, InfoListSize);
-
-    fprintf(Options.OutFile,
-            "Provided section has %" PRIuPTR " C-Strings:\n",
-            InfoListSize);
-
-    auto Counter = static_cast<uint64_t>(1);
-    const auto StringListSizeDigitLength =
-        PrintUtilsGetIntegerDigitLength(InfoListSize);
-
-    for (const auto &Info : InfoList) {
-        fprintf(Options.OutFile,
-                "C-String %0*" PRIu64 ": ",
-                StringListSizeDigitLength,
-                Counter);
-
-        PrintUtilsWriteOffset32Or64(Options.OutFile, Is64Bit, Info.Addr);
-        const auto PrintLength =
-            fprintf(Options.OutFile, " \"%s\"", Info.String.data());
-
-        if (Options.Verbose) {
-            const auto RightPad =
-                static_cast<int>(LongestStringLength + LENGTH_OF(" \"\""));
-
-            PrintUtilsRightPadSpaces(Options.OutFile, PrintLength, RightPad);
-            fprintf(Options.OutFile,
-                    " (Length: %0*" PRIuPTR ", File: ",
-                    LongestStringLengthDigitLength,
-                    Info.String.length());
-
-            PrintUtilsWriteOffset32Or64(Options.OutFile,
-                                        Is64Bit,
-                                        Info.Offset,
-                                        false,
-                                        "",
-                                        ")");
-        }
-
-        fputc('\n', Options.OutFile);
-        Counter++;
-    }
-
-    return 0;
+    SectionList.emplace_back(Section);
+    return PrintCStringSectionList(MapBegin, SectionList, Is64Bit, Options);
 }
 
 int
@@ -229,6 +557,84 @@ PrintCStringSectionOperation::Run(const MachOMemoryObject &Object,
     return Result;
 }
 
+// Images of a shared-cache share many of their strings, so --dedupe and
+// --stats are run across the matching sections of every image at once.
+
+int
+PrintCStringSectionOperation::Run(const DscMemoryObject &Object,
+                                  const struct Options &Options) noexcept
+{
+    assert(Options.Dedupe || Options.Stats);
+
+    const auto Map = Object.getMap().getBegin();
+    const auto MapRange = Object.getRange();
+
+    auto Table = CStringTable();
+    auto Is64Bit = true;
+    auto DidFindSection = false;
+
+    for (const auto &ImageInfo : Object.getConstImageInfoList()) {
+        const auto ImageOrError = Object.GetImageWithInfo(ImageInfo);
+        if (ImageOrError.hasError()) {
+            continue;
+        }
+
+        const auto Image =
+            std::unique_ptr<const DscImageMemoryObject>(ImageOrError.value());
+
+        const auto LoadCmdStorage = Image->GetLoadCommandsStorage();
+        if (LoadCmdStorage.hasError()) {
+            continue;
+        }
+
+        auto Error = MachO::SegmentInfoCollection::Error::None;
+        const auto Collection =
+            MachO::SegmentInfoCollection::Open(Image->getLoadCommandIndex(),
+                                               Image->is64Bit(),
+                                               &Error);
+
+        if (Error != MachO::SegmentInfoCollection::Error::None) {
+            continue;
+        }
+
+        auto SectionList = SectionInfoList();
+        if (Options.AllSections) {
+            CollectCStringSectionList(Collection, SectionList);
+        } else if (const auto Section =
+                        Collection.FindSectionWithName(Options.SegmentName,
+                                                       Options.SectionName))
+        {
+            const auto Kind = MachO::SegmentSectionKind::CStringLiterals;
+            if (Section->getKind() == Kind &&
+                !Section->getSegment()->getFlags().isProtected())
+            {
+                SectionList.emplace_back(Section);
+            }
+        }
+
+        for (const auto &Section : SectionList) {
+            // Sections of images in a sub-cache are outside of this file.
+            if (!MapRange.contains(Section->getFileRange())) {
+                continue;
+            }
+
+            AddSectionToTable(Map, *Section, Table);
+            DidFindSection = true;
+        }
+
+        Is64Bit = Image->is64Bit();
+    }
+
+    if (!DidFindSection) {
+        fputs("No image of the provided file has a matching C-String "
+              "Literal Section\n",
+              Options.ErrFile);
+        return 1;
+    }
+
+    return PrintCStringTable(Table, Is64Bit, Options);
+}
+
 auto
 PrintCStringSectionOperation::ParseOptionsImpl(const ArgvArray &Argv,
                                                int *const IndexOut) noexcept
@@ -237,6 +643,7 @@ PrintCStringSectionOperation::ParseOptionsImpl(const ArgvArray &Argv,
     struct Options Options;
 
     auto DidGetInfo = false;
+    auto DidGetTopCount = false;
     auto Index = int();
 
     for (const auto &Argument : Argv) {
@@ -244,8 +651,24 @@ PrintCStringSectionOperation::ParseOptionsImpl(const ArgvArray &Argv,
             Options.Verbose = true;
         } else if (strcmp(Argument, "--sort") == 0) {
             Options.Sort = true;
+        } else if (strcmp(Argument, "--all-sections") == 0) {
+            Options.AllSections = true;
+        } else if (strcmp(Argument, "--dedupe") == 0) {
+            Options.Dedupe = true;
+        } else if (strcmp(Argument, "--stats") == 0) {
+            Options.Stats = true;
+        } else if (Argument.GetStringView().starts_with("--top=")) {
+            Options.TopCount =
+                ParseNumber<uint32_t>(
+                    Argument.getString() + LENGTH_OF("--top="));
+
+            DidGetTopCount = true;
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
         } else if (!Argument.isOption()) {
-            if (DidGetInfo) {
+            if (DidGetInfo || Options.AllSections) {
                 break;
             }
 
@@ -266,6 +689,23 @@ PrintCStringSectionOperation::ParseOptionsImpl(const ArgvArray &Argv,
         Index++;
     }
 
+    if (DidGetInfo && Options.AllSections) {
+        fputs("Error: Provided both a Segment-Section Pair and "
+              "--all-sections\n",
+              stderr);
+        exit(1);
+    }
+
+    if (Options.Dedupe && Options.Stats) {
+        fputs("Error: Provided both --dedupe and --stats\n", stderr);
+        exit(1);
+    }
+
+    if (DidGetTopCount && !Options.Stats) {
+        fputs("Error: Provided --top without --stats\n", stderr);
+        exit(1);
+    }
+
     if (IndexOut != nullptr) {
         *IndexOut = Index;
     }
@@ -289,8 +729,13 @@ PrintCStringSectionOperation::Run(const MemoryObject &Object) const noexcept {
             return Run(cast<ObjectKind::MachO>(Object), Options);
         case ObjectKind::DscImage:
             return Run(cast<ObjectKind::DscImage>(Object), Options);
-        case ObjectKind::FatMachO:
         case ObjectKind::DyldSharedCache:
+            if (Options.Dedupe || Options.Stats) {
+                return Run(cast<ObjectKind::DyldSharedCache>(Object), Options);
+            }
+
+            return InvalidObjectKind;
+        case ObjectKind::FatMachO:
             return InvalidObjectKind;
     }
 
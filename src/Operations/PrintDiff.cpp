@@ -0,0 +1,1506 @@
+//
+//  Operations/PrintDiff.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <map>
+#include <memory>
+#include <thread>
+#include <unordered_set>
+
+#include "ADT/DscImage/DeVirtualizer.h"
+#include "ADT/DscImage/ObjcUtil.h"
+#include "ADT/DyldSharedCache/LocalSymbols.h"
+#include "ADT/FileDescriptor.h"
+#include "ADT/Mach/CpuKindInfoTemplates.h"
+#include "ADT/MappedFile.h"
+#include "ADT/ParallelSort.h"
+
+#include "Objects/DscImageMemory.h"
+
+#include "Operations/Common.h"
+#include "Operations/Operation.h"
+#include "Operations/PrintDiff.h"
+
+#include "Utils/Path.h"
+#include "Utils/PrintUtils.h"
+
+PrintDiffOperation::PrintDiffOperation() noexcept : Operation(OpKind) {}
+PrintDiffOperation::PrintDiffOperation(const struct Options &Options) noexcept
+: Operation(OpKind), Options(Options) {}
+
+using SectionKind = PrintDiffOperation::SectionKind;
+
+[[nodiscard]] static std::string_view
+GetSectionName(const SectionKind Kind) noexcept {
+    switch (Kind) {
+        case SectionKind::Header:
+            return "header";
+        case SectionKind::LoadCommands:
+            return "load-commands";
+        case SectionKind::Libraries:
+            return "libraries";
+        case SectionKind::Exports:
+            return "exports";
+        case SectionKind::Binds:
+            return "binds";
+        case SectionKind::Symbols:
+            return "symbols";
+        case SectionKind::ObjcClasses:
+            return "objc-classes";
+        case SectionKind::Images:
+            return "images";
+    }
+
+    assert(0 && "Unrecognized Section-Kind");
+}
+
+[[nodiscard]] static std::string_view
+GetSectionDescription(const SectionKind Kind) noexcept {
+    switch (Kind) {
+        case SectionKind::Header:
+            return "Header";
+        case SectionKind::LoadCommands:
+            return "Load-Commands";
+        case SectionKind::Libraries:
+            return "Libraries";
+        case SectionKind::Exports:
+            return "Exports";
+        case SectionKind::Binds:
+            return "Binds";
+        case SectionKind::Symbols:
+            return "Symbols";
+        case SectionKind::ObjcClasses:
+            return "Objc-Classes";
+        case SectionKind::Images:
+            return "Images";
+    }
+
+    assert(0 && "Unrecognized Section-Kind");
+}
+
+// An entry of a section, compared against the entry with the same name in the
+// other file.
+
+struct DiffItem {
+    std::string Name;
+    std::string Value;
+};
+
+enum class ChangeKind {
+    Added,
+    Removed,
+    Changed
+};
+
+struct DiffEntry {
+    SectionKind Section;
+    ChangeKind Change;
+
+    std::string Name;
+    std::string OldValue;
+    std::string NewValue;
+};
+
+using DiffItemListList =
+    std::array<std::vector<DiffItem>, PrintDiffOperation::SectionCount>;
+
+[[nodiscard]] static std::string_view
+GetChangeName(const ChangeKind Change) noexcept {
+    switch (Change) {
+        case ChangeKind::Added:
+            return "added";
+        case ChangeKind::Removed:
+            return "removed";
+        case ChangeKind::Changed:
+            return "changed";
+    }
+
+    assert(0 && "Unrecognized Change-Kind");
+}
+
+[[nodiscard]] static std::string_view
+GetBindKindName(const MachO::BindInfoKind Kind) noexcept {
+    switch (Kind) {
+        case MachO::BindInfoKind::Normal:
+            return "bind";
+        case MachO::BindInfoKind::Lazy:
+            return "lazy-bind";
+        case MachO::BindInfoKind::Weak:
+            return "weak-bind";
+    }
+
+    assert(0 && "Unrecognized Bind-Info Kind");
+}
+
+[[nodiscard]] static std::string
+GetVersionString(const Dyld3::PackedVersion &Version) noexcept {
+    return std::format("{}.{}.{}",
+                       Version.getMajor(),
+                       Version.getMinor(),
+                       Version.getRevision());
+}
+
+[[nodiscard]] static std::string GetUuidString(const uint8_t *const Uuid) {
+    auto Result = std::string();
+    Result.reserve(36);
+
+    for (auto I = 0; I != 16; I++) {
+        if (I == 4 || I == 6 || I == 8 || I == 10) {
+            Result += '-';
+        }
+
+        Result += std::format("{:02X}", Uuid[I]);
+    }
+
+    return Result;
+}
+
+[[nodiscard]] static const MachO::UuidCommand *
+FindUuidCommand(const MachO::ConstLoadCommandStorage &LoadCmdStorage) noexcept
+{
+    const auto IsBigEndian = LoadCmdStorage.isBigEndian();
+    for (const auto &LC : LoadCmdStorage) {
+        if (const auto Uuid = dyn_cast<MachO::UuidCommand>(LC, IsBigEndian)) {
+            return Uuid;
+        }
+    }
+
+    return nullptr;
+}
+
+[[nodiscard]] static const MachO::DyldInfoCommand *
+FindDyldInfoCommand(
+    const MachO::ConstLoadCommandStorage &LoadCmdStorage) noexcept
+{
+    const auto IsBigEndian = LoadCmdStorage.isBigEndian();
+    for (const auto &LC : LoadCmdStorage) {
+        const auto DyldInfo = dyn_cast<MachO::DyldInfoCommand>(LC, IsBigEndian);
+        if (DyldInfo != nullptr) {
+            return DyldInfo;
+        }
+    }
+
+    return nullptr;
+}
+
+// Everything needed to collect the entries of every section of a Mach-O
+// file, or of an image of a dyld_shared_cache.
+
+struct DiffImage {
+    const MachOMemoryObject &Object;
+    const DscImageMemoryObject *DscImage = nullptr;
+
+    const MachO::ConstLoadCommandStorage &LoadCmdStorage;
+    const MachO::SegmentInfoCollection &SegmentCollection;
+    const MachO::SharedLibraryInfoCollection &LibraryCollection;
+
+    // Offsets in load-commands of a dyld_shared_cache image are relative to
+    // the start of the shared-cache.
+
+    [[nodiscard]] inline auto getMap() const noexcept -> ConstMemoryMap {
+        if (DscImage != nullptr) {
+            return DscImage->getDscMap();
+        }
+
+        return Object.getMap();
+    }
+};
+
+static void
+CollectHeaderItems(const DiffImage &Image,
+                   std::vector<DiffItem> &ListOut) noexcept
+{
+    const auto &Object = Image.Object;
+    const auto CpuKind = Object.getCpuKind();
+    const auto FileKind = Object.getFileKind();
+
+    ListOut.emplace_back(DiffItem {
+        .Name = "cpu-kind",
+        .Value =
+            std::string(Mach::CpuKindGetName(CpuKind).value_or("Unknown"))
+    });
+
+    ListOut.emplace_back(DiffItem {
+        .Name = "cpu-subkind",
+        .Value = std::to_string(Object.getCpuSubKind())
+    });
+
+    ListOut.emplace_back(DiffItem {
+        .Name = "file-kind",
+        .Value =
+            std::string(
+                MachO::Header::FileKindGetName(FileKind).value_or("Unknown"))
+    });
+
+    ListOut.emplace_back(DiffItem {
+        .Name = "flags",
+        .Value = std::format("{:#x}", Object.getHeaderFlags().value())
+    });
+
+    ListOut.emplace_back(DiffItem {
+        .Name = "load-command-count",
+        .Value = std::to_string(Object.getLoadCommandsCount())
+    });
+
+    ListOut.emplace_back(DiffItem {
+        .Name = "load-commands-size",
+        .Value = std::to_string(Object.getLoadCommandsSize())
+    });
+
+    if (const auto Uuid = FindUuidCommand(Image.LoadCmdStorage)) {
+        ListOut.emplace_back(DiffItem {
+            .Name = "uuid",
+            .Value = GetUuidString(Uuid->Uuid)
+        });
+    }
+}
+
+static void
+CollectLoadCommandItems(const DiffImage &Image,
+                        std::vector<DiffItem> &ListOut) noexcept
+{
+    // Load-commands are compared by kind, as their order and amount rarely
+    // changes between builds, while their contents almost always do.
+
+    struct LoadCommandCount {
+        uint32_t Count = 0;
+        uint64_t Size = 0;
+    };
+
+    const auto IsBigEndian = Image.LoadCmdStorage.isBigEndian();
+    auto CountMap = std::map<std::string, LoadCommandCount>();
+
+    for (const auto &LC : Image.LoadCmdStorage) {
+        const auto Kind = LC.getKind(IsBigEndian);
+        const auto KindName = MachO::LoadCommand::KindGetName(Kind);
+        const auto Name =
+            KindName.has_value() ?
+                std::string(KindName.value()) :
+                std::format("{:#x}", static_cast<uint32_t>(Kind));
+
+        auto &Count = CountMap[Name];
+
+        Count.Count++;
+        Count.Size += LC.getCmdSize(IsBigEndian);
+    }
+
+    for (const auto &[Name, Count] : CountMap) {
+        ListOut.emplace_back(DiffItem {
+            .Name = Name,
+            .Value = std::format("{} ({} bytes)", Count.Count, Count.Size)
+        });
+    }
+}
+
+static void
+CollectLibraryItems(const DiffImage &Image,
+                    std::vector<DiffItem> &ListOut) noexcept
+{
+    for (const auto &Library : Image.LibraryCollection) {
+        const auto KindName =
+            MachO::LoadCommand::KindGetName(Library.getKind());
+
+        ListOut.emplace_back(DiffItem {
+            .Name = std::string(Library.getPath()),
+            .Value =
+                std::format("{}, current-version {}, compat-version {}",
+                            KindName.value_or("Unknown"),
+                            GetVersionString(Library.getCurrentVersion()),
+                            GetVersionString(Library.getCompatVersion()))
+        });
+    }
+}
+
+static void
+CollectExportItems(const DiffImage &Image,
+                   std::vector<DiffItem> &ListOut) noexcept
+{
+    // Offsets of exports almost always change between builds, so only
+    // compare the kind of each export.
+
+    const auto Index =
+        OperationCommon::GetExportIndex(Image.getMap(), Image.LoadCmdStorage);
+
+    ListOut.reserve(Index.size());
+    for (const auto &Entry : Index) {
+        const auto &Export = Entry.Value;
+        const auto KindName =
+            MachO::ExportTrieExportKindGetName(Export.Kind).value_or("Unknown");
+
+        auto Value = std::string(KindName);
+        if (Export.Kind == MachO::ExportTrieExportKind::Reexport) {
+            const auto Ordinal = Export.ReexportDylibOrdinal;
+            const auto Library =
+                (Ordinal != 0) ?
+                    Image.LibraryCollection.atOrdinalOrNull(Ordinal) :
+                    nullptr;
+
+            if (Library != nullptr) {
+                Value += std::format(" from {}", Library->getPath());
+            }
+
+            if (!Export.ReexportImportName.empty()) {
+                Value += std::format(" as {}", Export.ReexportImportName);
+            }
+        }
+
+        ListOut.emplace_back(DiffItem {
+            .Name = std::string(Entry.Key),
+            .Value = std::move(Value)
+        });
+    }
+}
+
+[[nodiscard]] static std::string
+GetBindLibraryName(const DiffImage &Image, const int64_t DylibOrdinal) noexcept
+{
+    if (DylibOrdinal > 0) {
+        const auto Library =
+            Image.LibraryCollection.atOrdinalOrNull(
+                static_cast<uint64_t>(DylibOrdinal));
+
+        if (Library != nullptr) {
+            return std::string(Library->getPath());
+        }
+
+        return std::format("ordinal {}", DylibOrdinal);
+    }
+
+    const auto SpecialName =
+        MachO::BindByteDylibSpecialOrdinalGetName(
+            static_cast<MachO::BindByteDylibSpecialOrdinal>(DylibOrdinal));
+
+    if (SpecialName.has_value()) {
+        return std::string(SpecialName.value());
+    }
+
+    return std::format("ordinal {}", DylibOrdinal);
+}
+
+static void
+CollectBindItems(const DiffImage &Image,
+                 std::vector<DiffItem> &ListOut) noexcept
+{
+    const auto DyldInfo = FindDyldInfoCommand(Image.LoadCmdStorage);
+    if (DyldInfo == nullptr) {
+        return;
+    }
+
+    const auto Map = Image.getMap();
+    const auto IsBigEndian = Image.Object.isBigEndian();
+    const auto Is64Bit = Image.Object.is64Bit();
+
+    auto ActionList = std::vector<MachO::BindActionInfo>();
+    const auto AddList = [&](const auto &ListOpt) noexcept {
+        if (ListOpt.getError() != MachO::SizeRangeError::None) {
+            return;
+        }
+
+        ActionList.clear();
+        static_cast<void>(ListOpt.value()->GetAsList(ActionList));
+
+        for (const auto &Action : ActionList) {
+            auto Value = std::string(GetBindKindName(Action.Kind));
+            if (Action.Kind != MachO::BindInfoKind::Weak) {
+                Value += " from ";
+                Value += GetBindLibraryName(Image, Action.DylibOrdinal);
+            }
+
+            ListOut.emplace_back(DiffItem {
+                .Name = std::string(Action.SymbolName),
+                .Value = std::move(Value)
+            });
+        }
+    };
+
+    const auto &SegmentCollection = Image.SegmentCollection;
+
+    AddList(DyldInfo->GetBindActionList(Map,
+                                        SegmentCollection,
+                                        IsBigEndian,
+                                        Is64Bit));
+    AddList(DyldInfo->GetLazyBindActionList(Map,
+                                            SegmentCollection,
+                                            IsBigEndian,
+                                            Is64Bit));
+    AddList(DyldInfo->GetWeakBindActionList(Map,
+                                            SegmentCollection,
+                                            IsBigEndian,
+                                            Is64Bit));
+}
+
+template <typename EntryList>
+static void
+AddSymbolItems(const EntryList &List,
+               const std::string_view StringTable,
+               const bool IsBigEndian,
+               std::vector<DiffItem> &ListOut) noexcept
+{
+    for (const auto &Entry : List) {
+        if (Entry.Info.isDebugSymbol()) {
+            continue;
+        }
+
+        const auto Index = SwitchEndianIf(Entry.Index, IsBigEndian);
+        if (Index >= StringTable.length()) {
+            continue;
+        }
+
+        const auto Rest = StringTable.substr(Index);
+        const auto Name = Rest.substr(0, Rest.find('\0'));
+
+        if (Name.empty()) {
+            continue;
+        }
+
+        const auto KindDesc =
+            MachO::SymbolTableEntrySymbolKindGetDesc(Entry.Info.getKind());
+
+        auto Value = std::string(KindDesc.value_or("Unknown"));
+        if (Entry.Info.isPrivateExternal()) {
+            Value += ", private-external";
+        } else if (Entry.Info.isExternal()) {
+            Value += ", external";
+        }
+
+        ListOut.emplace_back(DiffItem {
+            .Name = std::string(Name),
+            .Value = std::move(Value)
+        });
+    }
+}
+
+// Local-symbols of an image in a dyld_shared_cache are stripped from its
+// symbol-table. Only local-symbols stored in the cache itself are compared,
+// as the cache's .symbols file isn't available here.
+
+static void
+CollectCacheLocalSymbolItems(const DscImageMemoryObject &Image,
+                             std::vector<DiffItem> &ListOut) noexcept
+{
+    auto Error = DyldSharedCache::LocalSymbolsTable::Error::None;
+    const auto Table =
+        DyldSharedCache::LocalSymbolsTable::OpenForCache(Image.getDscMap(),
+                                                         nullptr,
+                                                         Image.is64Bit(),
+                                                         &Error);
+
+    if (!Table.has_value()) {
+        return;
+    }
+
+    const auto MappingList = Image.getDscHeaderV0().getConstMappingInfoList();
+    const auto Slice =
+        Table->GetSliceForImage(Image.getAddress() -
+                                MappingList.front().Address);
+
+    if (Slice == nullptr) {
+        return;
+    }
+
+    if (Table->is64Bit()) {
+        AddSymbolItems(Table->GetEntry64List(*Slice),
+                       Table->getStringTable(),
+                       false,
+                       ListOut);
+    } else {
+        AddSymbolItems(Table->GetEntry32List(*Slice),
+                       Table->getStringTable(),
+                       false,
+                       ListOut);
+    }
+}
+
+static void
+CollectSymbolItems(const DiffImage &Image,
+                   std::vector<DiffItem> &ListOut) noexcept
+{
+    const auto IsBigEndian = Image.Object.isBigEndian();
+    const auto *SymTab = static_cast<const MachO::SymTabCommand *>(nullptr);
+
+    for (const auto &LC : Image.LoadCmdStorage) {
+        SymTab = dyn_cast<MachO::SymTabCommand>(LC, IsBigEndian);
+        if (SymTab != nullptr) {
+            break;
+        }
+    }
+
+    if (SymTab == nullptr) {
+        return;
+    }
+
+    const auto Map = Image.getMap();
+    const auto StrOff = SymTab->getStringTableOffset(IsBigEndian);
+    const auto StrSize = SymTab->getStringTableSize(IsBigEndian);
+
+    auto StrEnd = uint64_t();
+    if (DoesAddOverflow(StrOff, StrSize, &StrEnd) ||
+        StrEnd > Map.getRange().getEnd())
+    {
+        return;
+    }
+
+    const auto StringTable =
+        std::string_view(reinterpret_cast<const char *>(Map.getBegin()) +
+                            StrOff,
+                         StrSize);
+
+    if (Image.Object.is64Bit()) {
+        const auto List = SymTab->GetConstEntry64List(Map, IsBigEndian);
+        if (List.getError() == MachO::SizeRangeError::None) {
+            AddSymbolItems(*List.value(), StringTable, IsBigEndian, ListOut);
+        }
+    } else {
+        const auto List = SymTab->GetConstEntry32List(Map, IsBigEndian);
+        if (List.getError() == MachO::SizeRangeError::None) {
+            AddSymbolItems(*List.value(), StringTable, IsBigEndian, ListOut);
+        }
+    }
+
+    if (Image.DscImage != nullptr) {
+        CollectCacheLocalSymbolItems(*Image.DscImage, ListOut);
+    }
+}
+
+static void
+AddObjcClassItems(const MachO::ObjcClassInfoCollection &Collection,
+                  std::vector<DiffItem> &ListOut) noexcept
+{
+    for (const auto &Class : Collection.GetAsList()) {
+        if (Class->isNull() || Class->isExternal()) {
+            continue;
+        }
+
+        const auto Super = Class->getSuper();
+        const auto SuperName =
+            (Super != nullptr && !Super->getName().empty()) ?
+                Super->getName() : std::string_view("<root>");
+
+        ListOut.emplace_back(DiffItem {
+            .Name = std::string(Class->getName()),
+            .Value = std::format("super-class {}", SuperName)
+        });
+    }
+}
+
+static void
+CollectObjcClassItems(const DiffImage &Image,
+                      std::vector<DiffItem> &ListOut) noexcept
+{
+    const auto Map = Image.getMap();
+    const auto IsBigEndian = Image.Object.isBigEndian();
+    const auto Is64Bit = Image.Object.is64Bit();
+
+    using BindListType =
+        ExpectedAlloc<MachO::BindActionList, MachO::SizeRangeError>;
+    using LazyBindListType =
+        ExpectedAlloc<MachO::LazyBindActionList, MachO::SizeRangeError>;
+    using WeakBindListType =
+        ExpectedAlloc<MachO::WeakBindActionList, MachO::SizeRangeError>;
+
+    auto BindListOpt = BindListType(MachO::SizeRangeError::Empty);
+    auto LazyBindListOpt = LazyBindListType(MachO::SizeRangeError::Empty);
+    auto WeakBindListOpt = WeakBindListType(MachO::SizeRangeError::Empty);
+
+    const auto &SegmentCollection = Image.SegmentCollection;
+    if (const auto DyldInfo = FindDyldInfoCommand(Image.LoadCmdStorage)) {
+        BindListOpt =
+            DyldInfo->GetBindActionList(Map,
+                                        SegmentCollection,
+                                        IsBigEndian,
+                                        Is64Bit);
+        LazyBindListOpt =
+            DyldInfo->GetLazyBindActionList(Map,
+                                            SegmentCollection,
+                                            IsBigEndian,
+                                            Is64Bit);
+        WeakBindListOpt =
+            DyldInfo->GetWeakBindActionList(Map,
+                                            SegmentCollection,
+                                            IsBigEndian,
+                                            Is64Bit);
+    }
+
+    const auto GetList = [](const auto &ListOpt) noexcept {
+        return (ListOpt.getError() == MachO::SizeRangeError::None) ?
+            ListOpt.value() : nullptr;
+    };
+
+    const auto BindList = GetList(BindListOpt);
+    const auto LazyBindList = GetList(LazyBindListOpt);
+    const auto WeakBindList = GetList(WeakBindListOpt);
+
+    auto Error = MachO::ObjcClassInfoCollection::Error::None;
+    auto ParseError = MachO::BindOpcodeParseError::None;
+    auto CollectionError = MachO::BindActionCollection::Error::None;
+
+    if (const auto DscImage = Image.DscImage) {
+        const auto MappingList =
+            DscImage->getDscHeaderV0().getConstMappingInfoList();
+        const auto DeVirtualizer =
+            DscImage::ConstDeVirtualizer(Map,
+                                         MappingList,
+                                         DscImage->getRebasedView());
+
+        const auto Collection =
+            DscImage::ObjcClassInfoCollection::Open(Map,
+                                                    DscImage->getMap(),
+                                                    SegmentCollection,
+                                                    DeVirtualizer,
+                                                    BindList,
+                                                    LazyBindList,
+                                                    WeakBindList,
+                                                    IsBigEndian,
+                                                    Is64Bit,
+                                                    &Error,
+                                                    &ParseError,
+                                                    &CollectionError);
+
+        AddObjcClassItems(Collection, ListOut);
+        return;
+    }
+
+    const auto DeVirtualizer =
+        MachO::ConstDeVirtualizer(Map, SegmentCollection);
+    const auto Collection =
+        MachO::ObjcClassInfoCollection::Open(Map,
+                                             SegmentCollection,
+                                             DeVirtualizer,
+                                             BindList,
+                                             LazyBindList,
+                                             WeakBindList,
+                                             IsBigEndian,
+                                             Is64Bit,
+                                             &Error,
+                                             &ParseError,
+                                             &CollectionError);
+
+    AddObjcClassItems(Collection, ListOut);
+}
+
+// Sorts both lists, and walks them together, adding an entry for every name
+// only in one list, or in both with different values.
+//
+// Entries found in both lists with the same name and value are dropped
+// before pairing, so that names appearing multiple times only have their
+// changed values paired, in order of their values.
+
+static void
+DiffItemLists(const SectionKind Section,
+              std::vector<DiffItem> &OldList,
+              std::vector<DiffItem> &NewList,
+              std::vector<DiffEntry> &EntryListOut) noexcept
+{
+    const auto Comparator = [](const DiffItem &Lhs, const DiffItem &Rhs) {
+        if (const auto Compare = Lhs.Name.compare(Rhs.Name)) {
+            return Compare < 0;
+        }
+
+        return Lhs.Value < Rhs.Value;
+    };
+
+    const auto IsEqual = [](const DiffItem &Lhs, const DiffItem &Rhs) {
+        return Lhs.Name == Rhs.Name && Lhs.Value == Rhs.Value;
+    };
+
+    ParallelSort(OldList.begin(), OldList.end(), Comparator);
+    ParallelSort(NewList.begin(), NewList.end(), Comparator);
+
+    OldList.erase(std::unique(OldList.begin(), OldList.end(), IsEqual),
+                  OldList.end());
+    NewList.erase(std::unique(NewList.begin(), NewList.end(), IsEqual),
+                  NewList.end());
+
+    // Keeps the entry at Iter by moving it down to Out, as entries before it
+    // may have been dropped.
+
+    const auto Keep = [](auto &Out, auto &Iter) noexcept {
+        if (Out != Iter) {
+            *Out = std::move(*Iter);
+        }
+
+        Out++;
+        Iter++;
+    };
+
+    auto OldIter = OldList.begin();
+    auto NewIter = NewList.begin();
+    auto OldOut = OldList.begin();
+    auto NewOut = NewList.begin();
+
+    while (OldIter != OldList.end() && NewIter != NewList.end()) {
+        if (Comparator(*OldIter, *NewIter)) {
+            Keep(OldOut, OldIter);
+        } else if (Comparator(*NewIter, *OldIter)) {
+            Keep(NewOut, NewIter);
+        } else {
+            OldIter++;
+            NewIter++;
+        }
+    }
+
+    while (OldIter != OldList.end()) {
+        Keep(OldOut, OldIter);
+    }
+
+    while (NewIter != NewList.end()) {
+        Keep(NewOut, NewIter);
+    }
+
+    OldList.erase(OldOut, OldList.end());
+    NewList.erase(NewOut, NewList.end());
+
+    OldIter = OldList.begin();
+    NewIter = NewList.begin();
+
+    const auto OldEnd = OldList.end();
+    const auto NewEnd = NewList.end();
+
+    while (OldIter != OldEnd || NewIter != NewEnd) {
+        const auto Compare =
+            (OldIter == OldEnd) ? 1 :
+            (NewIter == NewEnd) ? -1 :
+                OldIter->Name.compare(NewIter->Name);
+
+        if (Compare < 0) {
+            EntryListOut.emplace_back(DiffEntry {
+                .Section = Section,
+                .Change = ChangeKind::Removed,
+                .Name = std::move(OldIter->Name),
+                .OldValue = std::move(OldIter->Value),
+                .NewValue = std::string()
+            });
+
+            OldIter++;
+        } else if (Compare > 0) {
+            EntryListOut.emplace_back(DiffEntry {
+                .Section = Section,
+                .Change = ChangeKind::Added,
+                .Name = std::move(NewIter->Name),
+                .OldValue = std::string(),
+                .NewValue = std::move(NewIter->Value)
+            });
+
+            NewIter++;
+        } else {
+            if (OldIter->Value != NewIter->Value) {
+                EntryListOut.emplace_back(DiffEntry {
+                    .Section = Section,
+                    .Change = ChangeKind::Changed,
+                    .Name = std::move(NewIter->Name),
+                    .OldValue = std::move(OldIter->Value),
+                    .NewValue = std::move(NewIter->Value)
+                });
+            }
+
+            OldIter++;
+            NewIter++;
+        }
+    }
+}
+
+[[nodiscard]] static bool
+CollectItemLists(const MachOMemoryObject &Object,
+                 const struct PrintDiffOperation::Options &Options,
+                 DiffItemListList &ListListOut) noexcept
+{
+    const auto LoadCmdStorage = Object.GetLoadCommandsStorage();
+    if (LoadCmdStorage.hasError()) {
+        return false;
+    }
+
+    auto SegmentCollectionError = MachO::SegmentInfoCollection::Error::None;
+    const auto SegmentCollection =
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
+                                           Object.is64Bit(),
+                                           &SegmentCollectionError);
+
+    auto LibraryCollectionError =
+        MachO::SharedLibraryInfoCollection::Error::None;
+
+    const auto LibraryCollection =
+        MachO::SharedLibraryInfoCollection::Open(LoadCmdStorage,
+                                                 &LibraryCollectionError);
+
+    const auto Image = DiffImage {
+        .Object = Object,
+        .DscImage = dyn_cast<ObjectKind::DscImage>(&Object),
+        .LoadCmdStorage = LoadCmdStorage,
+        .SegmentCollection = SegmentCollection,
+        .LibraryCollection = LibraryCollection
+    };
+
+    const auto GetList = [&](const SectionKind Kind) noexcept -> auto & {
+        return ListListOut[static_cast<uint32_t>(Kind)];
+    };
+
+    if (Options.hasSection(SectionKind::Header)) {
+        CollectHeaderItems(Image, GetList(SectionKind::Header));
+    }
+
+    if (Options.hasSection(SectionKind::LoadCommands)) {
+        CollectLoadCommandItems(Image, GetList(SectionKind::LoadCommands));
+    }
+
+    if (Options.hasSection(SectionKind::Libraries)) {
+        CollectLibraryItems(Image, GetList(SectionKind::Libraries));
+    }
+
+    if (Options.hasSection(SectionKind::Exports)) {
+        CollectExportItems(Image, GetList(SectionKind::Exports));
+    }
+
+    if (Options.hasSection(SectionKind::Binds)) {
+        CollectBindItems(Image, GetList(SectionKind::Binds));
+    }
+
+    if (Options.hasSection(SectionKind::Symbols)) {
+        CollectSymbolItems(Image, GetList(SectionKind::Symbols));
+    }
+
+    if (Options.hasSection(SectionKind::ObjcClasses)) {
+        CollectObjcClassItems(Image, GetList(SectionKind::ObjcClasses));
+    }
+
+    return true;
+}
+
+static void
+DiffItemListLists(DiffItemListList &OldListList,
+                  DiffItemListList &NewListList,
+                  std::vector<DiffEntry> &EntryListOut) noexcept
+{
+    for (auto I = uint32_t(); I != PrintDiffOperation::SectionCount; I++) {
+        DiffItemLists(static_cast<SectionKind>(I),
+                      OldListList[I],
+                      NewListList[I],
+                      EntryListOut);
+    }
+}
+
+static void
+WriteEntryRecords(RecordWriter &Writer,
+                  const std::string_view ImagePath,
+                  const std::vector<DiffEntry> &EntryList) noexcept
+{
+    for (const auto &Entry : EntryList) {
+        Writer.beginRecord();
+        if (!ImagePath.empty()) {
+            Writer.writeString("image", ImagePath);
+        }
+
+        Writer.writeString("section", GetSectionName(Entry.Section));
+        Writer.writeString("change", GetChangeName(Entry.Change));
+        Writer.writeString("name", Entry.Name);
+
+        if (Entry.Change != ChangeKind::Added) {
+            Writer.writeString("old", Entry.OldValue);
+        } else {
+            Writer.writeNull("old");
+        }
+
+        if (Entry.Change != ChangeKind::Removed) {
+            Writer.writeString("new", Entry.NewValue);
+        } else {
+            Writer.writeNull("new");
+        }
+
+        Writer.endRecord();
+    }
+}
+
+static void
+PrintEntryList(const std::vector<DiffEntry> &EntryList,
+               const char *const LinePrefix,
+               const struct PrintDiffOperation::Options &Options) noexcept
+{
+    auto Section = std::optional<SectionKind>();
+    for (const auto &Entry : EntryList) {
+        if (Section != Entry.Section) {
+            fprintf(Options.OutFile,
+                    "%s%s:\n",
+                    LinePrefix,
+                    GetSectionDescription(Entry.Section).data());
+
+            Section = Entry.Section;
+        }
+
+        switch (Entry.Change) {
+            case ChangeKind::Added:
+                fprintf(Options.OutFile,
+                        "%s\t+ \"%s\"",
+                        LinePrefix,
+                        Entry.Name.c_str());
+
+                if (Options.Verbose) {
+                    fprintf(Options.OutFile,
+                            " (%s)",
+                            Entry.NewValue.c_str());
+                }
+
+                break;
+            case ChangeKind::Removed:
+                fprintf(Options.OutFile,
+                        "%s\t- \"%s\"",
+                        LinePrefix,
+                        Entry.Name.c_str());
+
+                if (Options.Verbose) {
+                    fprintf(Options.OutFile,
+                            " (%s)",
+                            Entry.OldValue.c_str());
+                }
+
+                break;
+            case ChangeKind::Changed:
+                fprintf(Options.OutFile,
+                        "%s\t~ \"%s\": %s -> %s",
+                        LinePrefix,
+                        Entry.Name.c_str(),
+                        Entry.OldValue.c_str(),
+                        Entry.NewValue.c_str());
+                break;
+        }
+
+        fputc('\n', Options.OutFile);
+    }
+}
+
+static int
+DiffMachOObjects(const MachOMemoryObject &OldObject,
+                 const MachOMemoryObject &NewObject,
+                 const struct PrintDiffOperation::Options &Options) noexcept
+{
+    auto OldListList = DiffItemListList();
+    auto NewListList = DiffItemListList();
+
+    if (!CollectItemLists(OldObject, Options, OldListList)) {
+        fputs("Old file has invalid load-commands\n", Options.ErrFile);
+        return 1;
+    }
+
+    if (!CollectItemLists(NewObject, Options, NewListList)) {
+        fputs("Provided file has invalid load-commands\n", Options.ErrFile);
+        return 1;
+    }
+
+    auto EntryList = std::vector<DiffEntry>();
+    DiffItemListLists(OldListList, NewListList, EntryList);
+
+    if (Options.isRecordFormat()) {
+        auto Writer = Options.GetRecordWriter();
+
+        Writer.beginList();
+        WriteEntryRecords(Writer, std::string_view(), EntryList);
+        Writer.endList();
+
+        return 0;
+    }
+
+    if (EntryList.empty()) {
+        fputs("Provided files have no differences\n", Options.OutFile);
+        return 0;
+    }
+
+    PrintEntryList(EntryList, "", Options);
+    return 0;
+}
+
+struct DscImageEntry {
+    std::string_view Path;
+    uint32_t Index;
+};
+
+// Lists the first image-info of every image, as aliases share the contents
+// of their image, sorted by path.
+
+[[nodiscard]] static std::vector<DscImageEntry>
+GetSortedImageList(const DscMemoryObject &Object) noexcept {
+    const auto Map = Object.getMap().getBegin();
+    const auto ImageCount = Object.getImageCount();
+
+    auto Result = std::vector<DscImageEntry>();
+    auto AddressSet = std::unordered_set<uint64_t>();
+
+    Result.reserve(ImageCount);
+    AddressSet.reserve(ImageCount);
+
+    for (auto Index = uint32_t(); Index != ImageCount; Index++) {
+        const auto &Info = Object.getImageInfoAtIndex(Index);
+        if (!AddressSet.insert(Info.Address).second) {
+            continue;
+        }
+
+        Result.emplace_back(DscImageEntry {
+            .Path = Info.getPath(Map),
+            .Index = Index
+        });
+    }
+
+    std::sort(Result.begin(),
+              Result.end(),
+              [](const DscImageEntry &Lhs, const DscImageEntry &Rhs) noexcept {
+                  return Lhs.Path < Rhs.Path;
+              });
+
+    return Result;
+}
+
+struct DscImagePair {
+    std::string_view Path;
+
+    uint32_t OldIndex;
+    uint32_t NewIndex;
+
+    std::vector<DiffEntry> EntryList;
+
+    bool Failed : 1 = false;
+    bool Skipped : 1 = false;
+};
+
+static void
+DiffDscImagePair(const DscMemoryObject &OldObject,
+                 const DscMemoryObject &NewObject,
+                 DscImagePair &Pair,
+                 const struct PrintDiffOperation::Options &Options) noexcept
+{
+    const auto OldImageOrError =
+        OldObject.GetImageWithInfo(
+            OldObject.getImageInfoAtIndex(Pair.OldIndex));
+    const auto NewImageOrError =
+        NewObject.GetImageWithInfo(
+            NewObject.getImageInfoAtIndex(Pair.NewIndex));
+
+    if (OldImageOrError.hasError() || NewImageOrError.hasError()) {
+        if (!OldImageOrError.hasError()) {
+            delete OldImageOrError.value();
+        }
+
+        if (!NewImageOrError.hasError()) {
+            delete NewImageOrError.value();
+        }
+
+        Pair.Failed = true;
+        return;
+    }
+
+    const auto OldImage =
+        std::unique_ptr<const DscImageMemoryObject>(OldImageOrError.value());
+    const auto NewImage =
+        std::unique_ptr<const DscImageMemoryObject>(NewImageOrError.value());
+
+    const auto OldLoadCmdStorage = OldImage->GetLoadCommandsStorage();
+    const auto NewLoadCmdStorage = NewImage->GetLoadCommandsStorage();
+
+    if (OldLoadCmdStorage.hasError() || NewLoadCmdStorage.hasError()) {
+        Pair.Failed = true;
+        return;
+    }
+
+    // Images with the same uuid were built from the same sources, so skip
+    // them without collecting any of their entries.
+
+    const auto OldUuid = FindUuidCommand(OldLoadCmdStorage);
+    const auto NewUuid = FindUuidCommand(NewLoadCmdStorage);
+
+    if (OldUuid != nullptr && NewUuid != nullptr) {
+        if (memcmp(OldUuid->Uuid, NewUuid->Uuid, sizeof(OldUuid->Uuid)) == 0) {
+            Pair.Skipped = true;
+            return;
+        }
+    }
+
+    auto OldListList = DiffItemListList();
+    auto NewListList = DiffItemListList();
+
+    if (!CollectItemLists(*OldImage, Options, OldListList) ||
+        !CollectItemLists(*NewImage, Options, NewListList))
+    {
+        Pair.Failed = true;
+        return;
+    }
+
+    DiffItemListLists(OldListList, NewListList, Pair.EntryList);
+}
+
+static int
+DiffDscObjects(const DscMemoryObject &OldObject,
+               const DscMemoryObject &NewObject,
+               const struct PrintDiffOperation::Options &Options) noexcept
+{
+    auto OldImageList = GetSortedImageList(OldObject);
+    auto NewImageList = GetSortedImageList(NewObject);
+
+    // Match images by path, with unmatched images being added or removed.
+
+    auto ImageEntryList = std::vector<DiffEntry>();
+    auto PairList = std::vector<DscImagePair>();
+
+    auto OldIter = OldImageList.cbegin();
+    auto NewIter = NewImageList.cbegin();
+
+    const auto OldEnd = OldImageList.cend();
+    const auto NewEnd = NewImageList.cend();
+
+    while (OldIter != OldEnd || NewIter != NewEnd) {
+        const auto Compare =
+            (OldIter == OldEnd) ? 1 :
+            (NewIter == NewEnd) ? -1 :
+                OldIter->Path.compare(NewIter->Path);
+
+        if (Compare < 0) {
+            ImageEntryList.emplace_back(DiffEntry {
+                .Section = SectionKind::Images,
+                .Change = ChangeKind::Removed,
+                .Name = std::string(OldIter->Path),
+                .OldValue = std::string(),
+                .NewValue = std::string()
+            });
+
+            OldIter++;
+        } else if (Compare > 0) {
+            ImageEntryList.emplace_back(DiffEntry {
+                .Section = SectionKind::Images,
+                .Change = ChangeKind::Added,
+                .Name = std::string(NewIter->Path),
+                .OldValue = std::string(),
+                .NewValue = std::string()
+            });
+
+            NewIter++;
+        } else {
+            PairList.emplace_back(DscImagePair {
+                .Path = NewIter->Path,
+                .OldIndex = OldIter->Index,
+                .NewIndex = NewIter->Index,
+                .EntryList = std::vector<DiffEntry>()
+            });
+
+            OldIter++;
+            NewIter++;
+        }
+    }
+
+    if (!Options.hasSection(SectionKind::Images)) {
+        ImageEntryList.clear();
+    }
+
+    const auto PairCount = static_cast<uint32_t>(PairList.size());
+    auto NextIndex = std::atomic<uint32_t>();
+
+    const auto DiffPairs = [&]() noexcept {
+        for (auto Index = NextIndex++; Index < PairCount; Index = NextIndex++) {
+            DiffDscImagePair(OldObject, NewObject, PairList[Index], Options);
+        }
+    };
+
+    if (PairCount != 0) {
+        const auto ThreadCount =
+            std::clamp(std::thread::hardware_concurrency(), 1u, PairCount);
+
+        auto ThreadList = std::vector<std::thread>();
+        ThreadList.reserve(ThreadCount - 1);
+
+        for (auto I = 1u; I != ThreadCount; I++) {
+            ThreadList.emplace_back(DiffPairs);
+        }
+
+        DiffPairs();
+        for (auto &Thread : ThreadList) {
+            Thread.join();
+        }
+    }
+
+    // Images with different uuids but without any differences are still
+    // counted as identical.
+
+    auto FailedCount = uint32_t();
+    auto IdenticalCount = uint32_t();
+    auto ChangedCount = uint32_t();
+
+    for (const auto &Pair : PairList) {
+        if (Pair.Failed) {
+            FailedCount++;
+        } else if (Pair.Skipped || Pair.EntryList.empty()) {
+            IdenticalCount++;
+        } else {
+            ChangedCount++;
+        }
+    }
+
+    if (FailedCount != 0) {
+        fprintf(Options.ErrFile,
+                "Warning: Skipped %" PRIu32 " images that could not be "
+                "parsed\n",
+                FailedCount);
+    }
+
+    if (Options.isRecordFormat()) {
+        auto Writer = Options.GetRecordWriter();
+
+        Writer.beginList();
+        WriteEntryRecords(Writer, std::string_view(), ImageEntryList);
+
+        for (const auto &Pair : PairList) {
+            WriteEntryRecords(Writer, Pair.Path, Pair.EntryList);
+        }
+
+        Writer.endList();
+        return 0;
+    }
+
+    PrintEntryList(ImageEntryList, "", Options);
+    for (const auto &Pair : PairList) {
+        if (Pair.EntryList.empty()) {
+            continue;
+        }
+
+        fprintf(Options.OutFile,
+                "Image \"" STRING_VIEW_FMT "\":\n",
+                STRING_VIEW_FMT_ARGS(Pair.Path));
+        PrintEntryList(Pair.EntryList, "\t", Options);
+    }
+
+    fprintf(Options.OutFile,
+            "%" PRIuPTR " Images matched, %" PRIu32 " changed, %" PRIu32
+            " identical\n",
+            PairList.size(),
+            ChangedCount,
+            IdenticalCount);
+
+    return 0;
+}
+
+int
+PrintDiffOperation::Run(const MachOMemoryObject &Object,
+                        const MemoryObject &OldObject,
+                        const struct Options &Options) noexcept
+{
+    switch (OldObject.getKind()) {
+        case ObjectKind::None:
+            assert(0 && "Object-Kind is None");
+        case ObjectKind::MachO:
+        case ObjectKind::DscImage:
+            return DiffMachOObjects(static_cast<const MachOMemoryObject &>(
+                                        OldObject),
+                                    Object,
+                                    Options);
+        case ObjectKind::FatMachO:
+            fputs("Old file is a FAT Mach-O File, which is not supported\n",
+                  Options.ErrFile);
+            return 1;
+        case ObjectKind::DyldSharedCache:
+            break;
+    }
+
+    // Compare an image of a shared-cache with the image at the same path in
+    // the old shared-cache.
+
+    const auto Image = dyn_cast<ObjectKind::DscImage>(&Object);
+    if (Image == nullptr) {
+        fputs("Old file is a Dyld Shared-Cache File, while the provided file "
+              "is a Mach-O File\n",
+              Options.ErrFile);
+        return 1;
+    }
+
+    const auto &OldDsc = cast<ObjectKind::DyldSharedCache>(OldObject);
+    const auto Path = Image->getPath();
+    const auto ImageInfo = OldDsc.GetImageInfoWithPath(Path);
+
+    if (ImageInfo == nullptr) {
+        fprintf(Options.ErrFile,
+                "Old file has no image with path \"%s\"\n",
+                Path);
+        return 1;
+    }
+
+    const auto OldImageOrError = OldDsc.GetImageWithInfo(*ImageInfo);
+    if (OldImageOrError.hasError()) {
+        fprintf(Options.ErrFile,
+                "Old file's image at path \"%s\" could not be parsed\n",
+                Path);
+        return 1;
+    }
+
+    const auto OldImage =
+        std::unique_ptr<const DscImageMemoryObject>(OldImageOrError.value());
+
+    return DiffMachOObjects(*OldImage, Object, Options);
+}
+
+int
+PrintDiffOperation::Run(const DscMemoryObject &Object,
+                        const MemoryObject &OldObject,
+                        const struct Options &Options) noexcept
+{
+    const auto OldDsc = dyn_cast<ObjectKind::DyldSharedCache>(&OldObject);
+    if (OldDsc == nullptr) {
+        fputs("Provided file is a Dyld Shared-Cache File, while the old file "
+              "is not\n",
+              Options.ErrFile);
+        return 1;
+    }
+
+    return DiffDscObjects(*OldDsc, Object, Options);
+}
+
+[[nodiscard]] static std::optional<SectionKind>
+ParseSectionName(const std::string_view Name) noexcept {
+    for (auto I = uint32_t(); I != PrintDiffOperation::SectionCount; I++) {
+        const auto Kind = static_cast<SectionKind>(I);
+        if (GetSectionName(Kind) == Name) {
+            return Kind;
+        }
+    }
+
+    return std::nullopt;
+}
+
+auto
+PrintDiffOperation::ParseOptionsImpl(const ArgvArray &Argv,
+                                     int *const IndexOut) noexcept
+    -> struct PrintDiffOperation::Options
+{
+    auto Index = int();
+    auto DidSetSections = false;
+
+    struct Options Options;
+    for (const auto &Argument : Argv) {
+        if (strcmp(Argument, "-v") == 0 || strcmp(Argument, "--verbose") == 0) {
+            Options.Verbose = true;
+        } else if (Argument.GetStringView().starts_with("--only=")) {
+            auto List = Argument.GetStringView().substr(LENGTH_OF("--only="));
+            if (!DidSetSections) {
+                Options.SectionMask = 0;
+                DidSetSections = true;
+            }
+
+            while (!List.empty()) {
+                const auto End = List.find(',');
+                const auto Name = List.substr(0, End);
+                const auto Kind = ParseSectionName(Name);
+
+                if (!Kind.has_value()) {
+                    fprintf(Options.ErrFile,
+                            "Unrecognized section \"%.*s\" for option "
+                            "--only\n",
+                            static_cast<int>(Name.length()),
+                            Name.data());
+                    exit(1);
+                }
+
+                Options.SectionMask |= 1u << static_cast<uint32_t>(*Kind);
+                List =
+                    (End != std::string_view::npos) ?
+                        List.substr(End + 1) : std::string_view();
+            }
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
+        } else if (!Argument.isOption()) {
+            // The first path is of the old file, and the second of the file
+            // the operation is run on.
+
+            if (!Options.OldPath.empty()) {
+                break;
+            }
+
+            Options.OldPath = Argument.GetStringView();
+        } else {
+            fprintf(stderr,
+                    "Unrecognized argument for operation %s: %s\n",
+                    OperationKindInfo<OpKind>::Name.data(),
+                    Argument.getString());
+            exit(1);
+        }
+
+        Index++;
+    }
+
+    if (Options.OldPath.empty()) {
+        fputs("Error: Please provide two files to compare\n", Options.ErrFile);
+        exit(1);
+    }
+
+    if (IndexOut != nullptr) {
+        *IndexOut = Index;
+    }
+
+    return Options;
+}
+
+int PrintDiffOperation::ParseOptions(const ArgvArray &Argv) noexcept {
+    auto Index = int();
+    Options = ParseOptionsImpl(Argv, &Index);
+
+    return Index;
+}
+
+int PrintDiffOperation::Run(const MemoryObject &Object) const noexcept {
+    const auto Path = PathUtil::MakeAbsolute(Options.OldPath);
+    const auto Fd =
+        FileDescriptor::Open(Path.data(), FileDescriptor::OpenKind::Read);
+
+    if (Fd.hasError()) {
+        fprintf(Options.ErrFile,
+                "Could not open the old file (at path: %s), error: \"%s\"\n",
+                Path.data(),
+                strerror(errno));
+        return 1;
+    }
+
+    auto FileMapProt = MappedFile::Protections();
+
+    FileMapProt.add(MappedFile::Protections::Flags::Read);
+    FileMapProt.add(MappedFile::Protections::Flags::Write);
+
+    const auto FileMap =
+        MappedFile::Open(Fd, FileMapProt, MappedFile::MapKind::Private);
+
+    if (FileMap.hasError()) {
+        fprintf(Options.ErrFile,
+                "Could not map the old file (at path: %s)\n",
+                Path.data());
+        return 1;
+    }
+
+    const auto OldObjectOrError = MemoryObject::Open(FileMap);
+    if (OldObjectOrError.hasError()) {
+        fprintf(Options.ErrFile,
+                "Old file (at path: %s) is not a valid Mach-O or Dyld "
+                "Shared-Cache File\n",
+                Path.data());
+        return 1;
+    }
+
+    const auto OldObject =
+        std::unique_ptr<const MemoryObject>(OldObjectOrError.value());
+
+    switch (Object.getKind()) {
+        case ObjectKind::None:
+            assert(0 && "Object-Kind is None");
+        case ObjectKind::MachO:
+            return Run(cast<ObjectKind::MachO>(Object), *OldObject, Options);
+        case ObjectKind::DscImage:
+            return Run(cast<ObjectKind::DscImage>(Object), *OldObject, Options);
+        case ObjectKind::DyldSharedCache:
+            return Run(cast<ObjectKind::DyldSharedCache>(Object),
+                       *OldObject,
+                       Options);
+        case ObjectKind::FatMachO:
+            return InvalidObjectKind;
+    }
+
+    assert(0 && "Unrecognized Object-Kind");
+}
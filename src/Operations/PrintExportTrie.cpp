@@ -10,6 +10,7 @@
 #include <cstring>
 
 #include "ADT/DscImage.h"
+#include "ADT/ParallelSort.h"
 
 #include "Operations/Common.h"
 #include "Operations/Operation.h"
@@ -85,7 +86,7 @@ constexpr static auto TabLength = 8;
 
 static void
 PrintTreeExportInfo(
-    const MachO::ExportTrieExportChildNode &Export,
+    const MachO::ExportTrieChildNode &Export,
     const MachO::SharedLibraryInfoCollection &SharedLibraryCollection,
     const int WrittenOut,
     const uint64_t DepthLevel,
@@ -147,20 +148,17 @@ PrintTreeExportInfo(
 }
 
 [[nodiscard]] static uint64_t
-GetSymbolLengthForLongestPrintedLineAndCount(
-    const MachO::ExportTrieEntryCollection &Collection,
-    uint64_t &Count) noexcept
+GetSymbolLengthForLongestPrintedLine(
+    const MachO::ExportTrieEntryCollection &Collection) noexcept
 {
     auto LongestLength = LargestIntHelper();
-
-    const auto End = Collection.end();
-    for (auto Iter = Collection.begin(); Iter != End; Iter++, Count++) {
-        if (!Iter->isExport()) {
+    for (const auto &Node : Collection) {
+        if (!Node.Value.isExport()) {
             continue;
         }
 
         const auto Length =
-            Iter.getPrintLineLength(TabLength) + Iter->getString().length();
+            TabLength * (Node.DepthLevel - 1) + Node.Value.getString().length();
 
         LongestLength = Length;
     }
@@ -183,12 +181,12 @@ HandleTreeOption(
     }
 
     if (!Options.SectionRequirements.empty()) {
-        auto CollectionEnd = EntryCollection.end();
-        for (auto Iter = EntryCollection.begin(); Iter != CollectionEnd;) {
-            const auto ExportNode = Iter->getIfExportNode();
+        const auto ShouldRemove =
+            [&](const MachO::ExportTrieChildNode &Node) noexcept
+        {
+            const auto ExportNode = Node.getIfExportNode();
             if (ExportNode == nullptr) {
-                Iter++;
-                continue;
+                return false;
             }
 
             const auto Kind = ExportNode->getKind();
@@ -206,14 +204,10 @@ HandleTreeOption(
                 }
             }
 
-            if (ExportMeetsRequirements(Kind, Segment, Section, Options)) {
-                Iter++;
-                continue;
-            }
-
-            Iter = EntryCollection.RemoveNode(*Iter.getNode(), true);
-        }
+            return !ExportMeetsRequirements(Kind, Segment, Section, Options);
+        };
 
+        EntryCollection.RemoveIf(ShouldRemove, true);
         if (EntryCollection.empty()) {
             fputs("Provided file has no export-trie after filtering with "
                   "provided requirements\n",
@@ -222,10 +216,7 @@ HandleTreeOption(
         }
     }
 
-    auto Count = uint64_t();
-    const auto LongestLength =
-        GetSymbolLengthForLongestPrintedLineAndCount(EntryCollection, Count);
-
+    const auto Count = static_cast<uint64_t>(EntryCollection.size());
     if (Options.OnlyCount) {
         fprintf(Options.OutFile,
                 "Provided file's export-trie has %" PRIu64 " nodes\n",
@@ -233,14 +224,14 @@ HandleTreeOption(
         return 0;
     }
 
-    if (Options.Sort) {
-        EntryCollection.Sort([](const auto &Lhs, const auto &Rhs) noexcept {
-            const auto &Left =
-                reinterpret_cast<const MachO::ExportTrieChildNode &>(Lhs);
-            const auto &Right =
-                reinterpret_cast<const MachO::ExportTrieChildNode &>(Rhs);
+    const auto LongestLength =
+        GetSymbolLengthForLongestPrintedLine(EntryCollection);
 
-            return (Left.getString() <= Right.getString());
+    if (Options.Sort) {
+        EntryCollection.Sort([](const MachO::ExportTrieChildNode &Lhs,
+                                const MachO::ExportTrieChildNode &Rhs) noexcept
+        {
+            return (Lhs.getString() < Rhs.getString());
         });
     }
 
@@ -248,11 +239,8 @@ HandleTreeOption(
         [&](FILE *const OutFile,
             int WrittenOut,
             uint64_t DepthLevel,
-            const TreeNode &Node) noexcept
+            const MachO::ExportTrieChildNode &Info) noexcept
     {
-        const auto &Info =
-            reinterpret_cast<const MachO::ExportTrieChildNode &>(Node);
-
         WrittenOut += fprintf(OutFile, "\"%s\"", Info.getString().data());
         if (const auto ExportInfo = Info.getIfExportNode()) {
             PrintTreeExportInfo(*ExportInfo,
@@ -366,6 +354,57 @@ PrintExportTrieCount(FILE *const OutFile,
     fputc('\n', OutFile);
 }
 
+static void
+WriteExportRecord(
+    RecordWriter &Writer,
+    const MachO::ExportTrieExportKind Kind,
+    const MachO::ExportTrieExportInfo &Info,
+    const std::string_view String,
+    const std::string_view SegmentName,
+    const std::string_view SectionName,
+    const uint64_t Base,
+    const MachO::SharedLibraryInfoCollection &LibraryCollection) noexcept
+{
+    Writer.beginRecord();
+    if (const auto KindName = MachO::ExportTrieExportKindGetName(Kind)) {
+        Writer.writeString("kind", KindName.value());
+    } else {
+        Writer.writeNull("kind");
+    }
+
+    Writer.writeString("symbol", String);
+    if (Info.isReexport()) {
+        const auto ImportName = Info.getReexportImportName();
+        if (!ImportName.empty()) {
+            Writer.writeString("reexport_name", ImportName);
+        } else {
+            Writer.writeNull("reexport_name");
+        }
+
+        OperationCommon::WriteDylibOrdinalFields(
+            Writer,
+            LibraryCollection,
+            Info.getReexportDylibOrdinal());
+    } else {
+        if (!SegmentName.empty()) {
+            Writer.writeString("segment", SegmentName);
+        } else {
+            Writer.writeNull("segment");
+        }
+
+        if (!SectionName.empty()) {
+            Writer.writeString("section", SectionName);
+        } else {
+            Writer.writeNull("section");
+        }
+
+        Writer.writeNumber("image_offset", Info.getImageOffset());
+        Writer.writeNumber("address", Base + Info.getImageOffset());
+    }
+
+    Writer.endRecord();
+}
+
 int
 PrintExportTrie(
     const MachOMemoryObject &Object,
@@ -382,7 +421,18 @@ PrintExportTrie(
     auto ExportList = std::vector<ExportInfo>();
     auto LongestExportLength = LargestIntHelper();
 
-    if (!Options.OnlyCount) {
+    // Without a sort, records are written out as soon as they're found, and
+    // the export-list is never filled.
+
+    auto Writer = Options.GetRecordWriter();
+    const auto StreamRecords =
+        Options.isRecordFormat() && !Options.Sort && !Options.OnlyCount;
+
+    if (Options.isRecordFormat()) {
+        Writer.beginList();
+    }
+
+    if (!Options.OnlyCount && !StreamRecords) {
         // Reserve an initial-capacity of 64 to minimize on number of
         // allocations.
 
@@ -443,6 +493,18 @@ PrintExportTrie(
             continue;
         }
 
+        if (StreamRecords) {
+            WriteExportRecord(Writer,
+                              Kind,
+                              Info.getExportInfo(),
+                              String,
+                              SegmentName,
+                              SectionName,
+                              Base,
+                              LibraryCollection);
+            continue;
+        }
+
         ExportList.emplace_back(ExportInfo {
             .Kind = Kind,
             .Info = Info.getExportInfo(),
@@ -453,11 +515,29 @@ PrintExportTrie(
     }
 
     if (Options.OnlyCount) {
+        if (Options.isRecordFormat()) {
+            Writer.beginRecord();
+            Writer.writeNumber("count", ExportListCount);
+            Writer.endRecord();
+            Writer.endList();
+
+            return 0;
+        }
+
         PrintExportTrieCount(Options.OutFile, ExportListCount, false);
         return 0;
     }
 
+    if (StreamRecords) {
+        Writer.endList();
+        return 0;
+    }
+
     if (ExportList.empty()) {
+        if (Options.isRecordFormat()) {
+            Writer.endList();
+        }
+
         fputs("Provided file has no exports in export-trie\n", Options.ErrFile);
         return 1;
     }
@@ -469,7 +549,23 @@ PrintExportTrie(
             return (Lhs.String < Rhs.String);
         };
 
-        std::sort(ExportList.begin(), ExportList.end(), Comparator);
+        ParallelSort(ExportList.begin(), ExportList.end(), Comparator);
+    }
+
+    if (Options.isRecordFormat()) {
+        for (const auto &Export : ExportList) {
+            WriteExportRecord(Writer,
+                              Export.Kind,
+                              Export.Info,
+                              Export.String,
+                              Export.SegmentName,
+                              Export.SectionName,
+                              Base,
+                              LibraryCollection);
+        }
+
+        Writer.endList();
+        return 0;
     }
 
     Operation::PrintLineSpamWarning(Options.OutFile, ExportList.size());
@@ -570,7 +666,7 @@ PrintExportTrieOperation::Run(const DscImageMemoryObject &Object,
     auto SegmentCollectionError = DscImage::SegmentInfoCollection::Error::None;
     const auto SegmentCollection =
         DscImage::SegmentInfoCollection::Open(Base,
-                                              LoadCmdStorage,
+                                              Object.getLoadCommandIndex(),
                                               Object.is64Bit(),
                                               &SegmentCollectionError);
 
@@ -647,7 +743,7 @@ PrintExportTrieOperation::Run(const MachOMemoryObject &Object,
 
     auto SegmentCollectionError = MachO::SegmentInfoCollection::Error::None;
     const auto SegmentCollection =
-        MachO::SegmentInfoCollection::Open(LoadCmdStorage,
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
                                            Object.is64Bit(),
                                            &SegmentCollectionError);
 
@@ -841,6 +937,10 @@ PrintExportTrieOperation::ParseOptionsImpl(const ArgvArray &Argv,
             Options.Sort = true;
         } else if (strcmp(Argument, "--tree") == 0) {
             Options.PrintTree = true;
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
         } else if (!Argument.isOption()) {
             break;
         } else {
@@ -854,6 +954,12 @@ PrintExportTrieOperation::ParseOptionsImpl(const ArgvArray &Argv,
         Index++;
     }
 
+    if (Options.PrintTree && Options.isRecordFormat()) {
+        fputs("Error: Provided option --tree with a non-text output-format\n",
+              Options.ErrFile);
+        exit(1);
+    }
+
     if (Options.OnlyCount && Options.Sort) {
         fputs("Error: Provided option --sort when only printing count\n",
               Options.ErrFile);
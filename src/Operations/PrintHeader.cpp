@@ -25,7 +25,7 @@ int
 PrintHeaderOperation::Run(const MachOMemoryObject &Object,
                           const struct Options &Options) noexcept
 {
-    fputs("Mach-O Single Architecture File\n", stdout);
+    fputs("Mach-O Single Architecture File\n", Options.OutFile);
 
     const auto Magic = Object.getMagic();
     const auto CpuKind = Object.getCpuKind();
@@ -222,7 +222,7 @@ int
 PrintHeaderOperation::Run(const FatMachOMemoryObject &Object,
                           const struct Options &Options) noexcept
 {
-    fputs("Mach-O Multi-Architecture (FAT) File\n", stdout);
+    fputs("Mach-O Multi-Architecture (FAT) File\n", Options.OutFile);
 
     const auto &Header = Object.getConstHeader();
     const auto &Magic = Header.Magic;
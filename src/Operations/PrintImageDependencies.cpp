@@ -0,0 +1,489 @@
+//
+//  Operations/PrintImageDependencies.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include "Operations/Common.h"
+#include "Operations/Operation.h"
+#include "Operations/PrintImageDependencies.h"
+
+#include "Utils/PrintUtils.h"
+
+PrintImageDependenciesOperation::PrintImageDependenciesOperation() noexcept
+: Operation(OpKind) {}
+
+PrintImageDependenciesOperation::PrintImageDependenciesOperation(
+    const struct Options &Options) noexcept
+: Operation(OpKind), Options(Options) {}
+
+using DependencyGraph = DyldSharedCache::DependencyGraph;
+
+[[nodiscard]] static std::string_view
+GetEdgeKindName(const DependencyGraph::EdgeKind Kind) noexcept {
+    switch (Kind) {
+        case DependencyGraph::EdgeKind::Load:
+            return "Load";
+        case DependencyGraph::EdgeKind::Weak:
+            return "Weak";
+        case DependencyGraph::EdgeKind::Reexport:
+            return "Re-export";
+        case DependencyGraph::EdgeKind::Upward:
+            return "Upward";
+    }
+
+    assert(0 && "Unrecognized Edge-Kind");
+}
+
+// Edges only point to the first image-info of an image, so an alias is found
+// through the address it shares with its image.
+
+[[nodiscard]] static std::optional<uint32_t>
+FindNodeForPath(const DscMemoryObject &Object,
+                const std::string_view Path) noexcept
+{
+    const auto Map = Object.getMap().getBegin();
+    const auto ImageCount = Object.getImageCount();
+
+    auto Address = std::optional<uint64_t>();
+    for (auto Index = uint32_t(); Index != ImageCount; Index++) {
+        const auto &Info = Object.getImageInfoAtIndex(Index);
+        if (Info.getPath(Map) == Path) {
+            Address = Info.Address;
+            break;
+        }
+    }
+
+    if (!Address.has_value()) {
+        return std::nullopt;
+    }
+
+    for (auto Index = uint32_t(); Index != ImageCount; Index++) {
+        if (Object.getImageInfoAtIndex(Index).Address == Address.value()) {
+            return Index;
+        }
+    }
+
+    return std::nullopt;
+}
+
+struct DependencyInfo {
+    uint32_t Node;
+    std::optional<DependencyGraph::EdgeKind> Kind;
+};
+
+[[nodiscard]] static std::vector<DependencyInfo>
+CollectDependencyList(
+    const DependencyGraph &Graph,
+    const uint32_t Node,
+    const struct PrintImageDependenciesOperation::Options &Options) noexcept
+{
+    using ModeKind = PrintImageDependenciesOperation::Options::ModeKind;
+    const auto IsDependents = (Options.Mode == ModeKind::Dependents);
+
+    auto Result = std::vector<DependencyInfo>();
+    if (Options.Recursive) {
+        const auto NodeList =
+            IsDependents ?
+                Graph.GetTransitiveDependents(Node, Options.IncludeUpward) :
+                Graph.GetTransitiveDependencies(Node, Options.IncludeUpward);
+
+        Result.reserve(NodeList.size());
+        for (const auto &Dependency : NodeList) {
+            Result.emplace_back(DependencyInfo {
+                .Node = Dependency,
+                .Kind = std::nullopt
+            });
+        }
+
+        return Result;
+    }
+
+    const auto EdgeList =
+        IsDependents ? Graph.getDependents(Node) : Graph.getDependencies(Node);
+
+    Result.reserve(EdgeList.size());
+    for (const auto &Edge : EdgeList) {
+        Result.emplace_back(DependencyInfo {
+            .Node = Edge.Node,
+            .Kind = Edge.Kind
+        });
+    }
+
+    return Result;
+}
+
+static int
+PrintDependencyList(
+    const DscMemoryObject &Object,
+    const DependencyGraph &Graph,
+    const struct PrintImageDependenciesOperation::Options &Options) noexcept
+{
+    using ModeKind = PrintImageDependenciesOperation::Options::ModeKind;
+
+    const auto Node = FindNodeForPath(Object, Options.ImagePath);
+    if (!Node.has_value()) {
+        fprintf(Options.ErrFile,
+                "Provided file has no image with path \"%s\"\n",
+                Options.ImagePath.data());
+        return 1;
+    }
+
+    const auto Map = Object.getMap().getBegin();
+    const auto GetPath = [&](const uint32_t Index) noexcept {
+        return std::string_view(Object.getImageInfoAtIndex(Index).getPath(Map));
+    };
+
+    const auto IsDependents = (Options.Mode == ModeKind::Dependents);
+    const auto List = CollectDependencyList(Graph, Node.value(), Options);
+
+    if (Options.isRecordFormat()) {
+        const auto Key = IsDependents ? "dependent" : "dependency";
+        auto Writer = Options.GetRecordWriter();
+
+        Writer.beginList();
+        for (const auto &Info : List) {
+            Writer.beginRecord();
+            Writer.writeString("image", Options.ImagePath);
+            Writer.writeString(Key, GetPath(Info.Node));
+
+            if (Info.Kind.has_value()) {
+                Writer.writeString("kind", GetEdgeKindName(Info.Kind.value()));
+            }
+
+            Writer.endRecord();
+        }
+
+        Writer.endList();
+        return 0;
+    }
+
+    const auto Name = IsDependents ? "Dependent" : "Dependency";
+    if (List.empty()) {
+        fprintf(Options.OutFile,
+                "Image \"%s\" has no %s%s\n",
+                Options.ImagePath.data(),
+                Options.Recursive ? "transitive " : "",
+                IsDependents ? "dependents" : "dependencies");
+        return 0;
+    }
+
+    fprintf(Options.OutFile,
+            "Image \"%s\" has %" PRIuPTR " %s%s:\n",
+            Options.ImagePath.data(),
+            List.size(),
+            Options.Recursive ? "transitive " : "",
+            IsDependents ? "dependents" : "dependencies");
+
+    const auto DigitLength = PrintUtilsGetIntegerDigitLength(List.size());
+    auto Counter = uint64_t(1);
+
+    for (const auto &Info : List) {
+        fprintf(Options.OutFile,
+                "%s %0*" PRIu64 ": \"%s\"",
+                Name,
+                DigitLength,
+                Counter,
+                GetPath(Info.Node).data());
+
+        if (Options.Verbose && Info.Kind.has_value()) {
+            fprintf(Options.OutFile,
+                    " <%s>",
+                    GetEdgeKindName(Info.Kind.value()).data());
+        }
+
+        fputc('\n', Options.OutFile);
+        Counter++;
+    }
+
+    return 0;
+}
+
+static int
+PrintLoadOrder(
+    const DscMemoryObject &Object,
+    const DependencyGraph &Graph,
+    const struct PrintImageDependenciesOperation::Options &Options) noexcept
+{
+    auto Order = std::vector<uint32_t>();
+    if (!Graph.GetTopologicalOrder(Order, Options.IncludeUpward)) {
+        fputs("Warning: Provided file has dependency-cycles, images in or "
+              "depending on a cycle are listed last\n",
+              Options.ErrFile);
+    }
+
+    const auto Map = Object.getMap().getBegin();
+    if (Options.isRecordFormat()) {
+        auto Writer = Options.GetRecordWriter();
+        auto Index = uint64_t();
+
+        Writer.beginList();
+        for (const auto &Node : Order) {
+            Writer.beginRecord();
+            Writer.writeNumber("index", Index);
+            Writer.writeString("image",
+                               Object.getImageInfoAtIndex(Node).getPath(Map));
+            Writer.endRecord();
+
+            Index++;
+        }
+
+        Writer.endList();
+        return 0;
+    }
+
+    fprintf(Options.OutFile,
+            "Provided file has %" PRIuPTR " Images, in load-order:\n",
+            Order.size());
+
+    const auto DigitLength = PrintUtilsGetIntegerDigitLength(Order.size());
+    auto Counter = uint64_t(1);
+
+    for (const auto &Node : Order) {
+        fprintf(Options.OutFile,
+                "Image %0*" PRIu64 ": \"%s\"",
+                DigitLength,
+                Counter,
+                Object.getImageInfoAtIndex(Node).getPath(Map));
+
+        if (Options.Verbose) {
+            fprintf(Options.OutFile,
+                    " <%" PRIuPTR " Dependencies, %" PRIuPTR " Dependents>",
+                    Graph.getDependencies(Node).size(),
+                    Graph.getDependents(Node).size());
+        }
+
+        fputc('\n', Options.OutFile);
+        Counter++;
+    }
+
+    return 0;
+}
+
+static int
+PrintCycles(
+    const DscMemoryObject &Object,
+    const DependencyGraph &Graph,
+    const struct PrintImageDependenciesOperation::Options &Options) noexcept
+{
+    const auto CycleList = Graph.FindCycles(Options.IncludeUpward);
+    const auto Map = Object.getMap().getBegin();
+
+    if (Options.isRecordFormat()) {
+        auto Writer = Options.GetRecordWriter();
+        auto Index = uint64_t();
+
+        Writer.beginList();
+        for (const auto &Cycle : CycleList) {
+            for (const auto &Node : Cycle) {
+                Writer.beginRecord();
+                Writer.writeNumber("cycle", Index);
+                Writer.writeString(
+                    "image", Object.getImageInfoAtIndex(Node).getPath(Map));
+                Writer.endRecord();
+            }
+
+            Index++;
+        }
+
+        Writer.endList();
+        return 0;
+    }
+
+    if (CycleList.empty()) {
+        fputs("Provided file has no dependency-cycles\n", Options.OutFile);
+        return 0;
+    }
+
+    fprintf(Options.OutFile,
+            "Provided file has %" PRIuPTR " dependency-cycles:\n",
+            CycleList.size());
+
+    const auto DigitLength = PrintUtilsGetIntegerDigitLength(CycleList.size());
+    auto Counter = uint64_t(1);
+
+    for (const auto &Cycle : CycleList) {
+        fprintf(Options.OutFile,
+                "Cycle %0*" PRIu64 " (%" PRIuPTR " Images):\n",
+                DigitLength,
+                Counter,
+                Cycle.size());
+
+        for (const auto &Node : Cycle) {
+            fprintf(Options.OutFile,
+                    "\t\"%s\"\n",
+                    Object.getImageInfoAtIndex(Node).getPath(Map));
+        }
+
+        Counter++;
+    }
+
+    return 0;
+}
+
+int
+PrintImageDependenciesOperation::Run(const DscMemoryObject &Object,
+                                     const struct Options &Options) noexcept
+{
+    if (Object.getImageCount() == 0) {
+        fputs("Provided file has no images\n", Options.ErrFile);
+        return 1;
+    }
+
+    auto Graph = DependencyGraph();
+    const auto FailedCount =
+        OperationCommon::GetDscDependencyGraph(Object, Graph);
+
+    if (FailedCount != 0) {
+        fprintf(Options.ErrFile,
+                "Warning: Skipped %" PRIu32 " images that could not be "
+                "parsed\n",
+                FailedCount);
+    }
+
+    switch (Options.Mode) {
+        case Options::ModeKind::Dependencies:
+        case Options::ModeKind::Dependents:
+            return PrintDependencyList(Object, Graph, Options);
+        case Options::ModeKind::LoadOrder:
+            return PrintLoadOrder(Object, Graph, Options);
+        case Options::ModeKind::Cycles:
+            return PrintCycles(Object, Graph, Options);
+    }
+
+    assert(0 && "Unrecognized Mode-Kind");
+}
+
+static inline void
+SetMode(const PrintImageDependenciesOperation::Options::ModeKind Mode,
+        const char *const Option,
+        bool &DidSetMode,
+        struct PrintImageDependenciesOperation::Options &Options) noexcept
+{
+    if (DidSetMode && Options.Mode != Mode) {
+        fprintf(Options.ErrFile,
+                "Error: Provided option %s with another mode-option\n",
+                Option);
+        exit(1);
+    }
+
+    Options.Mode = Mode;
+    DidSetMode = true;
+}
+
+auto
+PrintImageDependenciesOperation::ParseOptionsImpl(const ArgvArray &Argv,
+                                                  int *const IndexOut) noexcept
+    -> struct PrintImageDependenciesOperation::Options
+{
+    auto Index = int();
+    auto DidSetMode = false;
+
+    struct Options Options;
+    for (const auto &Argument : Argv) {
+        if (strcmp(Argument, "-v") == 0 || strcmp(Argument, "--verbose") == 0) {
+            Options.Verbose = true;
+        } else if (strcmp(Argument, "--recursive") == 0) {
+            Options.Recursive = true;
+        } else if (strcmp(Argument, "--include-upward") == 0) {
+            Options.IncludeUpward = true;
+        } else if (strcmp(Argument, "--dependents") == 0) {
+            SetMode(Options::ModeKind::Dependents,
+                    Argument,
+                    DidSetMode,
+                    Options);
+        } else if (strcmp(Argument, "--load-order") == 0) {
+            SetMode(Options::ModeKind::LoadOrder,
+                    Argument,
+                    DidSetMode,
+                    Options);
+        } else if (strcmp(Argument, "--cycles") == 0) {
+            SetMode(Options::ModeKind::Cycles, Argument, DidSetMode, Options);
+        } else if (Argument.GetStringView().starts_with("--image=")) {
+            Options.ImagePath =
+                Argument.GetStringView().substr(LENGTH_OF("--image="));
+
+            if (Options.ImagePath.empty()) {
+                fputs("Error: Provided option --image with an empty path\n",
+                      Options.ErrFile);
+                exit(1);
+            }
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
+        } else if (!Argument.isOption()) {
+            break;
+        } else {
+            fprintf(stderr,
+                    "Unrecognized argument for operation %s: %s\n",
+                    OperationKindInfo<OpKind>::Name.data(),
+                    Argument.getString());
+            exit(1);
+        }
+
+        Index++;
+    }
+
+    switch (Options.Mode) {
+        case Options::ModeKind::Dependencies:
+        case Options::ModeKind::Dependents:
+            if (Options.ImagePath.empty()) {
+                fputs("Error: Please provide an image with --image=<path>\n",
+                      Options.ErrFile);
+                exit(1);
+            }
+
+            break;
+        case Options::ModeKind::LoadOrder:
+        case Options::ModeKind::Cycles:
+            if (!Options.ImagePath.empty()) {
+                fputs("Error: Provided option --image when listing every "
+                      "image\n",
+                      Options.ErrFile);
+                exit(1);
+            }
+
+            if (Options.Recursive) {
+                fputs("Error: Provided option --recursive when listing every "
+                      "image\n",
+                      Options.ErrFile);
+                exit(1);
+            }
+
+            break;
+    }
+
+    if (IndexOut != nullptr) {
+        *IndexOut = Index;
+    }
+
+    return Options;
+}
+
+int
+PrintImageDependenciesOperation::ParseOptions(const ArgvArray &Argv) noexcept {
+    auto Index = int();
+    Options = ParseOptionsImpl(Argv, &Index);
+
+    return Index;
+}
+
+int
+PrintImageDependenciesOperation::Run(const MemoryObject &Object) const noexcept
+{
+    switch (Object.getKind()) {
+        case ObjectKind::None:
+            assert(0 && "Object-Kind is None");
+        case ObjectKind::DyldSharedCache:
+            return Run(cast<ObjectKind::DyldSharedCache>(Object), Options);
+        case ObjectKind::MachO:
+        case ObjectKind::FatMachO:
+        case ObjectKind::DscImage:
+            return InvalidObjectKind;
+    }
+
+    assert(0 && "Unrecognized Object-Kind");
+}
@@ -8,6 +8,8 @@
 
 #include <algorithm>
 
+#include "ADT/ParallelSort.h"
+
 #include "Operations/Operation.h"
 #include "Operations/PrintImageList.h"
 
@@ -29,42 +31,93 @@ struct ImageInfo : public DyldSharedCache::ImageInfo {
     }
 };
 
+template <PrintImageListOperation::Options::SortKind SortKind>
 [[nodiscard]] static int
-CompareInfosBySortKind(
-    const ImageInfo &Lhs,
-    const ImageInfo &Rhs,
-    const PrintImageListOperation::Options::SortKind SortKind) noexcept
-{
-    switch (SortKind) {
-        case PrintImageListOperation::Options::SortKind::ByAddress:
-            if (Lhs.Address == Rhs.Address) {
-                return 0;
-            } else if (Lhs.Address < Rhs.Address) {
-                return -1;
-            }
+CompareInfosBySortKind(const ImageInfo &Lhs, const ImageInfo &Rhs) noexcept {
+    using Enum = PrintImageListOperation::Options::SortKind;
+    if constexpr (SortKind == Enum::ByAddress) {
+        if (Lhs.Address == Rhs.Address) {
+            return 0;
+        } else if (Lhs.Address < Rhs.Address) {
+            return -1;
+        }
 
-            return 1;
-        case PrintImageListOperation::Options::SortKind::ByInode:
-            if (Lhs.Inode == Rhs.Inode) {
-                return 0;
-            } else if (Lhs.Inode < Rhs.Inode) {
-                return -1;
-            }
+        return 1;
+    } else if constexpr (SortKind == Enum::ByInode) {
+        if (Lhs.Inode == Rhs.Inode) {
+            return 0;
+        } else if (Lhs.Inode < Rhs.Inode) {
+            return -1;
+        }
 
-            return 1;
-        case PrintImageListOperation::Options::SortKind::ByModTime:
-            if (Lhs.ModTime == Rhs.ModTime) {
-                return 0;
-            } else if (Lhs.ModTime < Rhs.ModTime) {
-                return -1;
-            }
+        return 1;
+    } else if constexpr (SortKind == Enum::ByModTime) {
+        if (Lhs.ModTime == Rhs.ModTime) {
+            return 0;
+        } else if (Lhs.ModTime < Rhs.ModTime) {
+            return -1;
+        }
+
+        return 1;
+    } else if constexpr (SortKind == Enum::ByName) {
+        return Lhs.Path.compare(Rhs.Path);
+    }
+}
+
+static void
+SortImageInfoList(
+    std::vector<ImageInfo> &List,
+    const struct PrintImageListOperation::Options &Options) noexcept
+{
+    using Enum = PrintImageListOperation::Options::SortKind;
+
+    // Sorting by a single kind is by far the most common, so give it a
+    // comparator specialized at compile-time.
+
+    if (Options.SortKindList.size() == 1) {
+        switch (Options.SortKindList.front()) {
+            case Enum::ByAddress:
+                ParallelSortWithFunc<CompareInfosBySortKind<Enum::ByAddress>>(
+                    List.begin(), List.end());
+                return;
+            case Enum::ByInode:
+                ParallelSortWithFunc<CompareInfosBySortKind<Enum::ByInode>>(
+                    List.begin(), List.end());
+                return;
+            case Enum::ByModTime:
+                ParallelSortWithFunc<CompareInfosBySortKind<Enum::ByModTime>>(
+                    List.begin(), List.end());
+                return;
+            case Enum::ByName:
+                ParallelSortWithFunc<CompareInfosBySortKind<Enum::ByName>>(
+                    List.begin(), List.end());
+                return;
+        }
+
+        assert(0 && "Unrecognized (and invalid) Sort-Kind");
+    }
 
-            return 1;
-        case PrintImageListOperation::Options::SortKind::ByName:
-            return Lhs.Path.compare(Rhs.Path);
+    auto FuncList = std::vector<SortCompareFunc<ImageInfo>>();
+    FuncList.reserve(Options.SortKindList.size());
+
+    for (const auto &SortKind : Options.SortKindList) {
+        switch (SortKind) {
+            case Enum::ByAddress:
+                FuncList.emplace_back(CompareInfosBySortKind<Enum::ByAddress>);
+                break;
+            case Enum::ByInode:
+                FuncList.emplace_back(CompareInfosBySortKind<Enum::ByInode>);
+                break;
+            case Enum::ByModTime:
+                FuncList.emplace_back(CompareInfosBySortKind<Enum::ByModTime>);
+                break;
+            case Enum::ByName:
+                FuncList.emplace_back(CompareInfosBySortKind<Enum::ByName>);
+                break;
+        }
     }
 
-    assert(0 && "Unrecognized (and invalid) Sort-Kind");
+    ParallelSortWithFuncList(List.begin(), List.end(), FuncList);
 }
 
 static void
@@ -80,6 +133,21 @@ PrintImageCount(FILE *const OutFile,
     fputc('\n', OutFile);
 }
 
+static void
+WriteImageRecord(RecordWriter &Writer,
+                 const uint8_t *const Map,
+                 const DyldSharedCache::ImageInfo &Info,
+                 const std::string_view Path) noexcept
+{
+    Writer.beginRecord();
+    Writer.writeString("path", Path);
+    Writer.writeNumber("address", Info.Address);
+    Writer.writeNumber("mod_time", Info.ModTime);
+    Writer.writeNumber("inode", Info.Inode);
+    Writer.writeBool("alias", Info.isAlias(Map));
+    Writer.endRecord();
+}
+
 int
 PrintImageListOperation::Run(const DscMemoryObject &Object,
                              const struct Options &Options) noexcept
@@ -91,11 +159,34 @@ PrintImageListOperation::Run(const DscMemoryObject &Object,
     }
 
     if (Options.OnlyCount) {
+        if (Options.isRecordFormat()) {
+            auto Writer = Options.GetRecordWriter();
+
+            Writer.beginList();
+            Writer.beginRecord();
+            Writer.writeNumber("count", ImageCount);
+            Writer.endRecord();
+            Writer.endList();
+
+            return 0;
+        }
+
         PrintImageCount(Options.OutFile, ImageCount, false);
         return 0;
     }
 
     const auto Map = Object.getMap().getBegin();
+    auto Writer = Options.GetRecordWriter();
+
+    if (Options.isRecordFormat() && Options.SortKindList.empty()) {
+        Writer.beginList();
+        for (const auto &Info : Object.getConstImageInfoList()) {
+            WriteImageRecord(Writer, Map, Info, Info.getPath(Map));
+        }
+
+        Writer.endList();
+        return 0;
+    }
 
     auto ImageInfoList = std::vector<ImageInfo>();
     auto LongestImagePath = LargestIntHelper();
@@ -116,18 +207,17 @@ PrintImageListOperation::Run(const DscMemoryObject &Object,
     }
 
     if (!Options.SortKindList.empty()) {
-        const auto Comparator = [&](const auto &Lhs, const auto &Rhs) noexcept {
-            for (const auto &Sort : Options.SortKindList) {
-                const auto Compare = CompareInfosBySortKind(Lhs, Rhs, Sort);
-                if (Compare != 0) {
-                    return (Compare < 0);
-                }
-            }
+        SortImageInfoList(ImageInfoList, Options);
+    }
 
-            return false;
-        };
+    if (Options.isRecordFormat()) {
+        Writer.beginList();
+        for (const auto &Info : ImageInfoList) {
+            WriteImageRecord(Writer, Map, Info, Info.Path);
+        }
 
-        std::sort(ImageInfoList.begin(), ImageInfoList.end(), Comparator);
+        Writer.endList();
+        return 0;
     }
 
     PrintImageCount(Options.OutFile, ImageCount);
@@ -215,6 +305,10 @@ PrintImageListOperation::ParseOptionsImpl(const ArgvArray &Argv,
             AddSortKind(Options::SortKind::ByModTime, Argument, Options);
         } else if (strcmp(Argument, "--sort-by-name") == 0) {
             AddSortKind(Options::SortKind::ByName, Argument, Options);
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
         } else if (!Argument.isOption()) {
             break;
         } else {
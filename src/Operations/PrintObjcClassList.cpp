@@ -7,6 +7,7 @@
 //
 
 #include <cstring>
+#include <unordered_map>
 
 #include "ADT/DscImage/DeVirtualizer.h"
 #include "ADT/DscImage/ObjcUtil.h"
@@ -133,13 +134,10 @@ CompareActionsBySortKind(
 
 [[maybe_unused]] static int
 CompareObjcClasses(
-    const TreeNode &LEntry,
-    const TreeNode &REntry,
+    const MachO::ObjcClassInfo &Lhs,
+    const MachO::ObjcClassInfo &Rhs,
     const struct PrintObjcClassListOperation::Options &Options) noexcept
 {
-    const auto &Lhs = reinterpret_cast<const MachO::ObjcClassInfo &>(LEntry);
-    const auto &Rhs = reinterpret_cast<const MachO::ObjcClassInfo &>(REntry);
-
     for (const auto &SortKind : Options.SortKindList) {
         const auto CmpResult = CompareActionsBySortKind(Lhs, Rhs, SortKind);
         if (CmpResult != 0) {
@@ -231,6 +229,45 @@ PrintClassVerboseInfo(
     }
 }
 
+static void
+WriteObjcClassRecord(
+    RecordWriter &Writer,
+    const MachO::SharedLibraryInfoCollection &SharedLibraryCollection,
+    const MachO::ObjcClassInfo &Node,
+    const bool PrintCategories) noexcept
+{
+    Writer.beginRecord();
+    Writer.writeString("name", Node.getName());
+
+    if (Node.isExternal()) {
+        Writer.writeNull("address");
+        Writer.writeBool("external", true);
+
+        OperationCommon::WriteDylibOrdinalFields(Writer,
+                                                 SharedLibraryCollection,
+                                                 Node.getDylibOrdinal());
+    } else {
+        Writer.writeNumber("address", Node.getAddress());
+        Writer.writeBool("external", false);
+    }
+
+    const auto Super = Node.getSuper();
+    if (Super != nullptr && !Super->isNull()) {
+        Writer.writeString("super", Super->getName());
+    } else {
+        Writer.writeNull("super");
+    }
+
+    Writer.writeBool("swift", Node.isSwift());
+    Writer.writeNumber("flags", Node.getFlags().value());
+
+    if (PrintCategories) {
+        Writer.writeNumber("category_count", Node.getCategoryList().size());
+    }
+
+    Writer.endRecord();
+}
+
 constexpr static auto TabLength = 8;
 
 static void
@@ -245,23 +282,53 @@ PrintObjcClassList(
         return;
     }
 
-    const auto End = ObjcClassCollection.end();
+    if (Options.isRecordFormat()) {
+        auto ObjcClassList = ObjcClassCollection.GetAsList();
+        if (!Options.SortKindList.empty()) {
+            std::sort(ObjcClassList.begin(),
+                      ObjcClassList.end(),
+                      [&](const auto &Lhs, const auto &Rhs) noexcept
+            {
+                return CompareObjcClasses(*Lhs, *Rhs, Options);
+            });
+        }
+
+        auto Writer = Options.GetRecordWriter();
+        Writer.beginList();
+
+        for (const auto &Node : ObjcClassList) {
+            if (Node->isNull()) {
+                continue;
+            }
+
+            WriteObjcClassRecord(Writer,
+                                 SharedLibraryCollection,
+                                 *Node,
+                                 Options.PrintCategories);
+        }
+
+        Writer.endList();
+        return;
+    }
+
+    auto &ClassTree = ObjcClassCollection.getClassTree();
 
     auto LongestLength = LargestIntHelper();
     auto LongestName = LargestIntHelper();
 
-    for (auto Iter = ObjcClassCollection.begin(); Iter != End; Iter++) {
-        if (Iter->isNull()) {
+    for (const auto &Entry : ClassTree) {
+        const auto &Node = *Entry.Value;
+        if (Node.isNull()) {
             continue;
         }
 
-        const auto IsExternal = Iter->isExternal();
-        if (!IsExternal && Iter->getFlags().empty() && !Iter->isSwift()) {
+        const auto IsExternal = Node.isExternal();
+        if (!IsExternal && Node.getFlags().empty() && !Node.isSwift()) {
             continue;
         }
 
-        const auto NameLength = Iter->getName().length();
-        const auto Length = Iter.getPrintLineLength(TabLength) + NameLength;
+        const auto NameLength = Node.getName().length();
+        const auto Length = TabLength * (Entry.DepthLevel - 1) + NameLength;
 
         LongestLength = Length;
         LongestName = NameLength;
@@ -269,10 +336,10 @@ PrintObjcClassList(
 
     if (Options.PrintTree) {
         if (!Options.SortKindList.empty()) {
-            ObjcClassCollection.Sort([&](const auto &Lhs,
-                                         const auto &Rhs) noexcept
+            ClassTree.Sort([&](const MachO::ObjcClassInfo *const Lhs,
+                               const MachO::ObjcClassInfo *const Rhs) noexcept
             {
-                return CompareObjcClasses(Lhs, Rhs, Options);
+                return CompareObjcClasses(*Lhs, *Rhs, Options);
             });
         }
 
@@ -280,11 +347,9 @@ PrintObjcClassList(
             [&](FILE *const OutFile,
                 int WrittenOut,
                 const uint64_t ,
-                const TreeNode &TreeNode) noexcept
+                const MachO::ObjcClassInfo *const Info) noexcept
         {
-            const auto &Node =
-                reinterpret_cast<const MachO::ObjcClassInfo &>(TreeNode);
-
+            const auto &Node = *Info;
             if (Node.isNull()) {
                 return false;
             }
@@ -304,9 +369,7 @@ PrintObjcClassList(
             return true;
         };
 
-        ObjcClassCollection.PrintHorizontal(Options.OutFile,
-                                            TabLength,
-                                            Printer);
+        ClassTree.PrintHorizontal(Options.OutFile, TabLength, Printer);
     } else {
         auto ObjcClassList = ObjcClassCollection.GetAsList();
         if (!Options.SortKindList.empty()) {
@@ -386,7 +449,7 @@ PrintObjcClassListOperation::Run(const DscImageMemoryObject &Object,
 
     const auto Is64Bit = Object.is64Bit();
     const auto SegmentCollection =
-        MachO::SegmentInfoCollection::Open(LoadCmdStorage,
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
                                            Is64Bit,
                                            &SegmentCollectionError);
 
@@ -402,7 +465,7 @@ PrintObjcClassListOperation::Run(const DscImageMemoryObject &Object,
     const auto Map = Object.getMap();
     const auto GetDyldInfoResult =
         OperationCommon::GetDyldInfoCommand(Options.ErrFile,
-                                            LoadCmdStorage,
+                                            Object.getLoadCommandIndex(),
                                             DyldInfo);
 
     if (GetDyldInfoResult != 0) {
@@ -433,7 +496,9 @@ PrintObjcClassListOperation::Run(const DscImageMemoryObject &Object,
         Object.getDscHeaderV0().getConstMappingInfoList();
 
     const auto DeVirtualizer =
-        DscImage::ConstDeVirtualizer(DscMap.getBegin(), MappingList);
+        DscImage::ConstDeVirtualizer(DscMap,
+                                     MappingList,
+                                     Object.getRebasedView());
 
     auto Error = DscImage::ObjcClassInfoCollection::Error::None;
     auto CollectionError = MachO::BindActionCollection::Error::None;
@@ -493,7 +558,7 @@ PrintObjcClassListOperation::Run(const MachOMemoryObject &Object,
 
     const auto Is64Bit = Object.is64Bit();
     const auto SegmentCollection =
-        MachO::SegmentInfoCollection::Open(LoadCmdStorage,
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
                                            Is64Bit,
                                            &SegmentCollectionError);
 
@@ -509,7 +574,7 @@ PrintObjcClassListOperation::Run(const MachOMemoryObject &Object,
     const auto Map = Object.getMap();
     const auto GetDyldInfoResult =
         OperationCommon::GetDyldInfoCommand(Options.ErrFile,
-                                            LoadCmdStorage,
+                                            Object.getLoadCommandIndex(),
                                             DyldInfo);
 
     if (GetDyldInfoResult != 0) {
@@ -578,6 +643,194 @@ PrintObjcClassListOperation::Run(const MachOMemoryObject &Object,
     return 0;
 }
 
+struct DscObjcClassInfo {
+    std::string_view Name;
+    uint64_t Address;
+
+    // Index of the image defining the class, or UINT32_MAX if unknown.
+    uint32_t ImageIndex;
+};
+
+static int
+CompareDscClassesBySortKind(
+    const DscObjcClassInfo &Lhs,
+    const DscObjcClassInfo &Rhs,
+    const PrintObjcClassListOperation::Options::SortKind SortKind) noexcept
+{
+    switch (SortKind) {
+        case PrintObjcClassListOperation::Options::SortKind::None:
+            assert(0 && "Unrecognized Sort-Kind");
+        case PrintObjcClassListOperation::Options::SortKind::ByName:
+            return Lhs.Name.compare(Rhs.Name);
+        case PrintObjcClassListOperation::Options::SortKind::ByDylibOrdinal:
+            if (Lhs.ImageIndex < Rhs.ImageIndex) {
+                return -1;
+            } else if (Lhs.ImageIndex == Rhs.ImageIndex) {
+                return 0;
+            }
+
+            return 1;
+        case PrintObjcClassListOperation::Options::SortKind::ByKind:
+            // Every class in the shared-cache's class-table is defined in
+            // the shared-cache.
+            return 0;
+    }
+
+    return 0;
+}
+
+// Lists the classes of every image through the shared-cache's class-table,
+// without parsing any image's class-list.
+
+int
+PrintObjcClassListOperation::Run(const DscMemoryObject &Object,
+                                 const struct Options &Options) noexcept
+{
+    if (Options.PrintTree || Options.PrintCategories) {
+        fputs("Error: Options --tree and --include-categories are not "
+              "supported for a dyld_shared_cache\n",
+              Options.ErrFile);
+        return 1;
+    }
+
+    auto ObjcOpt = std::optional<DyldSharedCache::ObjcOptInfo>();
+    const auto GetObjcOptResult =
+        OperationCommon::GetDscObjcOptInfo(Options.ErrFile, Object, ObjcOpt);
+
+    if (GetObjcOptResult != 0) {
+        return GetObjcOptResult;
+    }
+
+    const auto Map = Object.getMap().getBegin();
+    const auto ImageCount = Object.getImageCount();
+
+    auto ImageIndexMap = std::unordered_map<uint64_t, uint32_t>();
+    ImageIndexMap.reserve(ImageCount);
+
+    for (auto I = uint32_t(); I != ImageCount; I++) {
+        ImageIndexMap.try_emplace(Object.getImageInfoAtIndex(I).Address, I);
+    }
+
+    auto ClassList = std::vector<DscObjcClassInfo>();
+    const auto AddClass =
+        [&](const std::string_view Name,
+            const DyldSharedCache::ObjcOptInfo::ClassEntry &Entry) noexcept
+    {
+        auto ImageIndex = UINT32_MAX;
+        const auto ImageAddr =
+            ObjcOpt->GetImageAddressForHeaderInfo(Entry.HeaderInfoAddress);
+
+        if (ImageAddr.has_value()) {
+            const auto Iter = ImageIndexMap.find(ImageAddr.value());
+            if (Iter != ImageIndexMap.end()) {
+                ImageIndex = Iter->second;
+            }
+        }
+
+        ClassList.emplace_back(DscObjcClassInfo {
+            .Name = Name,
+            .Address = Entry.ClassAddress,
+            .ImageIndex = ImageIndex
+        });
+    };
+
+    if (!Options.ClassName.empty()) {
+        for (const auto &Entry : ObjcOpt->FindClass(Options.ClassName)) {
+            AddClass(Options.ClassName, Entry);
+        }
+    } else {
+        ObjcOpt->ForEachClass(AddClass);
+    }
+
+    if (!Options.SortKindList.empty()) {
+        std::sort(ClassList.begin(),
+                  ClassList.end(),
+                  [&](const DscObjcClassInfo &Lhs,
+                      const DscObjcClassInfo &Rhs) noexcept
+        {
+            for (const auto &SortKind : Options.SortKindList) {
+                const auto CmpResult =
+                    CompareDscClassesBySortKind(Lhs, Rhs, SortKind);
+
+                if (CmpResult != 0) {
+                    return (CmpResult < 0);
+                }
+            }
+
+            return false;
+        });
+    }
+
+    if (Options.isRecordFormat()) {
+        auto Writer = Options.GetRecordWriter();
+        Writer.beginList();
+
+        for (const auto &Class : ClassList) {
+            Writer.beginRecord();
+            Writer.writeString("name", Class.Name);
+            Writer.writeNumber("address", Class.Address);
+
+            if (Class.ImageIndex != UINT32_MAX) {
+                const auto &Info = Object.getImageInfoAtIndex(Class.ImageIndex);
+                Writer.writeString("image", Info.getPath(Map));
+            } else {
+                Writer.writeNull("image");
+            }
+
+            Writer.endRecord();
+        }
+
+        Writer.endList();
+        return 0;
+    }
+
+    if (ClassList.empty()) {
+        if (!Options.ClassName.empty()) {
+            fprintf(Options.OutFile,
+                    "Provided file has no Objective-C Class named \"%s\"\n",
+                    Options.ClassName.data());
+        } else {
+            fputs("Provided file has no Objective-C Classes\n",
+                  Options.OutFile);
+        }
+
+        return 0;
+    }
+
+    Operation::PrintLineSpamWarning(Options.OutFile, ClassList.size());
+    fprintf(Options.OutFile,
+            "Provided file has %" PRIuPTR " Objective-C Classes:\n",
+            ClassList.size());
+
+    const auto Is64Bit = ObjcOpt->is64Bit();
+    const auto MaxDigitLength =
+        PrintUtilsGetIntegerDigitLength(ClassList.size());
+
+    auto I = static_cast<uint64_t>(1);
+    for (const auto &Class : ClassList) {
+        fprintf(Options.OutFile,
+                "Objective-C Class %0*" PRIu64 ": ",
+                MaxDigitLength,
+                I);
+
+        PrintUtilsWriteOffset32Or64(Options.OutFile, Is64Bit, Class.Address);
+        fprintf(Options.OutFile,
+                " \"%.*s\"",
+                static_cast<int>(Class.Name.size()),
+                Class.Name.data());
+
+        if (Class.ImageIndex != UINT32_MAX) {
+            const auto &Info = Object.getImageInfoAtIndex(Class.ImageIndex);
+            fprintf(Options.OutFile, " (Image: \"%s\")", Info.getPath(Map));
+        }
+
+        fputc('\n', Options.OutFile);
+        I++;
+    }
+
+    return 0;
+}
+
 static inline bool
 ListHasSortKind(
     const std::vector<PrintObjcClassListOperation::Options::SortKind> &List,
@@ -620,6 +873,19 @@ PrintObjcClassListOperation::ParseOptionsImpl(const ArgvArray &Argv,
             AddSortKind(Argument, Options, Options::SortKind::ByKind);
         } else if (strcmp(Argument, "--tree") == 0) {
             Options.PrintTree = true;
+        } else if (Argument.GetStringView().starts_with("--class=")) {
+            Options.ClassName =
+                Argument.GetStringView().substr(LENGTH_OF("--class="));
+
+            if (Options.ClassName.empty()) {
+                fputs("Error: Provided option --class with an empty name\n",
+                      Options.ErrFile);
+                exit(1);
+            }
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
         } else if (!Argument.isOption()) {
             break;
         } else {
@@ -639,6 +905,12 @@ PrintObjcClassListOperation::ParseOptionsImpl(const ArgvArray &Argv,
         exit(1);
     }
 
+    if (Options.PrintTree && Options.isRecordFormat()) {
+        fputs("Error: Provided option --tree with a non-text output-format\n",
+              Options.ErrFile);
+        exit(1);
+    }
+
     if (IndexOut != nullptr) {
         *IndexOut = Index;
     }
@@ -659,11 +931,22 @@ PrintObjcClassListOperation::Run(const MemoryObject &Object) const noexcept {
         case ObjectKind::None:
             assert(0 && "Object-Kind is None");
         case ObjectKind::MachO:
-            return Run(cast<ObjectKind::MachO>(Object), Options);
         case ObjectKind::DscImage:
+            if (!Options.ClassName.empty()) {
+                fputs("Error: Option --class is only supported for a "
+                      "dyld_shared_cache\n",
+                      Options.ErrFile);
+                return 1;
+            }
+
+            if (Object.getKind() == ObjectKind::MachO) {
+                return Run(cast<ObjectKind::MachO>(Object), Options);
+            }
+
             return Run(cast<ObjectKind::DscImage>(Object), Options);
-        case ObjectKind::FatMachO:
         case ObjectKind::DyldSharedCache:
+            return Run(cast<ObjectKind::DyldSharedCache>(Object), Options);
+        case ObjectKind::FatMachO:
             return InvalidObjectKind;
     }
 
@@ -0,0 +1,681 @@
+//
+//  Operations/PrintObjcMethodList.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "ADT/DscImage/DeVirtualizer.h"
+#include "ADT/DscImage/ObjcMetadata.h"
+#include "ADT/Mach-O/ObjcMetadata.h"
+
+#include "Operations/Common.h"
+#include "Operations/Operation.h"
+#include "Operations/PrintObjcMethodList.h"
+
+#include "Utils/PrintUtils.h"
+
+PrintObjcMethodListOperation::PrintObjcMethodListOperation() noexcept
+: Operation(OpKind) {}
+
+PrintObjcMethodListOperation::PrintObjcMethodListOperation(
+    const struct Options &Options) noexcept
+: Operation(OpKind), Options(Options) {}
+
+struct ImageMetadata {
+    DscImage::ObjcMetadataCollection Collection;
+
+    bool Is64Bit : 1 = false;
+    bool FailedToParse : 1 = false;
+};
+
+static inline void
+PrintString(FILE *const OutFile, const std::string_view String) noexcept {
+    fprintf(OutFile, "%.*s", static_cast<int>(String.size()), String.data());
+}
+
+static void
+SortClassList(MachO::ObjcMetadataCollection &Collection) noexcept {
+    auto &ClassList = Collection.getClassList();
+    std::sort(ClassList.begin(),
+              ClassList.end(),
+              [&](const MachO::ObjcClassMetadata &Lhs,
+                  const MachO::ObjcClassMetadata &Rhs) noexcept
+    {
+        return Collection.getString(Lhs.Name) <
+               Collection.getString(Rhs.Name);
+    });
+}
+
+[[nodiscard]] static uint64_t
+GetPrintedLineCount(
+    const MachO::ObjcMetadataCollection &Collection,
+    const struct PrintObjcMethodListOperation::Options &Options) noexcept
+{
+    auto Count = uint64_t();
+    for (const auto &Class : Collection.getClassList()) {
+        Count += 1;
+        Count += Class.InstanceMethods.Count;
+        Count += Class.ClassMethods.Count;
+
+        if (Options.PrintIvars) {
+            Count += Class.Ivars.Count;
+        }
+
+        if (Options.PrintProperties) {
+            Count += Class.Properties.Count;
+        }
+
+        if (Options.PrintProtocols) {
+            Count += Class.Protocols.Count;
+        }
+    }
+
+    return Count;
+}
+
+static void
+PrintMethodList(
+    const MachO::ObjcMetadataCollection &Collection,
+    const std::string_view ClassName,
+    const MachO::ObjcMetadataRange &Range,
+    const char Prefix,
+    const bool Is64Bit,
+    const char *const LinePrefix,
+    const struct PrintObjcMethodListOperation::Options &Options) noexcept
+{
+    for (const auto &Method : Collection.getMethodList(Range)) {
+        fprintf(Options.OutFile, "%s\t%c[", LinePrefix, Prefix);
+
+        PrintString(Options.OutFile, ClassName);
+        fputc(' ', Options.OutFile);
+        PrintString(Options.OutFile, Collection.getString(Method.Selector));
+        fputc(']', Options.OutFile);
+
+        if (Options.Verbose) {
+            PrintUtilsWriteOffset32Or64(Options.OutFile,
+                                        Is64Bit,
+                                        Method.Imp,
+                                        false,
+                                        " (Imp: ");
+
+            fputs(", Types: \"", Options.OutFile);
+            PrintString(Options.OutFile, Collection.getString(Method.Types));
+            fputs("\")", Options.OutFile);
+        }
+
+        fputc('\n', Options.OutFile);
+    }
+}
+
+static void
+PrintClass(const MachO::ObjcMetadataCollection &Collection,
+           const MachO::ObjcClassMetadata &Class,
+           const bool Is64Bit,
+           const char *const LinePrefix,
+           const struct PrintObjcMethodListOperation::Options &Options) noexcept
+{
+    const auto ClassName = Collection.getString(Class.Name);
+
+    fprintf(Options.OutFile, "%sClass \"", LinePrefix);
+    PrintString(Options.OutFile, ClassName);
+    fputc('"', Options.OutFile);
+
+    if (Options.Verbose) {
+        PrintUtilsWriteOffset32Or64(Options.OutFile,
+                                    Is64Bit,
+                                    Class.Address,
+                                    false,
+                                    " (",
+                                    ")");
+    }
+
+    fputc('\n', Options.OutFile);
+    if (Options.PrintProtocols) {
+        for (const auto &Protocol : Collection.getProtocolList(Class.Protocols))
+        {
+            fprintf(Options.OutFile, "%s\tProtocol \"", LinePrefix);
+            PrintString(Options.OutFile, Collection.getString(Protocol));
+            fputs("\"\n", Options.OutFile);
+        }
+    }
+
+    if (Options.PrintIvars) {
+        for (const auto &Ivar : Collection.getIvarList(Class.Ivars)) {
+            fprintf(Options.OutFile, "%s\tIvar \"", LinePrefix);
+            PrintString(Options.OutFile, Collection.getString(Ivar.Name));
+            fprintf(Options.OutFile,
+                    "\" (Offset: %" PRIu32 ", Size: %" PRIu32 ", Type: \"",
+                    Ivar.Offset,
+                    Ivar.Size);
+
+            PrintString(Options.OutFile, Collection.getString(Ivar.Type));
+            fputs("\")\n", Options.OutFile);
+        }
+    }
+
+    if (Options.PrintProperties) {
+        for (const auto &Property :
+                Collection.getPropertyList(Class.Properties))
+        {
+            fprintf(Options.OutFile, "%s\tProperty \"", LinePrefix);
+            PrintString(Options.OutFile, Collection.getString(Property.Name));
+            fputs("\" (Attributes: \"", Options.OutFile);
+            PrintString(Options.OutFile,
+                        Collection.getString(Property.Attributes));
+            fputs("\")\n", Options.OutFile);
+        }
+    }
+
+    PrintMethodList(Collection,
+                    ClassName,
+                    Class.InstanceMethods,
+                    '-',
+                    Is64Bit,
+                    LinePrefix,
+                    Options);
+
+    PrintMethodList(Collection,
+                    ClassName,
+                    Class.ClassMethods,
+                    '+',
+                    Is64Bit,
+                    LinePrefix,
+                    Options);
+}
+
+static void
+WriteMethodListRecords(RecordWriter &Writer,
+                       const MachO::ObjcMetadataCollection &Collection,
+                       const std::string_view ImagePath,
+                       const std::string_view ClassName,
+                       const MachO::ObjcMetadataRange &Range,
+                       const std::string_view Kind) noexcept
+{
+    for (const auto &Method : Collection.getMethodList(Range)) {
+        Writer.beginRecord();
+        if (!ImagePath.empty()) {
+            Writer.writeString("image", ImagePath);
+        }
+
+        Writer.writeString("class", ClassName);
+        Writer.writeString("kind", Kind);
+        Writer.writeString("name", Collection.getString(Method.Selector));
+        Writer.writeString("types", Collection.getString(Method.Types));
+        Writer.writeNumber("imp", Method.Imp);
+        Writer.endRecord();
+    }
+}
+
+// Writes a record for every method, and for every ivar, property and protocol
+// that was asked for, with the "kind" field telling them apart.
+
+static void
+WriteCollectionRecords(
+    RecordWriter &Writer,
+    const MachO::ObjcMetadataCollection &Collection,
+    const std::string_view ImagePath,
+    const struct PrintObjcMethodListOperation::Options &Options) noexcept
+{
+    const auto BeginRecord = [&](const std::string_view ClassName,
+                                 const std::string_view Kind) noexcept
+    {
+        Writer.beginRecord();
+        if (!ImagePath.empty()) {
+            Writer.writeString("image", ImagePath);
+        }
+
+        Writer.writeString("class", ClassName);
+        Writer.writeString("kind", Kind);
+    };
+
+    for (const auto &Class : Collection.getClassList()) {
+        const auto ClassName = Collection.getString(Class.Name);
+        if (Options.PrintProtocols) {
+            for (const auto &Protocol :
+                    Collection.getProtocolList(Class.Protocols))
+            {
+                BeginRecord(ClassName, "protocol");
+                Writer.writeString("name", Collection.getString(Protocol));
+                Writer.endRecord();
+            }
+        }
+
+        if (Options.PrintIvars) {
+            for (const auto &Ivar : Collection.getIvarList(Class.Ivars)) {
+                BeginRecord(ClassName, "ivar");
+                Writer.writeString("name", Collection.getString(Ivar.Name));
+                Writer.writeString("types", Collection.getString(Ivar.Type));
+                Writer.writeNumber("offset", Ivar.Offset);
+                Writer.writeNumber("size", Ivar.Size);
+                Writer.endRecord();
+            }
+        }
+
+        if (Options.PrintProperties) {
+            for (const auto &Property :
+                    Collection.getPropertyList(Class.Properties))
+            {
+                BeginRecord(ClassName, "property");
+                Writer.writeString("name",
+                                   Collection.getString(Property.Name));
+                Writer.writeString("attributes",
+                                   Collection.getString(Property.Attributes));
+                Writer.endRecord();
+            }
+        }
+
+        WriteMethodListRecords(Writer,
+                               Collection,
+                               ImagePath,
+                               ClassName,
+                               Class.InstanceMethods,
+                               "instance-method");
+
+        WriteMethodListRecords(Writer,
+                               Collection,
+                               ImagePath,
+                               ClassName,
+                               Class.ClassMethods,
+                               "class-method");
+    }
+}
+
+static int
+PrintObjcMethodList(
+    MachO::ObjcMetadataCollection &Collection,
+    const bool Is64Bit,
+    const struct PrintObjcMethodListOperation::Options &Options) noexcept
+{
+    if (Options.Sort) {
+        SortClassList(Collection);
+    }
+
+    if (Options.isRecordFormat()) {
+        auto Writer = Options.GetRecordWriter();
+
+        Writer.beginList();
+        WriteCollectionRecords(Writer, Collection, std::string_view(), Options);
+        Writer.endList();
+
+        return 0;
+    }
+
+    if (Collection.empty()) {
+        fputs("Provided file has no Objective-C Classes\n", Options.OutFile);
+        return 0;
+    }
+
+    Operation::PrintLineSpamWarning(Options.OutFile,
+                                    GetPrintedLineCount(Collection, Options));
+
+    fprintf(Options.OutFile,
+            "Provided file has %" PRIuPTR " Objective-C Classes with "
+            "%" PRIuPTR " Methods:\n",
+            Collection.getClassList().size(),
+            Collection.getMethodCount());
+
+    for (const auto &Class : Collection.getClassList()) {
+        PrintClass(Collection, Class, Is64Bit, "", Options);
+    }
+
+    return 0;
+}
+
+int
+PrintObjcMethodListOperation::Run(const MachOMemoryObject &Object,
+                                  const struct Options &Options) noexcept
+{
+    const auto LoadCmdStorage =
+        OperationCommon::GetConstLoadCommandStorage(Object, Options.ErrFile);
+
+    if (LoadCmdStorage.hasError()) {
+        return 1;
+    }
+
+    auto Error = MachO::SegmentInfoCollection::Error::None;
+
+    const auto Is64Bit = Object.is64Bit();
+    const auto SegmentCollection =
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
+                                           Is64Bit,
+                                           &Error);
+
+    if (Error != MachO::SegmentInfoCollection::Error::None) {
+        fputs("Provided file has an invalid segment-list\n", Options.ErrFile);
+        return 1;
+    }
+
+    const auto DeVirtualizer =
+        MachO::ConstDeVirtualizer(Object.getMap(), SegmentCollection);
+
+    auto Collection =
+        MachO::ObjcMetadataCollection::Open(SegmentCollection,
+                                            DeVirtualizer,
+                                            Object.isBigEndian(),
+                                            Is64Bit);
+
+    return PrintObjcMethodList(Collection, Is64Bit, Options);
+}
+
+int
+PrintObjcMethodListOperation::Run(const DscImageMemoryObject &Object,
+                                  const struct Options &Options) noexcept
+{
+    const auto LoadCmdStorage =
+        OperationCommon::GetConstLoadCommandStorage(Object, Options.ErrFile);
+
+    if (LoadCmdStorage.hasError()) {
+        return 1;
+    }
+
+    auto Error = MachO::SegmentInfoCollection::Error::None;
+
+    const auto Is64Bit = Object.is64Bit();
+    const auto SegmentCollection =
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
+                                           Is64Bit,
+                                           &Error);
+
+    if (Error != MachO::SegmentInfoCollection::Error::None) {
+        fputs("Provided image has an invalid segment-list\n", Options.ErrFile);
+        return 1;
+    }
+
+    const auto MappingList =
+        Object.getDscHeaderV0().getConstMappingInfoList();
+    const auto DeVirtualizer =
+        DscImage::ConstDeVirtualizer(Object.getDscMap(),
+                                     MappingList,
+                                     Object.getRebasedView());
+
+    auto Collection =
+        DscImage::ObjcMetadataCollection::Open(SegmentCollection,
+                                               DeVirtualizer,
+                                               Object.isBigEndian(),
+                                               Is64Bit);
+
+    return PrintObjcMethodList(Collection, Is64Bit, Options);
+}
+
+static void
+ParseImage(const DscMemoryObject &Object,
+           const DyldSharedCache::ImageInfo &ImageInfo,
+           const DscImage::ConstDeVirtualizer &DeVirtualizer,
+           const std::optional<uint64_t> RelativeSelectorBase,
+           ImageMetadata &MetadataOut) noexcept
+{
+    const auto ImageOrError = Object.GetImageWithInfo(ImageInfo);
+    if (ImageOrError.hasError()) {
+        MetadataOut.FailedToParse = true;
+        return;
+    }
+
+    const auto Image =
+        std::unique_ptr<const DscImageMemoryObject>(ImageOrError.value());
+
+    const auto LoadCmdStorage = Image->GetLoadCommandsStorage();
+    if (LoadCmdStorage.hasError()) {
+        MetadataOut.FailedToParse = true;
+        return;
+    }
+
+    const auto Is64Bit = Image->is64Bit();
+
+    auto Error = MachO::SegmentInfoCollection::Error::None;
+    const auto SegmentCollection =
+        MachO::SegmentInfoCollection::Open(Image->getLoadCommandIndex(),
+                                           Is64Bit,
+                                           &Error);
+
+    if (Error != MachO::SegmentInfoCollection::Error::None) {
+        MetadataOut.FailedToParse = true;
+        return;
+    }
+
+    MetadataOut.Is64Bit = Is64Bit;
+    MetadataOut.Collection =
+        DscImage::ObjcMetadataCollection::Open(SegmentCollection,
+                                               DeVirtualizer,
+                                               Image->isBigEndian(),
+                                               Is64Bit,
+                                               RelativeSelectorBase);
+}
+
+// Images are handed out to threads one at a time, as the amount of classes
+// varies greatly between images. Every image has its own collection, so no
+// locking is needed beyond picking the next image.
+
+static void
+ParseImageList(const DscMemoryObject &Object,
+               const DscImage::ConstDeVirtualizer &DeVirtualizer,
+               const std::optional<uint64_t> RelativeSelectorBase,
+               std::vector<ImageMetadata> &ListOut) noexcept
+{
+    const auto ImageCount = Object.getImageCount();
+    const auto ThreadCount =
+        std::clamp(std::thread::hardware_concurrency(), 1u, ImageCount);
+
+    auto NextImageIndex = std::atomic<uint32_t>();
+    const auto ParseImages = [&]() noexcept {
+        for (auto Index = NextImageIndex++;
+             Index < ImageCount;
+             Index = NextImageIndex++)
+        {
+            ParseImage(Object,
+                       Object.getImageInfoAtIndex(Index),
+                       DeVirtualizer,
+                       RelativeSelectorBase,
+                       ListOut[Index]);
+        }
+    };
+
+    auto ThreadList = std::vector<std::thread>();
+    ThreadList.reserve(ThreadCount - 1);
+
+    for (auto I = 1u; I != ThreadCount; I++) {
+        ThreadList.emplace_back(ParseImages);
+    }
+
+    ParseImages();
+    for (auto &Thread : ThreadList) {
+        Thread.join();
+    }
+}
+
+int
+PrintObjcMethodListOperation::Run(const DscMemoryObject &Object,
+                                  const struct Options &Options) noexcept
+{
+    const auto ImageCount = Object.getImageCount();
+    if (ImageCount == 0) {
+        fputs("Provided file has no images\n", Options.ErrFile);
+        return 1;
+    }
+
+    const auto Map = Object.getMap().getBegin();
+    const auto DeVirtualizer =
+        DscImage::ConstDeVirtualizer(Object.getMap(),
+                                     Object.getConstMappingInfoList(),
+                                     Object.getRebasedView());
+
+    // Relative method-lists in the shared-cache store their selectors as
+    // offsets from a base found in the Objective-C optimization-tables. Caches
+    // without a base still have selector-references to read instead.
+
+    auto ObjcOpt = std::optional<DyldSharedCache::ObjcOptInfo>();
+    auto RelativeSelectorBase = std::optional<uint64_t>();
+
+    if (OperationCommon::GetDscObjcOptInfo(nullptr, Object, ObjcOpt) == 0) {
+        RelativeSelectorBase = ObjcOpt->getRelativeSelectorBase();
+    }
+
+    auto ImageList = std::vector<ImageMetadata>(ImageCount);
+    ParseImageList(Object, DeVirtualizer, RelativeSelectorBase, ImageList);
+
+    const auto FailedCount =
+        std::count_if(ImageList.cbegin(),
+                      ImageList.cend(),
+                      [](const ImageMetadata &Image) noexcept {
+                          return Image.FailedToParse;
+                      });
+
+    if (FailedCount != 0) {
+        fprintf(Options.ErrFile,
+                "Warning: Skipped %" PRIdPTR " images that could not be "
+                "parsed\n",
+                FailedCount);
+    }
+
+    if (Options.Sort) {
+        for (auto &Image : ImageList) {
+            SortClassList(Image.Collection);
+        }
+    }
+
+    if (Options.isRecordFormat()) {
+        auto Writer = Options.GetRecordWriter();
+        auto Index = uint32_t();
+
+        Writer.beginList();
+        for (const auto &Image : ImageList) {
+            const auto Path =
+                std::string_view(
+                    Object.getImageInfoAtIndex(Index).getPath(Map));
+
+            WriteCollectionRecords(Writer, Image.Collection, Path, Options);
+            Index++;
+        }
+
+        Writer.endList();
+        return 0;
+    }
+
+    auto ClassCount = uint64_t();
+    auto MethodCount = uint64_t();
+    auto LineCount = uint64_t();
+
+    for (const auto &Image : ImageList) {
+        if (Image.Collection.empty()) {
+            continue;
+        }
+
+        ClassCount += Image.Collection.getClassList().size();
+        MethodCount += Image.Collection.getMethodCount();
+        LineCount += GetPrintedLineCount(Image.Collection, Options) + 1;
+    }
+
+    if (ClassCount == 0) {
+        fputs("Provided file has no Objective-C Classes\n", Options.OutFile);
+        return 0;
+    }
+
+    Operation::PrintLineSpamWarning(Options.OutFile, LineCount);
+    fprintf(Options.OutFile,
+            "Provided file has %" PRIu64 " Objective-C Classes with "
+            "%" PRIu64 " Methods:\n",
+            ClassCount,
+            MethodCount);
+
+    const auto ImageCountDigitLength =
+        PrintUtilsGetIntegerDigitLength(ImageCount);
+
+    auto Index = uint32_t();
+    for (const auto &Image : ImageList) {
+        if (Image.Collection.empty()) {
+            Index++;
+            continue;
+        }
+
+        const auto &Info = Object.getImageInfoAtIndex(Index);
+        fprintf(Options.OutFile,
+                "Image %0*" PRIu32 ": \"%s\"\n",
+                ImageCountDigitLength,
+                Index + 1,
+                Info.getPath(Map));
+
+        for (const auto &Class : Image.Collection.getClassList()) {
+            PrintClass(Image.Collection, Class, Image.Is64Bit, "\t", Options);
+        }
+
+        Index++;
+    }
+
+    return 0;
+}
+
+auto
+PrintObjcMethodListOperation::ParseOptionsImpl(const ArgvArray &Argv,
+                                               int *const IndexOut) noexcept
+    -> struct PrintObjcMethodListOperation::Options
+{
+    auto Index = int();
+    struct Options Options;
+
+    for (const auto &Argument : Argv) {
+        if (strcmp(Argument, "-v") == 0 || strcmp(Argument, "--verbose") == 0) {
+            Options.Verbose = true;
+        } else if (strcmp(Argument, "--include-ivars") == 0) {
+            Options.PrintIvars = true;
+        } else if (strcmp(Argument, "--include-properties") == 0) {
+            Options.PrintProperties = true;
+        } else if (strcmp(Argument, "--include-protocols") == 0) {
+            Options.PrintProtocols = true;
+        } else if (strcmp(Argument, "--sort") == 0) {
+            Options.Sort = true;
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
+        } else if (!Argument.isOption()) {
+            break;
+        } else {
+            fprintf(stderr,
+                    "Unrecognized argument for operation %s: %s\n",
+                    OperationKindInfo<OpKind>::Name.data(),
+                    Argument.getString());
+            exit(1);
+        }
+
+        Index++;
+    }
+
+    if (IndexOut != nullptr) {
+        *IndexOut = Index;
+    }
+
+    return Options;
+}
+
+int PrintObjcMethodListOperation::ParseOptions(const ArgvArray &Argv) noexcept
+{
+    auto Index = int();
+    Options = ParseOptionsImpl(Argv, &Index);
+
+    return Index;
+}
+
+int
+PrintObjcMethodListOperation::Run(const MemoryObject &Object) const noexcept {
+    switch (Object.getKind()) {
+        case ObjectKind::None:
+            assert(0 && "Object-Kind is None");
+        case ObjectKind::MachO:
+            return Run(cast<ObjectKind::MachO>(Object), Options);
+        case ObjectKind::DscImage:
+            return Run(cast<ObjectKind::DscImage>(Object), Options);
+        case ObjectKind::DyldSharedCache:
+            return Run(cast<ObjectKind::DyldSharedCache>(Object), Options);
+        case ObjectKind::FatMachO:
+            return InvalidObjectKind;
+    }
+
+    assert(0 && "Unrecognized Object-Kind");
+}
@@ -13,6 +13,8 @@
 #include "Operations/Operation.h"
 #include "Operations/PrintRebaseActionList.h"
 
+#include "ADT/Mach-O/RebaseUtil.h"
+
 #include "Utils/PrintUtils.h"
 
 PrintRebaseActionListOperation::PrintRebaseActionListOperation() noexcept
@@ -64,6 +66,147 @@ PrintRebaseAction(
     fputc('\n', Options.OutFile);
 }
 
+static void
+WriteRebaseActionRecord(
+    RecordWriter &Writer,
+    const MachO::RebaseActionInfo &Action,
+    const MachO::SegmentInfoCollection &SegmentCollection) noexcept
+{
+    Writer.beginRecord();
+    if (const auto Name = MachO::RebaseWriteKindGetName(Action.Kind)) {
+        Writer.writeString("write_kind", Name.value());
+    } else {
+        Writer.writeNull("write_kind");
+    }
+
+    if (const auto *Segment = SegmentCollection.atOrNull(Action.SegmentIndex)) {
+        const auto FullAddr =
+            Segment->getMemoryRange().getBegin() + Action.AddrInSeg;
+
+        OperationCommon::WriteSegmentSectionFields(
+            Writer,
+            Segment,
+            Segment->FindSectionContainingAddress(FullAddr));
+
+        Writer.writeNumber("address", FullAddr);
+    } else {
+        OperationCommon::WriteSegmentSectionFields(Writer, nullptr, nullptr);
+        Writer.writeNull("address");
+    }
+
+    Writer.writeNumber("segment_index", Action.SegmentIndex);
+    Writer.writeNumber("segment_offset", Action.AddrInSeg);
+    Writer.endRecord();
+}
+
+template <typename T>
+static void
+PrintRebaseActions(
+    const uint64_t ListSize,
+    const T &ForEachAction,
+    const MachO::SegmentInfoCollection &SegmentCollection,
+    const bool Is64Bit,
+    const struct PrintRebaseActionListOperation::Options &Options) noexcept
+{
+    if (ListSize == 0) {
+        fputs("No Rebase-Info\n", Options.OutFile);
+        return;
+    }
+
+    Operation::PrintLineSpamWarning(Options.OutFile, ListSize);
+    switch (ListSize) {
+        case 0:
+            assert(0 && "Rebase-Action List shouldn't be empty at this point");
+        case 1:
+            fputs("1 Rebase Action:\n", Options.OutFile);
+            break;
+        default:
+            fprintf(Options.OutFile,
+                    "%" PRIu64 " Rebase Actions:\n",
+                    ListSize);
+            break;
+    }
+
+    auto Counter = 1ull;
+    const auto SizeDigitLength = PrintUtilsGetIntegerDigitLength(ListSize);
+
+    ForEachAction([&](const MachO::RebaseActionInfo &Action) noexcept {
+        PrintRebaseAction(Counter,
+                          SizeDigitLength,
+                          Action,
+                          SegmentCollection,
+                          Is64Bit,
+                          Options);
+        Counter++;
+    });
+}
+
+static void
+HandleRebaseActionCollectionError(
+    FILE *const ErrFile,
+    const MachO::RebaseActionCollection::Error Error) noexcept
+{
+    switch (Error) {
+        case MachO::RebaseActionCollection::Error::None:
+            break;
+        case MachO::RebaseActionCollection::Error::ActionOutsideSegment:
+            fputs("Warning: Rebase-Actions outside of their segment were "
+                  "skipped\n",
+                  ErrFile);
+            break;
+    }
+}
+
+static int
+WriteRebaseActionListRecords(
+    const MachO::RebaseActionList &List,
+    const MachO::SegmentInfoCollection &SegmentCollection,
+    const bool Is64Bit,
+    const struct PrintRebaseActionListOperation::Options &Options) noexcept
+{
+    auto Writer = Options.GetRecordWriter();
+    auto ParseError = MachO::RebaseOpcodeParseError::None;
+
+    Writer.beginList();
+    if (!Options.Sort) {
+        // Without a sort, write out each action as soon as it's decoded
+        // instead of collecting the entire list first.
+
+        for (const auto &Iter : List) {
+            ParseError = Iter.getError();
+            if (!Iter.CanIgnoreError(ParseError)) {
+                break;
+            }
+
+            WriteRebaseActionRecord(Writer,
+                                    Iter.GetAction(),
+                                    SegmentCollection);
+        }
+    } else {
+        // The collection's bitmap is already ordered by address, so there's
+        // nothing left to sort.
+
+        auto CollectionError = MachO::RebaseActionCollection::Error::None;
+        const auto Collection =
+            MachO::RebaseActionCollection::Open(SegmentCollection,
+                                                List,
+                                                Is64Bit,
+                                                &ParseError,
+                                                &CollectionError);
+
+        Collection.forEach([&](const MachO::RebaseActionInfo &Action) noexcept {
+            WriteRebaseActionRecord(Writer, Action, SegmentCollection);
+        });
+
+        HandleRebaseActionCollectionError(Options.ErrFile, CollectionError);
+    }
+
+    Writer.endList();
+    OperationCommon::HandleRebaseOpcodeParseError(Options.ErrFile, ParseError);
+
+    return 0;
+}
+
 static int
 PrintRebaseActionList(
     const MachOMemoryObject &Object,
@@ -127,7 +270,7 @@ PrintRebaseActionList(
 
     const auto Is64Bit = Object.is64Bit();
     const auto SegmentCollection =
-        MachO::SegmentInfoCollection::Open(LoadCmdStorage,
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
                                            Is64Bit,
                                            &SegmentCollectionError);
 
@@ -149,59 +292,56 @@ PrintRebaseActionList(
             return 1;
     }
 
-    auto RebaseActionInfoList = std::vector<MachO::RebaseActionInfo>();
+    if (Options.isRecordFormat()) {
+        return WriteRebaseActionListRecords(*RebaseActionListOpt.value(),
+                                            SegmentCollection,
+                                            Is64Bit,
+                                            Options);
+    }
 
     const auto RebaseActionList = *RebaseActionListOpt.value();
-    const auto RebaseActionListError =
-        RebaseActionList.GetAsList(RebaseActionInfoList);
-
     if (Options.Sort) {
-        const auto Comparator =
-            [&](const MachO::RebaseActionInfo &Lhs,
-                const MachO::RebaseActionInfo &Rhs) noexcept
-        {
-            return (Lhs.AddrInSeg < Rhs.AddrInSeg);
+        auto ParseError = MachO::RebaseOpcodeParseError::None;
+        auto CollectionError = MachO::RebaseActionCollection::Error::None;
+
+        const auto Collection =
+            MachO::RebaseActionCollection::Open(SegmentCollection,
+                                                RebaseActionList,
+                                                Is64Bit,
+                                                &ParseError,
+                                                &CollectionError);
+
+        const auto ForEachAction = [&](const auto &Callback) noexcept {
+            Collection.forEach(Callback);
         };
 
+        PrintRebaseActions(Collection.size(),
+                           ForEachAction,
+                           SegmentCollection,
+                           Is64Bit,
+                           Options);
 
-        std::sort(RebaseActionInfoList.begin(),
-                  RebaseActionInfoList.end(),
-                  Comparator);
-    }
-
-    if (RebaseActionInfoList.empty()) {
-        fputs("No Rebase-Info\n", Options.OutFile);
+        HandleRebaseActionCollectionError(Options.ErrFile, CollectionError);
+        OperationCommon::HandleRebaseOpcodeParseError(Options.ErrFile,
+                                                      ParseError);
         return 0;
     }
 
-    const auto ListSize = RebaseActionInfoList.size();
-    Operation::PrintLineSpamWarning(Options.OutFile, ListSize);
-
-    switch (ListSize) {
-        case 0:
-            assert(0 && "Rebase-Action List shouldn't be empty at this point");
-        case 1:
-            fputs("1 Rebase Action:\n", Options.OutFile);
-            break;
-        default:
-            fprintf(Options.OutFile,
-                    "%" PRIuPTR " Rebase Actions:\n",
-                    ListSize);
-            break;
-    }
+    auto RebaseActionInfoList = std::vector<MachO::RebaseActionInfo>();
+    const auto RebaseActionListError =
+        RebaseActionList.GetAsList(RebaseActionInfoList);
 
-    auto Counter = 1ull;
-    const auto SizeDigitLength = PrintUtilsGetIntegerDigitLength(ListSize);
+    const auto ForEachAction = [&](const auto &Callback) noexcept {
+        for (const auto &Action : RebaseActionInfoList) {
+            Callback(Action);
+        }
+    };
 
-    for (const auto &Action : RebaseActionInfoList) {
-        PrintRebaseAction(Counter,
-                          SizeDigitLength,
-                          Action,
-                          SegmentCollection,
-                          Is64Bit,
-                          Options);
-        Counter++;
-    }
+    PrintRebaseActions(RebaseActionInfoList.size(),
+                       ForEachAction,
+                       SegmentCollection,
+                       Is64Bit,
+                       Options);
 
     OperationCommon::HandleRebaseOpcodeParseError(Options.ErrFile,
                                                   RebaseActionListError);
@@ -236,6 +376,10 @@ PrintRebaseActionListOperation::ParseOptionsImpl(const ArgvArray &Argv,
             Options.Verbose = true;
         } else if (strcmp(Argument, "--sort") == 0) {
             Options.Sort = true;
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
         } else if (!Argument.isOption()) {
             break;
         } else {
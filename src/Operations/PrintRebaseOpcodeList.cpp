@@ -213,7 +213,7 @@ PrintRebaseOpcodeList(
     auto DyldInfo = static_cast<const MachO::DyldInfoCommand *>(nullptr);
     const auto GetDyldInfoResult =
         OperationCommon::GetDyldInfoCommand(Options.ErrFile,
-                                            LoadCmdStorage,
+                                            Object.getLoadCommandIndex(),
                                             DyldInfo);
 
     if (GetDyldInfoResult != 0) {
@@ -237,7 +237,7 @@ PrintRebaseOpcodeList(
 
     const auto Is64Bit = Object.is64Bit();
     const auto SegmentCollection =
-        MachO::SegmentInfoCollection::Open(LoadCmdStorage,
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
                                            Is64Bit,
                                            &SegmentCollectionError);
 
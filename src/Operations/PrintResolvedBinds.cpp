@@ -0,0 +1,581 @@
+//
+//  Operations/PrintResolvedBinds.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+
+#include "Operations/Common.h"
+#include "Operations/Operation.h"
+#include "Operations/PrintResolvedBinds.h"
+
+#include "Utils/PrintUtils.h"
+
+PrintResolvedBindsOperation::PrintResolvedBindsOperation() noexcept
+: Operation(OpKind) {}
+
+PrintResolvedBindsOperation::PrintResolvedBindsOperation(
+    const struct Options &Options) noexcept
+: Operation(OpKind), Options(Options) {}
+
+using SymbolResolver = DyldSharedCache::SymbolResolver;
+
+// Weak-binds don't carry a dylib-ordinal, and are instead looked up in every
+// image, as with BIND_SPECIAL_DYLIB_WEAK_LOOKUP.
+
+constexpr static auto WeakLookupDylibOrdinal = int64_t(-3);
+
+struct ResolvedBindInfo {
+    MachO::BindInfoKind Kind;
+
+    uint64_t Address = 0;
+    int64_t DylibOrdinal = 0;
+
+    std::string_view SymbolName;
+    SymbolResolver::Resolution Resolution;
+};
+
+struct ImageBindList {
+    std::vector<ResolvedBindInfo> BindList;
+    uint64_t UnresolvedCount = 0;
+
+    bool Parsed : 1 = false;
+};
+
+[[nodiscard]] static std::string_view
+GetBindKindName(const MachO::BindInfoKind Kind) noexcept {
+    switch (Kind) {
+        case MachO::BindInfoKind::Normal:
+            return "bind";
+        case MachO::BindInfoKind::Lazy:
+            return "lazy-bind";
+        case MachO::BindInfoKind::Weak:
+            return "weak-bind";
+    }
+
+    assert(0 && "Unrecognized Bind-Info Kind");
+}
+
+[[nodiscard]] static std::string_view
+GetStatusName(const SymbolResolver::StatusKind Status) noexcept {
+    switch (Status) {
+        case SymbolResolver::StatusKind::Resolved:
+            return "resolved";
+        case SymbolResolver::StatusKind::SymbolNotFound:
+            return "symbol-not-found";
+        case SymbolResolver::StatusKind::LibraryNotInCache:
+            return "library-not-in-cache";
+        case SymbolResolver::StatusKind::InvalidDylibOrdinal:
+            return "invalid-dylib-ordinal";
+        case SymbolResolver::StatusKind::InMainExecutable:
+            return "main-executable";
+        case SymbolResolver::StatusKind::ImageNotParsed:
+            return "image-not-parsed";
+        case SymbolResolver::StatusKind::ReexportTooDeep:
+            return "reexport-too-deep";
+    }
+
+    assert(0 && "Unrecognized Status-Kind");
+}
+
+[[nodiscard]] static std::string_view
+GetStatusDescription(const SymbolResolver::StatusKind Status) noexcept {
+    switch (Status) {
+        case SymbolResolver::StatusKind::Resolved:
+            return "Resolved";
+        case SymbolResolver::StatusKind::SymbolNotFound:
+            return "Symbol not found";
+        case SymbolResolver::StatusKind::LibraryNotInCache:
+            return "Library not in shared-cache";
+        case SymbolResolver::StatusKind::InvalidDylibOrdinal:
+            return "Invalid dylib-ordinal";
+        case SymbolResolver::StatusKind::InMainExecutable:
+            return "Bound to the main-executable";
+        case SymbolResolver::StatusKind::ImageNotParsed:
+            return "Library could not be parsed";
+        case SymbolResolver::StatusKind::ReexportTooDeep:
+            return "Re-exported too many times";
+    }
+
+    assert(0 && "Unrecognized Status-Kind");
+}
+
+[[nodiscard]] static std::optional<uint32_t>
+FindNodeForPath(const DscMemoryObject &Object,
+                const std::string_view Path) noexcept
+{
+    const auto Map = Object.getMap().getBegin();
+    const auto ImageCount = Object.getImageCount();
+
+    auto Address = std::optional<uint64_t>();
+    for (auto Index = uint32_t(); Index != ImageCount; Index++) {
+        const auto &Info = Object.getImageInfoAtIndex(Index);
+        if (Info.getPath(Map) == Path) {
+            Address = Info.Address;
+            break;
+        }
+    }
+
+    if (!Address.has_value()) {
+        return std::nullopt;
+    }
+
+    for (auto Index = uint32_t(); Index != ImageCount; Index++) {
+        if (Object.getImageInfoAtIndex(Index).Address == Address.value()) {
+            return Index;
+        }
+    }
+
+    return std::nullopt;
+}
+
+static void
+ResolveBindsOfImage(const DscMemoryObject &Object,
+                    SymbolResolver &Resolver,
+                    const uint32_t Node,
+                    ImageBindList &ListOut) noexcept
+{
+    const auto ImageOrError =
+        Object.GetImageWithInfo(Object.getImageInfoAtIndex(Node));
+
+    if (ImageOrError.hasError()) {
+        return;
+    }
+
+    const auto Image =
+        std::unique_ptr<const DscImageMemoryObject>(ImageOrError.value());
+
+    const auto LoadCmdStorage = Image->GetLoadCommandsStorage();
+    if (LoadCmdStorage.hasError()) {
+        return;
+    }
+
+    ListOut.Parsed = true;
+
+    const auto IsBigEndian = LoadCmdStorage.isBigEndian();
+    const auto *DyldInfo = static_cast<const MachO::DyldInfoCommand *>(nullptr);
+
+    for (const auto &LC : LoadCmdStorage) {
+        DyldInfo = dyn_cast<MachO::DyldInfoCommand>(LC, IsBigEndian);
+        if (DyldInfo != nullptr) {
+            break;
+        }
+    }
+
+    // Images without dyld-info were bound when the cache was built.
+
+    if (DyldInfo == nullptr) {
+        return;
+    }
+
+    const auto Is64Bit = Image->is64Bit();
+    const auto &Map = Image->getDscMap();
+
+    auto SegmentCollectionError = MachO::SegmentInfoCollection::Error::None;
+    const auto SegmentCollection =
+        MachO::SegmentInfoCollection::Open(Image->getLoadCommandIndex(),
+                                           Is64Bit,
+                                           &SegmentCollectionError);
+
+    auto ActionList = std::vector<MachO::BindActionInfo>();
+    const auto AddList = [&](const auto &ListOpt) noexcept {
+        if (ListOpt.getError() != MachO::SizeRangeError::None) {
+            return;
+        }
+
+        ActionList.clear();
+        static_cast<void>(ListOpt.value()->GetAsList(ActionList));
+
+        for (const auto &Action : ActionList) {
+            const auto Segment =
+                SegmentCollection.atOrNull(Action.SegmentIndex);
+
+            const auto Address =
+                (Segment != nullptr) ?
+                    Segment->getMemoryRange().getBegin() + Action.AddrInSeg :
+                    Action.AddrInSeg;
+
+            const auto DylibOrdinal =
+                (Action.Kind == MachO::BindInfoKind::Weak) ?
+                    WeakLookupDylibOrdinal : Action.DylibOrdinal;
+
+            const auto Resolution =
+                Resolver.Resolve(Node, DylibOrdinal, Action.SymbolName);
+
+            if (!Resolution.isResolved()) {
+                ListOut.UnresolvedCount++;
+            }
+
+            ListOut.BindList.emplace_back(ResolvedBindInfo {
+                .Kind = Action.Kind,
+                .Address = Address,
+                .DylibOrdinal = Action.DylibOrdinal,
+                .SymbolName = Action.SymbolName,
+                .Resolution = Resolution
+            });
+        }
+    };
+
+    AddList(DyldInfo->GetBindActionList(Map,
+                                        SegmentCollection,
+                                        IsBigEndian,
+                                        Is64Bit));
+    AddList(DyldInfo->GetLazyBindActionList(Map,
+                                            SegmentCollection,
+                                            IsBigEndian,
+                                            Is64Bit));
+    AddList(DyldInfo->GetWeakBindActionList(Map,
+                                            SegmentCollection,
+                                            IsBigEndian,
+                                            Is64Bit));
+}
+
+static void
+WriteBindRecords(RecordWriter &Writer,
+                 const DscMemoryObject &Object,
+                 const uint32_t Node,
+                 const ImageBindList &List,
+                 const struct PrintResolvedBindsOperation::Options &Options)
+    noexcept
+{
+    const auto Map = Object.getMap().getBegin();
+    const auto Path = Object.getImageInfoAtIndex(Node).getPath(Map);
+
+    for (const auto &Bind : List.BindList) {
+        const auto &Resolution = Bind.Resolution;
+        if (Options.OnlyUnresolved && Resolution.isResolved()) {
+            continue;
+        }
+
+        Writer.beginRecord();
+        Writer.writeString("image", Path);
+        Writer.writeString("kind", GetBindKindName(Bind.Kind));
+        Writer.writeNumber("address", Bind.Address);
+        Writer.writeSignedNumber("dylib_ordinal", Bind.DylibOrdinal);
+        Writer.writeString("symbol", Bind.SymbolName);
+        Writer.writeString("status", GetStatusName(Resolution.Status));
+
+        if (Resolution.isResolved()) {
+            Writer.writeString(
+                "target_image",
+                Object.getImageInfoAtIndex(Resolution.Node).getPath(Map));
+            Writer.writeNumber("target_address", Resolution.Address);
+        } else {
+            Writer.writeNull("target_image");
+            Writer.writeNull("target_address");
+        }
+
+        Writer.endRecord();
+    }
+}
+
+static void
+PrintBindList(const DscMemoryObject &Object,
+              const ImageBindList &List,
+              const struct PrintResolvedBindsOperation::Options &Options)
+    noexcept
+{
+    const auto Map = Object.getMap().getBegin();
+    const auto DigitLength =
+        PrintUtilsGetIntegerDigitLength(List.BindList.size());
+
+    auto Counter = uint64_t();
+    for (const auto &Bind : List.BindList) {
+        const auto &Resolution = Bind.Resolution;
+
+        Counter++;
+        if (Options.OnlyUnresolved && Resolution.isResolved()) {
+            continue;
+        }
+
+        fprintf(Options.OutFile, "Bind %0*" PRIu64 ": ", DigitLength, Counter);
+        PrintUtilsWriteOffset(Options.OutFile, Bind.Address);
+
+        if (Options.Verbose) {
+            fprintf(Options.OutFile,
+                    " <%s, Ordinal %" PRId64 ">",
+                    GetBindKindName(Bind.Kind).data(),
+                    Bind.DylibOrdinal);
+        }
+
+        fprintf(Options.OutFile,
+                " \"%.*s\" -> ",
+                static_cast<int>(Bind.SymbolName.length()),
+                Bind.SymbolName.data());
+
+        if (!Resolution.isResolved()) {
+            fprintf(Options.OutFile,
+                    "<%s>\n",
+                    GetStatusDescription(Resolution.Status).data());
+            continue;
+        }
+
+        PrintUtilsWriteOffset(Options.OutFile, Resolution.Address, false);
+        fprintf(Options.OutFile,
+                " (\"%s\")\n",
+                Object.getImageInfoAtIndex(Resolution.Node).getPath(Map));
+    }
+}
+
+static int
+PrintResolvedBindsOfImage(
+    const DscMemoryObject &Object,
+    SymbolResolver &Resolver,
+    const struct PrintResolvedBindsOperation::Options &Options) noexcept
+{
+    const auto Node = FindNodeForPath(Object, Options.ImagePath);
+    if (!Node.has_value()) {
+        fprintf(Options.ErrFile,
+                "Provided file has no image with path \"%s\"\n",
+                Options.ImagePath.data());
+        return 1;
+    }
+
+    auto List = ImageBindList();
+    ResolveBindsOfImage(Object, Resolver, Node.value(), List);
+
+    if (!List.Parsed) {
+        fprintf(Options.ErrFile,
+                "Image \"%s\" could not be parsed\n",
+                Options.ImagePath.data());
+        return 1;
+    }
+
+    if (Options.isRecordFormat()) {
+        auto Writer = Options.GetRecordWriter();
+
+        Writer.beginList();
+        WriteBindRecords(Writer, Object, Node.value(), List, Options);
+        Writer.endList();
+
+        return 0;
+    }
+
+    if (List.BindList.empty()) {
+        fprintf(Options.OutFile,
+                "Image \"%s\" has no binds\n",
+                Options.ImagePath.data());
+        return 0;
+    }
+
+    fprintf(Options.OutFile,
+            "Image \"%s\" has %" PRIuPTR " binds, %" PRIu64 " unresolved:\n",
+            Options.ImagePath.data(),
+            List.BindList.size(),
+            List.UnresolvedCount);
+
+    PrintBindList(Object, List, Options);
+    return 0;
+}
+
+static int
+PrintResolvedBindsOfAllImages(
+    const DscMemoryObject &Object,
+    SymbolResolver &Resolver,
+    const struct PrintResolvedBindsOperation::Options &Options) noexcept
+{
+    // Aliases share the binds of their image, so only resolve the first
+    // image-info of every address.
+
+    const auto ImageCount = Object.getImageCount();
+
+    auto NodeList = std::vector<uint32_t>();
+    auto AddressSet = std::unordered_set<uint64_t>();
+
+    NodeList.reserve(ImageCount);
+    AddressSet.reserve(ImageCount);
+
+    for (auto Index = uint32_t(); Index != ImageCount; Index++) {
+        const auto &Info = Object.getImageInfoAtIndex(Index);
+        if (AddressSet.insert(Info.Address).second) {
+            NodeList.emplace_back(Index);
+        }
+    }
+
+    const auto NodeCount = static_cast<uint32_t>(NodeList.size());
+
+    auto ListList = std::vector<ImageBindList>(NodeCount);
+    auto NextIndex = std::atomic<uint32_t>();
+
+    const auto ResolveImages = [&]() noexcept {
+        for (auto Index = NextIndex++; Index < NodeCount; Index = NextIndex++) {
+            ResolveBindsOfImage(Object,
+                                Resolver,
+                                NodeList[Index],
+                                ListList[Index]);
+        }
+    };
+
+    const auto ThreadCount =
+        std::clamp(std::thread::hardware_concurrency(), 1u, NodeCount);
+
+    auto ThreadList = std::vector<std::thread>();
+    ThreadList.reserve(ThreadCount - 1);
+
+    for (auto I = 1u; I != ThreadCount; I++) {
+        ThreadList.emplace_back(ResolveImages);
+    }
+
+    ResolveImages();
+    for (auto &Thread : ThreadList) {
+        Thread.join();
+    }
+
+    auto FailedCount = uint32_t();
+    for (const auto &List : ListList) {
+        if (!List.Parsed) {
+            FailedCount++;
+        }
+    }
+
+    if (FailedCount != 0) {
+        fprintf(Options.ErrFile,
+                "Warning: Skipped %" PRIu32 " images that could not be "
+                "parsed\n",
+                FailedCount);
+    }
+
+    if (Options.isRecordFormat()) {
+        auto Writer = Options.GetRecordWriter();
+
+        Writer.beginList();
+        for (auto I = uint32_t(); I != NodeCount; I++) {
+            WriteBindRecords(Writer, Object, NodeList[I], ListList[I], Options);
+        }
+
+        Writer.endList();
+        return 0;
+    }
+
+    const auto Map = Object.getMap().getBegin();
+
+    auto BindCount = uint64_t();
+    auto UnresolvedCount = uint64_t();
+
+    for (auto I = uint32_t(); I != NodeCount; I++) {
+        const auto &List = ListList[I];
+        if (List.BindList.empty()) {
+            continue;
+        }
+
+        BindCount += List.BindList.size();
+        UnresolvedCount += List.UnresolvedCount;
+
+        if (Options.OnlyUnresolved && List.UnresolvedCount == 0) {
+            continue;
+        }
+
+        fprintf(Options.OutFile,
+                "Image \"%s\": %" PRIuPTR " binds, %" PRIu64 " unresolved\n",
+                Object.getImageInfoAtIndex(NodeList[I]).getPath(Map),
+                List.BindList.size(),
+                List.UnresolvedCount);
+
+        if (Options.OnlyUnresolved) {
+            PrintBindList(Object, List, Options);
+        }
+    }
+
+    fprintf(Options.OutFile,
+            "Resolved %" PRIu64 " of %" PRIu64 " binds across %" PRIu32
+            " images\n",
+            BindCount - UnresolvedCount,
+            BindCount,
+            NodeCount);
+
+    return 0;
+}
+
+int
+PrintResolvedBindsOperation::Run(const DscMemoryObject &Object,
+                                 const struct Options &Options) noexcept
+{
+    if (Object.getImageCount() == 0) {
+        fputs("Provided file has no images\n", Options.ErrFile);
+        return 1;
+    }
+
+    auto Resolver = OperationCommon::CreateDscSymbolResolver(Object);
+    if (!Options.ImagePath.empty()) {
+        return PrintResolvedBindsOfImage(Object, Resolver, Options);
+    }
+
+    return PrintResolvedBindsOfAllImages(Object, Resolver, Options);
+}
+
+auto
+PrintResolvedBindsOperation::ParseOptionsImpl(const ArgvArray &Argv,
+                                              int *const IndexOut) noexcept
+    -> struct PrintResolvedBindsOperation::Options
+{
+    auto Index = int();
+    struct Options Options;
+
+    for (const auto &Argument : Argv) {
+        if (strcmp(Argument, "-v") == 0 || strcmp(Argument, "--verbose") == 0) {
+            Options.Verbose = true;
+        } else if (strcmp(Argument, "--unresolved") == 0) {
+            Options.OnlyUnresolved = true;
+        } else if (Argument.GetStringView().starts_with("--image=")) {
+            Options.ImagePath =
+                Argument.GetStringView().substr(LENGTH_OF("--image="));
+
+            if (Options.ImagePath.empty()) {
+                fputs("Error: Provided option --image with an empty path\n",
+                      Options.ErrFile);
+                exit(1);
+            }
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
+        } else if (!Argument.isOption()) {
+            break;
+        } else {
+            fprintf(stderr,
+                    "Unrecognized argument for operation %s: %s\n",
+                    OperationKindInfo<OpKind>::Name.data(),
+                    Argument.getString());
+            exit(1);
+        }
+
+        Index++;
+    }
+
+    if (IndexOut != nullptr) {
+        *IndexOut = Index;
+    }
+
+    return Options;
+}
+
+int
+PrintResolvedBindsOperation::ParseOptions(const ArgvArray &Argv) noexcept {
+    auto Index = int();
+    Options = ParseOptionsImpl(Argv, &Index);
+
+    return Index;
+}
+
+int
+PrintResolvedBindsOperation::Run(const MemoryObject &Object) const noexcept
+{
+    switch (Object.getKind()) {
+        case ObjectKind::None:
+            assert(0 && "Object-Kind is None");
+        case ObjectKind::DyldSharedCache:
+            return Run(cast<ObjectKind::DyldSharedCache>(Object), Options);
+        case ObjectKind::MachO:
+        case ObjectKind::FatMachO:
+        case ObjectKind::DscImage:
+            return InvalidObjectKind;
+    }
+
+    assert(0 && "Unrecognized Object-Kind");
+}
@@ -90,6 +90,48 @@ CompareEntriesBySortKind(
     assert(0 && "Unrecognized (and invalid) Sort-Kind");
 }
 
+[[nodiscard]]
+static std::string
+GetVersionString(const Dyld3::PackedVersion &Version) noexcept {
+    return std::format("{}.{}.{}",
+                       Version.getMajor(),
+                       Version.getMinor(),
+                       Version.getRevision());
+}
+
+static void
+WriteDylibListRecords(
+    const std::vector<DylibInfo> &DylibList,
+    const struct PrintSharedLibrariesOperation::Options &Options) noexcept
+{
+    auto Writer = Options.GetRecordWriter();
+    Writer.beginList();
+
+    for (const auto &DylibInfo : DylibList) {
+        Writer.beginRecord();
+        Writer.writeNumber("lc_index", DylibInfo.Index);
+
+        const auto KindNameOpt =
+            MachO::LoadCommand::KindGetName(DylibInfo.Kind);
+
+        if (KindNameOpt.has_value()) {
+            Writer.writeString("kind", KindNameOpt.value());
+        } else {
+            Writer.writeNull("kind");
+        }
+
+        Writer.writeString("path", DylibInfo.Name);
+        Writer.writeString("current_version",
+                           GetVersionString(DylibInfo.CurrentVersion));
+        Writer.writeString("compat_version",
+                           GetVersionString(DylibInfo.CompatVersion));
+        Writer.writeNumber("timestamp", DylibInfo.Timestamp);
+        Writer.endRecord();
+    }
+
+    Writer.endList();
+}
+
 int
 PrintSharedLibrariesOperation::Run(const MachOMemoryObject &Object,
                                    const struct Options &Options) noexcept
@@ -233,6 +275,11 @@ PrintSharedLibrariesOperation::Run(const MachOMemoryObject &Object,
         std::sort(DylibList.begin(), DylibList.end(), Comparator);
     }
 
+    if (Options.isRecordFormat()) {
+        WriteDylibListRecords(DylibList, Options);
+        return 0;
+    }
+
     const auto DylibListSize = DylibList.size();
     fprintf(Options.OutFile,
             "Provided file has %" PRIuPTR " Shared Libraries:\n",
@@ -324,6 +371,10 @@ PrintSharedLibrariesOperation::ParseOptionsImpl(const ArgvArray &Argv,
             AddSortKind(Options::SortKind::ByName, Argument, Options);
         } else if (strcmp(Argument, "--sort-by-timestamp") == 0) {
             AddSortKind(Options::SortKind::ByTimeStamp, Argument, Options);
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
         } else if (!Argument.isOption()) {
             break;
         } else {
@@ -0,0 +1,302 @@
+//
+//  Operations/PrintSlideInfo.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include "ADT/DyldSharedCache/SlideInfo.h"
+
+#include "Operations/Operation.h"
+#include "Operations/PrintSlideInfo.h"
+
+#include "Utils/PrintUtils.h"
+
+PrintSlideInfoOperation::PrintSlideInfoOperation() noexcept
+: Operation(OpKind) {}
+
+PrintSlideInfoOperation::PrintSlideInfoOperation(
+    const struct Options &Options) noexcept
+: Operation(OpKind), Options(Options) {}
+
+using SlideInfo = DyldSharedCache::SlideInfo;
+using SlideInfoVersion = DyldSharedCache::SlideInfoVersion;
+
+[[nodiscard]] static std::string_view
+GetVersionName(const SlideInfoVersion Version) noexcept {
+    switch (Version) {
+        case SlideInfoVersion::None:
+            break;
+        case SlideInfoVersion::V1:
+            return "v1";
+        case SlideInfoVersion::V2:
+            return "v2";
+        case SlideInfoVersion::V3:
+            return "v3";
+        case SlideInfoVersion::V4:
+            return "v4";
+        case SlideInfoVersion::V5:
+            return "v5";
+    }
+
+    assert(0 && "Unrecognized Slide-Info Version");
+}
+
+[[nodiscard]] static std::string_view
+GetErrorDescription(const SlideInfo::Error Error) noexcept {
+    switch (Error) {
+        case SlideInfo::Error::None:
+            break;
+        case SlideInfo::Error::InvalidRange:
+            return "Slide-Info is out of bounds";
+        case SlideInfo::Error::UnknownVersion:
+            return "Slide-Info has an unknown version";
+        case SlideInfo::Error::InvalidPageSize:
+            return "Slide-Info has an invalid page-size";
+        case SlideInfo::Error::InvalidPageStarts:
+            return "Slide-Info has invalid page-starts";
+        case SlideInfo::Error::InvalidPageExtras:
+            return "Slide-Info has invalid page-extras";
+        case SlideInfo::Error::InvalidChain:
+            return "Slide-Info has a chain that runs out of its page";
+    }
+
+    assert(0 && "Unrecognized Slide-Info Error");
+}
+
+[[nodiscard]] static std::string_view
+GetKeyName(const uint8_t Key) noexcept {
+    switch (Key) {
+        case 0:
+            return "IA";
+        case 1:
+            return "IB";
+        case 2:
+            return "DA";
+        case 3:
+            return "DB";
+    }
+
+    return "Unknown";
+}
+
+static void
+WriteRebaseRecords(RecordWriter &Writer,
+                   const SlideInfo &Info,
+                   const std::vector<SlideInfo::Rebase> &RebaseList) noexcept
+{
+    for (const auto &Rebase : RebaseList) {
+        const auto &Pointer = Rebase.Pointer;
+
+        Writer.beginRecord();
+        Writer.writeNumber("mapping", Info.getMappingIndex());
+        Writer.writeNumber("address", Rebase.Address);
+        Writer.writeNumber("target", Pointer.Target);
+        Writer.writeBool("authenticated", Pointer.IsAuthenticated);
+
+        if (Pointer.IsAuthenticated) {
+            Writer.writeString("key", GetKeyName(Pointer.Key));
+            Writer.writeNumber("diversity", Pointer.Diversity);
+            Writer.writeBool("address_diversity", Pointer.HasAddressDiversity);
+        } else {
+            Writer.writeNull("key");
+            Writer.writeNull("diversity");
+            Writer.writeNull("address_diversity");
+        }
+
+        Writer.endRecord();
+    }
+}
+
+static void
+PrintRebaseList(const std::vector<SlideInfo::Rebase> &RebaseList,
+                const struct PrintSlideInfoOperation::Options &Options) noexcept
+{
+    const auto DigitLength =
+        PrintUtilsGetIntegerDigitLength(RebaseList.size());
+
+    auto Counter = uint64_t();
+    for (const auto &Rebase : RebaseList) {
+        const auto &Pointer = Rebase.Pointer;
+
+        Counter++;
+        fprintf(Options.OutFile,
+                "\tRebase %0*" PRIu64 ": ",
+                DigitLength,
+                Counter);
+
+        PrintUtilsWriteOffset(Options.OutFile, Rebase.Address);
+        fputs(" -> ", Options.OutFile);
+        PrintUtilsWriteOffset(Options.OutFile, Pointer.Target, false);
+
+        if (Options.Verbose && Pointer.IsAuthenticated) {
+            fprintf(Options.OutFile,
+                    " <Auth, Key %s, Diversity 0x%" PRIx16 "%s>",
+                    GetKeyName(Pointer.Key).data(),
+                    Pointer.Diversity,
+                    Pointer.HasAddressDiversity ? ", Address-Diversity" : "");
+        }
+
+        fputc('\n', Options.OutFile);
+    }
+}
+
+int
+PrintSlideInfoOperation::Run(const DscMemoryObject &Object,
+                             const struct Options &Options) noexcept
+{
+    auto Error = SlideInfo::Error::None;
+    const auto List = SlideInfo::OpenAll(Object.getMap(), &Error);
+
+    if (Error != SlideInfo::Error::None) {
+        fprintf(Options.ErrFile,
+                "Warning: %s\n",
+                GetErrorDescription(Error).data());
+    }
+
+    if (List.empty()) {
+        if (!Options.isRecordFormat()) {
+            fputs("Provided file has no slide-info\n", Options.OutFile);
+        }
+
+        return Error != SlideInfo::Error::None;
+    }
+
+    auto Writer = std::optional<RecordWriter>();
+    if (Options.isRecordFormat()) {
+        Writer.emplace(Options.GetRecordWriter());
+        Writer->beginList();
+    }
+
+    auto TotalCount = uint64_t();
+    for (const auto &Info : List) {
+        if (!Options.isRecordFormat()) {
+            fprintf(Options.OutFile,
+                    "Mapping %" PRIu32 ": ",
+                    Info.getMappingIndex());
+
+            PrintUtilsWriteOffsetRange(Options.OutFile,
+                                       Info.getMappingAddress(),
+                                       Info.getMappingAddress() +
+                                        Info.getMappingSize(),
+                                       true);
+
+            fprintf(Options.OutFile,
+                    " Slide-Info %s, %" PRIu32 " Pages of %" PRIu32
+                    " Bytes\n",
+                    GetVersionName(Info.getVersion()).data(),
+                    Info.getPageCount(),
+                    Info.getPageSize());
+        }
+
+        auto DecodeError = SlideInfo::Error::None;
+        const auto RebaseList = Info.GetRebaseList(&DecodeError);
+
+        if (DecodeError != SlideInfo::Error::None) {
+            fprintf(Options.ErrFile,
+                    "Warning: Mapping %" PRIu32 ": %s\n",
+                    Info.getMappingIndex(),
+                    GetErrorDescription(DecodeError).data());
+        }
+
+        TotalCount += RebaseList.size();
+        if (Writer.has_value()) {
+            if (Options.PrintRebases) {
+                WriteRebaseRecords(Writer.value(), Info, RebaseList);
+            } else {
+                Writer->beginRecord();
+                Writer->writeNumber("mapping", Info.getMappingIndex());
+                Writer->writeNumber("address", Info.getMappingAddress());
+                Writer->writeNumber("size", Info.getMappingSize());
+                Writer->writeString("version",
+                                    GetVersionName(Info.getVersion()));
+                Writer->writeNumber("page_size", Info.getPageSize());
+                Writer->writeNumber("page_count", Info.getPageCount());
+                Writer->writeNumber("rebase_count", RebaseList.size());
+                Writer->endRecord();
+            }
+
+            continue;
+        }
+
+        if (Options.PrintRebases) {
+            PrintRebaseList(RebaseList, Options);
+        }
+
+        fprintf(Options.OutFile,
+                "\t%" PRIuPTR " Rebased Pointers\n",
+                RebaseList.size());
+    }
+
+    if (Writer.has_value()) {
+        Writer->endList();
+        return 0;
+    }
+
+    fprintf(Options.OutFile,
+            "%" PRIu64 " Rebased Pointers across %" PRIuPTR " Mappings\n",
+            TotalCount,
+            List.size());
+
+    return 0;
+}
+
+auto
+PrintSlideInfoOperation::ParseOptionsImpl(const ArgvArray &Argv,
+                                          int *const IndexOut) noexcept
+    -> struct PrintSlideInfoOperation::Options
+{
+    auto Index = int();
+    struct Options Options;
+
+    for (const auto &Argument : Argv) {
+        if (strcmp(Argument, "-v") == 0 || strcmp(Argument, "--verbose") == 0) {
+            Options.Verbose = true;
+        } else if (strcmp(Argument, "--rebases") == 0) {
+            Options.PrintRebases = true;
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
+        } else if (!Argument.isOption()) {
+            break;
+        } else {
+            fprintf(stderr,
+                    "Unrecognized argument for operation %s: %s\n",
+                    OperationKindInfo<OpKind>::Name.data(),
+                    Argument.getString());
+            exit(1);
+        }
+
+        Index++;
+    }
+
+    if (IndexOut != nullptr) {
+        *IndexOut = Index;
+    }
+
+    return Options;
+}
+
+int PrintSlideInfoOperation::ParseOptions(const ArgvArray &Argv) noexcept {
+    auto Index = int();
+    Options = ParseOptionsImpl(Argv, &Index);
+
+    return Index;
+}
+
+int PrintSlideInfoOperation::Run(const MemoryObject &Object) const noexcept {
+    switch (Object.getKind()) {
+        case ObjectKind::None:
+            assert(0 && "Object-Kind is None");
+        case ObjectKind::DyldSharedCache:
+            return Run(cast<ObjectKind::DyldSharedCache>(Object), Options);
+        case ObjectKind::MachO:
+        case ObjectKind::FatMachO:
+        case ObjectKind::DscImage:
+            return InvalidObjectKind;
+    }
+
+    assert(0 && "Unrecognized Object-Kind");
+}
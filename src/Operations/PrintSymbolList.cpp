@@ -0,0 +1,477 @@
+//
+//  Operations/PrintSymbolList.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <cerrno>
+#include <optional>
+#include <vector>
+
+#include "ADT/DyldSharedCache/LocalSymbols.h"
+#include "ADT/FileDescriptor.h"
+#include "ADT/MappedFile.h"
+
+#include "Operations/Common.h"
+#include "Operations/Operation.h"
+#include "Operations/PrintSymbolList.h"
+
+#include "Utils/Path.h"
+#include "Utils/PrintUtils.h"
+
+PrintSymbolListOperation::PrintSymbolListOperation() noexcept
+: Operation(OpKind) {}
+
+PrintSymbolListOperation::PrintSymbolListOperation(
+    const struct Options &Options) noexcept
+: Operation(OpKind), Options(Options) {}
+
+struct SymbolEntry {
+    std::string_view Name;
+    uint64_t Value;
+
+    MachO::SymbolTableEntryInfo Info;
+    uint8_t SectionOrdinal;
+
+    // Whether the symbol was found in the local-symbols of the
+    // dyld_shared_cache, rather than in the image's own symbol-table.
+
+    bool IsCacheLocal;
+};
+
+template <typename EntryList>
+static void
+AddSymbolEntries(const EntryList &List,
+                 const std::string_view StringTable,
+                 const bool IsBigEndian,
+                 const bool IsCacheLocal,
+                 const struct PrintSymbolListOperation::Options &Options,
+                 std::vector<SymbolEntry> &ListOut) noexcept
+{
+    for (const auto &Entry : List) {
+        if (Entry.Info.isDebugSymbol() && !Options.IncludeDebugSymbols) {
+            continue;
+        }
+
+        const auto Index = Entry.getIndex(IsBigEndian);
+        if (Index >= StringTable.length()) {
+            continue;
+        }
+
+        const auto Rest = StringTable.substr(Index);
+        ListOut.emplace_back(SymbolEntry {
+            .Name = Rest.substr(0, Rest.find('\0')),
+            .Value = Entry.getValue(IsBigEndian),
+            .Info = Entry.Info,
+            .SectionOrdinal = Entry.getSectionOrdinal(IsBigEndian),
+            .IsCacheLocal = IsCacheLocal
+        });
+    }
+}
+
+static void
+AddImageSymbols(const MachOMemoryObject &Object,
+                const ConstMemoryMap &Map,
+                const struct PrintSymbolListOperation::Options &Options,
+                std::vector<SymbolEntry> &ListOut) noexcept
+{
+    const auto IsBigEndian = Object.isBigEndian();
+    const auto LoadCmdStorage =
+        OperationCommon::GetConstLoadCommandStorage(Object, Options.ErrFile);
+
+    const auto *SymTab = static_cast<const MachO::SymTabCommand *>(nullptr);
+    for (const auto &LC : LoadCmdStorage) {
+        SymTab = dyn_cast<MachO::SymTabCommand>(LC, IsBigEndian);
+        if (SymTab != nullptr) {
+            break;
+        }
+    }
+
+    if (SymTab == nullptr) {
+        return;
+    }
+
+    const auto StrOff = SymTab->getStringTableOffset(IsBigEndian);
+    const auto StrSize = SymTab->getStringTableSize(IsBigEndian);
+
+    const auto MapSize = static_cast<uint64_t>(Map.size());
+
+    auto StrEnd = uint64_t();
+    if (DoesAddOverflow(StrOff, StrSize, &StrEnd) || StrEnd > MapSize) {
+        fputs("Provided file has a string-table that is out-of-bounds\n",
+              Options.ErrFile);
+        return;
+    }
+
+    const auto StringTable =
+        std::string_view(reinterpret_cast<const char *>(Map.getBegin()) +
+                            StrOff,
+                         StrSize);
+
+    if (Object.is64Bit()) {
+        const auto List = SymTab->GetConstEntry64List(Map, IsBigEndian);
+        if (List.getError() == MachO::SizeRangeError::None) {
+            AddSymbolEntries(*List.value(),
+                             StringTable,
+                             IsBigEndian,
+                             false,
+                             Options,
+                             ListOut);
+        }
+    } else {
+        const auto List = SymTab->GetConstEntry32List(Map, IsBigEndian);
+        if (List.getError() == MachO::SizeRangeError::None) {
+            AddSymbolEntries(*List.value(),
+                             StringTable,
+                             IsBigEndian,
+                             false,
+                             Options,
+                             ListOut);
+        }
+    }
+}
+
+static void
+PrintLocalSymbolsError(FILE *const ErrFile,
+                       const DyldSharedCache::LocalSymbolsTable::Error Error)
+    noexcept
+{
+    using Enum = DyldSharedCache::LocalSymbolsTable::Error;
+    switch (Error) {
+        case Enum::None:
+        case Enum::NoLocalSymbols:
+            break;
+        case Enum::NeedsSymbolsFile:
+            fputs("Warning: Local-Symbols of the Shared-Cache are in its "
+                  ".symbols file, provide it with --symbols-file=<path>\n",
+                  ErrFile);
+            break;
+        case Enum::SymbolsFileMismatch:
+            fputs("Warning: Provided .symbols file does not belong to the "
+                  "Shared-Cache\n",
+                  ErrFile);
+            break;
+        case Enum::InvalidRange:
+            fputs("Warning: Local-Symbols of the Shared-Cache are "
+                  "out-of-bounds\n",
+                  ErrFile);
+            break;
+        case Enum::InvalidNlistRange:
+            fputs("Warning: Local-Symbols of the Shared-Cache have an "
+                  "out-of-bounds symbol-list\n",
+                  ErrFile);
+            break;
+        case Enum::InvalidStringRange:
+            fputs("Warning: Local-Symbols of the Shared-Cache have an "
+                  "out-of-bounds string-table\n",
+                  ErrFile);
+            break;
+        case Enum::InvalidEntryRange:
+            fputs("Warning: Local-Symbols of the Shared-Cache have an "
+                  "out-of-bounds image-list\n",
+                  ErrFile);
+            break;
+        case Enum::InvalidEntry:
+            fputs("Warning: Local-Symbols of the Shared-Cache have images "
+                  "with invalid symbol-ranges\n",
+                  ErrFile);
+            break;
+    }
+}
+
+static int
+AddCacheLocalSymbols(const DscImageMemoryObject &Object,
+                     const struct PrintSymbolListOperation::Options &Options,
+                     std::vector<SymbolEntry> &ListOut) noexcept
+{
+    auto SymbolsFile = std::optional<MappedFile>();
+    auto SymbolsFileMap = std::optional<ConstMemoryMap>();
+
+    if (!Options.SymbolsFilePath.empty()) {
+        const auto Path = PathUtil::MakeAbsolute(Options.SymbolsFilePath);
+        const auto Fd =
+            FileDescriptor::Open(Path.data(), FileDescriptor::OpenKind::Read);
+
+        if (Fd.hasError()) {
+            fprintf(Options.ErrFile,
+                    "Could not open the .symbols file (at path: %s), error: "
+                    "\"%s\"\n",
+                    Path.data(),
+                    strerror(errno));
+            return 1;
+        }
+
+        auto FileMapProt = MappedFile::Protections();
+        FileMapProt.add(MappedFile::Protections::Flags::Read);
+
+        SymbolsFile.emplace(
+            MappedFile::Open(Fd, FileMapProt, MappedFile::MapKind::Private));
+
+        if (SymbolsFile->hasError()) {
+            fprintf(Options.ErrFile,
+                    "Could not map the .symbols file (at path: %s)\n",
+                    Path.data());
+            return 1;
+        }
+
+        SymbolsFileMap.emplace(static_cast<ConstMemoryMap>(*SymbolsFile));
+    }
+
+    auto Error = DyldSharedCache::LocalSymbolsTable::Error::None;
+    const auto Table =
+        DyldSharedCache::LocalSymbolsTable::OpenForCache(
+            Object.getDscMap(),
+            SymbolsFileMap.has_value() ? &SymbolsFileMap.value() : nullptr,
+            Object.is64Bit(),
+            &Error);
+
+    PrintLocalSymbolsError(Options.ErrFile, Error);
+    if (!Table.has_value()) {
+        return 0;
+    }
+
+    const auto MappingList = Object.getDscHeaderV0().getConstMappingInfoList();
+    const auto ImageOffset = Object.getAddress() - MappingList.front().Address;
+
+    const auto Slice = Table->GetSliceForImage(ImageOffset);
+    if (Slice == nullptr) {
+        return 0;
+    }
+
+    // The local-symbols of a cache are always little-endian.
+
+    if (Table->is64Bit()) {
+        AddSymbolEntries(Table->GetEntry64List(*Slice),
+                         Table->getStringTable(),
+                         false,
+                         true,
+                         Options,
+                         ListOut);
+    } else {
+        AddSymbolEntries(Table->GetEntry32List(*Slice),
+                         Table->getStringTable(),
+                         false,
+                         true,
+                         Options,
+                         ListOut);
+    }
+
+    return 0;
+}
+
+static void
+WriteSymbolRecords(const std::vector<SymbolEntry> &List,
+                   const struct PrintSymbolListOperation::Options &Options)
+    noexcept
+{
+    auto Writer = Options.GetRecordWriter();
+    Writer.beginList();
+
+    for (const auto &Symbol : List) {
+        Writer.beginRecord();
+        Writer.writeString("symbol", Symbol.Name);
+        Writer.writeNumber("value", Symbol.Value);
+
+        const auto KindName =
+            MachO::SymbolTableEntrySymbolKindGetName(Symbol.Info.getKind());
+
+        if (KindName.has_value()) {
+            Writer.writeString("kind", KindName.value());
+        } else {
+            Writer.writeNull("kind");
+        }
+
+        if (Symbol.Info.isSectionDefined()) {
+            Writer.writeNumber("section", Symbol.SectionOrdinal);
+        } else {
+            Writer.writeNull("section");
+        }
+
+        Writer.writeBool("external", Symbol.Info.isExternal());
+        Writer.writeBool("private_external", Symbol.Info.isPrivateExternal());
+        Writer.writeBool("debug_symbol", Symbol.Info.isDebugSymbol());
+        Writer.writeBool("cache_local", Symbol.IsCacheLocal);
+        Writer.endRecord();
+    }
+
+    Writer.endList();
+}
+
+static void
+PrintSymbols(const std::vector<SymbolEntry> &List,
+             const bool Is64Bit,
+             const struct PrintSymbolListOperation::Options &Options) noexcept
+{
+    Operation::PrintLineSpamWarning(Options.OutFile, List.size());
+    fprintf(Options.OutFile,
+            "Provided file has %" PRIuPTR " Symbols:\n",
+            List.size());
+
+    const auto DigitLength = PrintUtilsGetIntegerDigitLength(List.size());
+
+    auto Counter = uint64_t();
+    for (const auto &Symbol : List) {
+        Counter++;
+        fprintf(Options.OutFile,
+                "Symbol %0*" PRIu64 ": ",
+                DigitLength,
+                Counter);
+
+        PrintUtilsWriteOffset32Or64(Options.OutFile, Is64Bit, Symbol.Value);
+        fprintf(Options.OutFile,
+                " \"" STRING_VIEW_FMT "\"",
+                STRING_VIEW_FMT_ARGS(Symbol.Name));
+
+        if (Options.Verbose) {
+            const auto KindDesc =
+                MachO::SymbolTableEntrySymbolKindGetDesc(
+                    Symbol.Info.getKind());
+
+            fprintf(Options.OutFile,
+                    " <Kind: %s",
+                    KindDesc.value_or("Unrecognized").data());
+
+            if (Symbol.Info.isSectionDefined()) {
+                fprintf(Options.OutFile,
+                        ", Section: %" PRIu8,
+                        Symbol.SectionOrdinal);
+            }
+
+            if (Symbol.Info.isPrivateExternal()) {
+                fputs(", Private-External", Options.OutFile);
+            } else if (Symbol.Info.isExternal()) {
+                fputs(", External", Options.OutFile);
+            }
+
+            if (Symbol.Info.isDebugSymbol()) {
+                fputs(", Debug-Symbol", Options.OutFile);
+            }
+
+            if (Symbol.IsCacheLocal) {
+                fputs(", Shared-Cache Local-Symbol", Options.OutFile);
+            }
+
+            fputc('>', Options.OutFile);
+        }
+
+        fputc('\n', Options.OutFile);
+    }
+}
+
+static int
+PrintSymbolsOrRecords(const std::vector<SymbolEntry> &List,
+                      const bool Is64Bit,
+                      const struct PrintSymbolListOperation::Options &Options)
+    noexcept
+{
+    if (Options.isRecordFormat()) {
+        WriteSymbolRecords(List, Options);
+        return 0;
+    }
+
+    if (List.empty()) {
+        fputs("Provided file has no symbols\n", Options.OutFile);
+        return 0;
+    }
+
+    PrintSymbols(List, Is64Bit, Options);
+    return 0;
+}
+
+int
+PrintSymbolListOperation::Run(const DscImageMemoryObject &Object,
+                              const struct Options &Options) noexcept
+{
+    auto List = std::vector<SymbolEntry>();
+    if (!Options.OnlyCacheLocalSymbols) {
+        AddImageSymbols(Object, Object.getDscMap(), Options, List);
+    }
+
+    if (const auto Result = AddCacheLocalSymbols(Object, Options, List)) {
+        return Result;
+    }
+
+    return PrintSymbolsOrRecords(List, Object.is64Bit(), Options);
+}
+
+int
+PrintSymbolListOperation::Run(const MachOMemoryObject &Object,
+                              const struct Options &Options) noexcept
+{
+    auto List = std::vector<SymbolEntry>();
+    AddImageSymbols(Object, Object.getMap(), Options, List);
+
+    return PrintSymbolsOrRecords(List, Object.is64Bit(), Options);
+}
+
+auto
+PrintSymbolListOperation::ParseOptionsImpl(const ArgvArray &Argv,
+                                           int *const IndexOut) noexcept
+    -> struct PrintSymbolListOperation::Options
+{
+    auto Index = int();
+    struct Options Options;
+
+    for (const auto &Argument : Argv) {
+        if (strcmp(Argument, "-v") == 0 || strcmp(Argument, "--verbose") == 0) {
+            Options.Verbose = true;
+        } else if (strcmp(Argument, "--debug-symbols") == 0) {
+            Options.IncludeDebugSymbols = true;
+        } else if (strcmp(Argument, "--cache-locals-only") == 0) {
+            Options.OnlyCacheLocalSymbols = true;
+        } else if (Argument.GetStringView().starts_with("--symbols-file=")) {
+            Options.SymbolsFilePath =
+                Argument.GetStringView().substr(LENGTH_OF("--symbols-file="));
+
+            if (Options.SymbolsFilePath.empty()) {
+                fputs("Please provide a path to --symbols-file\n", stderr);
+                exit(1);
+            }
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
+        } else if (!Argument.isOption()) {
+            break;
+        } else {
+            fprintf(stderr,
+                    "Unrecognized argument for operation %s: %s\n",
+                    OperationKindInfo<OpKind>::Name.data(),
+                    Argument.getString());
+            exit(1);
+        }
+
+        Index++;
+    }
+
+    if (IndexOut != nullptr) {
+        *IndexOut = Index;
+    }
+
+    return Options;
+}
+
+int PrintSymbolListOperation::ParseOptions(const ArgvArray &Argv) noexcept {
+    auto Index = int();
+    Options = ParseOptionsImpl(Argv, &Index);
+
+    return Index;
+}
+
+int PrintSymbolListOperation::Run(const MemoryObject &Object) const noexcept {
+    switch (Object.getKind()) {
+        case ObjectKind::None:
+            assert(0 && "Object-Kind is None");
+        case ObjectKind::MachO:
+            return Run(cast<ObjectKind::MachO>(Object), Options);
+        case ObjectKind::DscImage:
+            return Run(cast<ObjectKind::DscImage>(Object), Options);
+        case ObjectKind::FatMachO:
+        case ObjectKind::DyldSharedCache:
+            return InvalidObjectKind;
+    }
+
+    assert(0 && "Unrecognized Object-Kind");
+}
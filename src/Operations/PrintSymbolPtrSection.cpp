@@ -6,6 +6,8 @@
 //  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
 //
 
+#include "ADT/ParallelSort.h"
+
 #include "Operations/Common.h"
 #include "Operations/Operation.h"
 #include "Operations/PrintSymbolPtrSection.h"
@@ -17,47 +19,112 @@ PrintSymbolPtrSectionOperation::PrintSymbolPtrSectionOperation(
     const struct Options &Options) noexcept
 : Operation(OpKind), Options(Options) {}
 
+template <PrintSymbolPtrSectionOperation::Options::SortKind SortKind>
 static int
 CompareEntriesBySortKind(
-    const MachO::SymbolTableEntryCollectionEntryInfo &Lhs,
-    const MachO::SymbolTableEntryCollectionEntryInfo &Rhs,
-    const PrintSymbolPtrSectionOperation::Options::SortKind SortKind) noexcept
+    MachO::SymbolTableEntryCollectionEntryInfo *const &Lhs,
+    MachO::SymbolTableEntryCollectionEntryInfo *const &Rhs) noexcept
 {
-    switch (SortKind) {
-        case PrintSymbolPtrSectionOperation::Options::SortKind::ByDylibOrdinal:
-            if (Lhs.getDylibOrdinal() == Rhs.getDylibOrdinal()) {
-                return 0;
-            } else if (Lhs.getDylibOrdinal() < Rhs.getDylibOrdinal()) {
-                return -1;
-            }
+    using Enum = PrintSymbolPtrSectionOperation::Options::SortKind;
+    if constexpr (SortKind == Enum::ByDylibOrdinal) {
+        if (Lhs->getDylibOrdinal() == Rhs->getDylibOrdinal()) {
+            return 0;
+        } else if (Lhs->getDylibOrdinal() < Rhs->getDylibOrdinal()) {
+            return -1;
+        }
 
-            return 1;
-        case PrintSymbolPtrSectionOperation::Options::SortKind::ByKind: {
-            const auto LhsKind = Lhs.getSymbolInfo().getKind();
-            const auto RhsKind = Rhs.getSymbolInfo().getKind();
-
-            if (LhsKind == RhsKind) {
-                return 0;
-            } else if (LhsKind < RhsKind) {
-                return -1;
-            }
+        return 1;
+    } else if constexpr (SortKind == Enum::ByKind) {
+        const auto LhsKind = Lhs->getSymbolInfo().getKind();
+        const auto RhsKind = Rhs->getSymbolInfo().getKind();
+
+        if (LhsKind == RhsKind) {
+            return 0;
+        } else if (LhsKind < RhsKind) {
+            return -1;
+        }
 
-            return 1;
+        return 1;
+    } else if constexpr (SortKind == Enum::ByIndex) {
+        if (Lhs->getIndex() == Rhs->getIndex()) {
+            return 0;
+        } else if (Lhs->getIndex() < Rhs->getIndex()) {
+            return -1;
         }
-        case PrintSymbolPtrSectionOperation::Options::SortKind::ByIndex: {
-            if (Lhs.getIndex() == Rhs.getIndex()) {
-                return 0;
-            } else if (Lhs.getIndex() < Rhs.getIndex()) {
-                return -1;
-            }
 
-            return 1;
+        return 1;
+    } else if constexpr (SortKind == Enum::BySymbol) {
+        return Lhs->getString()->compare(*Rhs->getString());
+    }
+}
+
+static void
+SortEntryList(
+    std::vector<MachO::SymbolTableEntryCollectionEntryInfo *> &List,
+    const struct PrintSymbolPtrSectionOperation::Options &Options) noexcept
+{
+    using Enum = PrintSymbolPtrSectionOperation::Options::SortKind;
+
+    // Without a sort-kind, entries are sorted by their index. Sorting by a
+    // single kind is by far the most common, so give it a comparator
+    // specialized at compile-time.
+
+    if (Options.SortKindList.empty()) {
+        ParallelSortWithFunc<CompareEntriesBySortKind<Enum::ByIndex>>(
+            List.begin(), List.end());
+        return;
+    }
+
+    if (Options.SortKindList.size() == 1) {
+        switch (Options.SortKindList.front()) {
+            case Enum::ByDylibOrdinal:
+                ParallelSortWithFunc<
+                    CompareEntriesBySortKind<Enum::ByDylibOrdinal>>(
+                        List.begin(), List.end());
+                return;
+            case Enum::ByKind:
+                ParallelSortWithFunc<CompareEntriesBySortKind<Enum::ByKind>>(
+                    List.begin(), List.end());
+                return;
+            case Enum::ByIndex:
+                ParallelSortWithFunc<CompareEntriesBySortKind<Enum::ByIndex>>(
+                    List.begin(), List.end());
+                return;
+            case Enum::BySymbol:
+                ParallelSortWithFunc<
+                    CompareEntriesBySortKind<Enum::BySymbol>>(
+                        List.begin(), List.end());
+                return;
+        }
+
+        assert(0 && "Unrecognized (and invalid) Sort-Kind");
+    }
+
+    using EntryType = MachO::SymbolTableEntryCollectionEntryInfo *;
+
+    auto FuncList = std::vector<SortCompareFunc<EntryType>>();
+    FuncList.reserve(Options.SortKindList.size());
+
+    for (const auto &SortKind : Options.SortKindList) {
+        switch (SortKind) {
+            case Enum::ByDylibOrdinal:
+                FuncList.emplace_back(
+                    CompareEntriesBySortKind<Enum::ByDylibOrdinal>);
+                break;
+            case Enum::ByKind:
+                FuncList.emplace_back(CompareEntriesBySortKind<Enum::ByKind>);
+                break;
+            case Enum::ByIndex:
+                FuncList.emplace_back(CompareEntriesBySortKind<Enum::ByIndex>);
+                break;
+            case Enum::BySymbol:
+                FuncList.emplace_back(
+                    CompareEntriesBySortKind<Enum::BySymbol>);
+                break;
         }
-        case PrintSymbolPtrSectionOperation::Options::SortKind::BySymbol:
-            return Lhs.getString()->compare(*Rhs.getString());
     }
 
-    assert(0 && "Unrecognized (and invalid) Sort-Kind");
+    ParallelSortWithFuncList(List.begin(), List.end(), FuncList);
 }
 
 static void
@@ -178,6 +245,60 @@ PrintSymbolList(
     }
 }
 
+static void
+WriteSymbolListRecords(
+    const struct PrintSymbolPtrSectionOperation::Options &Options,
+    const MachO::SegmentInfoCollection &SegmentCollection,
+    const MachO::SharedLibraryInfoCollection &SharedLibraryCollection,
+    const std::vector<MachO::SymbolTableEntryCollectionEntryInfo *> &List)
+{
+    auto Writer = Options.GetRecordWriter();
+    Writer.beginList();
+
+    for (const auto &Info : List) {
+        Writer.beginRecord();
+        Writer.writeNumber("index", Info->getIndex());
+        Writer.writeString("symbol", *Info->getString());
+
+        const auto &SymbolInfo = Info->getSymbolInfo();
+        const auto SymbolKindNameOpt =
+            MachO::SymbolTableEntrySymbolKindGetName(SymbolInfo.getKind());
+
+        if (SymbolKindNameOpt.has_value()) {
+            Writer.writeString("kind", SymbolKindNameOpt.value());
+        } else {
+            Writer.writeNull("kind");
+        }
+
+        Writer.writeBool("private_external", SymbolInfo.isPrivateExternal());
+        Writer.writeBool("debug_symbol", SymbolInfo.isDebugSymbol());
+
+        if (Info->isSectionDefined()) {
+            const auto Section =
+                SegmentCollection.GetSectionWithIndex(
+                    Info->getSectionOrdinal() - 1);
+
+            const auto Segment =
+                (Section != nullptr) ? Section->getSegment() : nullptr;
+
+            OperationCommon::WriteSegmentSectionFields(Writer,
+                                                       Segment,
+                                                       Section);
+        } else {
+            OperationCommon::WriteSegmentSectionFields(Writer,
+                                                       nullptr,
+                                                       nullptr);
+        }
+
+        OperationCommon::WriteDylibOrdinalFields(Writer,
+                                                 SharedLibraryCollection,
+                                                 Info->getDylibOrdinal());
+        Writer.endRecord();
+    }
+
+    Writer.endList();
+}
+
 static int
 PrintSymbolPtrList(
     const MachOMemoryObject &Object,
@@ -192,7 +313,7 @@ PrintSymbolPtrList(
 
     const auto Is64Bit = Object.is64Bit();
     const auto SegmentCollection =
-        MachO::SegmentInfoCollection::Open(LoadCmdStorage,
+        MachO::SegmentInfoCollection::Open(Object.getLoadCommandIndex(),
                                            Is64Bit,
                                            &SegmentCollectionError);
 
@@ -210,17 +331,18 @@ PrintSymbolPtrList(
 
     if (Segment->getFlags().isProtected()) {
         fprintf(Options.ErrFile,
-                "Provided segment \"%s\" is protected (encrypted)\n",
-                Segment->getName().data());
+                "Provided segment \"" STRING_VIEW_FMT "\" is protected "
+                "(encrypted)\n",
+                STRING_VIEW_FMT_ARGS(Segment->getName()));
         return 1;
     }
 
     const auto Section = Segment->FindSectionWithName(Options.SectionName);
     if (Section == nullptr) {
         fprintf(Options.ErrFile,
-                "Provided file has no section with name \"%s\" in provided "
-                "segment\n",
-                Options.SectionName.data());
+                "Provided file has no section with name \"" STRING_VIEW_FMT
+                "\" in provided segment\n",
+                STRING_VIEW_FMT_ARGS(Options.SectionName));
         return 1;
     }
 
@@ -229,10 +351,11 @@ PrintSymbolPtrList(
         SectionKind != MachO::SegmentSectionKind::NonLazySymbolPointers)
     {
         fprintf(Options.OutFile,
-                "Provided Segment-Section \"%s\",\"%s\" is neither a Non-Lazy "
+                "Provided Segment-Section \"" STRING_VIEW_FMT "\",\""
+                STRING_VIEW_FMT "\" is neither a Non-Lazy "
                 "nor a Lazy Symbol-Pointer Section\n",
-                Segment->getName().data(),
-                Section->getName().data());
+                STRING_VIEW_FMT_ARGS(Segment->getName()),
+                STRING_VIEW_FMT_ARGS(Section->getName()));
         return 0;
     }
 
@@ -356,27 +479,14 @@ PrintSymbolPtrList(
         return 1;
     }
 
-    if (!Options.SortKindList.empty()) {
-        std::sort(List.begin(),
-                  List.end(),
-                  [&](const auto &Lhs, const auto &Rhs) noexcept
-        {
-            for (const auto &Sort : Options.SortKindList) {
-                const auto Compare = CompareEntriesBySortKind(*Lhs, *Rhs, Sort);
-                if (Compare != 0) {
-                    return (Compare < 0);
-                }
-            }
+    SortEntryList(List, Options);
 
-            return false;
-        });
-    } else {
-        std::sort(List.begin(),
-                  List.end(),
-                  [&](const auto &Lhs, const auto &Rhs) noexcept
-        {
-            return Lhs->getIndex() < Rhs->getIndex();
-        });
+    if (Options.isRecordFormat()) {
+        WriteSymbolListRecords(Options,
+                               SegmentCollection,
+                               SharedLibraryCollection,
+                               List);
+        return 0;
     }
 
     PrintSymbolList(Options,
@@ -442,6 +552,10 @@ PrintSymbolPtrSectionOperation::ParseOptionsImpl(const ArgvArray &Argv,
             AddSortKind(Options::SortKind::ByKind, Argument, Options);
         } else if (strcmp(Argument, "--sort-by-symbol") == 0) {
             AddSortKind(Options::SortKind::BySymbol, Argument, Options);
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
         } else if (!Argument.isOption()) {
             if (DidGetInfo) {
                 break;
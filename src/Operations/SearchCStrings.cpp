@@ -0,0 +1,478 @@
+//
+//  Operations/SearchCStrings.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <regex>
+#include <thread>
+
+#include "ADT/CStringScanner.h"
+
+#include "Operations/Common.h"
+#include "Operations/Operation.h"
+#include "Operations/SearchCStrings.h"
+
+#include "Utils/PrintUtils.h"
+
+SearchCStringsOperation::SearchCStringsOperation() noexcept
+: Operation(OpKind) {}
+
+SearchCStringsOperation::SearchCStringsOperation(
+    const struct Options &Options) noexcept
+: Operation(OpKind), Options(Options) {}
+
+struct StringMatch {
+    std::string_view String;
+
+    uint64_t Offset;
+    uint64_t Addr;
+};
+
+struct SectionMatchList {
+    std::string SegmentName;
+    std::string SectionName;
+
+    std::vector<StringMatch> MatchList;
+};
+
+struct ImageMatchList {
+    std::vector<SectionMatchList> SectionList;
+
+    bool Is64Bit : 1 = false;
+    bool FailedToParse : 1 = false;
+};
+
+[[nodiscard]] static bool
+RegexMatches(const std::regex &Regex, const std::string_view String) noexcept {
+    try {
+        return std::regex_search(String.begin(), String.end(), Regex);
+    } catch (const std::regex_error &) {
+        return false;
+    }
+}
+
+template <typename T>
+static void
+ForEachMatchingCString(
+    const char *const Begin,
+    const char *const End,
+    const struct SearchCStringsOperation::Options &Options,
+    const std::regex *const Regex,
+    const T &Callback) noexcept
+{
+    using MatchKind = SearchCStringsOperation::Options::MatchKind;
+    if (Options.Match == MatchKind::Regex) {
+        ScanPrintableCStrings(Begin, End, [&](const std::string_view String,
+                                              const uint64_t Offset) noexcept
+        {
+            if (RegexMatches(*Regex, String)) {
+                Callback(String, Offset);
+            }
+        });
+
+        return;
+    }
+
+    // Literal and prefix patterns are searched for in the section's data
+    // directly, so that only the strings with a match are ever looked at.
+
+    for (auto Ptr = Begin; Ptr < End;) {
+        const auto Match = FindSubstring(Ptr, End, Options.Pattern);
+        if (Match == nullptr) {
+            break;
+        }
+
+        // Ptr is always at the start of a string, so the string with the
+        // match can't begin before it.
+
+        auto StringBegin = Match;
+        while (StringBegin != Ptr && StringBegin[-1] != '\0') {
+            StringBegin--;
+        }
+
+        const auto StringEnd =
+            Match + strnlen(Match, static_cast<size_t>(End - Match));
+        const auto String =
+            std::string_view(StringBegin,
+                             static_cast<size_t>(StringEnd - StringBegin));
+
+        if (Options.Match != MatchKind::Prefix || Match == StringBegin) {
+            if (std::all_of(String.begin(),
+                            String.end(),
+                            CStringScanner::IsPrintable))
+            {
+                Callback(String, static_cast<uint64_t>(StringBegin - Begin));
+            }
+        }
+
+        Ptr = StringEnd + 1;
+    }
+}
+
+static void
+SearchImage(const DscMemoryObject &Object,
+            const DyldSharedCache::ImageInfo &ImageInfo,
+            const struct SearchCStringsOperation::Options &Options,
+            const std::regex *const Regex,
+            ImageMatchList &ListOut) noexcept
+{
+    const auto ImageOrError = Object.GetImageWithInfo(ImageInfo);
+    if (ImageOrError.hasError()) {
+        ListOut.FailedToParse = true;
+        return;
+    }
+
+    const auto Image =
+        std::unique_ptr<const DscImageMemoryObject>(ImageOrError.value());
+
+    const auto LoadCmdStorage = Image->GetLoadCommandsStorage();
+    if (LoadCmdStorage.hasError()) {
+        ListOut.FailedToParse = true;
+        return;
+    }
+
+    const auto Is64Bit = Image->is64Bit();
+
+    auto Error = MachO::SegmentInfoCollection::Error::None;
+    const auto Collection =
+        MachO::SegmentInfoCollection::Open(Image->getLoadCommandIndex(),
+                                           Is64Bit,
+                                           &Error);
+
+    if (Error != MachO::SegmentInfoCollection::Error::None) {
+        ListOut.FailedToParse = true;
+        return;
+    }
+
+    ListOut.Is64Bit = Is64Bit;
+
+    const auto Map = Object.getMap().getBegin();
+    const auto MapRange = Object.getRange();
+
+    for (const auto &Segment : Collection) {
+        if (Segment.getFlags().isProtected()) {
+            continue;
+        }
+
+        for (const auto &Section : Segment.getSectionList()) {
+            if (Section.getKind() !=
+                    MachO::SegmentSectionKind::CStringLiterals)
+            {
+                continue;
+            }
+
+            // Sections of images in a sub-cache are outside of this file.
+            if (!MapRange.contains(Section.getFileRange())) {
+                continue;
+            }
+
+            const auto FileOffset = Section.getFileRange().getBegin();
+            const auto VmAddr = Section.getMemoryRange().getBegin();
+
+            auto MatchList = std::vector<StringMatch>();
+            ForEachMatchingCString(Section.getData<const char>(Map),
+                                   Section.getDataEnd<const char>(Map),
+                                   Options,
+                                   Regex,
+                                   [&](const std::string_view String,
+                                       const uint64_t Offset) noexcept
+            {
+                MatchList.emplace_back(StringMatch {
+                    .String = String,
+                    .Offset = FileOffset + Offset,
+                    .Addr = VmAddr + Offset
+                });
+            });
+
+            if (MatchList.empty()) {
+                continue;
+            }
+
+            ListOut.SectionList.emplace_back(SectionMatchList {
+                .SegmentName = std::string(Segment.getName()),
+                .SectionName = std::string(Section.getName()),
+                .MatchList = std::move(MatchList)
+            });
+        }
+    }
+}
+
+// Images are handed out to threads one at a time, as the amount of C-Strings
+// varies greatly between images.
+
+static void
+SearchImageList(const DscMemoryObject &Object,
+                const struct SearchCStringsOperation::Options &Options,
+                const std::regex *const Regex,
+                std::vector<ImageMatchList> &ListOut) noexcept
+{
+    const auto ImageCount = Object.getImageCount();
+    const auto ThreadCount =
+        std::clamp(std::thread::hardware_concurrency(), 1u, ImageCount);
+
+    auto NextImageIndex = std::atomic<uint32_t>();
+    const auto SearchImages = [&]() noexcept {
+        for (auto Index = NextImageIndex++;
+             Index < ImageCount;
+             Index = NextImageIndex++)
+        {
+            SearchImage(Object,
+                        Object.getImageInfoAtIndex(Index),
+                        Options,
+                        Regex,
+                        ListOut[Index]);
+        }
+    };
+
+    auto ThreadList = std::vector<std::thread>();
+    ThreadList.reserve(ThreadCount - 1);
+
+    for (auto I = 1u; I != ThreadCount; I++) {
+        ThreadList.emplace_back(SearchImages);
+    }
+
+    SearchImages();
+    for (auto &Thread : ThreadList) {
+        Thread.join();
+    }
+}
+
+static void
+WriteMatchListRecords(
+    const uint8_t *const Map,
+    const DscMemoryObject &Object,
+    const std::vector<ImageMatchList> &ImageList,
+    const struct SearchCStringsOperation::Options &Options) noexcept
+{
+    auto Writer = Options.GetRecordWriter();
+    auto Index = uint32_t();
+
+    Writer.beginList();
+    for (const auto &Image : ImageList) {
+        const auto Path = Object.getImageInfoAtIndex(Index).getPath(Map);
+        for (const auto &Section : Image.SectionList) {
+            for (const auto &Match : Section.MatchList) {
+                Writer.beginRecord();
+                Writer.writeString("image", Path);
+                Writer.writeString("segment", Section.SegmentName);
+                Writer.writeString("section", Section.SectionName);
+                Writer.writeNumber("address", Match.Addr);
+                Writer.writeNumber("offset", Match.Offset);
+                Writer.writeString("string", Match.String);
+                Writer.endRecord();
+            }
+        }
+
+        Index++;
+    }
+
+    Writer.endList();
+}
+
+int
+SearchCStringsOperation::Run(const DscMemoryObject &Object,
+                             const struct Options &Options) noexcept
+{
+    const auto ImageCount = Object.getImageCount();
+    if (ImageCount == 0) {
+        fputs("Provided file has no images\n", Options.ErrFile);
+        return 1;
+    }
+
+    auto Regex = std::regex();
+    if (Options.Match == Options::MatchKind::Regex) {
+        try {
+            Regex = std::regex(Options.Pattern.begin(), Options.Pattern.end());
+        } catch (const std::regex_error &Error) {
+            fprintf(Options.ErrFile,
+                    "Provided pattern is not a valid regular-expression: %s\n",
+                    Error.what());
+            return 1;
+        }
+    }
+
+    auto ImageList = std::vector<ImageMatchList>(ImageCount);
+    SearchImageList(Object, Options, &Regex, ImageList);
+
+    const auto FailedCount =
+        std::count_if(ImageList.cbegin(),
+                      ImageList.cend(),
+                      [](const ImageMatchList &Image) noexcept {
+                          return Image.FailedToParse;
+                      });
+
+    if (FailedCount != 0) {
+        fprintf(Options.ErrFile,
+                "Warning: Skipped %" PRIdPTR " images that could not be "
+                "parsed\n",
+                FailedCount);
+    }
+
+    const auto Map = Object.getMap().getBegin();
+    if (Options.isRecordFormat()) {
+        WriteMatchListRecords(Map, Object, ImageList, Options);
+        return 0;
+    }
+
+    auto MatchCount = uint64_t();
+    auto MatchedImageCount = uint32_t();
+
+    for (const auto &Image : ImageList) {
+        for (const auto &Section : Image.SectionList) {
+            MatchCount += Section.MatchList.size();
+        }
+
+        if (!Image.SectionList.empty()) {
+            MatchedImageCount++;
+        }
+    }
+
+    if (MatchCount == 0) {
+        fputs("No C-Strings matched the provided pattern\n", Options.OutFile);
+        return 0;
+    }
+
+    Operation::PrintLineSpamWarning(Options.OutFile,
+                                    MatchCount + MatchedImageCount);
+
+    fprintf(Options.OutFile,
+            "Found %" PRIu64 " C-Strings in %" PRIu32 " Images:\n",
+            MatchCount,
+            MatchedImageCount);
+
+    const auto ImageCountDigitLength =
+        PrintUtilsGetIntegerDigitLength(ImageCount);
+
+    auto Index = uint32_t();
+    for (const auto &Image : ImageList) {
+        if (Image.SectionList.empty()) {
+            Index++;
+            continue;
+        }
+
+        const auto &Info = Object.getImageInfoAtIndex(Index);
+        fprintf(Options.OutFile,
+                "Image %0*" PRIu32 ": \"%s\"\n",
+                ImageCountDigitLength,
+                Index + 1,
+                Info.getPath(Map));
+
+        for (const auto &Section : Image.SectionList) {
+            for (const auto &Match : Section.MatchList) {
+                fprintf(Options.OutFile,
+                        "\t\"%s\",\"%s\" ",
+                        Section.SegmentName.data(),
+                        Section.SectionName.data());
+
+                PrintUtilsWriteOffset32Or64(Options.OutFile,
+                                            Image.Is64Bit,
+                                            Match.Addr);
+
+                fprintf(Options.OutFile,
+                        " \"" STRING_VIEW_FMT "\"",
+                        STRING_VIEW_FMT_ARGS(Match.String));
+
+                PrintUtilsWriteOffset32Or64(Options.OutFile,
+                                            Image.Is64Bit,
+                                            Match.Offset,
+                                            false,
+                                            " (File: ",
+                                            ")");
+
+                fputc('\n', Options.OutFile);
+            }
+        }
+
+        Index++;
+    }
+
+    return 0;
+}
+
+auto
+SearchCStringsOperation::ParseOptionsImpl(const ArgvArray &Argv,
+                                          int *const IndexOut) noexcept
+    -> struct SearchCStringsOperation::Options
+{
+    struct Options Options;
+
+    auto DidGetPattern = false;
+    auto DidGetMatchKind = false;
+    auto Index = int();
+
+    const auto SetMatchKind = [&](const Options::MatchKind Kind) noexcept {
+        if (DidGetMatchKind && Options.Match != Kind) {
+            fputs("Error: Provided both --prefix and --regex\n", stderr);
+            exit(1);
+        }
+
+        Options.Match = Kind;
+        DidGetMatchKind = true;
+    };
+
+    for (const auto &Argument : Argv) {
+        if (strcmp(Argument, "--prefix") == 0) {
+            SetMatchKind(Options::MatchKind::Prefix);
+        } else if (strcmp(Argument, "--regex") == 0) {
+            SetMatchKind(Options::MatchKind::Regex);
+        } else if (Argument.GetStringView().starts_with("--format=")) {
+            Options.Format =
+                Operation::ParseOutputFormatOption(Argument.GetStringView(),
+                                                   OpKind);
+        } else if (!Argument.isOption()) {
+            if (DidGetPattern) {
+                break;
+            }
+
+            Options.Pattern = Argument.GetStringView();
+            DidGetPattern = true;
+        } else {
+            fprintf(stderr,
+                    "Unrecognized argument for operation %s: %s\n",
+                    OperationKindInfo<OpKind>::Name.data(),
+                    Argument.getString());
+            exit(1);
+        }
+
+        Index++;
+    }
+
+    if (!DidGetPattern || Options.Pattern.empty()) {
+        fputs("Please provide a non-empty pattern to search for\n", stderr);
+        exit(1);
+    }
+
+    if (IndexOut != nullptr) {
+        *IndexOut = Index;
+    }
+
+    return Options;
+}
+
+int SearchCStringsOperation::ParseOptions(const ArgvArray &Argv) noexcept {
+    auto Index = int();
+    Options = ParseOptionsImpl(Argv, &Index);
+
+    return Index;
+}
+
+int SearchCStringsOperation::Run(const MemoryObject &Object) const noexcept {
+    switch (Object.getKind()) {
+        case ObjectKind::None:
+            assert(0 && "Object-Kind is None");
+        case ObjectKind::DyldSharedCache:
+            return Run(cast<ObjectKind::DyldSharedCache>(Object), Options);
+        case ObjectKind::MachO:
+        case ObjectKind::FatMachO:
+        case ObjectKind::DscImage:
+            return InvalidObjectKind;
+    }
+
+    assert(0 && "Unrecognized Object-Kind");
+}
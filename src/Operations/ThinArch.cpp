@@ -0,0 +1,300 @@
+//
+//  Operations/ThinArch.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <optional>
+
+#include "ADT/Mach.h"
+#include "ADT/OutputFile.h"
+
+#include "Objects/MachOMemory.h"
+
+#include "Operations/Operation.h"
+#include "Operations/ThinArch.h"
+
+#include "Utils/DoesOverflow.h"
+#include "Utils/MiscTemplates.h"
+#include "Utils/Path.h"
+#include "Utils/PrintUtils.h"
+#include "Utils/StringUtils.h"
+
+ThinArchOperation::ThinArchOperation() noexcept : Operation(OpKind) {}
+ThinArchOperation::ThinArchOperation(const struct Options &Options) noexcept
+: Operation(OpKind), Options(Options) {}
+
+[[nodiscard]] static auto
+EqualsIgnoreCase(const std::string_view Lhs,
+                 const std::string_view Rhs) noexcept
+{
+    const auto ToLower = [](const char Ch) noexcept {
+        if (Ch >= 'A' && Ch <= 'Z') {
+            return static_cast<char>(Ch - 'A' + 'a');
+        }
+
+        return Ch;
+    };
+
+    return std::ranges::equal(Lhs, Rhs, [&](const char L, const char R) {
+        return ToLower(L) == ToLower(R);
+    });
+}
+
+[[nodiscard]] static auto
+GetArchName(const FatMachOMemoryObject::ArchInfo &Info) noexcept
+    -> std::string_view
+{
+    const auto CpuKind = Info.CpuKind;
+    if (const auto Name = Mach::CpuSubKind::GetFullName(CpuKind,
+                                                        Info.CpuSubKind))
+    {
+        return Name.value();
+    }
+
+    return Mach::CpuKindGetDescription(CpuKind).value_or("Unknown");
+}
+
+// An arch is selected by its ordinal, by the full-name of its cpu-subtype
+// (ex. "Arm64E"), or by the name of its cpu-type (ex. "x86_64"). The first
+// matching arch is picked for a cpu-type shared by several archs.
+
+[[nodiscard]] static auto
+FindArchIndex(const FatMachOMemoryObject &Object,
+              const std::string_view Arch) noexcept -> std::optional<uint32_t>
+{
+    const auto ArchCount = Object.getArchCount();
+    if (std::ranges::all_of(Arch, IsDigit)) {
+        const auto ArchNumber = ParseNumber<uint32_t>(Arch.data());
+        if (ArchNumber == 0 || ArchNumber > ArchCount) {
+            return std::nullopt;
+        }
+
+        return ArchNumber - 1;
+    }
+
+    auto CpuKindMatch = std::optional<uint32_t>();
+    for (auto I = uint32_t(); I != ArchCount; I++) {
+        const auto Info = Object.GetArchInfoAtIndex(I);
+        const auto SubKindName =
+            Mach::CpuSubKind::GetFullName(Info.CpuKind, Info.CpuSubKind);
+
+        if (SubKindName.has_value() && EqualsIgnoreCase(*SubKindName, Arch)) {
+            return I;
+        }
+
+        if (CpuKindMatch.has_value()) {
+            continue;
+        }
+
+        const auto KindName = Mach::CpuKindGetDescription(Info.CpuKind);
+        if (KindName.has_value() && EqualsIgnoreCase(*KindName, Arch)) {
+            CpuKindMatch = I;
+        }
+    }
+
+    return CpuKindMatch;
+}
+
+[[nodiscard]] static std::string_view
+GetValidateErrorDescription(const MachOMemoryObject::Error Error) noexcept {
+    switch (Error) {
+        case MachOMemoryObject::Error::None:
+            break;
+        case MachOMemoryObject::Error::WrongFormat:
+            return "Not a Mach-O File";
+        case MachOMemoryObject::Error::SizeTooSmall:
+            return "Too small to be a Mach-O File";
+        case MachOMemoryObject::Error::TooManyLoadCommands:
+            return "Has too many load-commands for its size";
+    }
+
+    assert(0 && "Unrecognized Mach-O Error");
+}
+
+int
+ThinArchOperation::Run(const FatMachOMemoryObject &Object,
+                       const struct Options &Options) noexcept
+{
+    if (Options.Arch.empty()) {
+        fputs("Please provide an arch to extract with --arch=<ordinal|name>\n",
+              Options.ErrFile);
+        return 1;
+    }
+
+    if (Options.OutputPath.empty()) {
+        fputs("Please provide a path to extract the arch to with "
+              "--output=<path>\n",
+              Options.ErrFile);
+        return 1;
+    }
+
+    const auto ArchIndex = FindArchIndex(Object, Options.Arch);
+    if (!ArchIndex.has_value()) {
+        fprintf(Options.ErrFile,
+                "Provided file has no arch \"" STRING_VIEW_FMT "\"\n",
+                STRING_VIEW_FMT_ARGS(Options.Arch));
+        return 1;
+    }
+
+    const auto ArchNumber = ArchIndex.value() + 1;
+    const auto Info = Object.GetArchInfoAtIndex(ArchIndex.value());
+    const auto ArchName = GetArchName(Info);
+
+    auto ArchEnd = uint64_t();
+    if (DoesAddOverflow(Info.Offset, Info.Size, &ArchEnd) ||
+        ArchEnd > static_cast<uint64_t>(Object.getMap().size()))
+    {
+        fprintf(Options.ErrFile,
+                "Arch #%" PRIu32 " (" STRING_VIEW_FMT ") is out of bounds of "
+                "the file\n",
+                ArchNumber,
+                STRING_VIEW_FMT_ARGS(ArchName));
+        return 1;
+    }
+
+    const auto ArchBegin = Object.getMap().getBegin() + Info.Offset;
+    const auto ArchMap = ConstMemoryMap(ArchBegin, ArchBegin + Info.Size);
+
+    if (const auto Error = MachOMemoryObject::ValidateMap(ArchMap);
+        Error != MachOMemoryObject::Error::None)
+    {
+        fprintf(Options.ErrFile,
+                "Arch #%" PRIu32 " (" STRING_VIEW_FMT ") is invalid: %s\n",
+                ArchNumber,
+                STRING_VIEW_FMT_ARGS(ArchName),
+                GetValidateErrorDescription(Error).data());
+        return 1;
+    }
+
+    const auto Path = PathUtil::MakeAbsolute(Options.OutputPath);
+    auto Output = OutputFile(Path);
+
+    if (Output.hasError()) {
+        fprintf(Options.ErrFile,
+                "Failed to create %s, error: \"%s\"\n",
+                Path.data(),
+                strerror(errno));
+        return 1;
+    }
+
+    // The arch's range is copied straight from the input file where possible,
+    // and only otherwise written out of the mapped file.
+
+    auto IsCopiedFromFile = false;
+    if (Options.InputFd != -1) {
+        IsCopiedFromFile =
+            Output.CopyRangeFrom(Options.InputFd, Info.Offset, Info.Size);
+    }
+
+    if (!IsCopiedFromFile) {
+        if (!Output.TruncateToSize(0) ||
+            !Output.WriteAt(ArchBegin, Info.Size, 0))
+        {
+            fprintf(Options.ErrFile,
+                    "Failed to write to %s, error: \"%s\"\n",
+                    Path.data(),
+                    strerror(errno));
+            return 1;
+        }
+    }
+
+    if (!Output.Finalize()) {
+        fprintf(Options.ErrFile,
+                "Failed to move output to %s, error: \"%s\"\n",
+                Path.data(),
+                strerror(errno));
+        return 1;
+    }
+
+    fprintf(Options.OutFile,
+            "Extracted Arch #%" PRIu32 " (" STRING_VIEW_FMT ") to %s "
+            "(%" PRIu64 " bytes)\n",
+            ArchNumber,
+            STRING_VIEW_FMT_ARGS(ArchName),
+            Path.data(),
+            Info.Size);
+
+    if (Options.Verbose) {
+        fprintf(Options.OutFile,
+                "Arch was %s\n",
+                IsCopiedFromFile ?
+                    "copied without reading it into memory" :
+                    "written from memory");
+    }
+
+    return 0;
+}
+
+auto
+ThinArchOperation::ParseOptionsImpl(const ArgvArray &Argv,
+                                    int *const IndexOut) noexcept
+    -> struct ThinArchOperation::Options
+{
+    auto Index = int();
+    struct Options Options;
+
+    for (const auto &Argument : Argv) {
+        if (strcmp(Argument, "-v") == 0 || strcmp(Argument, "--verbose") == 0) {
+            Options.Verbose = true;
+        } else if (Argument.GetStringView().starts_with("--arch=")) {
+            Options.Arch =
+                Argument.GetStringView().substr(LENGTH_OF("--arch="));
+
+            if (Options.Arch.empty()) {
+                fputs("Please provide an arch to --arch\n", stderr);
+                exit(1);
+            }
+        } else if (Argument.GetStringView().starts_with("--output=")) {
+            Options.OutputPath =
+                Argument.GetStringView().substr(LENGTH_OF("--output="));
+
+            if (Options.OutputPath.empty()) {
+                fputs("Please provide a path to --output\n", stderr);
+                exit(1);
+            }
+        } else if (!Argument.isOption()) {
+            break;
+        } else {
+            fprintf(stderr,
+                    "Unrecognized argument for operation %s: %s\n",
+                    OperationKindInfo<OpKind>::Name.data(),
+                    Argument.getString());
+            exit(1);
+        }
+
+        Index++;
+    }
+
+    if (IndexOut != nullptr) {
+        *IndexOut = Index;
+    }
+
+    return Options;
+}
+
+int ThinArchOperation::ParseOptions(const ArgvArray &Argv) noexcept {
+    auto Index = int();
+    Options = ParseOptionsImpl(Argv, &Index);
+
+    return Index;
+}
+
+int ThinArchOperation::Run(const MemoryObject &Object) const noexcept {
+    switch (Object.getKind()) {
+        case ObjectKind::None:
+            assert(0 && "Object-Kind is None");
+        case ObjectKind::FatMachO:
+            return Run(cast<ObjectKind::FatMachO>(Object), Options);
+        case ObjectKind::MachO:
+        case ObjectKind::DyldSharedCache:
+        case ObjectKind::DscImage:
+            return InvalidObjectKind;
+    }
+
+    assert(0 && "Unrecognized Object-Kind");
+}
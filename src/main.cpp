@@ -6,15 +6,21 @@
 //  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
 //
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <inttypes.h>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 
 #include "ADT/ArgvArray.h"
 #include "ADT/FileDescriptor.h"
+#include "ADT/JsonWriter.h"
+#include "ADT/Mach.h"
 #include "ADT/MappedFile.h"
 
 #include "Objects/DscMemory.h"
@@ -26,6 +32,7 @@
 
 #include "Utils/MiscTemplates.h"
 #include "Utils/Path.h"
+#include "Utils/PrintUtils.h"
 #include "Utils/StringUtils.h"
 
 static void PrintRunHelpMessage() noexcept {
@@ -123,132 +130,423 @@ MatchesOption(const OperationKind Kind, const ArgvArrayIterator &Arg) noexcept {
     return false;
 }
 
-constexpr static auto UsageString =
-    "Usage: ktool [Operation] [Operation-Options] [Path] [Path-Options]\n";
-
-int main(const int Argc, const char *Argv[]) {
-    // Skip the command-name at Argv[0]
-
-    const auto ArgvArr = ArgvArray(Argc, Argv).fromIndex(1);
-    if (ArgvArr.empty()) {
-        PrintRunHelpMessage();
-        return 0;
-    }
-
-    // Get the Operation-Kind.
-
-    const auto OpsKindArg = ArgvArr.front();
-    if (!OpsKindArg.isOption()) {
-        fprintf(stderr,
-                "Expected Operation-Kind Option, Got: \"%s\"\n",
-                OpsKindArg.getString());
-        return 1;
-    }
-
-    if (OpsKindArg.isEmptyOption()) {
-        fputs("Please provide a non-empty option for an operation-kind\n",
-              stderr);
-        return 1;
-    }
-
+[[nodiscard]] static auto
+CreateOperation(const ArgvArrayIterator &OpsKindArg) noexcept
+    -> std::unique_ptr<Operation>
+{
     auto OpsKind = OperationKind::None;
-    auto OpsOpt = std::optional<std::unique_ptr<Operation>>();
 
     switch (OpsKind) {
         using Enum = OperationKind;
         case Enum::None:
-            if (OpsKindArg.isHelpOption()) {
-                fputs(UsageString, stdout);
-                fputs("Options:\n", stdout);
-
-                Operation::PrintHelpMenu(stdout);
-                return 0;
-            }
         case Enum::PrintHeader:
             if (MatchesOption(Enum::PrintHeader, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintHeaderOperation>();
-                break;
+                return std::make_unique<PrintHeaderOperation>();
             }
         case Enum::PrintLoadCommands:
             if (MatchesOption(Enum::PrintLoadCommands, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintLoadCommandsOperation>();
-                break;
+                return std::make_unique<PrintLoadCommandsOperation>();
             }
         case Enum::PrintSharedLibraries:
             if (MatchesOption(Enum::PrintSharedLibraries, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintSharedLibrariesOperation>();
-                break;
+                return std::make_unique<PrintSharedLibrariesOperation>();
             }
         case Enum::PrintId:
             if (MatchesOption(Enum::PrintId, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintIdOperation>();
-                break;
+                return std::make_unique<PrintIdOperation>();
             }
         case Enum::PrintArchList:
             if (MatchesOption(Enum::PrintArchList, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintArchListOperation>();
-                break;
+                return std::make_unique<PrintArchListOperation>();
             }
         case Enum::PrintExportTrie:
             if (MatchesOption(Enum::PrintExportTrie, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintExportTrieOperation>();
-                break;
+                return std::make_unique<PrintExportTrieOperation>();
             }
         case Enum::PrintObjcClassList:
             if (MatchesOption(Enum::PrintObjcClassList, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintObjcClassListOperation>();
-                break;
+                return std::make_unique<PrintObjcClassListOperation>();
             }
         case Enum::PrintBindActionList:
             if (MatchesOption(Enum::PrintBindActionList, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintBindActionListOperation>();
-                break;
+                return std::make_unique<PrintBindActionListOperation>();
             }
         case Enum::PrintBindOpcodeList:
             if (MatchesOption(Enum::PrintBindOpcodeList, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintBindOpcodeListOperation>();
-                break;
+                return std::make_unique<PrintBindOpcodeListOperation>();
             }
         case Enum::PrintBindSymbolList:
             if (MatchesOption(Enum::PrintBindSymbolList, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintBindSymbolListOperation>();
-                break;
+                return std::make_unique<PrintBindSymbolListOperation>();
             }
         case Enum::PrintRebaseActionList:
             if (MatchesOption(Enum::PrintRebaseActionList, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintRebaseActionListOperation>();
-                break;
+                return std::make_unique<PrintRebaseActionListOperation>();
             }
         case Enum::PrintRebaseOpcodeList:
             if (MatchesOption(Enum::PrintRebaseOpcodeList, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintRebaseOpcodeListOperation>();
-                break;
+                return std::make_unique<PrintRebaseOpcodeListOperation>();
             }
         case Enum::PrintCStringSection:
             if (MatchesOption(Enum::PrintCStringSection, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintCStringSectionOperation>();
-                break;
+                return std::make_unique<PrintCStringSectionOperation>();
             }
         case Enum::PrintSymbolPtrSection:
             if (MatchesOption(Enum::PrintSymbolPtrSection, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintSymbolPtrSectionOperation>();
-                break;
+                return std::make_unique<PrintSymbolPtrSectionOperation>();
             }
         case Enum::PrintImageList:
             if (MatchesOption(Enum::PrintImageList, OpsKindArg)) {
-                OpsOpt = std::make_unique<PrintImageListOperation>();
-                break;
+                return std::make_unique<PrintImageListOperation>();
+            }
+        case Enum::SearchCStrings:
+            if (MatchesOption(Enum::SearchCStrings, OpsKindArg)) {
+                return std::make_unique<SearchCStringsOperation>();
+            }
+        case Enum::PrintObjcMethodList:
+            if (MatchesOption(Enum::PrintObjcMethodList, OpsKindArg)) {
+                return std::make_unique<PrintObjcMethodListOperation>();
+            }
+        case Enum::PrintImageDependencies:
+            if (MatchesOption(Enum::PrintImageDependencies, OpsKindArg)) {
+                return std::make_unique<PrintImageDependenciesOperation>();
+            }
+        case Enum::PrintResolvedBinds:
+            if (MatchesOption(Enum::PrintResolvedBinds, OpsKindArg)) {
+                return std::make_unique<PrintResolvedBindsOperation>();
+            }
+        case Enum::PrintDiff:
+            if (MatchesOption(Enum::PrintDiff, OpsKindArg)) {
+                return std::make_unique<PrintDiffOperation>();
             }
+        case Enum::PrintSlideInfo:
+            if (MatchesOption(Enum::PrintSlideInfo, OpsKindArg)) {
+                return std::make_unique<PrintSlideInfoOperation>();
+            }
+        case Enum::PrintSymbolList:
+            if (MatchesOption(Enum::PrintSymbolList, OpsKindArg)) {
+                return std::make_unique<PrintSymbolListOperation>();
+            }
+        case Enum::ExtractImage:
+            if (MatchesOption(Enum::ExtractImage, OpsKindArg)) {
+                return std::make_unique<ExtractImageOperation>();
+            }
+        case Enum::ThinArch:
+            if (MatchesOption(Enum::ThinArch, OpsKindArg)) {
+                return std::make_unique<ThinArchOperation>();
+            }
+    }
+
+    return nullptr;
+}
+
+// Prints the error or warning of opening an arch, returning false on error.
+
+[[nodiscard]] static bool
+HandleArchObjectResult(
+    const FatMachOMemoryObject::GetArchObjectResult &ArchObjectOrError,
+    const uint32_t ArchNumber) noexcept
+{
+    switch (ArchObjectOrError.getError()) {
+        using ErrorEnum = FatMachOMemoryObject::GetArchObjectError;
+        case ErrorEnum::None:
+            break;
+
+        case ErrorEnum::InvalidArchRange:
+            fprintf(stderr,
+                    "Provided file's arch #%" PRIu32 " has an invalid "
+                    "file-range\n",
+                    ArchNumber);
+            return false;
+
+        case ErrorEnum::UnsupportedObjectKind:
+            fprintf(stderr,
+                    "Provided file's arch #%" PRIu32 " is of an "
+                    "unsupported object-kind\n",
+                    ArchNumber);
+            return false;
     }
 
-    if (!OpsOpt.has_value()) {
+    switch (ArchObjectOrError.getWarning()) {
+        using WarningEnum = FatMachOMemoryObject::GetArchObjectWarning;
+        case WarningEnum::None:
+            break;
+        case WarningEnum::MachOCpuKindMismatch:
+            fputs("Warning: Arch's Cpu-Kind differs from expected\n",
+                  stderr);
+            break;
+    }
+
+    return true;
+}
+
+struct ArchRun {
+    std::unique_ptr<Operation> Ops;
+    const MemoryObject *Object = nullptr;
+
+    char *OutBuffer = nullptr;
+    size_t OutSize = 0;
+
+    char *ErrBuffer = nullptr;
+    size_t ErrSize = 0;
+
+    int Result = 0;
+};
+
+[[nodiscard]] static std::string_view
+GetArchName(const FatMachOMemoryObject &FatObject,
+            const uint32_t Index) noexcept
+{
+    const auto ArchInfo = FatObject.GetArchInfoAtIndex(Index);
+    const auto ArchName =
+        Mach::CpuSubKind::GetName(ArchInfo.CpuKind,
+                                  ArchInfo.CpuSubKind).value_or(
+            Mach::CpuKindGetName(ArchInfo.CpuKind).value_or("Unrecognized"));
+
+    return ArchName;
+}
+
+// Writes an arch's buffered records as a {"arch", "records"} object, so that
+// the records of every arch can be told apart. With JSON, the objects of
+// every arch are gathered into one top-level array, while with NDJSON, each
+// arch's object is written on its own line.
+
+static void
+WriteArchRecords(FILE *const OutFile,
+                 const Operation::OutputFormat Format,
+                 const std::string_view ArchName,
+                 const std::string_view Records,
+                 const bool IsFirst) noexcept
+{
+    if (Format == Operation::OutputFormat::Json) {
+        fputs(IsFirst ? "[\n" : ",\n", OutFile);
+    }
+
+    fputs("{\"arch\":", OutFile);
+    JsonWriter::WriteEscapedString(OutFile, ArchName);
+    fputs(",\"records\":", OutFile);
+
+    switch (Format) {
+        case Operation::OutputFormat::Default:
+        case Operation::OutputFormat::Binary:
+            assert(0 && "WriteArchRecords() got a non-JSON format");
+        case Operation::OutputFormat::Json: {
+            // The records are already a JSON array, without the trailing
+            // newline.
+
+            const auto End = Records.find_last_not_of(" \n");
+            if (End != std::string_view::npos) {
+                fwrite(Records.data(), 1, End + 1, OutFile);
+            } else {
+                fputs("[]", OutFile);
+            }
+
+            fputc('}', OutFile);
+            break;
+        }
+        case Operation::OutputFormat::NdJson: {
+            // Each record is on its own line, so join the lines into an
+            // array.
+
+            fputc('[', OutFile);
+
+            auto Rest = Records;
+            auto IsFirstRecord = true;
+
+            while (!Rest.empty()) {
+                const auto LineEnd = Rest.find('\n');
+                const auto Line = Rest.substr(0, LineEnd);
+
+                if (!Line.empty()) {
+                    if (!IsFirstRecord) {
+                        fputc(',', OutFile);
+                    }
+
+                    fwrite(Line.data(), 1, Line.length(), OutFile);
+                    IsFirstRecord = false;
+                }
+
+                if (LineEnd == std::string_view::npos) {
+                    break;
+                }
+
+                Rest.remove_prefix(LineEnd + 1);
+            }
+
+            fputs("]}\n", OutFile);
+            break;
+        }
+    }
+}
+
+// Runs a copy of the operation on every arch of a fat file at once. Each
+// arch's output is buffered, and printed in arch order once every arch has
+// finished.
+
+[[nodiscard]] static int
+RunOnAllArchs(const FatMachOMemoryObject &FatObject,
+              const ArgvArrayIterator &OpsKindArg,
+              const ArgvArray &OpsArgv) noexcept
+{
+    const auto ArchCount = FatObject.getArchCount();
+    auto RunList = std::vector<ArchRun>(ArchCount);
+
+    for (auto Index = uint32_t(); Index != ArchCount; Index++) {
+        const auto ArchInfo = FatObject.GetArchInfoAtIndex(Index);
+        const auto ArchObjectOrError =
+            FatObject.GetArchObjectFromInfo(ArchInfo);
+
+        if (!HandleArchObjectResult(ArchObjectOrError, Index + 1)) {
+            continue;
+        }
+
+        auto &Run = RunList[Index];
+
+        Run.Object = ArchObjectOrError.getObject();
+        Run.Ops = CreateOperation(OpsKindArg);
+
+        static_cast<void>(Run.Ops->ParseOptions(OpsArgv));
+
+        auto &Options = Run.Ops->getOptions();
+
+        Options.OutFile = open_memstream(&Run.OutBuffer, &Run.OutSize);
+        Options.ErrFile = open_memstream(&Run.ErrBuffer, &Run.ErrSize);
+
+        if (Options.OutFile == nullptr || Options.ErrFile == nullptr) {
+            fputs("Failed to allocate output for archs\n", stderr);
+            exit(1);
+        }
+    }
+
+    const auto ThreadCount =
+        std::clamp(std::thread::hardware_concurrency(), 1u, ArchCount);
+
+    auto NextArchIndex = std::atomic<uint32_t>();
+    const auto RunArchs = [&]() noexcept {
+        for (auto Index = NextArchIndex++;
+             Index < ArchCount;
+             Index = NextArchIndex++)
+        {
+            auto &Run = RunList[Index];
+            if (Run.Ops == nullptr) {
+                continue;
+            }
+
+            Run.Result = Run.Ops->Run(*Run.Object);
+
+            auto &Options = Run.Ops->getOptions();
+
+            fclose(Options.OutFile);
+            fclose(Options.ErrFile);
+        }
+    };
+
+    auto ThreadList = std::vector<std::thread>();
+    ThreadList.reserve(ThreadCount - 1);
+
+    for (auto I = 1u; I != ThreadCount; I++) {
+        ThreadList.emplace_back(RunArchs);
+    }
+
+    RunArchs();
+    for (auto &Thread : ThreadList) {
+        Thread.join();
+    }
+
+    auto Result = 0;
+    auto RecordFormat = Operation::OutputFormat::Default;
+
+    for (auto Index = uint32_t(); Index != ArchCount; Index++) {
+        auto &Run = RunList[Index];
+        if (Run.Ops == nullptr) {
+            Result = 1;
+            continue;
+        }
+
+        const auto &Options = Run.Ops->getOptions();
+        const auto ArchName = GetArchName(FatObject, Index);
+
+        if (Options.isRecordFormat()) {
+            WriteArchRecords(stdout,
+                             Options.Format,
+                             ArchName,
+                             std::string_view(Run.OutBuffer, Run.OutSize),
+                             RecordFormat == Operation::OutputFormat::Default);
+
+            RecordFormat = Options.Format;
+        } else {
+            fprintf(stdout,
+                    "%sArch #%" PRIu32 " (" STRING_VIEW_FMT "):\n",
+                    Index != 0 ? "\n" : "",
+                    Index + 1,
+                    STRING_VIEW_FMT_ARGS(ArchName));
+
+            fwrite(Run.OutBuffer, 1, Run.OutSize, stdout);
+        }
+
+        fwrite(Run.ErrBuffer, 1, Run.ErrSize, stderr);
+
+        free(Run.OutBuffer);
+        free(Run.ErrBuffer);
+
+        if (Run.Result == Operation::InvalidObjectKind) {
+            Run.Ops->printObjectKindNotSupportedError(*Run.Object);
+            Result = 1;
+        }
+    }
+
+    if (RecordFormat == Operation::OutputFormat::Json) {
+        fputs("\n]\n", stdout);
+    }
+
+    return Result;
+}
+
+constexpr static auto UsageString =
+    "Usage: ktool [Operation] [Operation-Options] [Path] [Path-Options]\n";
+
+int main(const int Argc, const char *Argv[]) {
+    // Skip the command-name at Argv[0]
+
+    const auto ArgvArr = ArgvArray(Argc, Argv).fromIndex(1);
+    if (ArgvArr.empty()) {
+        PrintRunHelpMessage();
+        return 0;
+    }
+
+    // Get the Operation-Kind.
+
+    const auto OpsKindArg = ArgvArr.front();
+    if (!OpsKindArg.isOption()) {
+        fprintf(stderr,
+                "Expected Operation-Kind Option, Got: \"%s\"\n",
+                OpsKindArg.getString());
+        return 1;
+    }
+
+    if (OpsKindArg.isEmptyOption()) {
+        fputs("Please provide a non-empty option for an operation-kind\n",
+              stderr);
+        return 1;
+    }
+
+    if (OpsKindArg.isHelpOption()) {
+        fputs(UsageString, stdout);
+        fputs("Options:\n", stdout);
+
+        Operation::PrintHelpMenu(stdout);
+        return 0;
+    }
+
+    const auto OpsPtr = CreateOperation(OpsKindArg);
+    if (OpsPtr == nullptr) {
         PrintUnrecognizedOptionError(OpsKindArg);
         PrintRunHelpMessage();
 
         return 1;
     }
 
-    const auto Ops = OpsOpt->get();
+    const auto Ops = OpsPtr.get();
     const auto OpsArgv = ArgvArr.fromIndex(1);
 
     if (OpsArgv.empty()) {
@@ -410,6 +708,7 @@ int main(const int Argc, const char *Argv[]) {
 
     auto Object = ObjectOrError.value();
     auto SubObject = Object;
+    auto AllArchsObject = static_cast<FatMachOMemoryObject *>(nullptr);
 
     const auto PathArgv = OpsArgv.fromIndex(PathIndex + 1);
     for (auto &Argument : PathArgv) {
@@ -437,6 +736,10 @@ int main(const int Argc, const char *Argv[]) {
             }
 
             Argument.advance();
+            if (strcmp(Argument, "all") == 0) {
+                AllArchsObject = FatObject;
+                continue;
+            }
 
             const auto ArchNumber = ParseNumber<uint32_t>(Argument.getString());
             if (ArchNumber == 0) {
@@ -459,34 +762,8 @@ int main(const int Argc, const char *Argv[]) {
             const auto ArchInfo = FatObject->GetArchInfoAtIndex(ArchIndex);
             auto ArchObjectOrError = FatObject->GetArchObjectFromInfo(ArchInfo);
 
-            switch (ArchObjectOrError.getError()) {
-                using ErrorEnum = FatMachOMemoryObject::GetArchObjectError;
-                case ErrorEnum::None:
-                    break;
-
-                case ErrorEnum::InvalidArchRange:
-                    fprintf(stderr,
-                            "Provided file's arch #%" PRIu32 " has an invalid "
-                            "file-range\n",
-                            ArchNumber);
-                    return 1;
-
-                case ErrorEnum::UnsupportedObjectKind:
-                    fprintf(stderr,
-                            "Provided file's arch #%" PRIu32 " is of an "
-                            "unsupported object-kind\n",
-                            ArchNumber);
-                    return 1;
-            }
-
-            switch (ArchObjectOrError.getWarning()) {
-                using WarningEnum = FatMachOMemoryObject::GetArchObjectWarning;
-                case WarningEnum::None:
-                    break;
-                case WarningEnum::MachOCpuKindMismatch:
-                    fputs("Warning: Arch's Cpu-Kind differs from expected\n",
-                          stderr);
-                    break;
+            if (!HandleArchObjectResult(ArchObjectOrError, ArchNumber)) {
+                return 1;
             }
 
             SubObject = ArchObjectOrError.getObject();
@@ -549,6 +826,22 @@ int main(const int Argc, const char *Argv[]) {
         }
     }
 
+    if (AllArchsObject != nullptr) {
+        // A columnar file describes a single list of records, so there's no
+        // way to write several archs' lists into one.
+
+        if (Ops->getOptions().Format == Operation::OutputFormat::Binary) {
+            fputs("-arch all can't be used with --format=bin. Use -arch with "
+                  "an arch-number instead\n",
+                  stderr);
+            return 1;
+        }
+
+        return RunOnAllArchs(*AllArchsObject, OpsKindArg, OpsArgv);
+    }
+
+    Ops->getOptions().InputFd = Fd.getDescriptor();
+
     const auto Result = Ops->Run(*SubObject);
     if (Result == Operation::InvalidObjectKind) {
         Ops->printObjectKindNotSupportedError(*SubObject);
@@ -0,0 +1,116 @@
+//
+//  tests/ObjcClassLookupTest.cpp
+//  ktool
+//
+//  Created by Suhas Pai on 10/19/26.
+//  Copyright © 2020 - 2024 Suhas Pai. All rights reserved.
+//
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ADT/Mach-O/ObjcParse.h"
+
+// Builds an ExternalAndRootClassCollection of about as many classes as the
+// largest images in a shared-cache have, and checks that every lookup finds
+// the first class added for its dylib-ordinal and name.
+
+constexpr static auto ClassCount = uint64_t(50000);
+constexpr static auto DylibCount = uint64_t(64);
+
+[[nodiscard]] static auto GetDylibOrdinal(const uint64_t Index) noexcept {
+    return (Index % DylibCount) + 1;
+}
+
+[[nodiscard]] static auto GetName(const uint64_t Index) noexcept {
+    return "_TtC9Synthetic" + std::to_string(Index);
+}
+
+[[nodiscard]] static auto
+MakeExternalClass(const uint64_t Index) noexcept
+    -> std::unique_ptr<MachO::ObjcClassInfo>
+{
+    auto Info = std::make_unique<MachO::ObjcClassInfo>(GetName(Index));
+
+    Info->setIsExternal();
+    Info->setDylibOrdinal(GetDylibOrdinal(Index));
+    Info->setBindAddr(Index * 8);
+
+    return Info;
+}
+
+int main() {
+    auto ClassList = std::vector<std::unique_ptr<MachO::ObjcClassInfo>>();
+    auto Collection = MachO::ObjcParse::ExternalAndRootClassCollection();
+
+    ClassList.reserve(ClassCount * 2);
+    for (auto I = uint64_t(); I != ClassCount; I++) {
+        ClassList.emplace_back(MakeExternalClass(I));
+        Collection.add(ClassList.back().get());
+    }
+
+    // Add a second class for every key, which lookups must never return.
+    for (auto I = uint64_t(); I != ClassCount; I++) {
+        ClassList.emplace_back(MakeExternalClass(I));
+        Collection.add(ClassList.back().get());
+    }
+
+    if (Collection.getList().size() != ClassCount * 2) {
+        fprintf(stderr,
+                "Expected %" PRIu64 " classes in list, got %zu\n",
+                ClassCount * 2,
+                Collection.getList().size());
+        return 1;
+    }
+
+    auto NameList = std::vector<std::string>();
+    NameList.reserve(ClassCount);
+
+    for (auto I = uint64_t(); I != ClassCount; I++) {
+        NameList.emplace_back(GetName(I));
+    }
+
+    const auto Start = std::chrono::steady_clock::now();
+    for (auto I = uint64_t(); I != ClassCount; I++) {
+        const auto Found = Collection.find(GetDylibOrdinal(I), NameList[I]);
+        if (Found != ClassList[I].get()) {
+            fprintf(stderr,
+                    "Lookup of class %" PRIu64 " (\"%s\") returned the wrong "
+                    "class\n",
+                    I,
+                    NameList[I].c_str());
+            return 1;
+        }
+
+        // The same name under another dylib-ordinal is a different class.
+        const auto OtherOrdinal = GetDylibOrdinal(I + 1);
+        if (Collection.find(OtherOrdinal, NameList[I]) != nullptr) {
+            fprintf(stderr,
+                    "Lookup of class %" PRIu64 " with dylib-ordinal %" PRIu64
+                    " should have failed\n",
+                    I,
+                    OtherOrdinal);
+            return 1;
+        }
+    }
+
+    const auto Duration = std::chrono::steady_clock::now() - Start;
+    if (Collection.find(1, "_TtC9SyntheticMissing") != nullptr) {
+        fputs("Lookup of a missing class should have failed\n", stderr);
+        return 1;
+    }
+
+    const auto Microseconds =
+        std::chrono::duration_cast<std::chrono::microseconds>(Duration);
+
+    printf("%" PRIu64 " lookups over %zu classes took %lld us\n",
+           ClassCount * 2,
+           Collection.getList().size(),
+           static_cast<long long>(Microseconds.count()));
+
+    return 0;
+}